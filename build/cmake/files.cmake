@@ -437,12 +437,14 @@ set(BASE_CMN_SRC
     src/common/languageinfo.cpp
     src/common/list.cpp
     src/common/log.cpp
+    src/common/logasync.cpp
     src/common/longlong.cpp
     src/common/mimecmn.cpp
     src/common/module.cpp
     src/common/mstream.cpp
     src/common/numformatter.cpp
     src/common/object.cpp
+    src/common/parsedfmt.cpp
     src/common/platinfo.cpp
     src/common/process.cpp
     src/common/regex.cpp
@@ -460,6 +462,7 @@ set(BASE_CMN_SRC
     src/common/tarstrm.cpp
     src/common/textbuf.cpp
     src/common/textfile.cpp
+    src/common/threadpool.cpp
     src/common/time.cpp
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
@@ -566,6 +569,7 @@ set(BASE_CMN_HDR
     wx/list.h
     wx/listimpl.cpp
     wx/log.h
+    wx/logasync.h
     wx/longlong.h
     wx/math.h
     wx/memconf.h
@@ -579,6 +583,7 @@ set(BASE_CMN_HDR
     wx/mstream.h
     wx/numformatter.h
     wx/object.h
+    wx/parsedfmt.h
     wx/platform.h
     wx/platinfo.h
     wx/process.h
@@ -787,6 +792,7 @@ set(GUI_CMN_SRC
     src/common/imaggif.cpp
     src/common/imagiff.cpp
     src/common/imagjpeg.cpp
+    src/common/imageloader.cpp
     src/common/imagpcx.cpp
     src/common/imagpng.cpp
     src/common/imagpnm.cpp
@@ -885,6 +891,7 @@ set(GUI_CMN_SRC
     src/common/bmpcboxcmn.cpp
     src/generic/grideditors.cpp
     src/generic/gridctrl.cpp
+    src/generic/gridcoltable.cpp
     src/generic/grid.cpp
     src/generic/hyperlinkg.cpp
     src/common/calctrlcmn.cpp
@@ -1098,6 +1105,7 @@ set(GUI_CMN_HDR
     wx/imaggif.h
     wx/imagiff.h
     wx/imagjpeg.h
+    wx/imageloader.h
     wx/imaglist.h
     wx/imagpcx.h
     wx/imagpng.h
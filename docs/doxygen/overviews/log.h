@@ -195,6 +195,8 @@ also be used without any change. There are:
     the log, close it completely or save all messages to file.
 @li wxLogBuffer: This target collects all the logged messages in an internal
     buffer allowing to show them later to the user all at once.
+@li wxLogAsync: This target writes the messages to a file or a stream from a
+    background thread, without blocking the threads logging them.
 @li wxLogNull: The last log class is quite particular: it doesn't do anything.
     The objects of this class may be instantiated to (temporarily) suppress
     output of @e wxLogXXX() functions. As an example, trying to open a
@@ -238,6 +240,12 @@ with later timestamp may appear before messages with earlier timestamp logged
 from other threads. wxLog does however guarantee that messages logged by each
 thread will appear in order in which they were logged.
 
+Log targets which are thread-safe, i.e. override wxLog::IsThreadSafe() to
+return @true, are used directly by all threads instead. Notably, wxLogAsync is
+such a target and is particularly suitable for applications logging many
+messages from several threads, as each thread only adds the messages to its own
+queue and they are written out by a separate thread.
+
 Also notice that wxLog::EnableLogging() and wxLogNull class which uses it only
 affect the current thread, i.e. logging messages may still be generated by the
 other threads after a call to @c EnableLogging(false).
@@ -29,6 +29,10 @@
 #include "wx/systhemectrl.h"
 #include "wx/vector.h"
 
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
 class WXDLLIMPEXP_FWD_CORE wxImageList;
 class wxItemAttr;
 class WXDLLIMPEXP_FWD_CORE wxHeaderCtrl;
@@ -467,6 +471,101 @@ private:
 };
 #endif
 
+// ---------------------------------------------------------
+// wxDataViewAsyncVirtualListModel
+// ---------------------------------------------------------
+
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+
+class WXDLLIMPEXP_CORE wxDataViewAsyncVirtualListModel: public wxDataViewVirtualListModel
+{
+public:
+    // Function called from a worker thread to retrieve the values of all
+    // columns of the given row.
+    using RowFetcher = std::function<void (unsigned int row, wxVector<wxVariant>& values)>;
+
+    wxDataViewAsyncVirtualListModel( const RowFetcher& fetcher,
+                                     unsigned int initial_size = 0 );
+    virtual ~wxDataViewAsyncVirtualListModel();
+
+    // Number of rows before and after the requested one to fetch too.
+    void SetPrefetchMargin( unsigned int rows ) { m_prefetchMargin = rows; }
+    unsigned int GetPrefetchMargin() const { return m_prefetchMargin; }
+
+    // Maximal number of rows whose values are kept in the cache.
+    void SetMaxCachedRows( unsigned int rows );
+    unsigned int GetMaxCachedRows() const { return m_maxCachedRows; }
+
+    // Start fetching the rows in the given inclusive range if they're not
+    // cached yet.
+    void PrefetchRows( unsigned int from, unsigned int to );
+
+    // Forget all the cached values, must be called when the underlying data
+    // changes.
+    void ClearCache();
+
+    // Return true if the value of the given row is available.
+    bool IsRowCached( unsigned int row ) const;
+
+    // Return the value to show while the real one is being fetched, by default
+    // the cell remains empty.
+    virtual void GetPlaceholderByRow( wxVariant &variant,
+                                      unsigned int row, unsigned int col ) const;
+
+    // Return the cached value or the placeholder while the value is fetched.
+    virtual void GetValueByRow( wxVariant &variant,
+                                unsigned int row, unsigned int col ) const override;
+
+    // The default implementation doesn't allow changing the values.
+    virtual bool SetValueByRow( const wxVariant &variant,
+                                unsigned int row, unsigned int col ) override;
+
+private:
+    struct SharedState;
+
+    // Queue fetching the given row, if it's not cached nor queued yet,
+    // must be called with the shared state mutex locked.
+    void DoQueueRow( unsigned int row ) const;
+
+    // Launch the worker thread task if it's not running yet, must be called
+    // with the shared state mutex locked.
+    void DoStartFetching() const;
+
+    // Called in the main thread when the worker has fetched some rows.
+    void OnRowsFetched();
+
+    // Fetch the queued rows, this is executed by the worker thread.
+    static void FetchRows( const std::shared_ptr<SharedState>& state );
+
+    // Remove the rows farthest from the last requested one from the cache.
+    void TrimCache() const;
+
+
+    unsigned int m_prefetchMargin;
+    unsigned int m_maxCachedRows;
+
+    // Cached values of all columns of the rows, only used in the main thread.
+    mutable std::unordered_map<unsigned int, wxVector<wxVariant>> m_cache;
+
+    // The last row whose value was requested, used to decide which rows to
+    // remove from the cache.
+    mutable unsigned int m_lastRequestedRow;
+
+    // Receives the notifications from the worker thread.
+    wxEvtHandler m_notifier;
+
+    // State shared with the worker thread.
+    std::shared_ptr<SharedState> m_state;
+
+#if wxUSE_THREADS
+    // The pool with a single thread used for fetching the rows: we don't use
+    // the global pool as fetching the values may block for a long time.
+    std::unique_ptr<wxThreadPool> m_pool;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxDataViewAsyncVirtualListModel);
+};
+
 // ----------------------------------------------------------------------------
 // wxDataViewRenderer and related classes
 // ----------------------------------------------------------------------------
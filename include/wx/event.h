@@ -34,6 +34,8 @@
 #include "wx/meta/convertible.h"
 #include "wx/meta/removeref.h"
 
+#include <atomic>
+
 // This is now always defined, but keep it for backwards compatibility.
 #define wxHAS_CALL_AFTER
 
@@ -44,6 +46,8 @@
 class WXDLLIMPEXP_FWD_BASE wxList;
 class WXDLLIMPEXP_FWD_BASE wxEvent;
 class WXDLLIMPEXP_FWD_BASE wxEventFilter;
+class wxPendingEventsQueue;
+class wxDynamicEventTable;
 #if wxUSE_GUI
     class WXDLLIMPEXP_FWD_CORE wxDC;
     class WXDLLIMPEXP_FWD_CORE wxMenu;
@@ -3737,6 +3741,13 @@ public:
     // buffer as other wxString objects in this thread.
     virtual void QueueEvent(wxEvent *event);
 
+    // Similar to QueueEvent() but if an event with the same key had been
+    // already queued and not processed yet, replace it with this one instead
+    // of adding a new one. This is useful for events only the latest of which
+    // matters, e.g. progress notifications. This is also safe to call from
+    // any thread.
+    void QueueEventCoalesced(wxEvent *event, const wxString& key);
+
     // Add an event to be processed later: notice that this function is not
     // safe to call from threads other than main, use QueueEvent()
     virtual void AddPendingEvent(const wxEvent& event)
@@ -4065,15 +4076,16 @@ protected:
     wxEvtHandler*       m_nextHandler;
     wxEvtHandler*       m_previousHandler;
 
-    typedef wxVector<wxDynamicEventTableEntry*> DynamicEvents;
-    DynamicEvents* m_dynamicEvents;
+    // Dynamically bound handlers, indexed by event type and id.
+    wxDynamicEventTable* m_dynamicEvents;
 
-    wxList*             m_pendingEvents;
+    // Lock-free queue of the pending events, allocated on demand: this pointer
+    // is only set once and can be read from any thread without locking.
+    std::atomic<wxPendingEventsQueue*> m_pendingEvents;
 
-#if wxUSE_THREADS
-    // critical section protecting m_pendingEvents
-    wxCriticalSection m_pendingEventsLock;
-#endif // wxUSE_THREADS
+    // True if this handler is in the list of handlers with pending events
+    // maintained by wxApp or in its list of delayed handlers.
+    std::atomic<bool>   m_isInPendingHandlers;
 
     // Is event handler enabled?
     bool                m_enabled;
@@ -4107,6 +4119,9 @@ private:
     // pass the event to wxTheApp instance, called from TryAfter()
     bool DoTryApp(wxEvent& event);
 
+    // return m_pendingEvents, allocating it if necessary
+    wxPendingEventsQueue* GetOrCreatePendingEventsQueue();
+
     // try to process events in all handlers chained to this one
     bool DoTryChain(wxEvent& event);
 
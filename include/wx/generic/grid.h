@@ -92,6 +92,7 @@ enum wxGridRenderStyle
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_FWD_CORE wxGrid;
+class WXDLLIMPEXP_FWD_CORE wxGridBlockCoords;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttr;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttrProviderData;
 class WXDLLIMPEXP_FWD_CORE wxGridColLabelWindow;
@@ -114,8 +115,14 @@ class WXDLLIMPEXP_FWD_CORE wxSpinCtrl;
 class WXDLLIMPEXP_FWD_CORE wxDatePickerCtrl;
 #endif
 
+class WXDLLIMPEXP_FWD_BASE wxInputStream;
+
 using wxGridFixedIndicesSet = std::unordered_set<int>;
 
+class wxGridCellAttrCache;
+class wxGridTextLayoutCache;
+class wxGridCellBestWidthCache;
+struct wxGridAutoSizeColsState;
 class wxGridOperations;
 class wxGridRowOperations;
 class wxGridColumnOperations;
@@ -981,6 +988,8 @@ public:
     // all these functions take ownership of the pointer, don't call DecRef()
     // on it
     virtual void SetAttr(wxGridCellAttr *attr, int row, int col);
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
@@ -1375,6 +1384,8 @@ public:
 
     // these functions take ownership of the pointer
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
+    virtual void SetBlockAttr(wxGridCellAttr* attr,
+                              const wxGridBlockCoords& block);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
@@ -1504,6 +1515,110 @@ private:
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridStringTable);
 };
 
+// ----------------------------------------------------------------------------
+// wxGridColumnarTable: memory efficient table storing its data by columns
+// ----------------------------------------------------------------------------
+
+// Flags for wxGridColumnarTable::LoadCSV().
+enum wxGridCSVFlags
+{
+    // Use the first line for the column labels.
+    wxGRID_CSV_HEADER       = 0x0001,
+
+    // Use numeric types for the columns containing only numbers.
+    wxGRID_CSV_DETECT_TYPES = 0x0002,
+
+    wxGRID_CSV_DEFAULT      = wxGRID_CSV_HEADER | wxGRID_CSV_DETECT_TYPES
+};
+
+class WXDLLIMPEXP_CORE wxGridColumnarTable : public wxGridTableBase
+{
+public:
+    wxGridColumnarTable();
+    wxGridColumnarTable( int numRows, int numCols );
+    virtual ~wxGridColumnarTable();
+
+    // these are pure virtual in wxGridTableBase
+    //
+    virtual int GetNumberRows() override { return m_numRows; }
+    virtual int GetNumberCols() override { return static_cast<int>(m_cols.size()); }
+    virtual wxString GetValue( int row, int col ) override;
+    virtual void SetValue( int row, int col, const wxString& s ) override;
+
+    // overridden functions from wxGridTableBase
+    //
+    virtual bool IsEmptyCell( int row, int col ) override;
+    virtual wxString GetTypeName( int row, int col ) override;
+    virtual bool CanGetValueAs( int row, int col, const wxString& typeName ) override;
+    virtual bool CanSetValueAs( int row, int col, const wxString& typeName ) override;
+    virtual long GetValueAsLong( int row, int col ) override;
+    virtual double GetValueAsDouble( int row, int col ) override;
+    virtual void SetValueAsLong( int row, int col, long value ) override;
+    virtual void SetValueAsDouble( int row, int col, double value ) override;
+
+    void Clear() override;
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 ) override;
+    bool AppendRows( size_t numRows = 1 ) override;
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 ) override;
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 ) override;
+    bool AppendCols( size_t numCols = 1 ) override;
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 ) override;
+
+    void SetRowLabelValue( int row, const wxString& ) override;
+    void SetColLabelValue( int col, const wxString& ) override;
+    void SetCornerLabelValue( const wxString& ) override;
+    wxString GetRowLabelValue( int row ) override;
+    wxString GetColLabelValue( int col ) override;
+    wxString GetCornerLabelValue() const override;
+
+    // Change the type of the column, which must be one of wxGRID_VALUE_STRING,
+    // wxGRID_VALUE_NUMBER or wxGRID_VALUE_FLOAT, converting its values to the
+    // new type. Returns false, without changing anything, if some of them
+    // can't be converted without losing information.
+    bool SetColType( int col, const wxString& typeName );
+
+    // Returns the type of the column, as set by SetColType() or detected by
+    // LoadCSV().
+    wxString GetColType( int col ) const;
+
+    // Replace the contents of the table with the data read from the stream in
+    // CSV format using the given separator and encoding.
+    bool LoadCSV( wxInputStream& stream,
+                  char sep = ',',
+                  int flags = wxGRID_CSV_DEFAULT,
+                  const wxMBConv& conv = wxConvUTF8 );
+
+    // Returns the approximate amount of memory used by the table data.
+    size_t GetMemoryUsage() const;
+
+private:
+    class Column;
+    class CSVParser;
+
+    // Return the column with the given index, which must be valid, and
+    // check that the row is valid too.
+    Column* GetColumn( int row, int col ) const;
+
+    // Replace all the existing data with the given columns.
+    void DoReplaceData( std::vector<std::unique_ptr<Column>>& cols,
+                        int numRows );
+
+
+    int m_numRows;
+
+    // The columns also store their labels, if they were set.
+    std::vector<std::unique_ptr<Column>> m_cols;
+
+    // This only gets used if you set your own labels, otherwise the
+    // GetRowLabelValue function returns wxGridTableBase default
+    //
+    wxArrayString     m_rowLabels;
+
+    wxString m_cornerLabel;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridColumnarTable);
+};
+
 
 
 // ============================================================================
@@ -2084,15 +2199,15 @@ public:
     // attributes
     // ----------
 
-    // this sets the specified attribute for this cell or in this row/col
+    // this sets the specified attribute for this cell, block or in this row/col
     void     SetAttr(int row, int col, wxGridCellAttr *attr);
+    void     SetBlockAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr);
     void     SetRowAttr(int row, wxGridCellAttr *attr);
     void     SetColAttr(int col, wxGridCellAttr *attr);
 
-    // the grid can cache attributes for the recently used cells (currently it
-    // only caches one attribute for the most recently used one) and might
-    // notice that its value in the attribute provider has changed -- if this
-    // happens, call this function to force it
+    // the grid caches attributes for the recently used cells until it is
+    // refreshed and might not notice that their values in the attribute
+    // provider have changed -- if this happens, call this function to force it
     void RefreshAttr(int row, int col);
 
     // returns the attribute we may modify in place: a new one if this cell
@@ -2253,6 +2368,22 @@ public:
     void     AutoSizeColumns( bool setAsMin = true );
     void     AutoSizeRows( bool setAsMin = true );
 
+    // options making auto sizing the columns faster for big grids: cache the
+    // best widths of the cells and/or only measure the given number of rows
+    void     EnableAutoSizeCache( bool enable = true );
+    bool     IsAutoSizeCacheEnabled() const { return m_bestWidthCache != nullptr; }
+    void     ClearAutoSizeCache();
+
+    void     SetAutoSizeSampleSize( int numRows );
+    int      GetAutoSizeSampleSize() const { return m_autoSizeSampleSize; }
+
+    // auto size all columns in idle time, without blocking the UI, and send
+    // wxEVT_GRID_COLS_AUTO_SIZED when done
+    void     AutoSizeColumnsInIdle( bool setAsMin = true );
+    bool     IsAutoSizingColumnsInIdle() const
+        { return m_autoSizeColsState != nullptr; }
+    void     CancelAutoSizeColumnsInIdle();
+
     // auto size the grid, that is make the columns/rows of the "right" size
     // and also set the grid size to just fit its contents
     void     AutoSize();
@@ -2667,6 +2798,30 @@ protected:
     // common part of AutoSizeColumn/Row()
     void AutoSizeColOrRow(int n, bool setAsMin, wxGridDirection direction);
 
+    // return the best width or height of the cell, as used by
+    // AutoSizeColOrRow(): attr and renderer are reused if they're not null
+    wxCoord GetCellBestExtent(wxDC& dc,
+                              int row, int col,
+                              wxGridDirection direction,
+                              wxGridCellAttrPtr& attr,
+                              wxGridCellRendererPtr& renderer);
+
+    // set the size of the column or row to fit its contents of the given
+    // extent and its label
+    void SetAutoSizeExtent(wxDC& dc,
+                           int colOrRow,
+                           wxCoord extentMax,
+                           bool setAsMin,
+                           wxGridDirection direction);
+
+    // return the number of rows measured when auto-sizing the columns and the
+    // index of the n-th of them, taking m_autoSizeSampleSize into account
+    int GetAutoSizeRowsCount() const;
+    int GetAutoSizeRow(int n) const;
+
+    // measure more cells when auto-sizing the columns in idle time
+    void OnIdle(wxIdleEvent& event);
+
     // Calculate the minimum acceptable size for labels area
     wxCoord CalcColOrRowLabelAreaMinSize(wxGridDirection direction);
 
@@ -2682,13 +2837,23 @@ protected:
     // do we have some place to store attributes in?
     bool CanHaveAttributes() const;
 
-    // cell attribute cache (currently we only cache 1, may be will do
-    // more/better later)
-    struct CachedAttr
-    {
-        int             row, col;
-        wxGridCellAttr *attr;
-    } m_attrCache;
+    // cache of the attributes of the recently used cells
+    wxGridCellAttrCache *m_attrCache;
+
+    // cache of the layouts of the recently drawn cells texts
+    wxGridTextLayoutCache *m_textLayoutCache;
+
+    // check if the text layout cache can be used when drawing on this DC
+    bool CanUseTextLayoutCache(const wxReadOnlyDC& dc) const;
+
+    // cache of the best widths of the cells, only used if enabled
+    wxGridCellBestWidthCache *m_bestWidthCache;
+
+    // number of rows measured when auto-sizing the columns, 0 for all
+    int m_autoSizeSampleSize;
+
+    // non-null only while auto-sizing the columns in idle time
+    wxGridAutoSizeColsState *m_autoSizeColsState;
 
     // invalidates the attribute cache
     void ClearAttrCache();
@@ -3487,6 +3652,7 @@ wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_ROW_SIZE, wxGridSizeEvent
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_ROW_AUTO_SIZE, wxGridSizeEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_COL_SIZE, wxGridSizeEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_COL_AUTO_SIZE, wxGridSizeEvent );
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_COLS_AUTO_SIZED, wxGridEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_ROW_LABEL_SIZE, wxGridSizeEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_COL_LABEL_SIZE, wxGridSizeEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_CORE, wxEVT_GRID_RANGE_SELECTING, wxGridRangeSelectEvent );
@@ -3543,6 +3709,7 @@ typedef void (wxEvtHandler::*wxGridEditorCreatedEventFunction)(wxGridEditorCreat
 #define EVT_GRID_CMD_ROW_SIZE(id, fn)            wx__DECLARE_GRIDSIZEEVT(ROW_SIZE, id, fn)
 #define EVT_GRID_CMD_COL_SIZE(id, fn)            wx__DECLARE_GRIDSIZEEVT(COL_SIZE, id, fn)
 #define EVT_GRID_CMD_COL_AUTO_SIZE(id, fn)       wx__DECLARE_GRIDSIZEEVT(COL_AUTO_SIZE, id, fn)
+#define EVT_GRID_CMD_COLS_AUTO_SIZED(id, fn)     wx__DECLARE_GRIDEVT(COLS_AUTO_SIZED, id, fn)
 #define EVT_GRID_CMD_ROW_LABEL_SIZE(id, fn)      wx__DECLARE_GRIDSIZEEVT(ROW_LABEL_SIZE, id, fn)
 #define EVT_GRID_CMD_COL_LABEL_SIZE(id, fn)      wx__DECLARE_GRIDSIZEEVT(COL_LABEL_SIZE, id, fn)
 #define EVT_GRID_CMD_ROW_MOVE(id, fn)            wx__DECLARE_GRIDEVT(ROW_MOVE, id, fn)
@@ -3572,6 +3739,7 @@ typedef void (wxEvtHandler::*wxGridEditorCreatedEventFunction)(wxGridEditorCreat
 #define EVT_GRID_ROW_SIZE(fn)            EVT_GRID_CMD_ROW_SIZE(wxID_ANY, fn)
 #define EVT_GRID_COL_SIZE(fn)            EVT_GRID_CMD_COL_SIZE(wxID_ANY, fn)
 #define EVT_GRID_COL_AUTO_SIZE(fn)       EVT_GRID_CMD_COL_AUTO_SIZE(wxID_ANY, fn)
+#define EVT_GRID_COLS_AUTO_SIZED(fn)     EVT_GRID_CMD_COLS_AUTO_SIZED(wxID_ANY, fn)
 #define EVT_GRID_ROW_LABEL_SIZE(fn)      EVT_GRID_CMD_ROW_LABEL_SIZE(wxID_ANY, fn)
 #define EVT_GRID_COL_LABEL_SIZE(fn)      EVT_GRID_CMD_COL_LABEL_SIZE(wxID_ANY, fn)
 #define EVT_GRID_ROW_MOVE(fn)            EVT_GRID_CMD_ROW_MOVE(wxID_ANY, fn)
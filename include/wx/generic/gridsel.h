@@ -21,7 +21,7 @@
 #include <memory>
 
 // Forward declaration
-namespace wxGridPrivate { class SelectionShape; }
+namespace wxGridPrivate { class SelectionShape; class SelectionIndex; }
 
 using wxSelectionShape = wxGridPrivate::SelectionShape;
 
@@ -35,6 +35,7 @@ class WXDLLIMPEXP_CORE wxGridSelection
 public:
     wxGridSelection(wxGrid *grid,
                     wxGrid::wxGridSelectionModes sel = wxGrid::wxGridSelectCells);
+    ~wxGridSelection();
 
     bool IsSelection();
     bool IsInSelection(int row, int col) const;
@@ -154,9 +155,15 @@ private:
     // Called each time the selection changed or scrolled to recompute m_selectionShape.
     void ComputeSelectionShape(const wxRect& renderExtent = {});
 
+    // Must be called whenever m_selection changes.
+    void InvalidateIndex() { m_indexValid = false; }
+
     // All currently selected blocks. We expect there to be a relatively small
     // amount of them, even for very large grids, as each block must be
-    // selected by the user, so we store them unsorted.
+    // selected by the user, so we store them unsorted. But as there can still
+    // be thousands of them, e.g. if the user selected many rows one by one,
+    // m_index is used to check if a cell is selected when there are many of
+    // them.
     //
     // Selection may be empty, but if it isn't, the last block is special, as
     // it is the current block, which is affected by operations such as
@@ -166,6 +173,15 @@ private:
     wxGrid                              *m_grid;
     wxGrid::wxGridSelectionModes        m_selectionMode;
 
+    // Index of m_selection blocks, created on demand and rebuilt when it's
+    // used after m_selection changes, i.e. when m_indexValid is false.
+    mutable std::unique_ptr<wxGridPrivate::SelectionIndex> m_index;
+    mutable bool m_indexValid = false;
+
+    // True if no blocks in m_selection, except possibly the last one, can be
+    // merged together.
+    bool m_blocksMerged = true;
+
     // Used by wxGrid::DrawOverlaySelection() to draw a:
     //
     // - Simple rectangle (using wxDC::DrawRectangle() if it is empty and the bounding box is valid.
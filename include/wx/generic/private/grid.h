@@ -28,6 +28,8 @@
 #include <iterator>
 #include <set>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // array classes
@@ -477,20 +479,283 @@ public:
     void UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols );
 
 private:
+    // Return the index of the given row or column in m_rowsOrCols or the
+    // index at which it should be inserted if it's not there.
+    int FindIndex(int rowOrCol) const;
+
+    // These arrays are sorted by row or column.
     wxArrayInt m_rowsOrCols;
     wxArrayAttrs m_attrs;
 };
 
-// NB: this is just a wrapper around 3 objects: one which stores cell
-//     attributes, and 2 others for row/col ones
+// this class stores attributes set for rectangular blocks of cells
+class WXDLLIMPEXP_ADV wxGridBlockAttrData
+{
+public:
+    wxGridBlockAttrData() = default;
+    ~wxGridBlockAttrData();
+
+    // Set the attribute for all cells of the block, overriding the attributes
+    // previously set for any of them, or remove the attributes of all these
+    // cells if attr is null.
+    void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
+    wxGridCellAttr *GetAttr(int row, int col) const;
+    void UpdateAttrRows( size_t pos, int numRows );
+    void UpdateAttrCols( size_t pos, int numCols );
+
+private:
+    struct Block
+    {
+        wxGridBlockCoords coords;
+
+        // This is null for the blocks removing the attributes.
+        wxGridCellAttr *attr;
+    };
+
+    // Rebuild the index below if necessary.
+    void UpdateIndex() const;
+
+    // Update the blocks after inserting or deleting rows or columns.
+    void DoUpdateAttrRowsOrCols( size_t pos, int numRowsOrCols, bool rows );
+
+    // All the blocks in the order in which they were set, i.e. the later
+    // blocks override the earlier ones where they overlap. The blocks which
+    // are completely overridden by the later ones are removed from here when
+    // the index is rebuilt.
+    mutable std::vector<Block> m_blocks;
+
+    // The number of blocks remaining after the last index rebuild.
+    mutable size_t m_compactedSize = 0;
+
+    // The index allowing to find the attribute of the given cell in
+    // logarithmic time: the rows are divided into bands, such that each
+    // block either covers all rows of a band or none of them, and the
+    // columns of each band are divided into non-overlapping segments, each
+    // of which has the attribute of the topmost block covering it.
+    struct Segment
+    {
+        int leftCol,
+            rightCol;
+        wxGridCellAttr *attr;
+    };
+
+    struct Band
+    {
+        // The band extends until the top row of the next one.
+        int topRow;
+
+        // Index of the first segment of this band in m_segments, the
+        // segments of each band are sorted by their columns.
+        size_t firstSegment;
+    };
+
+    mutable std::vector<Band> m_bands;
+    mutable std::vector<Segment> m_segments;
+    mutable bool m_indexValid = true;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridBlockAttrData);
+};
+
+// NB: this is just a wrapper around 4 objects: two which store cell
+//     attributes, for individual cells and for blocks of them, and 2 others
+//     for row/col ones
 class WXDLLIMPEXP_ADV wxGridCellAttrProviderData
 {
 public:
     wxGridCellAttrData m_cellAttrs;
+    wxGridBlockAttrData m_blockAttrs;
     wxGridRowOrColAttrData m_rowAttrs,
                            m_colAttrs;
 };
 
+// ----------------------------------------------------------------------------
+// caches used by wxGrid for drawing the cells
+// ----------------------------------------------------------------------------
+
+// This class caches the attributes returned by the table for the recently
+// used cells, to avoid merging the cell, row and column attributes again
+// every time the same cell is drawn. It is cleared whenever the grid is
+// refreshed, as the attributes may have changed then.
+class wxGridCellAttrCache
+{
+public:
+    wxGridCellAttrCache() = default;
+    ~wxGridCellAttrCache() { Clear(); }
+
+    // Return true and fill the output parameter with the attribute, which can
+    // be null, and has its reference count incremented if it's not, if the
+    // cell is in the cache.
+    bool Lookup(int row, int col, wxGridCellAttr** attr) const;
+
+    // Add the attribute, which can be null, for the given cell to the cache.
+    void Add(int row, int col, wxGridCellAttr* attr);
+
+    void Remove(int row, int col);
+
+    // Remove all cells in the given block, whose corners must be valid.
+    void RemoveBlock(int topRow, int leftCol, int bottomRow, int rightCol);
+
+    void Clear();
+
+private:
+    // The cache is big enough for all the cells visible on screen even when
+    // they are small, as there is no point in keeping more than this.
+    static const size_t MAX_CELLS = 16384;
+
+    wxGridCoordsToAttrMap m_attrs;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridCellAttrCache);
+};
+
+// Text split into lines and measured for drawing it in a grid cell.
+struct wxGridTextLayout
+{
+    wxArrayString lines;
+
+    // Size of each line: notice that empty lines still have the height of
+    // a character.
+    std::vector<wxSize> lineSizes;
+
+    // Size of the bounding box of all lines.
+    wxSize size;
+};
+
+// This class caches the layouts of the texts drawn by wxGrid, which allows
+// to avoid measuring the same text again when the cells are redrawn, e.g.
+// when the grid is scrolled.
+//
+// The layouts depend only on the text, the font and the width available for
+// it (for ellipsizing), so they don't need to be invalidated when the cell
+// contents or attributes change, but old entries are discarded when the
+// cache becomes too big.
+class wxGridTextLayoutCache
+{
+public:
+    wxGridTextLayoutCache() = default;
+
+    // Return the layout of the given text drawn using the current font of
+    // the DC and ellipsized to fit into the given width, or null if it's not
+    // in the cache.
+    const wxGridTextLayout* Find(const wxReadOnlyDC& dc,
+                                 const wxString& text,
+                                 int width,
+                                 wxEllipsizeMode mode);
+
+    // Add a new (empty) layout to the cache and return it for filling in.
+    wxGridTextLayout& Add(const wxReadOnlyDC& dc,
+                          const wxString& text,
+                          int width,
+                          wxEllipsizeMode mode);
+
+    void Clear();
+
+private:
+    struct Key
+    {
+        Key(const wxString& text_, int width_, wxEllipsizeMode mode_)
+            : text(text_),
+              width(mode_ == wxELLIPSIZE_NONE ? 0 : width_),
+              mode(mode_)
+        {
+        }
+
+        bool operator==(const Key& other) const
+        {
+            return width == other.width &&
+                    mode == other.mode &&
+                        text == other.text;
+        }
+
+        wxString text;
+
+        // This is always 0 if the text is not ellipsized, as then its layout
+        // doesn't depend on the width.
+        int width;
+
+        wxEllipsizeMode mode;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return wxStringHash()(key.text) ^
+                    (static_cast<size_t>(key.width) << 2) ^
+                        static_cast<size_t>(key.mode);
+        }
+    };
+
+    struct Entry
+    {
+        wxFont font;
+        wxGridTextLayout layout;
+    };
+
+    using Map = std::unordered_map<Key, Entry, KeyHash>;
+
+    // The maximal number of entries in each of the maps below.
+    static const size_t MAX_ENTRIES = 8192;
+
+    // The layouts are stored in two generations: when the current map
+    // becomes full, it replaces the previous one, and the entries from the
+    // previous map are moved back to the current one when they are used
+    // again. This is a cheap approximation of LRU eviction which ensures that
+    // the layouts of the visible cells remain in the cache.
+    Map m_current,
+        m_previous;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridTextLayoutCache);
+};
+
+// This class remembers the best widths of the cells computed when auto-sizing
+// the columns, to avoid measuring them again when the columns are auto-sized
+// the next time if their contents didn't change.
+class wxGridCellBestWidthCache
+{
+public:
+    wxGridCellBestWidthCache() = default;
+
+    // Return the cached width of the cell or -1 if it's not known.
+    int Get(int row, int col) const;
+
+    void Set(int row, int col, int width);
+
+    // Forget the width of the given cell or of all cells in the given row.
+    void Invalidate(int row, int col);
+    void InvalidateRow(int row);
+
+    void Clear() { m_widths.clear(); }
+
+private:
+    // The widths of the cells of each column indexed by their row, with -1
+    // used for the cells whose width is unknown.
+    std::unordered_map<int, std::vector<int>> m_widths;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridCellBestWidthCache);
+};
+
+// State of auto-sizing the columns in idle time.
+struct wxGridAutoSizeColsState
+{
+    explicit wxGridAutoSizeColsState(bool setAsMin_) : setAsMin(setAsMin_) { }
+
+    // Start from scratch, e.g. because rows or columns were added or removed.
+    void Restart()
+    {
+        nextRow = 0;
+        extents.clear();
+    }
+
+    const bool setAsMin;
+
+    // Index of the next row to measure among all the rows being measured,
+    // which may be only a sample of all the rows.
+    int nextRow = 0;
+
+    // Maximal extent of the cells measured so far for each column.
+    std::vector<int> extents;
+};
+
 // ----------------------------------------------------------------------------
 // operations classes abstracting the difference between operating on rows and
 // columns
@@ -1466,9 +1731,56 @@ private:
     wxDECLARE_NO_COPY_CLASS(SelectionShape);
 };
 
-// Used by wxGridSelection::Select() and wxGridSelection::DeselectBlock() to ensure
-// that we always have fewer blocks selected in m_selection.
-void MergeAdjacentBlocks(wxGridBlockCoordsVector& selection);
+// Used by wxGridSelection::DeselectBlock() to ensure that we always have fewer
+// blocks selected in m_selection.
+WXDLLIMPEXP_CORE void MergeAdjacentBlocks(wxGridBlockCoordsVector& selection);
+
+// Used by wxGridSelection::Select() to merge the last block of the selection,
+// which must be the only one which can be merged with the others, with its
+// neighbours. This is equivalent to, but much faster than, calling
+// MergeAdjacentBlocks() when there are many selected blocks.
+//
+// Both functions are only exported for the unit tests.
+WXDLLIMPEXP_CORE void MergeLastBlock(wxGridBlockCoordsVector& selection);
+
+// Index of the selected blocks allowing to check if a cell is selected in
+// logarithmic time: the grid is divided into horizontal bands in which the
+// same columns are selected in all rows and the selected columns of each band
+// are stored as sorted non-overlapping ranges.
+class SelectionIndex
+{
+public:
+    SelectionIndex() = default;
+
+    // Build the index for the given blocks, which may overlap. Returns false
+    // if the index would be too big to be worth using, as may happen if the
+    // blocks are arranged in some pathological way.
+    bool Build(const wxGridBlockCoordsVector& blocks);
+
+    // Can only be called after a successful Build().
+    bool Contains(int row, int col) const;
+
+private:
+    struct Range
+    {
+        int first,
+            last;
+    };
+
+    // The first row of each band and the index of its first range in
+    // m_ranges. The last band is always empty and only indicates where the
+    // previous one ends.
+    struct Band
+    {
+        int topRow;
+        size_t firstRange;
+    };
+
+    std::vector<Band> m_bands;
+    std::vector<Range> m_ranges;
+
+    wxDECLARE_NO_COPY_CLASS(SelectionIndex);
+};
 
 // This function attempts to reduce the number of rectangles returned from
 // wxGrid::GetSelectedRectangles() before trying to convert them to SelectionShape.
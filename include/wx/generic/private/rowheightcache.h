@@ -10,7 +10,6 @@
 #ifndef _WX_PRIVATE_ROWHEIGHTCACHE_H_
 #define _WX_PRIVATE_ROWHEIGHTCACHE_H_
 
-#include <unordered_map>
 #include <vector>
 
 // struct describing a range of rows which contains rows <from> .. <to-1>
@@ -84,46 +83,44 @@ private:
     * the y-coordinate where a row starts (GetLineStart)
     * and vice versa (GetLineAt)
 
-    The layout of the cache is a hashmap where the keys are all existing row
-    heights in pixels. The values are RowRange objects that represent all rows
-    having the specified height.
+    The heights of the rows are stored in a vector indexed by row, with 0
+    meaning that the height of the row is unknown, and their sums are kept in
+    a Fenwick (binary indexed) tree, so that all the operations above as well
+    as updating the height of a single row take logarithmic time.
+
+    Note that the positions of the rows following a row with unknown height
+    are unknown too, so GetLineStart() and GetLineAt() only use the rows
+    before the first unknown one.
 
     An example:
     @code
-    {
-    22: RowRange([0..10], [15..17], [20..2000]),
-    42: RowRange([11..12], [18..18]),
-    62: RowRange([13..14], [19..19])
-    }
+    heights: [22, 22, 42, 22, 62]
+    tree:    [22, 44, 42, 108, 62]
     @endcode
 
+    Here the element i (counting from 1) of the tree contains the sum of the
+    heights of the rows in (i - lowbit(i), i], where lowbit(i) is the value of
+    the lowest bit set in i, e.g. tree[4] is the sum of the first 4 heights.
+
     Examples
     ========
 
     GetLineStart
     ------------
-    To retrieve the y-coordinate of item 1000 it is necessary to look into
-    each key of the hashmap *m_heightToRowRange*. Get the row count of
-    indices lower than 1000 (RowRange::CountTo) and multiplies it which the
-    according height.
-
-    RowRange([0..10], [15..17], [20..2000]).CountTo(1000)
-    --> 0..10 are 11 items, 15..17 are 3 items and 20..1000 are 980 items (1000-20)
-    = 11 + 3 + 980 = 994 items
-
-    GetLineStart(1000) --> (22 * 994) + (42 * 3) + (62 * 3) = 22180
+    To retrieve the y-coordinate of item 4 add the tree elements for the
+    indices obtained by clearing the lowest bit of 4 until it becomes 0, i.e.
+    just tree[4] = 108 in this case, and for item 3 it would be tree[3] +
+    tree[2] = 42 + 44 = 86.
 
     GetLineHeight
     -------------
-    To retrieve the line height look into each key and check if row is
-    contained in RowRange (RowRange::Has)
+    The line height is just the element of the heights vector.
 
     GetLineAt
     ---------
-    To retrieve the row that starts at a specific y-coordinate.
-    Look into each key and count all rows.
-    Use bisect algorithm in combination with GetLineStart() to
-    find the appropriate item
+    To retrieve the row that starts at a specific y-coordinate, descend the
+    tree from its highest power of 2 index subtracting the sums of the rows
+    before the given coordinate.
 */
 class WXDLLIMPEXP_CORE HeightCache
 {
@@ -134,6 +131,9 @@ public:
     bool GetLineAt(int y, unsigned int& row);
     bool GetLineInfo(unsigned int row, int &start, int &height);
 
+    /**
+        Stores the height of the given row, which must be strictly positive.
+    */
     void Put(unsigned int row, int height);
 
     /**
@@ -142,12 +142,47 @@ public:
     */
     void Remove(unsigned int row);
 
+    /**
+        Inserts the given number of rows with unknown heights before the given
+        row, shifting the heights of all the subsequent rows.
+    */
+    void InsertRows(unsigned int row, unsigned int count);
+
+    /**
+        Deletes the given number of rows starting with the given one, shifting
+        the heights of all the subsequent rows.
+    */
+    void DeleteRows(unsigned int row, unsigned int count);
+
     void Clear();
 
 private:
-    using HeightToRowRangesMap = std::unordered_map<int, RowRanges>;
+    // Return the sum of the heights of all rows before the given one.
+    int GetSumBefore(unsigned int row) const;
+
+    // Update the tree after changing the height of the given row by delta.
+    void AddToTree(unsigned int row, int delta);
+
+    // Recompute the tree elements corresponding to the rows starting from
+    // the given one, the ones before must be already up to date.
+    void RebuildTreeFrom(unsigned int row);
+
+    // Set m_firstUnknown to the first row with unknown height starting from
+    // the given one, all the rows before it must be known.
+    void FindFirstUnknownFrom(unsigned int row);
+
+
+    // Heights of all rows, 0 for the unknown ones.
+    std::vector<int> m_heights;
+
+    // Fenwick tree of the heights: notice that it uses 1-based indices, so
+    // its size is one more than the number of rows and its first element is
+    // unused.
+    std::vector<int> m_tree;
 
-    HeightToRowRangesMap m_heightToRowRange;
+    // Index of the first row with unknown height, which may be equal to the
+    // size of m_heights if all rows in it are known.
+    unsigned int m_firstUnknown = 0;
 };
 
 
@@ -24,6 +24,8 @@
 #  include "wx/stream.h"
 #endif
 
+#include <functional>
+
 // on some systems (Unixware 7.x) index is defined as a macro in the headers
 // which breaks the compilation below
 #undef index
@@ -40,6 +42,9 @@
 #define wxIMAGE_OPTION_MAX_WIDTH             wxString(wxS("MaxWidth"))
 #define wxIMAGE_OPTION_MAX_HEIGHT            wxString(wxS("MaxHeight"))
 
+#define wxIMAGE_OPTION_DESIRED_WIDTH         wxString(wxS("DesiredWidth"))
+#define wxIMAGE_OPTION_DESIRED_HEIGHT        wxString(wxS("DesiredHeight"))
+
 #define wxIMAGE_OPTION_ORIGINAL_WIDTH        wxString(wxS("OriginalWidth"))
 #define wxIMAGE_OPTION_ORIGINAL_HEIGHT       wxString(wxS("OriginalHeight"))
 
@@ -99,6 +104,7 @@ const unsigned char wxIMAGE_ALPHA_OPAQUE = 0xff;
 //-----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_FWD_CORE wxImageHandler;
+class WXDLLIMPEXP_FWD_CORE wxImageDecoder;
 class WXDLLIMPEXP_FWD_CORE wxImage;
 class WXDLLIMPEXP_FWD_CORE wxPalette;
 
@@ -128,6 +134,11 @@ public:
 
     bool CanRead( wxInputStream& stream ) { return CallDoCanRead(stream); }
     bool CanRead( const wxString& name );
+
+    // create the object for decoding the image incrementally, as its data
+    // become available, or return nullptr if not supported by this handler
+    virtual wxImageDecoder* CreateDecoder(bool WXUNUSED(verbose) = true)
+        { return nullptr; }
 #endif // wxUSE_STREAMS
 
     void SetName(const wxString& name) { m_name = name; }
@@ -364,11 +375,21 @@ public:
 
     // blur the image according to the specified pixel radius
     wxImage Blur(int radius) const;
+    wxImage Blur(int radius, wxMemoryBuffer& scratch) const;
     wxImage BlurHorizontal(int radius) const;
     wxImage BlurVertical(int radius) const;
 
+    // approximate Gaussian blur with the given standard deviation
+    wxImage BlurGaussian(double sigma) const;
+    wxImage BlurGaussian(double sigma, wxMemoryBuffer& scratch) const;
+
     wxImage ShrinkBy( int xFactor , int yFactor ) const ;
 
+    // set the maximal number of threads used by the functions above and
+    // Rotate(), 1 by default meaning that no additional threads are used
+    static void SetMaxProcessingThreads(int numThreads);
+    static int GetMaxProcessingThreads();
+
     // rescales the image in place
     wxImage& Rescale( int width, int height,
                       wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL )
@@ -649,6 +670,144 @@ private:
     wxDECLARE_DYNAMIC_CLASS(wxImage);
 };
 
+#if wxUSE_STREAMS
+
+//-----------------------------------------------------------------------------
+// wxImageDecoder: incremental image decoder created by wxImageHandler
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageDecoder
+{
+public:
+    // the callback called with the range of rows updated by the decoder
+    using RowsCallback = std::function<void (int firstRow, int numRows)>;
+
+    virtual ~wxImageDecoder() = default;
+
+    // set the callback to call whenever some image rows are decoded
+    void SetRowsCallback(const RowsCallback& callback) { m_callback = callback; }
+
+    // decode the next chunk of the image data, return false on error
+    bool Feed(const void* data, size_t size);
+
+    // decode all the data currently available in the stream without waiting
+    // for more of them to arrive
+    bool Feed(wxInputStream& stream);
+
+    // the image is valid as soon as its header has been decoded, but its
+    // contents are only complete once IsDone() returns true
+    const wxImage& GetImage() const { return m_image; }
+
+    bool IsDone() const { return m_state == State_Done; }
+    bool HasFailed() const { return m_state == State_Failed; }
+
+protected:
+    explicit wxImageDecoder(bool verbose) : m_verbose(verbose) { }
+
+    // must be overridden to decode the given data, only called until the
+    // decoding is done or fails
+    virtual bool DoFeed(const unsigned char* data, size_t size) = 0;
+
+    // must be called by DoFeed() when the rows are decoded
+    void NotifyRowsDecoded(int firstRow, int numRows);
+
+    // must be called by DoFeed() when the entire image is decoded
+    void SetDone() { m_state = State_Done; }
+
+    bool IsVerbose() const { return m_verbose; }
+
+
+    // the image being decoded
+    wxImage m_image;
+
+private:
+    enum State
+    {
+        State_Decoding,
+        State_Done,
+        State_Failed
+    };
+
+    RowsCallback m_callback;
+    State m_state = State_Decoding;
+    const bool m_verbose;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageDecoder);
+};
+
+#endif // wxUSE_STREAMS
+
+//-----------------------------------------------------------------------------
+// wxImageView: rectangular part of an image sharing its pixel data
+//-----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageView
+{
+public:
+    // default ctor creates an invalid view
+    wxImageView() = default;
+
+    // create a view of the entire image or the given part of it, the pixel
+    // data are shared with the image and not copied
+    explicit wxImageView(const wxImage& image);
+    wxImageView(const wxImage& image, const wxRect& rect);
+
+    bool IsOk() const { return m_image.IsOk(); }
+
+    int GetWidth() const { return m_rect.width; }
+    int GetHeight() const { return m_rect.height; }
+    wxSize GetSize() const { return m_rect.GetSize(); }
+
+    // return the image whose data this view uses and the position of the
+    // view in it
+    const wxImage& GetImage() const { return m_image; }
+    const wxRect& GetRect() const { return m_rect; }
+
+    // return a view of a part of this view, the rectangle is specified in
+    // this view coordinates
+    wxImageView GetSubView(const wxRect& rect) const;
+
+    bool HasAlpha() const { return m_image.HasAlpha(); }
+
+    // accessors for the individual pixels, in this view coordinates
+    unsigned char GetRed(int x, int y) const;
+    unsigned char GetGreen(int x, int y) const;
+    unsigned char GetBlue(int x, int y) const;
+    unsigned char GetAlpha(int x, int y) const;
+
+    // direct access to the RGB data of the given row: GetWidth()*3 bytes are
+    // available at the returned pointer, while the data of the next row start
+    // at GetRowStride() bytes after it
+    const unsigned char* GetRowData(int y) const;
+    int GetRowStride() const { return 3*m_image.GetWidth(); }
+
+    // similar to GetRowData() but for the alpha channel (if any), the alpha
+    // stride is always GetRowStride()/3
+    const unsigned char* GetRowAlpha(int y) const;
+
+    // modifying the view makes a copy of the viewed part of the image first
+    // if the data are shared with any other image or view
+    void SetRGB(int x, int y,
+                unsigned char r, unsigned char g, unsigned char b);
+    void SetAlpha(int x, int y, unsigned char alpha);
+    unsigned char* GetWritableRowData(int y);
+    unsigned char* GetWritableRowAlpha(int y);
+
+    // return the image with the contents of this view, this only copies the
+    // pixels of the view and not of the entire image
+    wxImage ToImage() const;
+
+private:
+    // make a copy of the viewed part of the image if it's shared
+    void AllocExclusive();
+
+    // return the offset of the given pixel in the image data
+    long GetPixelOffset(int x, int y) const;
+
+    wxImage m_image;
+    wxRect m_rect;
+};
+
 
 extern void WXDLLIMPEXP_CORE wxInitAllImageHandlers();
 
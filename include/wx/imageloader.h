@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/imageloader.h
+// Purpose:     wxImageLoader: asynchronous image loading with a cache
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_IMAGELOADER_H_
+#define _WX_IMAGELOADER_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_IMAGE
+
+#include "wx/event.h"
+#include "wx/image.h"
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+// Event sent when loading an image requested from wxImageLoader completes.
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_CORE, wxEVT_IMAGE_LOADED, wxThreadEvent);
+
+// ----------------------------------------------------------------------------
+// wxImageLoader: loads images in background threads and caches them
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxImageLoader : public wxEvtHandler
+{
+public:
+    // Default maximal size of the cache: 64MiB.
+    static constexpr size_t DEFAULT_CACHE_SIZE = 64*1024*1024;
+
+    // Create the loader sending wxEVT_IMAGE_LOADED events to the given
+    // handler, which must remain alive for as long as this object exists.
+    explicit wxImageLoader(wxEvtHandler* handler,
+                           size_t maxCacheSize = DEFAULT_CACHE_SIZE);
+    virtual ~wxImageLoader();
+
+    // Start loading the image from the given file, scaling it down to fit
+    // into the given size if it's specified. The handler gets an event even if
+    // the image is already in the cache, but only a single one if the same
+    // image is requested again while it is still being loaded.
+    void Load(const wxString& path,
+              const wxSize& size = wxDefaultSize,
+              wxBitmapType type = wxBITMAP_TYPE_ANY);
+
+    // Return the image from the cache if it's there or an invalid image.
+    wxImage GetCached(const wxString& path,
+                      const wxSize& size = wxDefaultSize);
+
+    // Return true if the image is being loaded.
+    bool IsLoading(const wxString& path,
+                   const wxSize& size = wxDefaultSize) const;
+
+    // Cache size management, all sizes are in bytes.
+    void SetMaxCacheSize(size_t maxCacheSize);
+    size_t GetMaxCacheSize() const { return m_maxCacheSize; }
+    size_t GetCacheSize() const { return m_cacheSize; }
+    void ClearCache();
+
+private:
+    struct CacheEntry
+    {
+        wxString key;
+        wxImage image;
+        size_t size;
+    };
+
+    using CacheList = std::list<CacheEntry>;
+
+    struct SharedState;
+
+    // Return the key used for the cache for the image of the given size at
+    // the given path: it includes the file modification time to ensure we
+    // don't return the stale cached image if the file was modified.
+    static wxString MakeKey(const wxString& path, const wxSize& size);
+
+    // Add the image to the cache, possibly removing the old entries from it.
+    void AddToCache(const wxString& key, const wxImage& image);
+
+    // Remove the least recently used entries until the cache size is at most
+    // the given one.
+    void TrimCache(size_t maxCacheSize);
+
+    // Send the event with the given image to the handler.
+    void SendLoadedEvent(const wxString& path, const wxImage& image);
+
+    // Called when loading an image in a worker thread finishes.
+    void OnLoaded(wxThreadEvent& event);
+
+
+    wxEvtHandler* const m_handler;
+
+    size_t m_maxCacheSize;
+    size_t m_cacheSize = 0;
+
+    // Cache entries, with the most recently used ones first, and the map
+    // allowing to find them quickly.
+    CacheList m_cacheList;
+    std::unordered_map<wxString, CacheList::iterator> m_cacheMap;
+
+    // Keys of the images being loaded and their paths.
+    std::unordered_map<wxString, wxString> m_loading;
+
+    // State shared with the worker threads, which can outlive this object.
+    std::shared_ptr<SharedState> m_state;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageLoader);
+};
+
+#endif // wxUSE_IMAGE
+
+#endif // _WX_IMAGELOADER_H_
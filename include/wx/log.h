@@ -607,6 +607,12 @@ protected:
     // nothing otherwise; return the old value of repetition counter
     unsigned LogLastRepeatIfNeeded();
 
+    // override this to return true if DoLogRecord() can be called from any
+    // thread: by default, the messages logged by the threads other than main
+    // are buffered until they are flushed from the main thread, but they are
+    // passed to the thread-safe targets immediately
+    virtual bool IsThreadSafe() const { return false; }
+
 private:
 #if wxUSE_THREADS
     // called from FlushActive() to really log any buffered messages logged
@@ -633,6 +639,13 @@ private:
                       const wxString& msg,
                       const wxLogRecordInfo& info);
 
+    // called by CallDoLogNow() after handling the repeated messages and by
+    // OnLog() directly for the thread-safe targets, adds the extra
+    // information from wxLogRecordInfo to the message and logs it
+    void CallDoLogRecord(wxLogLevel level,
+                         const wxString& msg,
+                         const wxLogRecordInfo& info);
+
 
     // variables
     // ----------------
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/logasync.h
+// Purpose:     wxLogAsync: log target writing messages from another thread
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_LOGASYNC_H_
+#define _WX_LOGASYNC_H_
+
+#include "wx/log.h"
+
+#if wxUSE_LOG && wxUSE_THREADS && wxUSE_STREAMS
+
+#include "wx/thread.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+class WXDLLIMPEXP_FWD_BASE wxOutputStream;
+
+// ----------------------------------------------------------------------------
+// wxLogAsync: log target queuing the messages and writing them in background
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxLogAsync : public wxLog
+{
+public:
+    // What to do when a thread logs a message while its queue is full.
+    enum OverflowPolicy
+    {
+        Overflow_Drop,      // Discard the message.
+        Overflow_Block      // Wait until there is space in the queue.
+    };
+
+    // Default number of messages which can be queued by each thread.
+    static constexpr size_t DEFAULT_QUEUE_SIZE = 1024;
+
+    // Append the messages to the given file, creating it if necessary.
+    explicit wxLogAsync(const wxString& filename,
+                        size_t queueSize = DEFAULT_QUEUE_SIZE);
+
+    // Write the messages to the given stream, taking ownership of it.
+    explicit wxLogAsync(wxOutputStream* stream,
+                        size_t queueSize = DEFAULT_QUEUE_SIZE);
+
+    // Writes all the queued messages before returning.
+    virtual ~wxLogAsync();
+
+    // Return false if the output couldn't be opened.
+    bool IsOk() const;
+
+    // Overflow policy can be changed at any time.
+    void SetOverflowPolicy(OverflowPolicy policy) { m_policy = policy; }
+    OverflowPolicy GetOverflowPolicy() const { return m_policy; }
+
+    // Return the number of messages dropped so far due to Overflow_Drop.
+    size_t GetDroppedCount() const { return m_numDropped; }
+
+    // Block until all messages logged before calling it are written.
+    void WaitUntilWritten();
+
+    // Only wakes up the writer thread, without waiting for it.
+    virtual void Flush() override;
+
+protected:
+    virtual void DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info) override;
+
+    // Called from the writer thread only.
+    virtual void DoLogTextAtLevel(wxLogLevel level,
+                                  const wxString& msg) override;
+
+    virtual bool IsThreadSafe() const override { return true; }
+
+private:
+    class Queue;
+    class WriterThread;
+
+    void Init(size_t queueSize);
+
+    // Return the queue used by the current thread, creating it if necessary.
+    Queue& GetQueueForThisThread();
+
+    // Wake up the writer thread if it's waiting.
+    void WakeUpWriter();
+
+    // Called from WriterThread::Entry().
+    void WriterMain();
+
+    // Write all the messages currently in the queues.
+    void WriteQueued();
+
+    // Write the batch of formatted messages to the output.
+    void WriteBatch();
+
+
+    // Unique identifier of this object, used to find the per-thread queue.
+    const unsigned m_id;
+
+    size_t m_queueSize = 0;
+
+    std::unique_ptr<wxOutputStream> m_stream;
+
+    std::atomic<OverflowPolicy> m_policy{Overflow_Drop};
+    std::atomic<size_t> m_numDropped{0};
+
+    // Queues of all threads which logged something using this object, except
+    // for the ones which exited and whose queues were already emptied,
+    // protected by m_csQueues. The queues are shared with the threads using
+    // them, as they can outlive this object.
+    std::vector<std::shared_ptr<Queue>> m_queues;
+    wxCriticalSection m_csQueues;
+
+    // All the fields below are protected by m_mutex.
+    wxMutex m_mutex;
+
+    // Signalled to wake up the writer thread.
+    wxCondition m_condWake;
+
+    // Broadcast by the writer thread after writing the messages if
+    // m_numWaiting is non-zero.
+    wxCondition m_condWritten;
+
+    bool m_wakeRequested = false;
+    bool m_stopRequested = false;
+
+    // Generation numbers used by WaitUntilWritten().
+    unsigned long m_writeRequested = 0;
+    unsigned long m_writeDone = 0;
+
+    // The number of threads waiting for m_condWritten, only modified under
+    // m_mutex but read without it by the writer thread.
+    std::atomic<int> m_numWaiting{0};
+
+    WriterThread* m_thread = nullptr;
+
+    // These fields are only used by the writer thread.
+    std::vector<Queue*> m_queuesToWrite;
+    std::string m_batch;
+
+    wxDECLARE_NO_COPY_CLASS(wxLogAsync);
+};
+
+#endif // wxUSE_LOG && wxUSE_THREADS && wxUSE_STREAMS
+
+#endif // _WX_LOGASYNC_H_
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/parsedfmt.h
+// Purpose:     wxParsedFormat: printf-like format string parsed only once
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PARSEDFMT_H_
+#define _WX_PARSEDFMT_H_
+
+#include "wx/string.h"
+
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+// wxParsedFormat: format string which can be used many times efficiently
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxParsedFormat
+{
+public:
+    // Default ctor creates an invalid object which can only be assigned to.
+    wxParsedFormat() = default;
+
+    // Parse the given printf-like format string.
+    explicit wxParsedFormat(const wxString& format);
+
+    // Return false if the format string couldn't be parsed.
+    bool IsOk() const;
+
+    // Return the format string passed to the ctor.
+    wxString GetFormat() const;
+
+    // Return the number of arguments used by the format string.
+    size_t GetArgumentCount() const;
+
+    // Replace the contents of the given string with the formatted string,
+    // reusing its existing buffer.
+    template <typename... Targs>
+    void FormatTo(wxString& out, const Targs&... args) const
+    {
+        DoFormatTo(out, Output_Replace, args...);
+    }
+
+    // Append the formatted string to the given one.
+    template <typename... Targs>
+    void AppendTo(wxString& out, const Targs&... args) const
+    {
+        DoFormatTo(out, Output_Append, args...);
+    }
+
+    // Return the formatted string, this is the equivalent of
+    // wxString::Format() using this format.
+    template <typename... Targs>
+    wxString Format(const Targs&... args) const
+    {
+        wxString s;
+        AppendTo(s, args...);
+        return s;
+    }
+
+private:
+    // Argument value, as returned by wxArgNormalizer<T>::get().
+    struct Arg
+    {
+        enum Type
+        {
+            Type_Int,
+            Type_Double,
+            Type_LongDouble,
+            Type_Pointer,
+            Type_String
+        };
+
+        template <typename T>
+        explicit Arg(T value,
+                     typename std::enable_if<std::is_integral<T>::value ||
+                                             std::is_enum<T>::value,
+                                             int>::type = 0)
+            : m_type(Type_Int)
+        {
+            m_int = static_cast<wxLongLong_t>(value);
+        }
+
+        explicit Arg(float value) : m_type(Type_Double) { m_double = value; }
+        explicit Arg(double value) : m_type(Type_Double) { m_double = value; }
+        explicit Arg(long double value) : m_type(Type_LongDouble)
+            { m_longDouble = value; }
+
+        explicit Arg(const wxStringCharType* value) : m_type(Type_String)
+            { m_str = value; }
+
+        template <typename T>
+        explicit Arg(T* value) : m_type(Type_Pointer)
+            { m_pointer = value; }
+        explicit Arg(std::nullptr_t) : m_type(Type_Pointer)
+            { m_pointer = nullptr; }
+
+        Type m_type;
+        union
+        {
+            wxLongLong_t m_int;
+            double m_double;
+            long double m_longDouble;
+            const void* m_pointer;
+            const wxStringCharType* m_str;
+        };
+    };
+
+    // What to do with the existing contents of the output string.
+    enum OutputMode
+    {
+        Output_Replace,
+        Output_Append
+    };
+
+    template <typename... Targs>
+    void DoFormatTo(wxString& out, OutputMode mode, const Targs&... args) const
+    {
+        // Note that the arguments are normalized in the same full expression
+        // as DoFormat() call, as the normalizers may own the values returned
+        // by their get().
+        DoValidate({wxFormatStringSpecifier<typename std::decay<Targs>::type>::value...});
+        DoFormat(out, mode,
+                 {
+                    Arg(wxArgNormalizerNative<typename std::decay<Targs>::type>
+                            (args, nullptr, 0).get())...
+                 });
+    }
+
+    // Check that the argument types, given as wxFormatString::ArgumentType
+    // values, match the format string: does nothing in release builds.
+    void DoValidate(std::initializer_list<int> argTypes) const;
+
+    void DoFormat(wxString& out,
+                  OutputMode mode,
+                  std::initializer_list<Arg> args) const;
+
+
+    // The parsed format string, shared between all copies of this object and
+    // never modified after creation, so that it's safe to use the same object
+    // from multiple threads.
+    struct Data;
+    std::shared_ptr<const Data> m_data;
+};
+
+#if !wxDEBUG_LEVEL
+inline void
+wxParsedFormat::DoValidate(std::initializer_list<int> WXUNUSED(argTypes)) const
+{
+}
+#endif // !wxDEBUG_LEVEL
+
+#endif // _WX_PARSEDFMT_H_
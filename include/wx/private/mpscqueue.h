@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/mpscqueue.h
+// Purpose:     wxMPSCQueue: lock-free multiple producers single consumer queue
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_MPSCQUEUE_H_
+#define _WX_PRIVATE_MPSCQUEUE_H_
+
+#include "wx/defs.h"
+
+#include <atomic>
+
+// ----------------------------------------------------------------------------
+// wxMPSCQueue: unbounded FIFO queue which can be used without locking
+// ----------------------------------------------------------------------------
+
+// This is an intrusive node-based queue (see D. Vyukov "Intrusive MPSC
+// node-based queue") in which Push() may be called concurrently from any
+// number of threads, while all the other functions must only be called from
+// a single consumer thread.
+//
+// Push() is wait-free and Pop() is lock-free, however note that Pop() may
+// fail to return the last element if a producer is preempted in the middle of
+// adding a new one after it, i.e. it's possible for IsEmpty() to return false
+// and Pop() to still fail. The element becomes available as soon as Push()
+// returns in the producer thread.
+//
+// T must be a cheap to copy type, typically a pointer.
+template <typename T>
+class wxMPSCQueue
+{
+public:
+    wxMPSCQueue()
+        : m_head(&m_stub),
+          m_tail(&m_stub)
+    {
+    }
+
+    // Dtor doesn't do anything with the elements remaining in the queue, if
+    // they need to be freed, it must be done by the owner.
+    ~wxMPSCQueue()
+    {
+        T value;
+        while ( Pop(value) )
+            ;
+    }
+
+    // Can be called from any thread.
+    void Push(T value)
+    {
+        Node* const node = new Node;
+        node->value = value;
+
+        DoPush(node);
+    }
+
+    // All the functions below can only be called from the consumer thread.
+
+    // Return false if there are no elements in the queue.
+    bool Pop(T& value)
+    {
+        Node* head = m_head;
+        Node* next = head->next.load();
+
+        if ( head == &m_stub )
+        {
+            if ( !next )
+                return false;
+
+            // Skip over the stub node, it doesn't contain any value.
+            m_head = next;
+            head = next;
+            next = next->next.load();
+        }
+
+        if ( !next )
+        {
+            // This is the last node, we can only remove it if there are no
+            // producers adding more nodes after it right now and after putting
+            // the stub node back as the tail, as we can't leave the queue
+            // without any nodes at all.
+            if ( head != m_tail.load() )
+                return false;
+
+            DoPush(&m_stub);
+
+            next = head->next.load();
+            if ( !next )
+                return false;
+        }
+
+        m_head = next;
+        value = head->value;
+        delete head;
+
+        return true;
+    }
+
+    // Return true if there are no elements in the queue.
+    //
+    // Note that the push in progress in another thread may or not be taken
+    // into account by this function, but it's guaranteed that if it returns
+    // true, the next Push() that completes after it will be visible.
+    bool IsEmpty() const
+    {
+        return m_head == &m_stub && !m_stub.next.load();
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    void DoPush(Node* node)
+    {
+        node->next.store(nullptr);
+
+        // Atomically make the new node the tail and only then link it to the
+        // previous one: between these two operations, the consumer doesn't
+        // see the new node yet. Note that sequentially consistent ordering is
+        // used for all operations as the callers rely on it to synchronize
+        // with the other state.
+        Node* const prev = m_tail.exchange(node);
+        prev->next.store(node);
+    }
+
+
+    // Only used by the consumer.
+    Node* m_head;
+
+    // Modified by the producers.
+    std::atomic<Node*> m_tail;
+
+    // Node without any value which is used to avoid having empty queue.
+    Node m_stub;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS(wxMPSCQueue, T);
+};
+
+#endif // _WX_PRIVATE_MPSCQUEUE_H_
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/threadpool.h
+// Purpose:     wxThreadPool: simple pool of worker threads
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_THREADPOOL_H_
+#define _WX_PRIVATE_THREADPOOL_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: fixed number of worker threads executing the queued tasks
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // Create the pool with the given number of threads, by default as many
+    // as there are CPUs in the system. The threads are only launched when the
+    // first task is queued.
+    explicit wxThreadPool(int numThreads = 0);
+
+    // Dtor waits until all the already queued tasks are executed.
+    ~wxThreadPool();
+
+    // Get the global pool shared by all wx code. It is created on demand and
+    // destroyed during the library shutdown.
+    static wxThreadPool& Get();
+
+    // Get the number of worker threads in this pool.
+    int GetThreadCount() const { return m_numThreads; }
+
+    // Queue the task for execution by one of the worker threads. Note that
+    // tasks are executed in unspecified order and may run concurrently.
+    void QueueTask(Task task);
+
+    // Call func(start, end) for consecutive non-overlapping ranges covering
+    // [0, count) using at most the given number of threads, including the
+    // calling one, and wait until all ranges are processed. If maxThreads is
+    // 0, use all threads of the pool. The function must not throw.
+    //
+    // The calling thread processes the ranges too, so it's safe to call this
+    // function from a worker thread of the same pool.
+    void ParallelFor(int count,
+                     int maxThreads,
+                     const std::function<void(int, int)>& func);
+
+private:
+    class WorkerThread;
+
+    // Launch the worker threads if not done yet, must be called with m_mutex
+    // locked.
+    void DoStartThreadsIfNeeded();
+
+    // Function executed by the worker threads.
+    void WorkerMain();
+
+
+    const int m_numThreads;
+
+    // Protects all the fields below.
+    wxMutex m_mutex;
+
+    // Signalled when a new task is queued or when we're shutting down.
+    wxCondition m_condition;
+
+    std::deque<Task> m_tasks;
+    std::vector<WorkerThread*> m_threads;
+
+    bool m_stopping = false;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_PRIVATE_THREADPOOL_H_
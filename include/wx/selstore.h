@@ -12,8 +12,11 @@
 
 #include "wx/dynarray.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
-// wxSelectedIndices is just a sorted array of indices
+// wxSelectedIndices is just a sorted array of indices, it is not used by
+// wxSelectionStore any more but is still defined for compatibility
 // ----------------------------------------------------------------------------
 
 inline int CMPFUNC_CONV wxUIntCmp(unsigned n1, unsigned n2)
@@ -28,23 +31,22 @@ WX_DEFINE_SORTED_EXPORTED_ARRAY_CMP_INT(unsigned, wxUIntCmp, wxSelectedIndices);
 // controls, i.e. it is well suited for storing even when the control contains
 // a huge (practically infinite) number of items.
 //
-// Of course, internally it still has to store the selected items somehow (as
-// an array currently) but the advantage is that it can handle the selection
-// of all items (common operation) efficiently and that it could be made even
-// smarter in the future (e.g. store the selections as an array of ranges +
-// individual items) without changing its API.
+// Internally it stores the ranges of items whose state is different from the
+// default one, which allows to handle the selection of all or many items
+// (common operations) efficiently, as well as checking whether an item is
+// selected in logarithmic time.
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_CORE wxSelectionStore
 {
 public:
-    wxSelectionStore() : m_itemsSel(wxUIntCmp) { Init(); }
+    wxSelectionStore() { Init(); }
 
     // set the total number of items we handle
     void SetItemCount(unsigned count);
 
     // special case of SetItemCount(0)
-    void Clear() { m_itemsSel.Clear(); m_count = 0; m_defaultState = false; }
+    void Clear() { m_ranges.clear(); Init(); }
 
     // must be called when new items are inserted/added
     void OnItemsInserted(unsigned item, unsigned numItems);
@@ -77,20 +79,15 @@ public:
     // return true if no items are currently selected
     bool IsEmpty() const
     {
-        return m_defaultState ? m_itemsSel.size() == m_count
-                              : m_itemsSel.empty();
+        return m_defaultState ? m_numItemsSel == m_count
+                              : m_ranges.empty();
     }
 
     // return the total number of selected items
     unsigned GetSelectedCount() const
     {
-        // we can we never have more than UINT_MAX selected items, knowing that
-        // we store the total number of items in an unsigned m_count, so the
-        // cast is safe.
-        return static_cast<unsigned>(
-                m_defaultState ? m_count - m_itemsSel.GetCount()
-                               : m_itemsSel.GetCount()
-                );
+        return m_defaultState ? m_count - m_numItemsSel
+                              : m_numItemsSel;
     }
 
     // type of a "cookie" used to preserve the iteration state, this is an
@@ -107,8 +104,29 @@ public:
     unsigned GetNextSelectedItem(IterationState& cookie) const;
 
 private:
+    // inclusive range of items
+    struct Range
+    {
+        unsigned first,
+                 last;
+    };
+
+    typedef std::vector<Range> Ranges;
+
     // (re)init
-    void Init() { m_count = 0; m_defaultState = false; }
+    void Init() { m_count = 0; m_numItemsSel = 0; m_defaultState = false; }
+
+    // return the first range which ends at or after the given item
+    Ranges::iterator FindRange(unsigned item);
+    Ranges::const_iterator FindRange(unsigned item) const;
+
+    // make all items in the given range have non-default state (if add is
+    // true) or default state (otherwise), return the number of items whose
+    // state changed and append up to maxChanged of them to the provided
+    // array if it's non-null
+    unsigned ChangeRange(unsigned first, unsigned last, bool add,
+                         wxArrayInt *itemsChanged = nullptr,
+                         size_t maxChanged = 0);
 
     // the total number of items we handle
     unsigned m_count;
@@ -118,8 +136,12 @@ private:
     // handle selection of all items efficiently
     bool m_defaultState;
 
-    // the array of items whose selection state is different from default
-    wxSelectedIndices m_itemsSel;
+    // the sorted, non-overlapping and non-adjacent, ranges of items whose
+    // selection state is different from default
+    Ranges m_ranges;
+
+    // the total number of items in m_ranges
+    unsigned m_numItemsSel;
 
     wxDECLARE_NO_COPY_CLASS(wxSelectionStore);
 };
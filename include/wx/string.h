@@ -64,6 +64,20 @@
     #define wxUSE_STRING_POS_CACHE 0
 #endif
 
+// in addition to the cache above, long UTF-8 strings use a sparse index of
+// the offsets of every Nth character, which is built on demand and makes
+// random access to them (almost) constant time instead of linear; set this
+// to 0 to disable it and save the memory used by the index
+#if wxUSE_STRING_POS_CACHE
+    #define wxUSE_STRING_POS_INDEX 1
+#else
+    #define wxUSE_STRING_POS_INDEX 0
+#endif
+
+#if wxUSE_STRING_POS_INDEX
+    #include <atomic>
+#endif
+
 #if wxUSE_STRING_POS_CACHE
     #include "wx/tls.h"
 
@@ -619,8 +633,35 @@ private:
 #endif
   }
 
+#if wxUSE_STRING_POS_INDEX
+  // the index is only used for the strings of at least this many bytes, as
+  // iterating over the shorter ones is fast enough
+  enum { POS_INDEX_MIN_LENGTH = 4096 };
+
+  // the index itself, defined in string.cpp
+  struct PosIndex;
+
+  // versions of DoPosToImpl() and PosFromImpl() using the index, for the
+  // long strings only
+  size_t DoPosToImplUsingIndex(size_t pos) const;
+  size_t DoPosFromImplUsingIndex(size_t pos) const;
+
+  // get the index, creating it if necessary, and ensure that it contains the
+  // entry n or an entry for an offset not less than implPos, if possible;
+  // this can be safely called by several threads reading the same string
+  const PosIndex& GetPosIndex(size_t n, size_t implPos) const;
+
+  // free the index
+  void ResetPosIndex();
+#endif // wxUSE_STRING_POS_INDEX
+
   size_t DoPosToImpl(size_t pos) const
   {
+#if wxUSE_STRING_POS_INDEX
+      if ( m_impl.length() >= POS_INDEX_MIN_LENGTH )
+          return DoPosToImplUsingIndex(pos);
+#endif // wxUSE_STRING_POS_INDEX
+
       wxCACHE_PROFILE_FIELD_INC(postot);
 
       // NB: although the case of pos == 1 (and offset from cached position
@@ -669,11 +710,23 @@ private:
       return cache->impl;
   }
 
+  // the index must be discarded whenever the string length changes, even if
+  // the cached position remains valid, as it could be invalid for the
+  // positions after it
+#if wxUSE_STRING_POS_INDEX
+  #define wxSTRING_RESET_POS_INDEX() \
+      if ( m_posIndex.load(std::memory_order_relaxed) ) ResetPosIndex()
+#else
+  #define wxSTRING_RESET_POS_INDEX()
+#endif
+
   void InvalidateCache()
   {
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
           cache->Reset();
+
+      wxSTRING_RESET_POS_INDEX();
   }
 
   void InvalidateCachedLength()
@@ -681,6 +734,8 @@ private:
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
           cache->len = npos;
+
+      wxSTRING_RESET_POS_INDEX();
   }
 
   void SetCachedLength(size_t len)
@@ -690,6 +745,8 @@ private:
       // potential for avoiding length recomputation for long strings looks
       // interesting
       GetCacheElement()->len = len;
+
+      wxSTRING_RESET_POS_INDEX();
   }
 
   void UpdateCachedLength(ptrdiff_t delta)
@@ -701,6 +758,8 @@ private:
 
           cache->len += delta;
       }
+
+      wxSTRING_RESET_POS_INDEX();
   }
 
   #define wxSTRING_INVALIDATE_CACHE() InvalidateCache()
@@ -737,8 +796,13 @@ private:
   {
       if ( pos == 0 || pos == npos )
           return pos;
-      else
-          return const_iterator(this, m_impl.begin() + pos) - begin();
+
+#if wxUSE_STRING_POS_INDEX
+      if ( m_impl.length() >= POS_INDEX_MIN_LENGTH )
+          return DoPosFromImplUsingIndex(pos);
+#endif // wxUSE_STRING_POS_INDEX
+
+      return const_iterator(this, m_impl.begin() + pos) - begin();
   }
 #endif // wxUSE_UNICODE_WCHAR/wxUSE_UNICODE_UTF8
 
@@ -3652,42 +3716,56 @@ private:
   // existing code and consistency with std::string::c_str() so returning a
   // temporary buffer won't do and we need to cache the conversion results
 
-  // TODO-UTF8: benchmark various approaches to keeping compatibility buffers
+  // these buffers are rarely used, so each of them only takes a single
+  // pointer in wxString itself and the length of the converted string is
+  // stored in the same heap block as the string data, which is only
+  // allocated when the conversion is performed for the first time
   template<typename T>
   struct ConvertedBuffer
   {
-      // notice that there is no need to initialize m_len here as it's unused
-      // as long as m_str is null
       ConvertedBuffer() = default;
       ~ConvertedBuffer()
-          { free(m_str); }
+          { free(m_data); }
 
       bool Extend(size_t len)
       {
           // add extra 1 for the trailing NUL
-          void * const str = realloc(m_str, sizeof(T)*(len + 1));
-          if ( !str )
+          void * const data = realloc(m_data, sizeof(Data) + sizeof(T)*len);
+          if ( !data )
               return false;
 
-          m_str = static_cast<T *>(str);
-          m_len = len;
+          m_data = static_cast<Data *>(data);
+          m_data->m_len = len;
 
           return true;
       }
 
+      // pointer to the string data, null if there is none
+      T *GetStr() const { return m_data ? m_data->m_str : nullptr; }
+
+      // length, not size, i.e. in chars and without last NUL
+      size_t GetLen() const { return m_data ? m_data->m_len : 0; }
+
       const wxScopedCharTypeBuffer<T> AsScopedBuffer() const
       {
-          return wxScopedCharTypeBuffer<T>::CreateNonOwned(m_str, m_len);
+          return wxScopedCharTypeBuffer<T>::CreateNonOwned(GetStr(), GetLen());
       }
 
-      T *m_str{nullptr};     // pointer to the string data
-      size_t m_len{0}; // length, not size, i.e. in chars and without last NUL
+  private:
+      // header of the heap block: the string data follows the length
+      struct Data
+      {
+          size_t m_len;
+          T m_str[1];
+      };
+
+      Data *m_data{nullptr};
   };
 
 
   // common mb_str() and wxCStrData::AsChar() helper: performs the conversion
-  // and returns either m_convertedToChar.m_str (in which case its m_len is
-  // also updated) or nullptr if it failed
+  // and returns either m_convertedToChar.GetStr() (in which case its length
+  // is also updated) or nullptr if it failed
   //
   // there is an important exception: in wxUSE_UNICODE_UTF8 build if conv is a
   // UTF-8 one, we return m_impl.c_str() directly, without doing any conversion
@@ -3768,6 +3846,13 @@ private:
 
   wxStringIteratorNodeHead m_iterators;
 
+#if wxUSE_STRING_POS_INDEX
+  // index of the character positions, only allocated for long strings when
+  // it's needed and freed whenever the string changes; it's atomic because it
+  // can be created by any of the threads accessing a const string
+  mutable std::atomic<PosIndex*> m_posIndex{nullptr};
+#endif // wxUSE_STRING_POS_INDEX
+
   friend class WXDLLIMPEXP_FWD_BASE wxStringIteratorNode;
   friend class WXDLLIMPEXP_FWD_BASE wxUniCharRef;
   friend class wxUTF8StringBuffer;
@@ -4021,6 +4106,10 @@ public:
     wxUTF8StringBuffer(wxString& str, size_t size)
         : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size}
     {
+#if wxUSE_STRING_POS_CACHE
+        // the string contents is going to be modified directly
+        str.InvalidateCache();
+#endif // wxUSE_STRING_POS_CACHE
     }
 
     ~wxUTF8StringBuffer()
@@ -4040,6 +4129,10 @@ public:
     wxUTF8StringBufferLength(wxString& str, size_t size)
         : wxPrivate::wxUTF8StringBufferBase{str.m_impl, size}
     {
+#if wxUSE_STRING_POS_CACHE
+        // the string contents is going to be modified directly
+        str.InvalidateCache();
+#endif // wxUSE_STRING_POS_CACHE
     }
 
     ~wxUTF8StringBufferLength()
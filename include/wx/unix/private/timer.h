@@ -14,7 +14,7 @@
 
 #include "wx/private/timer.h"
 
-#include <list>
+#include <vector>
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -47,6 +47,12 @@ public:
 
 private:
     bool m_isRunning;
+
+    // the index of this timer in wxTimerScheduler heap, only valid while the
+    // timer is running
+    size_t m_heapIndex = 0;
+
+    friend class wxTimerScheduler;
 };
 
 // ----------------------------------------------------------------------------
@@ -55,10 +61,24 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    wxUint64 seq)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_seq(seq)
+    {
+    }
+
+    // return true if this timer must be notified before the other one: this
+    // is the case if it expires earlier or at the same time but was added
+    // before it
+    bool IsBefore(const wxTimerSchedule& other) const
     {
+        if ( m_expiration != other.m_expiration )
+            return m_expiration < other.m_expiration;
+
+        return m_seq < other.m_seq;
     }
 
     // the timer itself (we don't own this pointer)
@@ -66,10 +86,16 @@ struct wxTimerSchedule
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
+
+    // the sequence number of this schedule, used to notify the timers
+    // expiring at the same time in the order in which they were added
+    wxUint64 m_seq;
 };
 
-// the linked list of all active timers, we keep it sorted by expiration time
-using wxTimerList = std::list<wxTimerSchedule>;
+// the binary min-heap of all active timers ordered by expiration time, the
+// position of each timer in it is stored in the timer itself to allow
+// removing it in logarithmic time
+using wxTimerHeap = std::vector<wxTimerSchedule>;
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -123,12 +149,27 @@ private:
     wxTimerScheduler() = default;
     ~wxTimerScheduler() = default;
 
-    // add the given timer schedule to the list in the right place
-    void DoAddTimer(const wxTimerSchedule& s);
+    // add the given timer schedule to the heap
+    void DoAddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration);
+
+    // remove the timer at the given position from the heap
+    void DoRemoveAt(size_t n);
+
+    // store the schedule at the given position in the heap and update the
+    // timer index
+    void DoPlace(size_t n, const wxTimerSchedule& s);
+
+    // restore the heap invariant after the schedule at the given position
+    // was added or changed
+    void DoSiftUp(size_t n);
+    void DoSiftDown(size_t n);
+
 
+    // the heap of all currently active timers
+    wxTimerHeap m_timers;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // the sequence number to use for the next added timer
+    wxUint64 m_nextSeq = 0;
 
     static wxTimerScheduler *ms_instance;
 };
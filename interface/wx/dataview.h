@@ -679,6 +679,178 @@ public:
 };
 
 
+/**
+    @class wxDataViewAsyncVirtualListModel
+
+    wxDataViewAsyncVirtualListModel is a virtual list model retrieving the
+    values of its rows in a background thread.
+
+    This model is useful when getting the values is slow, e.g. because they
+    are stored in a database or on a remote server, as wxDataViewCtrl asks the
+    model for the values of all visible cells whenever it repaints itself and
+    blocking while doing this would make the UI unresponsive.
+
+    Instead of overriding GetValueByRow(), a function retrieving the values
+    of all columns of the given row must be passed to the constructor. This
+    function is called from a worker thread, so it must not use any GUI
+    functions and must not throw any exceptions. It is called for the rows
+    shown in the control, as well as for the rows close to them, see
+    SetPrefetchMargin(), and, while the row values are not available yet, the
+    placeholder values returned by GetPlaceholderByRow() are shown instead of
+    them. When the values become available, they are stored in the cache and
+    the control is notified about the change of the corresponding rows.
+
+    The values are cached until ClearCache() is called, which must be done
+    whenever the underlying data changes, or until they are removed from the
+    cache to make place for the other rows, see SetMaxCachedRows().
+
+    Example of using this model:
+    @code
+    auto model = new wxDataViewAsyncVirtualListModel
+        (
+            [db](unsigned int row, wxVector<wxVariant>& values)
+            {
+                const Record rec = db->GetRecord(row); // May take a long time.
+                values.push_back(rec.GetName());
+                values.push_back(rec.GetSize());
+            },
+            db->GetRecordCount()
+        );
+    dvc->AssociateModel(model);
+    model->DecRef();
+    @endcode
+
+    @library{wxcore}
+    @category{dvc}
+
+    @since 3.3.0
+*/
+class wxDataViewAsyncVirtualListModel : public wxDataViewVirtualListModel
+{
+public:
+    /**
+        Type of the function used for retrieving the row values.
+
+        The function must fill the provided vector, which is initially empty,
+        with the values of all the columns of the given row, in the order of
+        their model column indices.
+
+        Note that the values must be created by this function and not copied
+        from any existing wxVariant objects, as they are then used from the
+        main thread.
+    */
+    using RowFetcher = std::function<void (unsigned int row, wxVector<wxVariant>& values)>;
+
+    /**
+        Constructor.
+
+        @param fetcher
+            The function called from the worker thread to retrieve the row
+            values, must be valid.
+        @param initial_size
+            The initial number of rows.
+    */
+    wxDataViewAsyncVirtualListModel(const RowFetcher& fetcher,
+                                    unsigned int initial_size = 0);
+
+    /**
+        Destructor.
+
+        Waits until the fetcher function returns if it's currently being
+        executed, so it is guaranteed that it won't be called after the model
+        is destroyed, and discards all the other pending requests.
+    */
+    virtual ~wxDataViewAsyncVirtualListModel();
+
+    /**
+        Set the number of rows before and after the requested row which are
+        fetched together with it.
+
+        Default margin is 32 rows.
+    */
+    void SetPrefetchMargin(unsigned int rows);
+
+    /**
+        Get the number of rows before and after the requested row which are
+        fetched together with it.
+    */
+    unsigned int GetPrefetchMargin() const;
+
+    /**
+        Set the maximal number of rows whose values are kept in the cache.
+
+        When the cache becomes too big, the rows farthest from the last row
+        requested by the control are removed from it. The number of rows must
+        be greater than the number of rows shown in the control.
+
+        Default maximal number of cached rows is 10000.
+    */
+    void SetMaxCachedRows(unsigned int rows);
+
+    /**
+        Get the maximal number of rows whose values are kept in the cache.
+    */
+    unsigned int GetMaxCachedRows() const;
+
+    /**
+        Start fetching the values of the rows in the given inclusive range.
+
+        This function can be used to retrieve the rows which are expected to
+        be shown soon. The rows already in the cache are not fetched again.
+    */
+    void PrefetchRows(unsigned int from, unsigned int to);
+
+    /**
+        Forget all the cached values.
+
+        This function must be called when the underlying data changes. It
+        doesn't notify the control about the change, so it should usually be
+        followed by a call to Reset() or another function doing it.
+
+        Any values being fetched when this function is called are discarded.
+    */
+    void ClearCache();
+
+    /**
+        Return @true if the values of the given row are in the cache.
+    */
+    bool IsRowCached(unsigned int row) const;
+
+    /**
+        Override this function to return the value to show in the given cell
+        while its real value is being fetched.
+
+        The default implementation leaves @a variant unchanged, i.e. null,
+        which means that the cell remains empty.
+    */
+    virtual void GetPlaceholderByRow(wxVariant& variant,
+                                     unsigned int row,
+                                     unsigned int col) const;
+
+    /**
+        Return the cached value of the given cell or its placeholder value if
+        it is not available yet.
+
+        In the latter case, fetching the row, as well as the rows around it,
+        is started.
+    */
+    virtual void GetValueByRow(wxVariant& variant,
+                               unsigned int row,
+                               unsigned int col) const;
+
+    /**
+        The default implementation doesn't allow editing the values and just
+        returns @false.
+
+        If this function is overridden to change the underlying data, it
+        should call ClearCache() before returning.
+    */
+    virtual bool SetValueByRow(const wxVariant& variant,
+                               unsigned int row,
+                               unsigned int col);
+};
+
+
 
 /**
     @class wxDataViewItemAttr
@@ -416,10 +416,14 @@ public:
         moment).
 
         QueueEvent() can be used for inter-thread communication from the worker
-        threads to the main thread. It is safe in the sense that it uses
-        locking internally and avoids the problem mentioned in AddPendingEvent()
-        documentation by ensuring that the @a event object is not used by the
-        calling thread any more.
+        threads to the main thread. It is safe in the sense that it can be
+        called from any number of threads concurrently and avoids the problem
+        mentioned in AddPendingEvent() documentation by ensuring that the @a
+        event object is not used by the calling thread any more. Since
+        wxWidgets 3.3.0 it doesn't use any locks in the common case, when the
+        handler already has pending events, so queuing many events from
+        different threads doesn't result in contention between them and the
+        main thread.
 
         Example:
         @code
@@ -458,6 +462,53 @@ public:
      */
     virtual void QueueEvent(wxEvent *event);
 
+    /**
+        Queue event for a later processing, replacing any previously queued
+        event with the same key.
+
+        This function is similar to QueueEvent() and can also be called from
+        any thread, but if an event with the same @a key had been already
+        queued using this function and hasn't been processed yet, the new
+        event replaces it, i.e. the old event is deleted without being
+        processed and the new one is processed at the position of the old one
+        in the queue.
+
+        This is useful for the events only the latest of which matters, such
+        as progress notifications from a worker thread: using this function
+        ensures that the number of such events in the queue remains bounded
+        even if they're generated faster than the main thread can handle them.
+
+        Example:
+        @code
+            void MyThread::ReportProgress(int percent)
+            {
+                wxThreadEvent* evt = new wxThreadEvent(wxEVT_THREAD, ID_PROGRESS);
+                evt->SetInt(percent);
+
+                m_frame->QueueEventCoalesced(evt, "progress");
+            }
+        @endcode
+
+        Note that if QueueEvent() is overridden in the derived class, it is
+        called by this function, but not with @a event itself: instead, it
+        receives an internal placeholder event which is replaced with the
+        latest event queued with the same key when it is processed. Such
+        overrides must pass this placeholder to QueueEvent() of the base
+        class, or of another event handler, instead of processing or deleting
+        it themselves.
+
+        @param event
+            A heap-allocated event to be queued, QueueEventCoalesced() takes
+            ownership of it. This parameter shouldn't be @NULL.
+        @param key
+            Arbitrary string identifying the events replacing each other.
+            Events queued with different keys are never coalesced, and events
+            queued using QueueEvent() are never replaced.
+
+        @since 3.3.0
+     */
+    void QueueEventCoalesced(wxEvent *event, const wxString& key);
+
     /**
         Post an event to be processed later.
 
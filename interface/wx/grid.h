@@ -1776,6 +1776,27 @@ public:
     /// Set attribute for the specified cell.
     virtual void SetAttr(wxGridCellAttr *attr, int row, int col);
 
+    /**
+        Set attribute for all cells of the specified block.
+
+        This is more efficient than calling SetAttr() for all cells of the
+        block if it is big, both in terms of the memory used and the time
+        needed for retrieving the attribute of a cell, which is logarithmic
+        in the number of blocks. The block attributes override the attributes
+        of the blocks set before them, but not the attributes set for
+        individual cells using SetAttr(), which take precedence over them.
+
+        If @a attr is @NULL, the attributes previously set for the cells of
+        this block using this function are removed.
+
+        When rows or columns are inserted inside a block, it is split in two
+        parts and the new cells don't have any block attribute.
+
+        @since 3.3.0
+     */
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
+
     /// Set attribute for the specified row.
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
 
@@ -1943,6 +1964,152 @@ public:
     wxString GetCornerLabelValue() const;
 };
 
+/**
+    Flags used by wxGridColumnarTable::LoadCSV().
+
+    @since 3.3.0
+ */
+enum wxGridCSVFlags
+{
+    /// Use the first line of the data for the column labels.
+    wxGRID_CSV_HEADER       = 0x0001,
+
+    /**
+        Use wxGRID_VALUE_NUMBER or wxGRID_VALUE_FLOAT type for the columns
+        containing only numbers (or empty cells).
+     */
+    wxGRID_CSV_DETECT_TYPES = 0x0002,
+
+    /// Default flags, combining all the flags above.
+    wxGRID_CSV_DEFAULT      = wxGRID_CSV_HEADER | wxGRID_CSV_DETECT_TYPES
+};
+
+/**
+    Table class storing its data by columns in a compact representation.
+
+    This class can be used instead of wxGridStringTable for big tables, as it
+    uses much less memory: the cells of the numeric columns are stored as
+    numbers and the cells of the string columns are stored as indices into a
+    per-column pool containing each distinct string only once, in UTF-8.
+
+    It also provides LoadCSV() function which allows to quickly fill the table
+    with the data from a stream, e.g.
+    @code
+    wxFileInputStream input("data.csv");
+    auto table = new wxGridColumnarTable();
+    if ( !table->LoadCSV(input) )
+        wxLogError("Failed to load CSV data.");
+    grid->AssignTable(table);
+    @endcode
+
+    The type of each column, returned by GetTypeName() for all of its cells,
+    can be one of wxGRID_VALUE_STRING, wxGRID_VALUE_NUMBER or
+    wxGRID_VALUE_FLOAT. Note that setting a value which can't be represented
+    by the type of the numeric column using SetValue() changes the type of
+    the whole column to wxGRID_VALUE_STRING. The wxGRID_VALUE_FLOAT columns
+    use the same number of decimals for all their values, so setting a value
+    with more decimals than the other ones, e.g. "1.125" in a column
+    containing "0.50", increases the number of decimals shown for all of
+    them instead, but setting a value which can't be formatted in the same
+    way as the others, e.g. "1e10" in this column, still changes the column
+    type to wxGRID_VALUE_STRING.
+
+    @since 3.3.0
+
+    @library{wxcore}
+    @category{grid}
+ */
+class wxGridColumnarTable : public wxGridTableBase
+{
+public:
+    /**
+        Default constructor creates an empty table.
+     */
+    wxGridColumnarTable();
+
+    /**
+        Constructor taking number of rows and columns.
+
+        All columns initially have wxGRID_VALUE_STRING type.
+     */
+    wxGridColumnarTable( int numRows, int numCols );
+
+    virtual int GetNumberRows();
+    virtual int GetNumberCols();
+    virtual wxString GetValue( int row, int col );
+    virtual void SetValue( int row, int col, const wxString& s );
+
+    void Clear();
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 );
+    bool AppendRows( size_t numRows = 1 );
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 );
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 );
+    bool AppendCols( size_t numCols = 1 );
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 );
+
+    void SetRowLabelValue( int row, const wxString& );
+    void SetColLabelValue( int col, const wxString& );
+    void SetCornerLabelValue( const wxString& );
+    wxString GetRowLabelValue( int row );
+    wxString GetColLabelValue( int col );
+    wxString GetCornerLabelValue() const;
+
+    /**
+        Change the type of the given column.
+
+        The @a typeName must be one of wxGRID_VALUE_STRING,
+        wxGRID_VALUE_NUMBER or wxGRID_VALUE_FLOAT. The existing values are
+        converted to the new type and, if this can't be done without losing
+        information, e.g. because a cell contains a non-numeric string, the
+        function returns @false without changing anything.
+
+        Empty cells are preserved by all conversions.
+     */
+    bool SetColType( int col, const wxString& typeName );
+
+    /**
+        Return the type of the given column.
+
+        This is the same value as returned by GetTypeName() for all the cells
+        of this column.
+     */
+    wxString GetColType( int col ) const;
+
+    /**
+        Replace the contents of the table with the CSV data from the stream.
+
+        The data must use the format described in RFC 4180, i.e. the fields
+        containing separators, quotes or new lines must be quoted and the
+        quotes inside them must be doubled. Empty lines are ignored and the
+        lines with fewer fields than the others are padded with empty cells.
+
+        The data is decoded using the provided @a conv, which must be an
+        encoding compatible with ASCII, such as UTF-8, which is the default,
+        or any single byte encoding. UTF-8 BOM at the beginning of the data is
+        ignored. The fields which can't be decoded using @a conv, e.g. because
+        they contain invalid UTF-8 sequences, are decoded as ISO-8859-1
+        instead, so that the data is never silently lost.
+
+        @param stream The stream to read the data from.
+        @param sep The field separator.
+        @param flags Combination of wxGridCSVFlags values.
+        @param conv The encoding of the data.
+        @return @true if the data was loaded or @false if reading the stream
+            failed, in which case the table is left unchanged.
+     */
+    bool LoadCSV( wxInputStream& stream,
+                  char sep = ',',
+                  int flags = wxGRID_CSV_DEFAULT,
+                  const wxMBConv& conv = wxConvUTF8 );
+
+    /**
+        Return the approximate number of bytes used by the table data.
+
+        This doesn't include the memory used by the attributes.
+     */
+    size_t GetMemoryUsage() const;
+};
+
 /**
     Represents coordinates of a grid cell.
 
@@ -2682,6 +2849,19 @@ public:
      */
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
 
+    /**
+        Set attribute of all cells of the specified block.
+
+        By default this function is simply forwarded to
+        wxGridCellAttrProvider::SetBlockAttr().
+
+        The table takes ownership of @a attr, i.e. will call DecRef() on it.
+
+        @since 3.3.0
+     */
+    virtual void SetBlockAttr(wxGridCellAttr* attr,
+                              const wxGridBlockCoords& block);
+
     /**
         Set attribute of the specified row.
 
@@ -4065,9 +4245,120 @@ public:
         Automatically sizes all columns to fit their contents. If @a setAsMin
         is @true the calculated widths will also be set as the minimal widths
         for the columns.
+
+        Notice that this function needs to measure all the cells of the grid
+        and so can be slow for big grids. See EnableAutoSizeCache(),
+        SetAutoSizeSampleSize() and AutoSizeColumnsInIdle() for the ways to
+        make it faster or to avoid blocking the UI while doing it.
     */
     void AutoSizeColumns(bool setAsMin = true);
 
+    /**
+        Automatically sizes all columns to fit their contents without blocking
+        the program.
+
+        This function returns immediately and the cells are measured in idle
+        time, in small chunks. When all of them have been measured, the
+        columns are resized in the same way as AutoSizeColumns() does and
+        @c wxEVT_GRID_COLS_AUTO_SIZED event is sent.
+
+        If rows or columns are added or removed while the cells are being
+        measured, measuring them starts again. Calling this function again
+        while auto-sizing is in progress restarts it too.
+
+        @see IsAutoSizingColumnsInIdle(), CancelAutoSizeColumnsInIdle()
+
+        @since 3.3.0
+    */
+    void AutoSizeColumnsInIdle(bool setAsMin = true);
+
+    /**
+        Returns @true if AutoSizeColumnsInIdle() was called and the columns
+        haven't been resized yet.
+
+        @since 3.3.0
+    */
+    bool IsAutoSizingColumnsInIdle() const;
+
+    /**
+        Stops auto-sizing the columns started by AutoSizeColumnsInIdle().
+
+        The columns are not resized and no event is sent. Does nothing if
+        auto-sizing is not in progress.
+
+        @since 3.3.0
+    */
+    void CancelAutoSizeColumnsInIdle();
+
+    /**
+        Enables or disables caching the best widths of the cells.
+
+        When the cache is enabled, the best width of each cell computed by
+        AutoSizeColumn(), AutoSizeColumns() or AutoSizeColumnsInIdle() is
+        remembered and the cell is not measured again when the columns are
+        auto-sized the next time, unless it changed. This makes auto-sizing
+        the columns again after changing only a few cells much faster, at the
+        price of using an extra @c int per cell.
+
+        The cached widths are invalidated when the cell value is changed using
+        SetCellValue() or the cell editor, when the attributes are changed using wxGrid methods
+        such as SetCellFont() or SetColAttr(), when rows or columns are added
+        or removed and when the DPI changes. If the table data or the
+        attributes are modified directly, ClearAutoSizeCache() or RefreshAttr()
+        must be called to invalidate the widths.
+
+        The cache is disabled by default.
+
+        @since 3.3.0
+    */
+    void EnableAutoSizeCache(bool enable = true);
+
+    /**
+        Returns @true if the cache of the cells best widths is enabled.
+
+        @see EnableAutoSizeCache()
+
+        @since 3.3.0
+    */
+    bool IsAutoSizeCacheEnabled() const;
+
+    /**
+        Forgets all the cached cells best widths.
+
+        Does nothing if the cache is not enabled.
+
+        @see EnableAutoSizeCache()
+
+        @since 3.3.0
+    */
+    void ClearAutoSizeCache();
+
+    /**
+        Sets the maximal number of rows measured when auto-sizing the columns.
+
+        If the grid has more than the given number of rows, only this many
+        rows, evenly spread over the entire grid, are measured by
+        AutoSizeColumn(), AutoSizeColumns() and AutoSizeColumnsInIdle(). This
+        makes auto-sizing the columns of big grids much faster, but the
+        resulting widths may be too small for some cells.
+
+        @param numRows The number of rows to measure or 0, which is the
+            default, to measure all rows.
+
+        @since 3.3.0
+    */
+    void SetAutoSizeSampleSize(int numRows);
+
+    /**
+        Returns the maximal number of rows measured when auto-sizing the
+        columns.
+
+        @see SetAutoSizeSampleSize()
+
+        @since 3.3.0
+    */
+    int GetAutoSizeSampleSize() const;
+
     /**
         Automatically sizes the row to fit its contents. If @a setAsMin is
         @true the calculated height will also be set as the minimal height for
@@ -5922,18 +6213,20 @@ public:
     /**
         Invalidates the cached attribute for the given cell.
 
-        For efficiency reasons, wxGrid may cache the recently used attributes
-        (currently it caches only the single most recently used one, in fact)
-        which can result in the cell appearance not being refreshed even when
-        the attribute returned by your custom wxGridCellAttrProvider-derived
-        class has changed. To force the grid to refresh the cell attribute,
-        this function may be used. Notice that calling it will not result in
-        actually redrawing the cell, you still need to call
-        wxWindow::RefreshRect() to invalidate the area occupied by the cell in
-        the window to do this. Also note that you don't need to call this
-        function if you store the attributes in wxGrid itself, i.e. use its
-        SetAttr() and similar methods, it is only useful when using a separate
-        custom attributes provider.
+        For efficiency reasons, wxGrid caches the attributes of the recently
+        used cells, which can result in the cell appearance not being
+        refreshed even when the attribute returned by your custom
+        wxGridCellAttrProvider-derived class has changed. The cache is cleared
+        whenever the grid is refreshed, e.g. by calling wxWindow::Refresh()
+        or wxWindow::RefreshRect() for it, when a cell value is changed
+        using SetCellValue() or the cell editor, and for the cells refreshed
+        by RefreshBlock(), so usually there is no need to do anything
+        special, but this function may be used to force the grid to refresh
+        the cell attribute in the other cases. Notice that calling it will
+        not result in actually redrawing the cell. Also note that you don't
+        need to call this function if you store the attributes in wxGrid
+        itself, i.e. use its SetAttr() and similar methods, it is only useful
+        when using a separate custom attributes provider.
 
         @param row
             The row of the cell whose attribute needs to be queried again.
@@ -5958,6 +6251,10 @@ public:
         value for the left column is unsupported and would result in an
         assertion failure.
 
+        The cached attributes of the cells in the block are invalidated, so
+        this function can be used after changing their values in the table
+        directly.
+
         @since 3.1.3
      */
     void RefreshBlock(const wxGridCellCoords& topLeft,
@@ -6009,6 +6306,19 @@ public:
     */
     void SetAttr(int row, int col, wxGridCellAttr *attr);
 
+    /**
+        Sets the cell attributes for all cells in the specified block.
+
+        The grid takes ownership of the attribute pointer.
+
+        This is much more efficient than calling SetAttr() for each cell if
+        the block is big, see wxGridCellAttrProvider::SetBlockAttr() for more
+        details.
+
+        @since 3.3.0
+    */
+    void SetBlockAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr);
+
     /**
         Sets the cell attributes for all cells in the specified column.
 
@@ -6473,6 +6783,12 @@ public:
         logic, e.g. to go to the next non-empty cell instead of just the next
         cell. See also wxGrid::SetTabBehaviour(). This event is new since
         wxWidgets 2.9.5.
+    @event{EVT_GRID_COLS_AUTO_SIZED(func)}
+        This event is generated when auto-sizing the columns started by
+        wxGrid::AutoSizeColumnsInIdle() completes, after all the columns have
+        been resized. The row and column of this event are both -1.
+        This event macro corresponds to @c wxEVT_GRID_COLS_AUTO_SIZED event
+        type and is new since wxWidgets 3.3.0.
     @endEventTable
 
     @library{wxcore}
@@ -6861,6 +7177,7 @@ wxEventType wxEVT_GRID_ROW_SIZE;
 wxEventType wxEVT_GRID_ROW_AUTO_SIZE;
 wxEventType wxEVT_GRID_COL_SIZE;
 wxEventType wxEVT_GRID_COL_AUTO_SIZE;
+wxEventType wxEVT_GRID_COLS_AUTO_SIZED;
 wxEventType wxEVT_GRID_ROW_LABEL_SIZE;
 wxEventType wxEVT_GRID_COL_LABEL_SIZE;
 wxEventType wxEVT_GRID_RANGE_SELECTING;
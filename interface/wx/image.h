@@ -129,6 +129,8 @@ enum wxImagePNGType
 #define wxIMAGE_OPTION_RESOLUTIONUNIT                   wxString("ResolutionUnit")
 #define wxIMAGE_OPTION_MAX_WIDTH                        wxString("MaxWidth")
 #define wxIMAGE_OPTION_MAX_HEIGHT                       wxString("MaxHeight")
+#define wxIMAGE_OPTION_DESIRED_WIDTH                    wxString("DesiredWidth")
+#define wxIMAGE_OPTION_DESIRED_HEIGHT                   wxString("DesiredHeight")
 #define wxIMAGE_OPTION_ORIGINAL_WIDTH                   wxString("OriginalWidth")
 #define wxIMAGE_OPTION_ORIGINAL_HEIGHT                  wxString("OriginalHeight")
 
@@ -239,6 +241,30 @@ public:
     */
     bool CanRead( const wxString& filename );
 
+    /**
+        Creates an object for decoding the image incrementally.
+
+        Unlike LoadFile(), which only returns once the entire image is loaded,
+        the returned decoder allows to decode the image as its data become
+        available, e.g. when it is being received from the network, and to
+        show the already decoded part of it before the rest of the data
+        arrives. See wxImageDecoder for more details.
+
+        Incremental decoding is currently supported by wxPNGHandler and
+        wxJPEGHandler only and this function returns @NULL for all the other
+        handlers.
+
+        @param verbose
+            If set to @true, errors reported by the decoder will produce
+            wxLogMessages.
+
+        @return The new decoder which must be deleted by the caller or @NULL
+            if not supported or if creating it failed.
+
+        @since 3.3.0
+    */
+    virtual wxImageDecoder* CreateDecoder(bool verbose = true);
+
     /**
         Gets the preferred file extension associated with this handler.
 
@@ -410,6 +436,127 @@ protected:
 };
 
 
+/**
+    @class wxImageDecoder
+
+    Object decoding an image incrementally, as its data become available.
+
+    Objects of this class can't be created directly but are returned by
+    wxImageHandler::CreateDecoder() for the handlers supporting incremental
+    decoding. The image data are then passed to Feed() in chunks of any size,
+    and the callback set with SetRowsCallback() is called whenever some rows of
+    the image are decoded. The image being decoded, which can be retrieved
+    using GetImage(), becomes valid as soon as its header is decoded and is
+    updated in place as decoding progresses, so the only memory used is the
+    memory needed for the image itself, plus the small amount of memory used
+    by the decoder internally.
+
+    Here is an example of using this class:
+    @code
+    std::unique_ptr<wxImageDecoder>
+        decoder(wxImage::FindHandler(wxBITMAP_TYPE_PNG)->CreateDecoder());
+    decoder->SetRowsCallback([&](int firstRow, int numRows) {
+        // Update the display using decoder->GetImage() here.
+    });
+
+    // Call this whenever new data arrive.
+    if ( !decoder->Feed(data, size) ) {
+        // Handle the error.
+    }
+
+    if ( decoder->IsDone() ) {
+        wxImage image = decoder->GetImage();
+        ...
+    }
+    @endcode
+
+    Note that interlaced PNG images and progressive JPEG images are decoded
+    in several passes for the former and with all rows becoming available only
+    at the end for the latter, so the rows callback can be called several times
+    for the same row or only called after all the data have been received.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxImageHandler::CreateDecoder()
+
+    @since 3.3.0
+*/
+class wxImageDecoder
+{
+public:
+    /**
+        Type of the callback called when some rows of the image are decoded.
+
+        The callback is passed the first row which was decoded and the number
+        of rows decoded.
+    */
+    using RowsCallback = std::function<void (int firstRow, int numRows)>;
+
+    /**
+        Destructor frees all the resources used by the decoder.
+
+        It is safe to delete the decoder before decoding the image completely.
+    */
+    virtual ~wxImageDecoder();
+
+    /**
+        Set the function to call whenever some rows of the image are decoded.
+    */
+    void SetRowsCallback(const RowsCallback& callback);
+
+    /**
+        Decode the next chunk of the image data.
+
+        The data are decoded as far as possible and the rows callback is called
+        for all the rows which could be decoded. The decoder keeps the data
+        which can't be decoded yet internally, so the caller doesn't need to
+        keep them.
+
+        Any data passed to this function after the end of the image are simply
+        ignored.
+
+        @return @false if an error occurred, in which case all subsequent calls
+            to this function will return @false too and HasFailed() will
+            return @true.
+    */
+    bool Feed(const void* data, size_t size);
+
+    /**
+        Decode all the data currently available in the given stream.
+
+        This function reads the data from the stream as long as its
+        wxInputStream::CanRead() returns @true, meaning that it doesn't block
+        waiting for more data if the stream doesn't have them yet, and passes
+        them to the overload above.
+
+        @return @false if an error occurred.
+    */
+    bool Feed(wxInputStream& stream);
+
+    /**
+        Return the image being decoded.
+
+        The returned image is invalid until the header of the image is decoded
+        and is complete only once IsDone() returns @true.
+
+        Note that the returned image shares its data with the one used by the
+        decoder, so it shouldn't be modified before the decoding is done.
+    */
+    const wxImage& GetImage() const;
+
+    /**
+        Return @true if the entire image has been decoded.
+    */
+    bool IsDone() const;
+
+    /**
+        Return @true if decoding failed.
+    */
+    bool HasFailed() const;
+};
+
+
 /**
     Constant used to indicate the alpha value conventionally defined as
     the complete transparency.
@@ -821,10 +968,45 @@ public:
         specified pixel @a blurRadius. This should not be used when using
         a single mask colour for transparency.
 
-        @see BlurHorizontal(), BlurVertical()
+        The time taken by this function doesn't depend on the blur radius.
+
+        @see BlurHorizontal(), BlurVertical(), BlurGaussian()
     */
     wxImage Blur(int blurRadius) const;
 
+    /**
+        Blurs the image using the provided buffer for temporary data.
+
+        This overload is the same as Blur() but uses the provided @a scratch
+        buffer for storing the intermediate results instead of allocating
+        memory for them, which can be useful when blurring many images of the
+        same size. The buffer is enlarged if it is not big enough, so it can
+        be initially empty.
+
+        @since 3.3.0
+    */
+    wxImage Blur(int blurRadius, wxMemoryBuffer& scratch) const;
+
+    /**
+        Blurs the image using an approximation of the Gaussian blur.
+
+        This function uses three successive box blurs, see Blur(), with the
+        radii chosen to approximate the Gaussian blur with the standard
+        deviation @a sigma. Just as Blur(), it takes the time independent of
+        @a sigma, so it can be used even with large values, e.g. for creating
+        shadows, and it also shouldn't be used with images using a single mask
+        colour for transparency.
+
+        The overload taking @a scratch buffer uses it for storing the
+        intermediate results instead of allocating memory for them.
+
+        @since 3.3.0
+    */
+    wxImage BlurGaussian(double sigma) const;
+
+    /// @overload
+    wxImage BlurGaussian(double sigma, wxMemoryBuffer& scratch) const;
+
     /**
         Blurs the image in the horizontal direction only. This should not be used
         when using a single mask colour for transparency.
@@ -1029,6 +1211,40 @@ public:
     wxImage Scale(const wxSize& size,
                   wxImageResizeQuality quality = wxIMAGE_QUALITY_NORMAL) const;
 
+    /**
+        Sets the maximal number of threads used for processing images.
+
+        By default, all image processing is done in the calling thread only.
+        Calling this function with @a numThreads greater than 1 allows Scale(),
+        Rescale(), Blur(), BlurHorizontal(), BlurVertical() and Rotate() to
+        split the image in bands of rows (or columns) and process them in
+        parallel using the worker threads shared by the library and the calling
+        thread. The special value of 0 means to use as many threads as there
+        are CPUs in the system.
+
+        Note that the results of these functions don't depend on the number of
+        threads used, i.e. parallel processing produces exactly the same image
+        as the serial one. It is also only used for sufficiently big images,
+        as the overhead of using threads would outweigh the gains otherwise.
+
+        This function does nothing if wxWidgets was built without threads
+        support (@c wxUSE_THREADS set to 0).
+
+        @see GetMaxProcessingThreads()
+
+        @since 3.3.0
+     */
+    static void SetMaxProcessingThreads(int numThreads);
+
+    /**
+        Returns the maximal number of threads used for processing images.
+
+        See SetMaxProcessingThreads() for more information.
+
+        @since 3.3.0
+     */
+    static int GetMaxProcessingThreads();
+
     /**
         Returns a resized version of this image without scaling it by adding either a
         border with the given colour or cropping as necessary.
@@ -1346,10 +1562,27 @@ public:
             handler, this is still what happens however). These options must be
             set before calling LoadFile() to have any effect.
 
+        @li @c wxIMAGE_OPTION_DESIRED_WIDTH and @c wxIMAGE_OPTION_DESIRED_HEIGHT:
+            These options provide a hint about the size of the image which is
+            really needed, e.g. when creating thumbnails, allowing the handlers
+            supporting it to load a smaller image than the original one, as long
+            as it is still at least as big as the given width and height (if
+            they're not 0). Unlike with @c wxIMAGE_OPTION_MAX_WIDTH, the loaded
+            image is never rescaled by wxImage itself, so it can be bigger than
+            the desired size and usually needs to be rescaled by the caller to
+            the exact size. Currently only JPEG handler, which uses
+            libjpeg support for decoding the images at 1/2, 1/4 or 1/8 of their
+            original size, and TIFF handler, which uses the reduced-resolution
+            version of the image if the file contains it, take these options
+            into account. Just as for @c wxIMAGE_OPTION_MAX_WIDTH, these options
+            must be set before calling LoadFile().
+            @since 3.3.0
+
         @li @c wxIMAGE_OPTION_ORIGINAL_WIDTH and @c wxIMAGE_OPTION_ORIGINAL_HEIGHT:
             These options will return the original size of the image if either
-            @c wxIMAGE_OPTION_MAX_WIDTH or @c wxIMAGE_OPTION_MAX_HEIGHT is
-            specified.
+            @c wxIMAGE_OPTION_MAX_WIDTH or @c wxIMAGE_OPTION_MAX_HEIGHT, or
+            @c wxIMAGE_OPTION_DESIRED_WIDTH or @c wxIMAGE_OPTION_DESIRED_HEIGHT,
+            is specified and the loaded image is smaller than the original one.
             @since 2.9.3
 
         @li @c wxIMAGE_OPTION_QUALITY: JPEG quality used when saving. This is an
@@ -1471,6 +1704,9 @@ public:
     /**
         Returns a sub image of the current one as long as the rect belongs entirely
         to the image.
+
+        Note that this function copies the pixel data, use wxImageView to
+        access a part of the image without copying it.
     */
     wxImage GetSubImage(const wxRect& rect) const;
 
@@ -2141,6 +2377,185 @@ public:
 };
 
 
+/**
+    @class wxImageView
+
+    A rectangular part of a wxImage sharing the pixel data with it.
+
+    Creating an image view is cheap as, unlike wxImage::GetSubImage(), it
+    doesn't copy the image data, but just keeps a reference to the image, in
+    the same way as copying wxImage objects does. This makes it possible to
+    e.g. split a huge image into tiles without copying all of its data.
+
+    Image views use copy-on-write semantics: modifying a view using its SetRGB(),
+    SetAlpha(), GetWritableRowData() or GetWritableRowAlpha() functions first
+    copies the viewed part of the image, and only it, if the data are shared
+    with any other wxImage or wxImageView object. And modifying the original
+    image using wxImage methods doesn't affect the view either, as the image
+    makes a copy of its data before modifying them if they are shared. Notice
+    that, just as with wxImage itself, modifying the data directly using the
+    pointer returned by wxImage::GetData() does affect all the views of the
+    image, so it should be avoided while the views exist.
+
+    Notice that all coordinates used by this class are relative to the view
+    and not to the image it refers to.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxImage
+
+    @since 3.3.0
+*/
+class wxImageView
+{
+public:
+    /**
+        Default constructor creates an invalid view.
+
+        Use assignment operator to initialize it later.
+    */
+    wxImageView();
+
+    /**
+        Creates a view of the entire image.
+    */
+    explicit wxImageView(const wxImage& image);
+
+    /**
+        Creates a view of the given part of the image.
+
+        The rectangle must be non-empty and lie entirely inside the image.
+    */
+    wxImageView(const wxImage& image, const wxRect& rect);
+
+    /**
+        Returns @true if the view is valid.
+    */
+    bool IsOk() const;
+
+    /**
+        Returns the width of the view.
+    */
+    int GetWidth() const;
+
+    /**
+        Returns the height of the view.
+    */
+    int GetHeight() const;
+
+    /**
+        Returns the size of the view.
+    */
+    wxSize GetSize() const;
+
+    /**
+        Returns the image this view refers to.
+
+        Note that this may be a copy of the part of the original image if this
+        view had been modified.
+    */
+    const wxImage& GetImage() const;
+
+    /**
+        Returns the position and size of the view in GetImage().
+    */
+    const wxRect& GetRect() const;
+
+    /**
+        Returns a view of the part of this view.
+
+        The rectangle is specified in this view coordinates and must lie
+        entirely inside it. The returned view shares the data with this one.
+    */
+    wxImageView GetSubView(const wxRect& rect) const;
+
+    /**
+        Returns @true if the image has alpha channel.
+    */
+    bool HasAlpha() const;
+
+    /**
+        Returns the value of the given channel of the pixel at the given
+        position.
+
+        GetAlpha() can only be called if HasAlpha() returns @true.
+    */
+    ///@{
+    unsigned char GetRed(int x, int y) const;
+    unsigned char GetGreen(int x, int y) const;
+    unsigned char GetBlue(int x, int y) const;
+    unsigned char GetAlpha(int x, int y) const;
+    ///@}
+
+    /**
+        Returns the pointer to the RGB data of the given row.
+
+        The pointer can be used to access GetWidth()*3 bytes of data of this
+        row. The data of the next row start at GetRowStride() bytes after it.
+    */
+    const unsigned char* GetRowData(int y) const;
+
+    /**
+        Returns the offset between the RGB data of consecutive rows.
+
+        Notice that the offset between the alpha data of consecutive rows is
+        3 times smaller than this.
+    */
+    int GetRowStride() const;
+
+    /**
+        Returns the pointer to the alpha data of the given row.
+
+        Returns @NULL if the image doesn't have alpha channel.
+    */
+    const unsigned char* GetRowAlpha(int y) const;
+
+    /**
+        Sets the colour of the pixel at the given position.
+
+        This copies the viewed part of the image if its data are shared.
+    */
+    void SetRGB(int x, int y,
+                unsigned char r, unsigned char g, unsigned char b);
+
+    /**
+        Sets the alpha value of the pixel at the given position.
+
+        This copies the viewed part of the image if its data are shared. The
+        image must have alpha channel.
+    */
+    void SetAlpha(int x, int y, unsigned char alpha);
+
+    /**
+        Returns the pointer to the RGB data of the given row which can be
+        modified.
+
+        This copies the viewed part of the image if its data are shared, so
+        the pointers returned by the previous calls to GetRowData() may become
+        invalid after calling this function.
+    */
+    unsigned char* GetWritableRowData(int y);
+
+    /**
+        Returns the pointer to the alpha data of the given row which can be
+        modified.
+
+        This function is similar to GetWritableRowData() and returns @NULL if
+        the image doesn't have alpha channel.
+    */
+    unsigned char* GetWritableRowAlpha(int y);
+
+    /**
+        Returns an image containing the contents of this view.
+
+        Only the pixels of the view are copied, and if the view covers the
+        entire image, the returned image simply shares its data.
+    */
+    wxImage ToImage() const;
+};
+
+
 class wxImageHistogram : public wxImageHistogramBase
 {
 public:
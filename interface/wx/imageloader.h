@@ -0,0 +1,146 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        imageloader.h
+// Purpose:     interface of wxImageLoader
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxImageLoader
+
+    Loads images in the background threads and keeps the recently loaded
+    ones in a memory cache.
+
+    This class is useful for the applications showing many images, e.g.
+    thumbnails of all files in a directory, as it allows to avoid blocking the
+    UI while the images are being decoded and to use all the available CPUs
+    for decoding them. Images are loaded using the thread pool shared by all
+    wxWidgets code and, when the desired size is specified, use
+    ::wxIMAGE_OPTION_DESIRED_WIDTH and ::wxIMAGE_OPTION_DESIRED_HEIGHT to
+    allow the handlers supporting it to decode smaller images faster.
+
+    When loading an image completes, a @c wxEVT_IMAGE_LOADED event of type
+    wxThreadEvent is sent to the handler specified when creating the loader.
+    The event string is the path of the file passed to Load() and its payload
+    is the loaded wxImage, which is invalid if loading failed, e.g.
+    @code
+    void MyFrame::OnImageLoaded(wxThreadEvent& event)
+    {
+        const wxImage image = event.GetPayload<wxImage>();
+        if ( image.IsOk() )
+            UpdateThumbnail(event.GetString(), image);
+    }
+    @endcode
+
+    The cache is limited by the total size of the image data in it and, when
+    this limit is exceeded, the least recently used images are removed from
+    it. Cached images are identified by their path, size passed to Load() and
+    the file modification time, so that modified files are loaded again.
+
+    All member functions of this class must be called from the main thread
+    only.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @see wxImage, wxImageDecoder
+
+    @since 3.3.0
+*/
+class wxImageLoader : public wxEvtHandler
+{
+public:
+    /// Default maximal size of the cache in bytes.
+    static constexpr size_t DEFAULT_CACHE_SIZE = 64*1024*1024;
+
+    /**
+        Constructor.
+
+        @param handler
+            The handler to which the @c wxEVT_IMAGE_LOADED events are sent,
+            must be non-null and must remain alive for at least as long as
+            this object exists.
+        @param maxCacheSize
+            Maximal size of the images data in the cache, in bytes. Use 0 to
+            disable caching.
+    */
+    explicit wxImageLoader(wxEvtHandler* handler,
+                           size_t maxCacheSize = DEFAULT_CACHE_SIZE);
+
+    /**
+        Destructor.
+
+        Note that the images being loaded when the loader is destroyed are
+        still loaded to completion in the background, but no events are sent
+        for them any more.
+    */
+    virtual ~wxImageLoader();
+
+    /**
+        Start loading the image from the given file.
+
+        This function returns immediately and the handler is notified when
+        loading completes by a @c wxEVT_IMAGE_LOADED event. The event is
+        sent, asynchronously, even if the image is already in the cache.
+        If the same image is requested again while it is still being loaded,
+        no new loading is started and a single event is sent for all such
+        requests.
+
+        @param path
+            The path of the file to load the image from.
+        @param size
+            If specified, the image is scaled down, preserving its aspect
+            ratio, to fit into this size. Images smaller than this size are
+            not scaled up.
+        @param type
+            The type of the image, by default determined automatically.
+    */
+    void Load(const wxString& path,
+              const wxSize& size = wxDefaultSize,
+              wxBitmapType type = wxBITMAP_TYPE_ANY);
+
+    /**
+        Return the image from the cache, if any.
+
+        The parameters must be the same as were passed to Load().
+
+        @return The cached image or an invalid image if it's not in the cache.
+    */
+    wxImage GetCached(const wxString& path,
+                      const wxSize& size = wxDefaultSize);
+
+    /**
+        Return @true if the image with the given parameters is being loaded.
+    */
+    bool IsLoading(const wxString& path,
+                   const wxSize& size = wxDefaultSize) const;
+
+    /**
+        Change the maximal cache size.
+
+        If the current cache size is greater than the new maximum, the least
+        recently used images are removed from it immediately.
+    */
+    void SetMaxCacheSize(size_t maxCacheSize);
+
+    /**
+        Return the maximal cache size in bytes.
+    */
+    size_t GetMaxCacheSize() const;
+
+    /**
+        Return the size of all images currently in the cache in bytes.
+    */
+    size_t GetCacheSize() const;
+
+    /**
+        Remove all images from the cache.
+    */
+    void ClearCache();
+};
+
+/**
+    Event sent by wxImageLoader when loading an image completes.
+
+    @since 3.3.0
+*/
+wxEventType wxEVT_IMAGE_LOADED;
@@ -46,6 +46,7 @@ public:
     // let parent class's documentation through.
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 );
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true );
+    virtual wxImageDecoder* CreateDecoder(bool verbose=true);
 
 protected:
     virtual bool DoCanRead( wxInputStream& stream );
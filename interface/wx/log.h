@@ -689,6 +689,23 @@ protected:
     virtual void DoLogText(const wxString& msg);
 
     ///@}
+
+    /**
+        Return @true if this log target can be used from any thread.
+
+        By default, the messages logged by the threads other than the main
+        one are buffered and only passed to the active log target when it is
+        flushed from the main thread. If this function is overridden to
+        return @true, DoLogRecord() is called directly from the thread logging
+        the message instead, so it must be thread-safe. Note that the repeated
+        messages are not counted, even if SetRepetitionCounting() was called,
+        for the messages logged from the other threads in this case.
+
+        @see wxLogAsync
+
+        @since 3.3.0
+     */
+    virtual bool IsThreadSafe() const;
 };
 
 
@@ -0,0 +1,171 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        logasync.h
+// Purpose:     interface of wxLogAsync
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxLogAsync
+
+    Log target writing the messages to a file or a stream from a background
+    thread.
+
+    Unlike the other log targets, this one can be used directly from any
+    thread, i.e. the messages logged by the threads other than the main one
+    are not buffered until the next call to Flush() from the main thread. And,
+    unlike when using a thread-specific log target set with
+    wxLog::SetThreadActiveTarget(), the threads don't need to synchronize
+    with each other either. Instead, each thread adds the messages to its own
+    queue, which doesn't require any locking, and the messages from all these
+    queues are formatted, using wxLogFormatter as usual, and written out in
+    batches by a separate thread created by this object, so logging a message
+    is cheap even when many threads do it simultaneously.
+
+    The messages of all levels, including debug and trace ones, are written
+    to the output in UTF-8 encoding, one message per line. Note that while the
+    messages logged by the same thread are always written in the order in
+    which they were logged, the messages from different threads may be
+    interleaved in any order.
+
+    Each queue can contain a fixed number of messages, specified when creating
+    the object, and so the amount of memory used by this class is bounded by
+    the queue size multiplied by the number of threads using it. The queue of
+    a thread is freed after the thread terminates, or starts using another
+    wxLogAsync object, and all the messages logged by it are written, so
+    creating many short-lived threads doesn't increase the memory usage
+    indefinitely. If the messages are logged faster than they can be written,
+    the queue
+    becomes full and the messages logged while it remains full are either
+    discarded, which is the default behaviour, or the thread logging them
+    waits until there is space in the queue, see SetOverflowPolicy().
+
+    Example of using this class:
+    @code
+    bool MyApp::OnInit()
+    {
+        m_logAsync = new wxLogAsync("myapp.log");
+        if ( !m_logAsync->IsOk() )
+        {
+            delete m_logAsync;
+            return false;
+        }
+
+        delete wxLog::SetActiveTarget(m_logAsync);
+
+        ...
+    }
+    @endcode
+
+    Note that, as the messages are written asynchronously, this log target
+    must not be destroyed while any threads can still be logging messages. It
+    also mustn't be modified by calling SetFormatter() after being installed
+    as active log target.
+
+    @library{wxbase}
+    @category{logging}
+
+    @see wxLog::IsThreadSafe()
+
+    @since 3.3.0
+*/
+class wxLogAsync : public wxLog
+{
+public:
+    /**
+        Possible behaviours when a thread logs a message while its queue is
+        full.
+
+        @see SetOverflowPolicy()
+     */
+    enum OverflowPolicy
+    {
+        /// The message is discarded, this is the default.
+        Overflow_Drop,
+
+        /// The thread waits until there is enough space in the queue.
+        Overflow_Block
+    };
+
+    /// Default number of messages which can be queued by each thread.
+    static constexpr size_t DEFAULT_QUEUE_SIZE = 1024;
+
+    /**
+        Constructor for the log target appending the messages to the given
+        file.
+
+        The file is created if it doesn't exist yet.
+
+        @param filename
+            The name of the file to write the messages to.
+        @param queueSize
+            The maximal number of messages waiting to be written for each
+            thread. It is rounded up to the next power of 2.
+
+        Use IsOk() to check if the file could be opened.
+     */
+    explicit wxLogAsync(const wxString& filename,
+                        size_t queueSize = DEFAULT_QUEUE_SIZE);
+
+    /**
+        Constructor for the log target writing the messages to the given
+        stream.
+
+        @param stream
+            The stream to write the messages to, which must be non-null and
+            is deleted by this object. It is only used from the writer thread.
+        @param queueSize
+            The maximal number of messages waiting to be written for each
+            thread. It is rounded up to the next power of 2.
+     */
+    explicit wxLogAsync(wxOutputStream* stream,
+                        size_t queueSize = DEFAULT_QUEUE_SIZE);
+
+    /**
+        Destructor writes all the messages logged so far and stops the writer
+        thread.
+     */
+    virtual ~wxLogAsync();
+
+    /**
+        Return @true if the object was successfully initialized.
+
+        If this function returns @false, all messages logged using this
+        object are discarded.
+     */
+    bool IsOk() const;
+
+    /**
+        Set the behaviour to use when the queue of a thread is full.
+
+        This function can be called at any time, even when other threads are
+        using this log target.
+     */
+    void SetOverflowPolicy(OverflowPolicy policy);
+
+    /**
+        Return the currently used overflow policy.
+     */
+    OverflowPolicy GetOverflowPolicy() const;
+
+    /**
+        Return the number of messages discarded since this object creation.
+
+        This can only be non-zero when using Overflow_Drop policy.
+     */
+    size_t GetDroppedCount() const;
+
+    /**
+        Wait until all the messages logged before calling this function are
+        written.
+     */
+    void WaitUntilWritten();
+
+    /**
+        Ask the writer thread to write the queued messages.
+
+        This function doesn't wait until the messages are written because it
+        is called periodically from the main thread, which shouldn't block,
+        use WaitUntilWritten() if this is needed.
+     */
+    virtual void Flush();
+};
@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        parsedfmt.h
+// Purpose:     interface of wxParsedFormat
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxParsedFormat
+
+    Printf-like format string which is parsed only once and can then be used
+    to format many strings efficiently.
+
+    wxString::Format() parses its format string each time it is called and
+    always allocates a new string for the result. This is fine in most cases,
+    but when the same format is used very often, e.g. for formatting log
+    messages, it can be worth parsing it once by creating a wxParsedFormat
+    object and using its FormatTo() function, which reuses the buffer of an
+    existing string, e.g.
+    @code
+    static const wxParsedFormat fmt("Processed %d items from \"%s\"");
+
+    wxString msg;
+    for ( const auto& file : files )
+    {
+        fmt.FormatTo(msg, file.GetCount(), file.GetName());
+        Output(msg);
+    }
+    @endcode
+
+    The format string uses the same syntax as wxString::Format() and the
+    arguments of any types supported by it can be passed to the functions of
+    this class, with the same rules for converting them: notably, strings can
+    be passed as @c char*, @c wchar_t*, wxString, @c std::string etc. The
+    types of the arguments which can't be used with a format string at all
+    result in compilation errors and, in debug builds, an assertion failure
+    is generated if they don't match the conversions in the format string.
+    Unlike with wxString::Format(), this check doesn't require parsing the
+    format string again.
+
+    Positional arguments, such as @c "%2$s", and @c '*' for specifying the
+    width or precision are supported, but can't be combined in the same
+    format string, and @c "%n" is not supported at all.
+
+    The simple conversions, such as @c "%s" or @c "%d", are handled directly
+    by this class while the rest of them is performed using the standard @c
+    snprintf(), so the results are the same as when using wxString::Format(),
+    with a possible exception for the strings with non-ASCII characters and a
+    width or precision, which are always counted in characters by this class.
+
+    Objects of this class are immutable and can be copied cheaply and used
+    from several threads simultaneously.
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxString::Format()
+
+    @since 3.3.0
+*/
+class wxParsedFormat
+{
+public:
+    /**
+        Default constructor creates an invalid object.
+
+        The object can only be assigned to before being used.
+     */
+    wxParsedFormat();
+
+    /**
+        Constructor parsing the given format string.
+
+        An assertion failure is generated and IsOk() returns @false if the
+        format string uses a feature not supported by this class.
+     */
+    explicit wxParsedFormat(const wxString& format);
+
+    /**
+        Return @true if the object was created from a valid format string.
+     */
+    bool IsOk() const;
+
+    /**
+        Return the format string passed to the constructor.
+     */
+    wxString GetFormat() const;
+
+    /**
+        Return the number of arguments used by the format string.
+
+        Note that passing more arguments to the functions of this class is
+        allowed, but passing fewer of them is not.
+     */
+    size_t GetArgumentCount() const;
+
+    /**
+        Replace the contents of the given string with the formatted string.
+
+        This function reuses the memory already allocated by @a out, so it
+        doesn't need to allocate any memory at all when it is called
+        repeatedly with the same string.
+
+        Note that @a out can also be used as one of the arguments, e.g. @c
+        fmt.FormatTo(s, s), in which case its original value is used for the
+        argument.
+     */
+    template <typename... Targs>
+    void FormatTo(wxString& out, const Targs&... args) const;
+
+    /**
+        Append the formatted string to the given string.
+
+        As with FormatTo(), @a out can also be used as one of the arguments.
+     */
+    template <typename... Targs>
+    void AppendTo(wxString& out, const Targs&... args) const;
+
+    /**
+        Return the formatted string.
+
+        This is equivalent to wxString::Format() using this format string.
+     */
+    template <typename... Targs>
+    wxString Format(const Targs&... args) const;
+};
@@ -1908,7 +1908,10 @@ public:
         This static function returns the string containing the result of calling
         Printf() with the passed parameters on it.
 
-        @see FormatV(), Printf()
+        If the same format string is used many times, consider using
+        wxParsedFormat instead of this function for better performance.
+
+        @see FormatV(), Printf(), wxParsedFormat
     */
     static wxString Format(const wxString& format, ...);
 
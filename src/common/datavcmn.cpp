@@ -36,6 +36,13 @@
 
 #include "wx/private/safecall.h"
 
+#if wxUSE_THREADS
+    #include "wx/private/threadpool.h"
+#endif // wxUSE_THREADS
+
+#include <deque>
+#include <unordered_set>
+
 // Uncomment this line to, for custom renderers, visually show the extent
 // of both a cell and its item.
 //#define DEBUG_RENDER_EXTENTS
@@ -678,6 +685,351 @@ unsigned int wxDataViewVirtualListModel::GetChildren( const wxDataViewItem &WXUN
 
 #endif  // __WXMAC__
 
+// ---------------------------------------------------------
+// wxDataViewAsyncVirtualListModel
+// ---------------------------------------------------------
+
+// This struct is used for communicating with the worker thread fetching the
+// rows, it is only accessed with the mutex locked.
+struct wxDataViewAsyncVirtualListModel::SharedState
+{
+    SharedState(const RowFetcher& fetcher_, wxEvtHandler* notifier_)
+        : fetcher(fetcher_),
+          notifier(notifier_)
+#if wxUSE_THREADS
+          , condition(mutex)
+#endif // wxUSE_THREADS
+    {
+    }
+
+    struct FetchedRow
+    {
+        unsigned int row;
+        wxVector<wxVariant> values;
+    };
+
+    // The function used for fetching the rows, only used by the worker.
+    const RowFetcher fetcher;
+
+    // Reset to null when the model is destroyed.
+    wxEvtHandler* notifier;
+
+#if wxUSE_THREADS
+    wxMutex mutex;
+
+    // Signalled when the worker stops running.
+    wxCondition condition;
+#endif // wxUSE_THREADS
+
+    // Rows to fetch, the most recently requested ones at the end, and all
+    // the rows which are either queued or being fetched.
+    std::deque<unsigned int> queue;
+    std::unordered_set<unsigned int> queued;
+
+    // Rows fetched by the worker but not taken by the model yet.
+    std::vector<FetchedRow> fetched;
+
+    // Incremented when the cache is cleared to discard the rows fetched
+    // before it.
+    unsigned int generation = 0;
+
+    // True while the worker is fetching the rows.
+    bool running = false;
+
+    // True if the notification about the fetched rows was already sent.
+    bool notifyPending = false;
+};
+
+wxDataViewAsyncVirtualListModel::wxDataViewAsyncVirtualListModel(
+        const RowFetcher& fetcher,
+        unsigned int initial_size)
+    : wxDataViewVirtualListModel(initial_size),
+      m_prefetchMargin(32),
+      m_maxCachedRows(10000),
+      m_lastRequestedRow(0),
+      m_state(std::make_shared<SharedState>(fetcher, &m_notifier))
+#if wxUSE_THREADS
+      , m_pool(new wxThreadPool(1))
+#endif // wxUSE_THREADS
+{
+    wxASSERT_MSG( fetcher, "must have a valid fetcher function" );
+
+    m_notifier.Bind(wxEVT_THREAD, [this](wxThreadEvent&) { OnRowsFetched(); });
+}
+
+wxDataViewAsyncVirtualListModel::~wxDataViewAsyncVirtualListModel()
+{
+#if wxUSE_THREADS
+    wxMutexLocker lock(m_state->mutex);
+#endif // wxUSE_THREADS
+
+    m_state->notifier = nullptr;
+    m_state->queue.clear();
+
+    // Wait until the row being fetched, if any, is done, to guarantee that
+    // the fetcher function is never called after the model is destroyed.
+#if wxUSE_THREADS
+    while ( m_state->running )
+        m_state->condition.Wait();
+#endif // wxUSE_THREADS
+}
+
+void wxDataViewAsyncVirtualListModel::SetMaxCachedRows(unsigned int rows)
+{
+    wxCHECK_RET( rows > 0, "must allow caching at least one row" );
+
+    m_maxCachedRows = rows;
+
+    TrimCache();
+}
+
+bool wxDataViewAsyncVirtualListModel::IsRowCached(unsigned int row) const
+{
+    return m_cache.count(row) != 0;
+}
+
+void wxDataViewAsyncVirtualListModel::ClearCache()
+{
+    m_cache.clear();
+
+#if wxUSE_THREADS
+    wxMutexLocker lock(m_state->mutex);
+#endif // wxUSE_THREADS
+
+    m_state->generation++;
+    m_state->queue.clear();
+    m_state->queued.clear();
+    m_state->fetched.clear();
+}
+
+void wxDataViewAsyncVirtualListModel::PrefetchRows(unsigned int from,
+                                                   unsigned int to)
+{
+    const unsigned int count = GetCount();
+    if ( from >= count || from > to )
+        return;
+
+    if ( to >= count )
+        to = count - 1;
+
+#if wxUSE_THREADS
+    wxMutexLocker lock(m_state->mutex);
+#endif // wxUSE_THREADS
+
+    // The rows queued last are fetched first, so queue them in reverse order.
+    for ( unsigned int row = to + 1; row > from; row-- )
+        DoQueueRow(row - 1);
+
+    DoStartFetching();
+}
+
+void
+wxDataViewAsyncVirtualListModel::GetPlaceholderByRow(wxVariant& WXUNUSED(variant),
+                                                     unsigned int WXUNUSED(row),
+                                                     unsigned int WXUNUSED(col)) const
+{
+}
+
+void
+wxDataViewAsyncVirtualListModel::GetValueByRow(wxVariant& variant,
+                                               unsigned int row,
+                                               unsigned int col) const
+{
+    m_lastRequestedRow = row;
+
+    const auto it = m_cache.find(row);
+    if ( it != m_cache.end() )
+    {
+        if ( col < it->second.size() )
+            variant = it->second[col];
+
+        return;
+    }
+
+    {
+#if wxUSE_THREADS
+        wxMutexLocker lock(m_state->mutex);
+#endif // wxUSE_THREADS
+
+        // If this row is already being fetched, the rows around it must have
+        // been queued too.
+        if ( !m_state->queued.count(row) )
+        {
+            // Queue the nearby rows first, so that the requested row itself
+            // and then the closest ones are fetched first.
+            const unsigned int count = GetCount();
+            for ( unsigned int d = m_prefetchMargin; d > 0; d-- )
+            {
+                if ( d < count - row )
+                    DoQueueRow(row + d);
+                if ( d <= row )
+                    DoQueueRow(row - d);
+            }
+
+            DoQueueRow(row);
+            DoStartFetching();
+        }
+    }
+
+    GetPlaceholderByRow(variant, row, col);
+}
+
+bool
+wxDataViewAsyncVirtualListModel::SetValueByRow(const wxVariant& WXUNUSED(variant),
+                                               unsigned int WXUNUSED(row),
+                                               unsigned int WXUNUSED(col))
+{
+    return false;
+}
+
+void wxDataViewAsyncVirtualListModel::DoQueueRow(unsigned int row) const
+{
+    if ( m_cache.count(row) || !m_state->queued.insert(row).second )
+        return;
+
+    std::deque<unsigned int>& queue = m_state->queue;
+    queue.push_back(row);
+
+    // Forget the oldest requests if there are too many of them, they're
+    // probably not needed any more anyhow.
+    if ( queue.size() > m_maxCachedRows )
+    {
+        m_state->queued.erase(queue.front());
+        queue.pop_front();
+    }
+}
+
+void wxDataViewAsyncVirtualListModel::DoStartFetching() const
+{
+    if ( m_state->running || m_state->queue.empty() )
+        return;
+
+    m_state->running = true;
+
+#if wxUSE_THREADS
+    const std::shared_ptr<SharedState> state = m_state;
+    m_pool->QueueTask([state]() { FetchRows(state); });
+#else // !wxUSE_THREADS
+    FetchRows(m_state);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+/* static */
+void
+wxDataViewAsyncVirtualListModel::FetchRows(const std::shared_ptr<SharedState>& state)
+{
+    for ( ;; )
+    {
+        unsigned int row,
+                     generation;
+        {
+#if wxUSE_THREADS
+            wxMutexLocker lock(state->mutex);
+#endif // wxUSE_THREADS
+
+            if ( state->queue.empty() || !state->notifier )
+            {
+                state->running = false;
+#if wxUSE_THREADS
+                state->condition.Broadcast();
+#endif // wxUSE_THREADS
+                return;
+            }
+
+            row = state->queue.back();
+            state->queue.pop_back();
+            generation = state->generation;
+        }
+
+        // Note that the values must not be referenced from this thread after
+        // passing them to the main one, as wxVariant reference counting is not
+        // thread-safe, which is why they're moved and not copied below.
+        wxVector<wxVariant> values;
+        state->fetcher(row, values);
+
+#if wxUSE_THREADS
+        wxMutexLocker lock(state->mutex);
+#endif // wxUSE_THREADS
+
+        // Discard the values if the cache was cleared while fetching them.
+        if ( generation != state->generation )
+            continue;
+
+        state->fetched.push_back(SharedState::FetchedRow{row, std::move(values)});
+
+        if ( !state->notifyPending && state->notifier )
+        {
+            state->notifyPending = true;
+            state->notifier->QueueEvent(new wxThreadEvent());
+        }
+    }
+}
+
+void wxDataViewAsyncVirtualListModel::OnRowsFetched()
+{
+    std::vector<SharedState::FetchedRow> fetched;
+    {
+#if wxUSE_THREADS
+        wxMutexLocker lock(m_state->mutex);
+#endif // wxUSE_THREADS
+
+        fetched.swap(m_state->fetched);
+        m_state->notifyPending = false;
+
+        for ( const auto& f : fetched )
+            m_state->queued.erase(f.row);
+    }
+
+    const unsigned int count = GetCount();
+
+    wxDataViewItemArray items;
+    for ( auto& f : fetched )
+    {
+        // The row could have been deleted since it was requested.
+        if ( f.row >= count )
+            continue;
+
+        m_cache[f.row] = std::move(f.values);
+        items.push_back(GetItem(f.row));
+    }
+
+    TrimCache();
+
+    // Refresh the rows showing the placeholders.
+    if ( !items.empty() )
+        ItemsChanged(items);
+}
+
+void wxDataViewAsyncVirtualListModel::TrimCache() const
+{
+    if ( m_cache.size() <= m_maxCachedRows )
+        return;
+
+    // Remove more rows than strictly necessary to avoid doing it every time
+    // a new row is added to the cache.
+    const size_t keep = m_maxCachedRows - m_maxCachedRows / 4;
+
+    std::vector<unsigned int> rows;
+    rows.reserve(m_cache.size());
+    for ( const auto& kv : m_cache )
+        rows.push_back(kv.first);
+
+    const unsigned int center = m_lastRequestedRow;
+    const auto distance = [center](unsigned int row)
+    {
+        return row > center ? row - center : center - row;
+    };
+
+    std::nth_element(rows.begin(), rows.begin() + keep, rows.end(),
+                     [distance](unsigned int row1, unsigned int row2)
+                     {
+                         return distance(row1) < distance(row2);
+                     });
+
+    for ( size_t n = keep; n < rows.size(); n++ )
+        m_cache.erase(rows[n]);
+}
+
 //-----------------------------------------------------------------------------
 // wxDataViewIconText
 //-----------------------------------------------------------------------------
@@ -46,7 +46,11 @@
 #include "wx/private/safecall.h"
 
 #if wxUSE_BASE
+    #include "wx/private/mpscqueue.h"
+
+    #include <deque>
     #include <memory>
+    #include <unordered_map>
 #endif // wxUSE_BASE
 
 #if wxUSE_GUI
@@ -1181,17 +1185,542 @@ void wxEventHashTable::GrowEventTypeTable()
     delete[] oldEventTypeTable;
 }
 
+// ----------------------------------------------------------------------------
+// wxPendingEventsQueue
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const wxEventType wxEVT_COALESCED_PLACEHOLDER = wxNewEventType();
+
+// The latest events queued by QueueEventCoalesced() for each key, which
+// haven't been taken from the queue yet. Its functions can be called from any
+// thread.
+class wxCoalescedEvents
+{
+public:
+    wxCoalescedEvents() = default;
+
+    ~wxCoalescedEvents()
+    {
+        DeleteAll();
+    }
+
+    // Store the event to be returned by Take() for the given key.
+    //
+    // Returns true if there was no undelivered event with this key yet, and
+    // so a new placeholder must be queued, or false if an existing event was
+    // replaced with the new one.
+    bool Store(wxEvent* event, const wxString& key)
+    {
+        wxEvent* old;
+        {
+            wxCRIT_SECT_LOCKER(lock, m_lock);
+
+            wxEvent*& slot = m_events[key];
+            old = slot;
+            slot = event;
+        }
+
+        if ( !old )
+            return true;
+
+        delete old;
+        return false;
+    }
+
+    // Return the event stored for this key, which can be null if it had been
+    // already taken or deleted.
+    wxEvent* Take(const wxString& key)
+    {
+        wxCRIT_SECT_LOCKER(lock, m_lock);
+
+        const auto it = m_events.find(key);
+        if ( it == m_events.end() )
+            return nullptr;
+
+        // Once we've taken the event, it can't be replaced any more and the
+        // next event with the same key will be queued normally.
+        wxEvent* const event = it->second;
+        m_events.erase(it);
+
+        return event;
+    }
+
+    void DeleteAll()
+    {
+        wxCRIT_SECT_LOCKER(lock, m_lock);
+
+        for ( const auto& kv : m_events )
+            delete kv.second;
+        m_events.clear();
+    }
+
+private:
+    std::unordered_map<wxString, wxEvent*> m_events;
+
+    wxCRIT_SECT_DECLARE_MEMBER(m_lock);
+
+    wxDECLARE_NO_COPY_CLASS(wxCoalescedEvents);
+};
+
+// This event is queued instead of the events passed to QueueEventCoalesced()
+// and is replaced by the latest event queued with the same key when it is
+// taken from the queue.
+//
+// Note that it may end up in the queue of another handler if QueueEvent() is
+// overridden to forward the events to it, which is why it keeps a reference
+// to the events of the handler which created it.
+class wxCoalescedEventPlaceholder : public wxEvent
+{
+public:
+    wxCoalescedEventPlaceholder(const std::shared_ptr<wxCoalescedEvents>& events,
+                                const wxString& key)
+        : wxEvent(0, wxEVT_COALESCED_PLACEHOLDER),
+          m_events(events),
+          m_key(key)
+    {
+    }
+
+    // Return the event this placeholder stands for, if any.
+    wxEvent* Resolve() const
+    {
+        return m_events->Take(m_key);
+    }
+
+    virtual wxEvent* Clone() const override
+    {
+        return new wxCoalescedEventPlaceholder(*this);
+    }
+
+private:
+    const std::shared_ptr<wxCoalescedEvents> m_events;
+    const wxString m_key;
+};
+
+} // anonymous namespace
+
+// Events can be queued from any thread without locking. They are normally
+// processed in the main thread only, but secondary threads running their own
+// event loop can process them too, so the consumer side functions are
+// serialized using a critical section as the underlying queue supports only a
+// single consumer.
+class wxPendingEventsQueue
+{
+public:
+    wxPendingEventsQueue() = default;
+
+    ~wxPendingEventsQueue()
+    {
+        DeleteAll();
+    }
+
+    // Can be called from any thread.
+    void Push(wxEvent* event)
+    {
+        m_incoming.Push(event);
+    }
+
+    // Store the event to be returned for the placeholder with the given key,
+    // can also be called from any thread.
+    //
+    // Returns the placeholder which must be queued if there was no
+    // undelivered event with this key yet, or null if an existing event was
+    // replaced with the new one.
+    wxEvent* StoreCoalesced(wxEvent* event, const wxString& key)
+    {
+        if ( !m_coalesced->Store(event, key) )
+            return nullptr;
+
+        return new wxCoalescedEventPlaceholder(m_coalesced, key);
+    }
+
+    // All the functions below lock m_consumerLock, so they can be called
+    // from any thread, but they're usually only called from the main one.
+
+    bool IsEmpty() const
+    {
+        wxCRIT_SECT_LOCKER(lock,
+                           const_cast<wxPendingEventsQueue*>(this)->m_consumerLock);
+
+        return m_skipped.empty() && m_incoming.IsEmpty();
+    }
+
+    // Return the oldest event which can be processed inside the given event
+    // loop (which may be null) or null if there are none.
+    wxEvent* TakeNext(wxEventLoopBase* evtLoop)
+    {
+        wxCRIT_SECT_LOCKER(lock, m_consumerLock);
+
+        const bool yielding = evtLoop && evtLoop->IsYielding();
+
+        // The skipped events are older than any events in the incoming queue,
+        // so check them first.
+        for ( auto it = m_skipped.begin(); it != m_skipped.end(); ++it )
+        {
+            wxEvent* const event = *it;
+            if ( !yielding ||
+                    evtLoop->IsEventAllowedInsideYield(event->GetEventCategory()) )
+            {
+                m_skipped.erase(it);
+                return event;
+            }
+        }
+
+        wxEvent* event;
+        while ( m_incoming.Pop(event) )
+        {
+            event = ResolveCoalesced(event);
+            if ( !event )
+                continue;
+
+            if ( !yielding ||
+                    evtLoop->IsEventAllowedInsideYield(event->GetEventCategory()) )
+                return event;
+
+            // Keep it for later, when we're not inside YieldFor() any more.
+            m_skipped.push_back(event);
+        }
+
+        return nullptr;
+    }
+
+    void DeleteAll()
+    {
+        wxCRIT_SECT_LOCKER(consumerLock, m_consumerLock);
+
+        for ( auto event : m_skipped )
+            delete event;
+        m_skipped.clear();
+
+        wxEvent* event;
+        while ( m_incoming.Pop(event) )
+            delete event;
+
+        m_coalesced->DeleteAll();
+    }
+
+private:
+    // If the event is a placeholder, return the event it stands for, which
+    // can be null if it had been already deleted, otherwise return the event
+    // itself.
+    wxEvent* ResolveCoalesced(wxEvent* event)
+    {
+        if ( event->GetEventType() != wxEVT_COALESCED_PLACEHOLDER )
+            return event;
+
+        std::unique_ptr<wxCoalescedEventPlaceholder>
+            placeholder(static_cast<wxCoalescedEventPlaceholder*>(event));
+
+        return placeholder->Resolve();
+    }
+
+
+    // Events queued by QueueEvent() and not examined yet.
+    wxMPSCQueue<wxEvent*> m_incoming;
+
+    // Events which couldn't be processed during a previous YieldFor() call.
+    std::deque<wxEvent*> m_skipped;
+
+    // The latest events queued by QueueEventCoalesced(), shared with the
+    // placeholders referring to them.
+    const std::shared_ptr<wxCoalescedEvents>
+        m_coalesced{std::make_shared<wxCoalescedEvents>()};
+
+    // Serializes the consumers, see the comment before this class.
+    wxCRIT_SECT_DECLARE_MEMBER(m_consumerLock);
+
+    wxDECLARE_NO_COPY_CLASS(wxPendingEventsQueue);
+};
+
+// ----------------------------------------------------------------------------
+// wxDynamicEventTable
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// All handlers bound to the same event type.
+//
+// Handlers are stored in the order of binding and when there are many of them
+// an index by their id is built, allowing to find the ones matching the given
+// event without examining all the others.
+struct wxDynamicEventTypeEntries
+{
+    // Minimal number of handlers for which the index is built.
+    static const size_t MIN_ENTRIES_FOR_INDEX = 16;
+
+    void Add(wxDynamicEventTableEntry* entry)
+    {
+        entries.push_back(entry);
+
+        if ( hasIndex )
+            AddToIndex(entries.size() - 1);
+        else if ( entries.size() >= MIN_ENTRIES_FOR_INDEX )
+            BuildIndex();
+    }
+
+    void Remove(wxDynamicEventTableEntry* entry)
+    {
+        // Just as in the main table, only reset the entry to null and really
+        // remove it later, in Prune().
+        for ( size_t n = entries.size(); n; n-- )
+        {
+            if ( entries[n - 1] == entry )
+            {
+                entries[n - 1] = nullptr;
+                numRemoved++;
+                return;
+            }
+        }
+
+        wxFAIL_MSG( "unknown dynamic event table entry" );
+    }
+
+    void Prune()
+    {
+        size_t nNew = 0;
+        for ( size_t n = 0; n != entries.size(); n++ )
+        {
+            if ( entries[n] )
+                entries[nNew++] = entries[n];
+        }
+
+        entries.resize(nNew);
+        numRemoved = 0;
+
+        // Positions of the entries have changed, so the index is invalid.
+        byId.clear();
+        anyId.clear();
+        hasIndex = false;
+
+        if ( entries.size() >= MIN_ENTRIES_FOR_INDEX )
+            BuildIndex();
+    }
+
+    void BuildIndex()
+    {
+        for ( size_t n = 0; n != entries.size(); n++ )
+        {
+            if ( entries[n] )
+                AddToIndex(n);
+        }
+
+        hasIndex = true;
+    }
+
+    void AddToIndex(size_t n)
+    {
+        const wxDynamicEventTableEntry* const entry = entries[n];
+
+        // Only handlers for a single id can be indexed, the others are
+        // checked for all events.
+        if ( entry->m_id != wxID_ANY &&
+                (entry->m_lastId == wxID_ANY || entry->m_lastId == entry->m_id) )
+            byId[entry->m_id].push_back(n);
+        else
+            anyId.push_back(n);
+    }
+
+    // The handlers in the order of binding, with null pointers for the
+    // handlers which were unbound but not removed yet.
+    wxVector<wxDynamicEventTableEntry*> entries;
+
+    // Positions in entries of the handlers for the given id and of all the
+    // others, both in increasing order. Only used if hasIndex is true.
+    std::unordered_map<int, wxVector<size_t>> byId;
+    wxVector<size_t> anyId;
+
+    // Number of null elements in entries.
+    size_t numRemoved = 0;
+
+    bool hasIndex = false;
+};
+
+} // anonymous namespace
+
+// This object is reference-counted to ensure that it remains alive while
+// searching it, even if the event handler owning it is destroyed by one of the
+// handlers called during the search, and to avoid modifying it while any
+// search is in progress.
+class wxDynamicEventTable : public wxRefCounter
+{
+public:
+    wxDynamicEventTable() = default;
+
+    // Get all the entries in the order of binding, with null pointers for the
+    // unbound ones.
+    const wxVector<wxDynamicEventTableEntry*>& GetAll() const { return m_all; }
+
+    void Add(wxDynamicEventTableEntry* entry)
+    {
+        m_all.push_back(entry);
+        m_byType[entry->m_eventType].Add(entry);
+    }
+
+    // Remove the entry at the given position in GetAll(), this doesn't delete
+    // the entry itself.
+    void RemoveAt(size_t n)
+    {
+        wxDynamicEventTableEntry* const entry = m_all[n];
+        m_all[n] = nullptr;
+        m_numRemoved++;
+
+        const auto it = m_byType.find(entry->m_eventType);
+        wxCHECK_RET( it != m_byType.end(), "unknown dynamic event type" );
+
+        it->second.Remove(entry);
+    }
+
+    // Call the handlers matching the given event until one of them processes
+    // it, in the reverse order of binding.
+    bool Search(wxEvtHandler* owner, wxEvent& event)
+    {
+        const auto it = m_byType.find(event.GetEventType());
+        if ( it == m_byType.end() )
+            return false;
+
+        // Note that this reference remains valid even if new elements are
+        // added to m_byType by the handlers we call, and none are removed
+        // while we hold a reference to this object.
+        wxDynamicEventTypeEntries& typeEntries = it->second;
+
+        IncRef();
+
+        const bool processed = typeEntries.hasIndex
+                                ? SearchIndexed(owner, typeEntries, event)
+                                : SearchAll(owner, typeEntries, event);
+        // If ours is the only remaining reference, the owner was destroyed by
+        // one of the handlers and this object is going to be deleted now.
+        const bool ownerDestroyed = GetRefCount() == 1;
+
+        DecRef();
+
+        if ( processed || ownerDestroyed )
+            return processed;
+
+        // Get rid of the unbound entries, but only if we're not called from
+        // inside another search, as this would invalidate its state.
+        if ( m_numRemoved && GetRefCount() == 1 )
+            Prune();
+
+        return false;
+    }
+
+private:
+    static bool ProcessEntry(wxEvtHandler* owner,
+                             const wxDynamicEventTableEntry* entry,
+                             wxEvent& event)
+    {
+        wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
+        if ( !handler )
+           handler = owner;
+
+        return wxEvtHandler::ProcessEventIfMatchesId(*entry, handler, event);
+    }
+
+    // Note that the functions below must access the vectors only using
+    // indices, as they may be modified by the handlers called from them.
+    // However any elements added to them by these handlers are not used.
+
+    static bool SearchAll(wxEvtHandler* owner,
+                          wxDynamicEventTypeEntries& typeEntries,
+                          wxEvent& event)
+    {
+        for ( size_t n = typeEntries.entries.size(); n; n-- )
+        {
+            const wxDynamicEventTableEntry* const
+                entry = typeEntries.entries[n - 1];
+            if ( entry && ProcessEntry(owner, entry, event) )
+                return true;
+        }
+
+        return false;
+    }
+
+    static bool SearchIndexed(wxEvtHandler* owner,
+                              wxDynamicEventTypeEntries& typeEntries,
+                              wxEvent& event)
+    {
+        const wxVector<size_t>* byId = nullptr;
+        const auto it = typeEntries.byId.find(event.GetId());
+        if ( it != typeEntries.byId.end() )
+            byId = &it->second;
+
+        const wxVector<size_t>& anyId = typeEntries.anyId;
+
+        // Merge both lists of positions to process the handlers in the same
+        // order as when not using the index.
+        size_t i = byId ? byId->size() : 0,
+               j = anyId.size();
+        while ( i || j )
+        {
+            size_t pos;
+            if ( i && (!j || (*byId)[i - 1] > anyId[j - 1]) )
+                pos = (*byId)[--i];
+            else
+                pos = anyId[--j];
+
+            const wxDynamicEventTableEntry* const
+                entry = typeEntries.entries[pos];
+            if ( entry && ProcessEntry(owner, entry, event) )
+                return true;
+        }
+
+        return false;
+    }
+
+    void Prune()
+    {
+        size_t nNew = 0;
+        for ( size_t n = 0; n != m_all.size(); n++ )
+        {
+            if ( m_all[n] )
+                m_all[nNew++] = m_all[n];
+        }
+
+        m_all.resize(nNew);
+        m_numRemoved = 0;
+
+        for ( auto it = m_byType.begin(); it != m_byType.end(); )
+        {
+            wxDynamicEventTypeEntries& typeEntries = it->second;
+            if ( typeEntries.numRemoved == typeEntries.entries.size() )
+            {
+                it = m_byType.erase(it);
+                continue;
+            }
+
+            if ( typeEntries.numRemoved )
+                typeEntries.Prune();
+
+            ++it;
+        }
+    }
+
+
+    wxVector<wxDynamicEventTableEntry*> m_all;
+    std::unordered_map<int, wxDynamicEventTypeEntries> m_byType;
+
+    // Number of null elements in m_all.
+    size_t m_numRemoved = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxDynamicEventTable);
+};
+
 // ----------------------------------------------------------------------------
 // wxEvtHandler
 // ----------------------------------------------------------------------------
 
 wxEvtHandler::wxEvtHandler()
+    : m_pendingEvents(nullptr),
+      m_isInPendingHandlers(false)
 {
     m_nextHandler = nullptr;
     m_previousHandler = nullptr;
     m_enabled = true;
     m_dynamicEvents = nullptr;
-    m_pendingEvents = nullptr;
 
     // no client data (yet)
     m_clientData = nullptr;
@@ -1223,10 +1752,17 @@ wxEvtHandler::~wxEvtHandler()
                 }
             }
 
+            // The table may be still used if we're being destroyed from an
+            // event handler, so don't leave dangling pointers in it.
+            m_dynamicEvents->RemoveAt(cookie);
+
             delete entry->m_callbackUserData;
             delete entry;
         }
-        delete m_dynamicEvents;
+
+        // Note that this may not delete the table if it's currently being
+        // searched, see SearchDynamicEventTable().
+        m_dynamicEvents->DecRef();
     }
 
     // Remove us from the list of the pending events if necessary.
@@ -1234,6 +1770,7 @@ wxEvtHandler::~wxEvtHandler()
         wxTheApp->RemovePendingEventHandler(this);
 
     DeletePendingEvents();
+    delete m_pendingEvents.load();
 
     // we only delete object data, not untyped
     if ( m_clientDataType == wxClientData_Object )
@@ -1314,6 +1851,24 @@ bool wxEvtHandler::ProcessThreadEvent(const wxEvent& event)
 
 #endif // wxUSE_THREADS
 
+wxPendingEventsQueue* wxEvtHandler::GetOrCreatePendingEventsQueue()
+{
+    // Create the queue if this is the first event ever queued for this
+    // handler: as this may happen in several threads simultaneously, only one
+    // of them wins.
+    wxPendingEventsQueue* queue = m_pendingEvents.load();
+    if ( !queue )
+    {
+        wxPendingEventsQueue* const newQueue = new wxPendingEventsQueue;
+        if ( m_pendingEvents.compare_exchange_strong(queue, newQueue) )
+            queue = newQueue;
+        else
+            delete newQueue; // queue was updated to the existing one
+    }
+
+    return queue;
+}
+
 void wxEvtHandler::QueueEvent(wxEvent *event)
 {
     wxCHECK_RET( event, "null event can't be posted" );
@@ -1330,37 +1885,55 @@ void wxEvtHandler::QueueEvent(wxEvent *event)
         return;
     }
 
-    // 1) Add this event to our list of pending events
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    // 1) Add this event to our queue of pending events.
+    GetOrCreatePendingEventsQueue()->Push(event);
 
-    if ( !m_pendingEvents )
-        m_pendingEvents = new wxList;
+    // 2) Add this event handler to list of event handlers that have pending
+    //    events, unless it's already there.
+    //
+    //    Note that this must be done after adding the event to the queue to
+    //    avoid the race condition described in the ticket #9093: we must never
+    //    have pending events without being in wxHandlersWithPendingEvents list
+    //    as they would never be processed then. See ProcessPendingEvents() for
+    //    the other side of this logic.
+    if ( !m_isInPendingHandlers.exchange(true) )
+        wxTheApp->AppendPendingEventHandler(this);
 
-    m_pendingEvents->Append(event);
+    // 3) Inform the system that new pending events are somewhere,
+    //    and that these should be processed in idle time.
+    wxWakeUpIdle();
+}
+
+void wxEvtHandler::QueueEventCoalesced(wxEvent *event, const wxString& key)
+{
+    wxCHECK_RET( event, "null event can't be posted" );
 
-    // 2) Add this event handler to list of event handlers that
-    //    have pending events.
+    if (!wxTheApp)
+    {
+        wxLogDebug("No application object! Cannot queue this event!");
 
-    wxTheApp->AppendPendingEventHandler(this);
+        delete event;
 
-    // only release m_pendingEventsLock now because otherwise there is a race
-    // condition as described in the ticket #9093: we could process the event
-    // just added to m_pendingEvents in our ProcessPendingEvents() below before
-    // we had time to append this pointer to wxHandlersWithPendingEvents list; thus
-    // breaking the invariant that a handler should be in the list iff it has
-    // any pending events to process
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+        return;
+    }
 
-    // 3) Inform the system that new pending events are somewhere,
-    //    and that these should be processed in idle time.
-    wxWakeUpIdle();
+    // If there is already an event with this key in the queue, it's enough to
+    // replace it with the new one and it will be processed in its place.
+    // Otherwise queue the placeholder using the virtual QueueEvent() to allow
+    // overriding it in the derived classes.
+    wxEvent* const
+        placeholder = GetOrCreatePendingEventsQueue()->StoreCoalesced(event, key);
+    if ( placeholder )
+        QueueEvent(placeholder);
 }
 
 void wxEvtHandler::DeletePendingEvents()
 {
-    if (m_pendingEvents)
-        m_pendingEvents->DeleteContents(true);
-    wxDELETE(m_pendingEvents);
+    wxPendingEventsQueue* const queue = m_pendingEvents.load();
+    if ( queue )
+        queue->DeleteAll();
+
+    m_isInPendingHandlers = false;
 }
 
 void wxEvtHandler::ProcessPendingEvents()
@@ -1377,55 +1950,53 @@ void wxEvtHandler::ProcessPendingEvents()
     // each call to ProcessEvent() could result in the destruction of this
     // same event handler (see the comment at the end of this function)
 
-    wxENTER_CRIT_SECT( m_pendingEventsLock );
+    wxPendingEventsQueue* const queue = m_pendingEvents.load();
 
     // this method is only called by wxApp if this handler does have
     // pending events
-    wxCHECK_RET( m_pendingEvents && !m_pendingEvents->IsEmpty(),
-                 "should have pending events if called" );
+    wxCHECK_RET( queue, "should have pending events if called" );
 
-    wxList::compatibility_iterator node = m_pendingEvents->GetFirst();
-    wxEvent* pEvent = static_cast<wxEvent *>(node->GetData());
+    // find the first event which can be processed now: notice that it's
+    // important we remove event from the queue before processing it, else a
+    // nested event loop, for example from a modal dialog, might process the
+    // same event again.
+    wxEventLoopBase* const evtLoop = wxEventLoopBase::GetActive();
+    std::unique_ptr<wxEvent> event(queue->TakeNext(evtLoop));
 
-    // find the first event which can be processed now:
-    wxEventLoopBase* evtLoop = wxEventLoopBase::GetActive();
-    if (evtLoop && evtLoop->IsYielding())
+    if ( !event && !queue->IsEmpty() )
     {
-        while (node && pEvent && !evtLoop->IsEventAllowedInsideYield(pEvent->GetEventCategory()))
-        {
-            node = node->GetNext();
-            pEvent = node ? static_cast<wxEvent *>(node->GetData()) : nullptr;
-        }
-
-        if (!node)
-        {
-            // all our events are NOT processable now... signal this:
-            wxTheApp->DelayPendingEventHandler(this);
+        // Either all our events are NOT processable now because we're inside
+        // YieldFor() (see the comment at the beginning of evtloop.h header for
+        // the logic behind it and behind DelayPendingEventHandler()), or the
+        // event is still being queued by another thread. In both cases, we
+        // need to postpone processing the events until the next call, as
+        // otherwise wxApp::ProcessPendingEvents() would keep calling us in a
+        // busy loop.
+        wxTheApp->DelayPendingEventHandler(this);
 
-            // see the comment at the beginning of evtloop.h header for the
-            // logic behind YieldFor() and behind DelayPendingEventHandler()
-
-            wxLEAVE_CRIT_SECT( m_pendingEventsLock );
-
-            return;
-        }
+        return;
     }
 
-    std::unique_ptr<wxEvent> event(pEvent);
-
-    // it's important we remove event from list before processing it, else a
-    // nested event loop, for example from a modal dialog, might process the
-    // same event again.
-    m_pendingEvents->Erase(node);
-
-    if ( m_pendingEvents->IsEmpty() )
+    if ( queue->IsEmpty() )
     {
         // if there are no more pending events left, we don't need to
         // stay in this list
         wxTheApp->RemovePendingEventHandler(this);
+        m_isInPendingHandlers = false;
+
+        // but an event could have been queued by another thread after we
+        // checked for it above but before resetting the flag, in which case
+        // QueueEvent() didn't add us to the list and we must do it ourselves
+        // (unless QueueEvent() has done it after we reset the flag)
+        if ( !queue->IsEmpty() && !m_isInPendingHandlers.exchange(true) )
+            wxTheApp->AppendPendingEventHandler(this);
     }
 
-    wxLEAVE_CRIT_SECT( m_pendingEventsLock );
+    // We can also be called without any events if QueueEvent() in another
+    // thread added us to the list only after we had already processed the
+    // event it queued, this is harmless.
+    if ( !event )
+        return;
 
     // We must not let exceptions escape from here, there is no outer exception
     // handler to catch them and so letting them do it would just terminate the
@@ -1781,12 +2352,12 @@ void wxEvtHandler::DoBind(int id,
     }
 
     if (!m_dynamicEvents)
-        m_dynamicEvents = new DynamicEvents;
+        m_dynamicEvents = new wxDynamicEventTable;
 
     // We prefer to push back the entry here and then iterate over the vector
     // in reverse direction in GetNextDynamicEntry() as it's more efficient
     // than inserting the element at the front.
-    m_dynamicEvents->push_back(entry);
+    m_dynamicEvents->Add(entry);
 
     // Make sure we get to know when a sink is destroyed
     wxEvtHandler *eventSink = func->GetEvtHandler();
@@ -1840,7 +2411,7 @@ wxEvtHandler::DoUnbind(int id,
             // Notice that we rely on "cookie" being just the index into the
             // vector, which is not guaranteed by our API, but here we can use
             // this implementation detail.
-            (*m_dynamicEvents)[cookie] = nullptr;
+            m_dynamicEvents->RemoveAt(cookie);
 
             delete entry;
             return true;
@@ -1856,7 +2427,7 @@ wxEvtHandler::GetFirstDynamicEntry(size_t& cookie) const
         return nullptr;
 
     // The handlers are in LIFO order, so we must start at the end.
-    cookie = m_dynamicEvents->size();
+    cookie = m_dynamicEvents->GetAll().size();
     return GetNextDynamicEntry(cookie);
 }
 
@@ -1869,7 +2440,8 @@ wxEvtHandler::GetNextDynamicEntry(size_t& cookie) const
     {
         // Otherwise return the element at the previous index, skipping any
         // null elements which indicate removed entries.
-        wxDynamicEventTableEntry* const entry = m_dynamicEvents->at(--cookie);
+        wxDynamicEventTableEntry* const
+            entry = m_dynamicEvents->GetAll().at(--cookie);
         if ( entry )
             return entry;
     }
@@ -1882,66 +2454,10 @@ bool wxEvtHandler::SearchDynamicEventTable( wxEvent& event )
     wxCHECK_MSG( m_dynamicEvents, false,
                  wxT("caller should check that we have dynamic events") );
 
-    DynamicEvents& dynamicEvents = *m_dynamicEvents;
-
-    bool needToPruneDeleted = false;
-
-    // We can't use Get{First,Next}DynamicEntry() here as they hide the deleted
-    // but not yet pruned entries from the caller, but here we do want to know
-    // about them, so iterate directly. Remember to do it in the reverse order
-    // to honour the order of handlers connection.
-    for ( size_t n = dynamicEvents.size(); n; n-- )
-    {
-        wxDynamicEventTableEntry* const entry = dynamicEvents[n - 1];
-
-        if ( !entry )
-        {
-            // This entry must have been unbound at some time in the past, so
-            // skip it now and really remove it from the vector below, once we
-            // finish iterating.
-            needToPruneDeleted = true;
-            continue;
-        }
-
-        if ( event.GetEventType() == entry->m_eventType )
-        {
-            wxEvtHandler *handler = entry->m_fn->GetEvtHandler();
-            if ( !handler )
-               handler = this;
-            if ( ProcessEventIfMatchesId(*entry, handler, event) )
-            {
-                // It's important to skip pruning of the unbound event entries
-                // below because this object itself could have been deleted by
-                // the event handler making m_dynamicEvents a dangling pointer
-                // which can't be accessed any longer in the code below.
-                //
-                // In practice, it hopefully shouldn't be a problem to wait
-                // until we get an event that we don't handle before pruning
-                // because this should happen soon enough and even if it
-                // doesn't the worst possible outcome is slightly increased
-                // memory consumption while not skipping pruning can result in
-                // hard to reproduce (because they require the disconnection
-                // and deletion happen at the same time which is not always the
-                // case) crashes.
-                return true;
-            }
-        }
-    }
-
-    if ( needToPruneDeleted )
-    {
-        size_t nNew = 0;
-        for ( size_t n = 0; n != dynamicEvents.size(); n++ )
-        {
-            if ( dynamicEvents[n] )
-                dynamicEvents[nNew++] = dynamicEvents[n];
-        }
-
-        wxASSERT( nNew != dynamicEvents.size() );
-        dynamicEvents.resize(nNew);
-    }
-
-    return false;
+    // Notice that we can't access any of our fields after calling this
+    // function if it returns true, as this object could have been deleted by
+    // the event handler.
+    return m_dynamicEvents->Search(this, event);
 }
 
 void wxEvtHandler::DoSetClientObject( wxClientData *data )
@@ -2014,12 +2530,12 @@ void wxEvtHandler::OnSinkDestroyed( wxEvtHandler *sink )
     {
         if ( entry->m_fn->GetEvtHandler() == sink )
         {
-            delete entry->m_callbackUserData;
-            delete entry;
-
             // Just as in DoUnbind(), we use our knowledge of
             // GetNextDynamicEntry() implementation here.
-            (*m_dynamicEvents)[cookie] = nullptr;
+            m_dynamicEvents->RemoveAt(cookie);
+
+            delete entry->m_callbackUserData;
+            delete entry;
         }
     }
 }
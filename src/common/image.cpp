@@ -26,10 +26,14 @@
 
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
+#include "wx/private/threadpool.h"
 
 // For memcpy
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <unordered_set>
 
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
@@ -131,6 +135,51 @@ wxImageRefData::~wxImageRefData()
 }
 
 
+//-----------------------------------------------------------------------------
+// image processing helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// Maximal number of threads used for processing images, see
+// wxImage::SetMaxProcessingThreads(). This is atomic because it can be changed
+// while other threads are processing images.
+std::atomic<unsigned> gs_maxProcessingThreads(1);
+
+// Call func(start, end) for the bands of rows (or columns) covering the range
+// [0, count), where each of them contains lineLength pixels, either serially
+// or in parallel, if this is enabled and the image is big enough for it to be
+// worth it.
+//
+// Note that func() is supposed to produce the same results independently of
+// how is the range split, so that parallel processing is deterministic.
+void
+ProcessImageBands(int count,
+                  int lineLength,
+                  const std::function<void(int, int)>& func)
+{
+#if wxUSE_THREADS
+    // Don't bother with using threads for images smaller than this, as the
+    // overhead of using them would outweigh any gains.
+    static const wxLongLong_t MIN_PIXELS_FOR_THREADS = 256*256;
+
+    const unsigned maxThreads = gs_maxProcessingThreads.load();
+    if ( maxThreads != 1 &&
+            static_cast<wxLongLong_t>(count)*lineLength >= MIN_PIXELS_FOR_THREADS )
+    {
+        wxThreadPool::Get().ParallelFor(count, static_cast<int>(maxThreads), func);
+        return;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(lineLength);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    func(0, count);
+}
+
+} // anonymous namespace
+
 //-----------------------------------------------------------------------------
 // wxImage
 //-----------------------------------------------------------------------------
@@ -439,6 +488,20 @@ wxImage wxImage::ShrinkBy( int xFactor , int yFactor ) const
     return image;
 }
 
+/* static */
+void wxImage::SetMaxProcessingThreads(int numThreads)
+{
+    wxCHECK_RET( numThreads >= 0, "invalid number of threads" );
+
+    gs_maxProcessingThreads = static_cast<unsigned>(numThreads);
+}
+
+/* static */
+int wxImage::GetMaxProcessingThreads()
+{
+    return static_cast<int>(gs_maxProcessingThreads.load());
+}
+
 wxImage
 wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
 {
@@ -577,30 +640,36 @@ wxImage wxImage::ResampleNearest(int width, int height) const
     const wxUIntPtr x_delta = (old_width  << 16) / width;
     const wxUIntPtr y_delta = (old_height << 16) / height;
 
-    unsigned char* dest_pixel = target_data;
-
-    wxUIntPtr y = y_delta / 2;
-    for (int j = 0; j < height; j++)
+    ProcessImageBands(height, width,
+    [=](int yStart, int yEnd)
     {
-        const unsigned char* src_line = &source_data[(y>>16)*old_width*3];
-        const unsigned char* src_alpha_line = source_alpha ? &source_alpha[(y>>16)*old_width] : nullptr ;
+        unsigned char* dest_pixel = target_data + 3*yStart*width;
+        unsigned char* dest_alpha = target_alpha ? target_alpha + yStart*width
+                                                 : nullptr;
 
-        wxUIntPtr x = x_delta / 2;
-        for (int i = 0; i < width; i++)
+        wxUIntPtr y = y_delta / 2 + yStart*y_delta;
+        for (int j = yStart; j < yEnd; j++)
         {
-            const unsigned char* src_pixel = &src_line[(x>>16)*3];
-            const unsigned char* src_alpha_pixel = source_alpha ? &src_alpha_line[(x>>16)] : nullptr ;
-            dest_pixel[0] = src_pixel[0];
-            dest_pixel[1] = src_pixel[1];
-            dest_pixel[2] = src_pixel[2];
-            dest_pixel += 3;
-            if ( source_alpha )
-                *(target_alpha++) = *src_alpha_pixel ;
-            x += x_delta;
-        }
+            const unsigned char* src_line = &source_data[(y>>16)*old_width*3];
+            const unsigned char* src_alpha_line = source_alpha ? &source_alpha[(y>>16)*old_width] : nullptr ;
 
-        y += y_delta;
-    }
+            wxUIntPtr x = x_delta / 2;
+            for (int i = 0; i < width; i++)
+            {
+                const unsigned char* src_pixel = &src_line[(x>>16)*3];
+                const unsigned char* src_alpha_pixel = source_alpha ? &src_alpha_line[(x>>16)] : nullptr ;
+                dest_pixel[0] = src_pixel[0];
+                dest_pixel[1] = src_pixel[1];
+                dest_pixel[2] = src_pixel[2];
+                dest_pixel += 3;
+                if ( source_alpha )
+                    *(dest_alpha++) = *src_alpha_pixel ;
+                x += x_delta;
+            }
+
+            y += y_delta;
+        }
+    });
 
     return image;
 }
@@ -657,6 +726,114 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
     }
 }
 
+// Helper of ResampleBox(): computes the destination row corresponding to the
+// given vertical box. The sums of all the pixels in the boxes are accumulated
+// separately in each direction, first horizontally for each source row and
+// then vertically for all rows of the box, which is much faster than summing
+// up the entire box for each destination pixel and produces exactly the same
+// results as integer sums are exact.
+//
+// The sums vector must have 4*width elements.
+template <bool hasAlpha>
+void
+DoResampleBoxRow(const unsigned char* src_data,
+                 const unsigned char* src_alpha,
+                 size_t srcWidth,
+                 const BoxPrecalc& vPrecalc,
+                 const wxVector<BoxPrecalc>& hPrecalcs,
+                 wxVector<wxUint64>& sums,
+                 unsigned char* dst_data,
+                 unsigned char* dst_alpha)
+{
+    const size_t width = hPrecalcs.size();
+
+    std::fill(sums.begin(), sums.end(), 0);
+
+    for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
+    {
+        const unsigned char* const src_line = src_data + 3*j*srcWidth;
+        const unsigned char* const src_alpha_line = hasAlpha
+                                                        ? src_alpha + j*srcWidth
+                                                        : nullptr;
+
+        wxUint64* sum = &sums[0];
+        for ( size_t x = 0; x < width; ++x, sum += 4 )
+        {
+            const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+            wxUint64 sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+            for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
+            {
+                const unsigned char* const src_pixel = src_line + 3*i;
+
+                if ( hasAlpha )
+                {
+                    const unsigned a = src_alpha_line[i];
+                    sum_r += src_pixel[0] * a;
+                    sum_g += src_pixel[1] * a;
+                    sum_b += src_pixel[2] * a;
+                    sum_a += a;
+                }
+                else
+                {
+                    sum_r += src_pixel[0];
+                    sum_g += src_pixel[1];
+                    sum_b += src_pixel[2];
+                }
+            }
+
+            sum[0] += sum_r;
+            sum[1] += sum_g;
+            sum[2] += sum_b;
+            sum[3] += sum_a;
+        }
+    }
+
+    const int averaged_rows = vPrecalc.boxEnd - vPrecalc.boxStart + 1;
+
+    const wxUint64* sum = &sums[0];
+    for ( size_t x = 0; x < width; ++x, sum += 4 )
+    {
+        const BoxPrecalc& hPrecalc = hPrecalcs[x];
+
+        // Box of pixels to average
+        const int averaged_pixels = averaged_rows
+                                    * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
+
+        // Note that the sums are converted to double before dividing them to
+        // get the same rounding as before (the conversion itself is exact).
+        const double sum_r = static_cast<double>(sum[0]);
+        const double sum_g = static_cast<double>(sum[1]);
+        const double sum_b = static_cast<double>(sum[2]);
+
+        // Calculate the average from the sum and number of averaged pixels
+        if ( hasAlpha )
+        {
+            const double sum_a = static_cast<double>(sum[3]);
+            if ( sum_a != 0 )
+            {
+                dst_data[0] = (unsigned char)(sum_r / sum_a);
+                dst_data[1] = (unsigned char)(sum_g / sum_a);
+                dst_data[2] = (unsigned char)(sum_b / sum_a);
+            }
+            else
+            {
+                dst_data[0] = 0;
+                dst_data[1] = 0;
+                dst_data[2] = 0;
+            }
+            *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
+        }
+        else
+        {
+            dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
+            dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
+            dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
+        }
+        dst_data += 3;
+    }
+}
+
 } // anonymous namespace
 
 wxImage wxImage::ResampleBox(int width, int height) const
@@ -690,73 +867,37 @@ wxImage wxImage::ResampleBox(int width, int height) const
         dst_alpha = ret_image.GetAlpha();
     }
 
-    int averaged_pixels, src_pixel_index;
-    double sum_r, sum_g, sum_b, sum_a;
+    const size_t srcWidth = M_IMGDATA->m_width;
 
-    for ( int y = 0; y < height; y++ )         // Destination image - Y direction
+    ProcessImageBands(height, width,
+    [&](int yStart, int yEnd)
     {
-        // Source pixel in the Y direction
-        const BoxPrecalc& vPrecalc = vPrecalcs[y];
-
-        for ( int x = 0; x < width; x++ )      // Destination image - X direction
-        {
-            // Source pixel in the X direction
-            const BoxPrecalc& hPrecalc = hPrecalcs[x];
-
-            // Box of pixels to average
-            averaged_pixels = (vPrecalc.boxEnd - vPrecalc.boxStart + 1)
-                                * (hPrecalc.boxEnd - hPrecalc.boxStart + 1);
-            sum_r = sum_g = sum_b = sum_a = 0.0;
+        // Per-column sums of all channels for the current destination row.
+        wxVector<wxUint64> sums(4*width);
 
-            for ( int j = vPrecalc.boxStart; j <= vPrecalc.boxEnd; ++j )
-            {
-                for ( int i = hPrecalc.boxStart; i <= hPrecalc.boxEnd; ++i )
-                {
-                    // Calculate the actual index in our source pixels
-                    src_pixel_index = j * M_IMGDATA->m_width + i;
+        unsigned char* dst_line = dst_data + 3*yStart*width;
+        unsigned char* dst_alpha_line = dst_alpha ? dst_alpha + yStart*width
+                                                  : nullptr;
 
-                    if (src_alpha)
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * src_alpha[src_pixel_index];
-                        sum_g += src_data[src_pixel_index * 3 + 1] * src_alpha[src_pixel_index];
-                        sum_b += src_data[src_pixel_index * 3 + 2] * src_alpha[src_pixel_index];
-                        sum_a += src_alpha[src_pixel_index];
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0];
-                        sum_g += src_data[src_pixel_index * 3 + 1];
-                        sum_b += src_data[src_pixel_index * 3 + 2];
-                    }
-                }
-            }
-
-            // Calculate the average from the sum and number of averaged pixels
-            if (src_alpha)
+        for ( int y = yStart; y < yEnd; y++ )  // Destination image - Y direction
+        {
+            if ( src_alpha )
             {
-                if (sum_a != 0)
-                {
-                    dst_data[0] = (unsigned char)(sum_r / sum_a);
-                    dst_data[1] = (unsigned char)(sum_g / sum_a);
-                    dst_data[2] = (unsigned char)(sum_b / sum_a);
-                }
-                else
-                {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
-                }
-                *dst_alpha++ = (unsigned char)(sum_a / averaged_pixels);
+                DoResampleBoxRow<true>(src_data, src_alpha, srcWidth,
+                                       vPrecalcs[y], hPrecalcs, sums,
+                                       dst_line, dst_alpha_line);
+                dst_alpha_line += width;
             }
             else
             {
-                dst_data[0] = (unsigned char)(sum_r / averaged_pixels);
-                dst_data[1] = (unsigned char)(sum_g / averaged_pixels);
-                dst_data[2] = (unsigned char)(sum_b / averaged_pixels);
+                DoResampleBoxRow<false>(src_data, nullptr, srcWidth,
+                                        vPrecalcs[y], hPrecalcs, sums,
+                                        dst_line, nullptr);
             }
-            dst_data += 3;
+
+            dst_line += 3*width;
         }
-    }
+    });
 
     return ret_image;
 }
@@ -819,6 +960,47 @@ void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
     }
 }
 
+// Helper of ResampleBilinear(): interpolates the given source row in the
+// horizontal direction and stores the results, 4 values (RGBA) per
+// destination pixel, in the provided line. As consecutive destination rows
+// typically use the same source rows, this allows reusing the results of
+// horizontal interpolation instead of recomputing them for every pixel.
+template <bool hasAlpha>
+void
+DoBilinearInterpolateRow(const unsigned char* src_data,
+                         const unsigned char* src_alpha,
+                         size_t srcWidth,
+                         int srcRow,
+                         const wxVector<BilinearPrecalc>& hPrecalcs,
+                         wxVector<double>& line)
+{
+    const unsigned char* const src_line = src_data + 3*srcRow*srcWidth;
+    const unsigned char* const src_alpha_line = hasAlpha
+                                                    ? src_alpha + srcRow*srcWidth
+                                                    : nullptr;
+
+    const size_t width = hPrecalcs.size();
+    double* dst = &line[0];
+    for ( size_t x = 0; x < width; ++x, dst += 4 )
+    {
+        const BilinearPrecalc& hPrecalc = hPrecalcs[x];
+
+        const int x_offset1 = hPrecalc.offset1;
+        const int x_offset2 = hPrecalc.offset2;
+        const double dx = hPrecalc.dd;
+        const double dx1 = hPrecalc.dd1;
+
+        const unsigned char* const src_pixel1 = src_line + 3*x_offset1;
+        const unsigned char* const src_pixel2 = src_line + 3*x_offset2;
+
+        dst[0] = src_pixel1[0] * dx1 + src_pixel2[0] * dx;
+        dst[1] = src_pixel1[1] * dx1 + src_pixel2[1] * dx;
+        dst[2] = src_pixel1[2] * dx1 + src_pixel2[2] * dx;
+        if ( hasAlpha )
+            dst[3] = src_alpha_line[x_offset1] * dx1 + src_alpha_line[x_offset2] * dx;
+    }
+}
+
 } // anonymous namespace
 
 wxImage wxImage::ResampleBilinear(int width, int height) const
@@ -845,61 +1027,74 @@ wxImage wxImage::ResampleBilinear(int width, int height) const
     ResampleBilinearPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBilinearPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    // initialize alpha values to avoid g++ warnings about possibly
-    // uninitialized variables
-    double r1, g1, b1, a1 = 0;
-    double r2, g2, b2, a2 = 0;
+    const size_t srcWidth = M_IMGDATA->m_width;
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    ProcessImageBands(height, width,
+    [&](int yStart, int yEnd)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
-        const int y_offset1 = vPrecalc.offset1;
-        const int y_offset2 = vPrecalc.offset2;
-        const double dy = vPrecalc.dd;
-        const double dy1 = vPrecalc.dd1;
+        // The two source rows interpolated horizontally and the indices of the
+        // rows they correspond to, -1 meaning that the line is not filled yet.
+        wxVector<double> line1(4*width), line2(4*width);
+        int line1Row = -1,
+            line2Row = -1;
 
+        unsigned char* dst_line = dst_data + 3*yStart*width;
+        unsigned char* dst_alpha_line = dst_alpha ? dst_alpha + yStart*width
+                                                  : nullptr;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dsty = yStart; dsty < yEnd; dsty++ )
         {
-            // X-axis of pixel to interpolate from
-            const BilinearPrecalc& hPrecalc = hPrecalcs[dstx];
-
-            const int x_offset1 = hPrecalc.offset1;
-            const int x_offset2 = hPrecalc.offset2;
-            const double dx = hPrecalc.dd;
-            const double dx1 = hPrecalc.dd1;
-
-            int src_pixel_index00 = y_offset1 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index01 = y_offset1 * M_IMGDATA->m_width + x_offset2;
-            int src_pixel_index10 = y_offset2 * M_IMGDATA->m_width + x_offset1;
-            int src_pixel_index11 = y_offset2 * M_IMGDATA->m_width + x_offset2;
-
-            // first line
-            r1 = src_data[src_pixel_index00 * 3 + 0] * dx1 + src_data[src_pixel_index01 * 3 + 0] * dx;
-            g1 = src_data[src_pixel_index00 * 3 + 1] * dx1 + src_data[src_pixel_index01 * 3 + 1] * dx;
-            b1 = src_data[src_pixel_index00 * 3 + 2] * dx1 + src_data[src_pixel_index01 * 3 + 2] * dx;
-            if ( src_alpha )
-                a1 = src_alpha[src_pixel_index00] * dx1 + src_alpha[src_pixel_index01] * dx;
+            // We need to calculate the source pixel to interpolate from - Y-axis
+            const BilinearPrecalc& vPrecalc = vPrecalcs[dsty];
+            const int y_offset1 = vPrecalc.offset1;
+            const int y_offset2 = vPrecalc.offset2;
+            const double dy = vPrecalc.dd;
+            const double dy1 = vPrecalc.dd1;
 
-            // second line
-            r2 = src_data[src_pixel_index10 * 3 + 0] * dx1 + src_data[src_pixel_index11 * 3 + 0] * dx;
-            g2 = src_data[src_pixel_index10 * 3 + 1] * dx1 + src_data[src_pixel_index11 * 3 + 1] * dx;
-            b2 = src_data[src_pixel_index10 * 3 + 2] * dx1 + src_data[src_pixel_index11 * 3 + 2] * dx;
-            if ( src_alpha )
-                a2 = src_alpha[src_pixel_index10] * dx1 + src_alpha[src_pixel_index11] * dx;
+            if ( y_offset1 != line1Row )
+            {
+                if ( y_offset1 == line2Row )
+                {
+                    line1.swap(line2);
+                    std::swap(line1Row, line2Row);
+                }
+                else
+                {
+                    if ( src_alpha )
+                        DoBilinearInterpolateRow<true>(src_data, src_alpha, srcWidth,
+                                                       y_offset1, hPrecalcs, line1);
+                    else
+                        DoBilinearInterpolateRow<false>(src_data, nullptr, srcWidth,
+                                                        y_offset1, hPrecalcs, line1);
+                    line1Row = y_offset1;
+                }
+            }
 
-            // result lines
+            if ( y_offset2 != line2Row )
+            {
+                if ( src_alpha )
+                    DoBilinearInterpolateRow<true>(src_data, src_alpha, srcWidth,
+                                                   y_offset2, hPrecalcs, line2);
+                else
+                    DoBilinearInterpolateRow<false>(src_data, nullptr, srcWidth,
+                                                    y_offset2, hPrecalcs, line2);
+                line2Row = y_offset2;
+            }
 
-            dst_data[0] = static_cast<unsigned char>(r1 * dy1 + r2 * dy + .5);
-            dst_data[1] = static_cast<unsigned char>(g1 * dy1 + g2 * dy + .5);
-            dst_data[2] = static_cast<unsigned char>(b1 * dy1 + b2 * dy + .5);
-            dst_data += 3;
+            const double* src1 = &line1[0];
+            const double* src2 = &line2[0];
+            for ( int dstx = 0; dstx < width; dstx++, src1 += 4, src2 += 4 )
+            {
+                dst_line[0] = static_cast<unsigned char>(src1[0] * dy1 + src2[0] * dy + .5);
+                dst_line[1] = static_cast<unsigned char>(src1[1] * dy1 + src2[1] * dy + .5);
+                dst_line[2] = static_cast<unsigned char>(src1[2] * dy1 + src2[2] * dy + .5);
+                dst_line += 3;
 
-            if ( src_alpha )
-                *dst_alpha++ = static_cast<unsigned char>(a1 * dy1 + a2 * dy +.5);
+                if ( src_alpha )
+                    *dst_alpha_line++ = static_cast<unsigned char>(src1[3] * dy1 + src2[3] * dy +.5);
+            }
         }
-    }
+    });
 
     return ret_image;
 }
@@ -973,6 +1168,105 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
     }
 }
 
+// Helper of ResampleBicubic(): computes a single destination row using the
+// precalculated source rows offsets and weights. This is a template to avoid
+// testing for alpha presence for every pixel, but the order of the floating
+// point operations is preserved to keep the results the same as before.
+template <bool hasAlpha>
+void
+DoResampleBicubicRow(const unsigned char* src_data,
+                     const unsigned char* src_alpha,
+                     size_t srcWidth,
+                     const BicubicPrecalc& vPrecalc,
+                     const wxVector<BicubicPrecalc>& hPrecalcs,
+                     unsigned char* dst_data,
+                     unsigned char* dst_alpha)
+{
+    // Source lines used for all pixels of this row.
+    const unsigned char* src_lines[4];
+    const unsigned char* src_alpha_lines[4];
+    for ( int k = 0; k < 4; k++ )
+    {
+        const size_t y_offset = vPrecalc.offset[k];
+        src_lines[k] = src_data + 3*y_offset*srcWidth;
+        src_alpha_lines[k] = hasAlpha ? src_alpha + y_offset*srcWidth : nullptr;
+    }
+
+    const size_t width = hPrecalcs.size();
+    for ( size_t dstx = 0; dstx < width; dstx++ )
+    {
+        // X-axis of pixel to interpolate from
+        const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+
+        // Sums for each color channel
+        double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+
+        // Here we actually determine the RGBA values for the destination pixel
+        for ( int k = 0; k < 4; k++ )
+        {
+            const unsigned char* const src_line = src_lines[k];
+            const unsigned char* const src_alpha_line = src_alpha_lines[k];
+
+            // Loop across the X axis
+            for ( int i = 0; i < 4; i++ )
+            {
+                // X offset
+                const int x_offset = hPrecalc.offset[i];
+                const unsigned char* const src_pixel = src_line + 3*x_offset;
+
+                // Calculate the weight for the specified pixel according
+                // to the bicubic b-spline kernel we're using for
+                // interpolation
+                const double
+                    pixel_weight = vPrecalc.weight[k] * hPrecalc.weight[i];
+
+                // Create a sum of all velues for each color channel
+                // adjusted for the pixel's calculated weight
+                if ( hasAlpha )
+                {
+                    const unsigned char a = src_alpha_line[x_offset];
+                    sum_r += src_pixel[0] * pixel_weight * a;
+                    sum_g += src_pixel[1] * pixel_weight * a;
+                    sum_b += src_pixel[2] * pixel_weight * a;
+                    sum_a += a * pixel_weight;
+                }
+                else
+                {
+                    sum_r += src_pixel[0] * pixel_weight;
+                    sum_g += src_pixel[1] * pixel_weight;
+                    sum_b += src_pixel[2] * pixel_weight;
+                }
+            }
+        }
+
+        // Put the data into the destination image.  The summed values are
+        // of double data type and are rounded here for accuracy
+        if ( hasAlpha )
+        {
+            if (sum_a != 0)
+            {
+                 dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
+                 dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
+                 dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
+            }
+            else
+            {
+                dst_data[0] = 0;
+                dst_data[1] = 0;
+                dst_data[2] = 0;
+            }
+            *dst_alpha++ = (unsigned char)sum_a;
+        }
+        else
+        {
+            dst_data[0] = (unsigned char)(sum_r + 0.5);
+            dst_data[1] = (unsigned char)(sum_g + 0.5);
+            dst_data[2] = (unsigned char)(sum_b + 0.5);
+        }
+        dst_data += 3;
+    }
+}
+
 } // anonymous namespace
 
 // This is the bicubic resampling algorithm
@@ -1030,190 +1324,375 @@ wxImage wxImage::ResampleBicubic(int width, int height) const
     ResampleBicubicPrecalc(vPrecalcs, M_IMGDATA->m_height);
     ResampleBicubicPrecalc(hPrecalcs, M_IMGDATA->m_width);
 
-    for ( int dsty = 0; dsty < height; dsty++ )
+    const size_t srcWidth = M_IMGDATA->m_width;
+
+    ProcessImageBands(height, width,
+    [&](int yStart, int yEnd)
     {
-        // We need to calculate the source pixel to interpolate from - Y-axis
-        const BicubicPrecalc& vPrecalc = vPrecalcs[dsty];
+        unsigned char* dst_line = dst_data + 3*yStart*width;
+        unsigned char* dst_alpha_line = dst_alpha ? dst_alpha + yStart*width
+                                                  : nullptr;
 
-        for ( int dstx = 0; dstx < width; dstx++ )
+        for ( int dsty = yStart; dsty < yEnd; dsty++ )
         {
-            // X-axis of pixel to interpolate from
-            const BicubicPrecalc& hPrecalc = hPrecalcs[dstx];
+            if ( src_alpha )
+            {
+                DoResampleBicubicRow<true>(src_data, src_alpha, srcWidth,
+                                           vPrecalcs[dsty], hPrecalcs,
+                                           dst_line, dst_alpha_line);
+                dst_alpha_line += width;
+            }
+            else
+            {
+                DoResampleBicubicRow<false>(src_data, nullptr, srcWidth,
+                                            vPrecalcs[dsty], hPrecalcs,
+                                            dst_line, nullptr);
+            }
 
-            // Sums for each color channel
-            double sum_r = 0, sum_g = 0, sum_b = 0, sum_a = 0;
+            dst_line += 3*width;
+        }
+    });
 
-            // Here we actually determine the RGBA values for the destination pixel
-            for ( int k = -1; k <= 2; k++ )
-            {
-                // Y offset
-                const int y_offset = vPrecalc.offset[k + 1];
+    return ret_image;
+}
 
-                // Loop across the X axis
-                for ( int i = -1; i <= 2; i++ )
-                {
-                    // X offset
-                    const int x_offset = hPrecalc.offset[i + 1];
+namespace
+{
 
-                    // Calculate the exact position where the source data
-                    // should be pulled from based on the x_offset and y_offset
-                    int src_pixel_index = y_offset*M_IMGDATA->m_width + x_offset;
+// Blur a single row of pixels, i.e. replace each pixel with the average of the
+// pixels in [x - radius, x + radius] range, using the edge pixels for the
+// parts of this range outside of the image.
+//
+// This uses a running sum, so the time taken doesn't depend on the radius,
+// and processes both RGB and alpha values in a single pass.
+//
+// If round is true, the results are rounded instead of being truncated.
+template <bool hasAlpha>
+void
+BoxBlurRow(const unsigned char* src,
+           const unsigned char* src_alpha,
+           unsigned char* dst,
+           unsigned char* dst_alpha,
+           int width,
+           int radius,
+           bool round)
+{
+    // number of pixels we average over
+    const int blurArea = radius*2 + 1;
+    const int bias = round ? radius : 0;
 
-                    // Calculate the weight for the specified pixel according
-                    // to the bicubic b-spline kernel we're using for
-                    // interpolation
-                    const double
-                        pixel_weight = vPrecalc.weight[k + 1] * hPrecalc.weight[i + 1];
+    const int last = width - 1;
 
-                    // Create a sum of all velues for each color channel
-                    // adjusted for the pixel's calculated weight
-                    if ( src_alpha )
-                    {
-                        const unsigned char a = src_alpha[src_pixel_index];
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight * a;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight * a;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight * a;
-                        sum_a += a * pixel_weight;
-                    }
-                    else
-                    {
-                        sum_r += src_data[src_pixel_index * 3 + 0] * pixel_weight;
-                        sum_g += src_data[src_pixel_index * 3 + 1] * pixel_weight;
-                        sum_b += src_data[src_pixel_index * 3 + 2] * pixel_weight;
-                    }
-                }
-            }
+    // Calculate the sum of all pixels in the blur radius for the first pixel
+    // of the row, duplicating the first pixel for all pixels before it.
+    int sum_r = (radius + 1)*src[0],
+        sum_g = (radius + 1)*src[1],
+        sum_b = (radius + 1)*src[2],
+        sum_a = hasAlpha ? (radius + 1)*src_alpha[0] : 0;
 
-            // Put the data into the destination image.  The summed values are
-            // of double data type and are rounded here for accuracy
-            if ( src_alpha )
+    for ( int kernel_x = 1; kernel_x <= radius; kernel_x++ )
+    {
+        const int x = wxMin(kernel_x, last);
+
+        sum_r += src[3*x + 0];
+        sum_g += src[3*x + 1];
+        sum_b += src[3*x + 2];
+        if ( hasAlpha )
+            sum_a += src_alpha[x];
+    }
+
+    for ( int x = 0; ; x++ )
+    {
+        // Save off the averaged data
+        dst[3*x + 0] = (unsigned char)((sum_r + bias) / blurArea);
+        dst[3*x + 1] = (unsigned char)((sum_g + bias) / blurArea);
+        dst[3*x + 2] = (unsigned char)((sum_b + bias) / blurArea);
+        if ( hasAlpha )
+            dst_alpha[x] = (unsigned char)((sum_a + bias) / blurArea);
+
+        if ( x == last )
+            break;
+
+        // Move the blur box along the row by subtracting the value of the
+        // pixel at its left side and adding the value of the next pixel on
+        // its right side, taking care of the edge pixels.
+        const int sub = wxMax(x - radius, 0);
+        const int add = wxMin(x + radius + 1, last);
+
+        sum_r += src[3*add + 0] - src[3*sub + 0];
+        sum_g += src[3*add + 1] - src[3*sub + 1];
+        sum_b += src[3*add + 2] - src[3*sub + 2];
+        if ( hasAlpha )
+            sum_a += src_alpha[add] - src_alpha[sub];
+    }
+}
+
+// Blur the given range of bytes in each row in the vertical direction.
+//
+// This works for both RGB and alpha data as all bytes are treated in the same
+// way and the rows are processed sequentially to be cache-friendly, with the
+// running sums for all columns being updated at once. The sums vector is used
+// as temporary storage.
+void
+BoxBlurColumns(const unsigned char* src,
+               unsigned char* dst,
+               size_t stride,
+               int height,
+               int colStart,
+               int colEnd,
+               int radius,
+               bool round,
+               wxVector<int>& sums)
+{
+    // number of pixels we average over
+    const int blurArea = radius*2 + 1;
+    const int bias = round ? radius : 0;
+
+    const int last = height - 1;
+    const int numCols = colEnd - colStart;
+
+    src += colStart;
+    dst += colStart;
+
+    sums.resize(numCols);
+
+    for ( int i = 0; i < numCols; i++ )
+        sums[i] = (radius + 1)*src[i];
+
+    for ( int kernel_y = 1; kernel_y <= radius; kernel_y++ )
+    {
+        const unsigned char* const row = src + wxMin(kernel_y, last)*stride;
+        for ( int i = 0; i < numCols; i++ )
+            sums[i] += row[i];
+    }
+
+    for ( int y = 0; ; y++ )
+    {
+        unsigned char* const out = dst + y*stride;
+        for ( int i = 0; i < numCols; i++ )
+            out[i] = (unsigned char)((sums[i] + bias) / blurArea);
+
+        if ( y == last )
+            break;
+
+        const unsigned char* const sub = src + wxMax(y - radius, 0)*stride;
+        const unsigned char* const add = src + wxMin(y + radius + 1, last)*stride;
+        for ( int i = 0; i < numCols; i++ )
+            sums[i] += add[i] - sub[i];
+    }
+}
+
+// Image-like RGB and (optional) alpha planes used by the functions below.
+struct BlurPlanes
+{
+    BlurPlanes(unsigned char* data_, unsigned char* alpha_)
+        : data(data_), alpha(alpha_)
+    {
+    }
+
+    unsigned char* data;
+    unsigned char* alpha;
+};
+
+// Apply the box blur with all the given radii to all rows of the image.
+void
+BoxBlurHorizontally(const BlurPlanes& src,
+                    const BlurPlanes& dst,
+                    int width,
+                    int height,
+                    const int* radii,
+                    int numPasses,
+                    bool round)
+{
+    ProcessImageBands(height, width,
+    [&](int yStart, int yEnd)
+    {
+        // If there is more than one pass, we need temporary storage for the
+        // intermediate results: as it is just a couple of rows, allocating it
+        // here is not a problem.
+        const size_t lineLen = src.alpha ? 4*width : 3*width;
+        wxVector<unsigned char> lines(numPasses > 1 ? 2*lineLen : 0);
+
+        for ( int y = yStart; y < yEnd; y++ )
+        {
+            const size_t offset = static_cast<size_t>(y)*width;
+
+            const unsigned char* in = src.data + 3*offset;
+            const unsigned char* in_alpha = src.alpha ? src.alpha + offset
+                                                      : nullptr;
+
+            for ( int pass = 0; pass < numPasses; pass++ )
             {
-                if (sum_a != 0)
+                unsigned char* out;
+                unsigned char* out_alpha = nullptr;
+                if ( pass == numPasses - 1 )
                 {
-                     dst_data[0] = (unsigned char)(sum_r / sum_a + 0.5);
-                     dst_data[1] = (unsigned char)(sum_g / sum_a + 0.5);
-                     dst_data[2] = (unsigned char)(sum_b / sum_a + 0.5);
+                    out = dst.data + 3*offset;
+                    if ( src.alpha )
+                        out_alpha = dst.alpha + offset;
                 }
                 else
                 {
-                    dst_data[0] = 0;
-                    dst_data[1] = 0;
-                    dst_data[2] = 0;
+                    out = &lines[(pass % 2)*lineLen];
+                    if ( src.alpha )
+                        out_alpha = out + 3*width;
                 }
-                *dst_alpha++ = (unsigned char)sum_a;
+
+                if ( src.alpha )
+                    BoxBlurRow<true>(in, in_alpha, out, out_alpha,
+                                     width, radii[pass], round);
+                else
+                    BoxBlurRow<false>(in, nullptr, out, nullptr,
+                                      width, radii[pass], round);
+
+                in = out;
+                in_alpha = out_alpha;
             }
-            else
+        }
+    });
+}
+
+// Apply the box blur with all the given radii to all columns of the image.
+//
+// If there is more than one pass, tmp1 (and tmp2, if there are more than two
+// of them) must be valid and are used for storing the intermediate results,
+// they may be the same as src, but not dst.
+void
+BoxBlurVertically(const BlurPlanes& src,
+                  const BlurPlanes& dst,
+                  const BlurPlanes& tmp1,
+                  const BlurPlanes& tmp2,
+                  int width,
+                  int height,
+                  const int* radii,
+                  int numPasses,
+                  bool round)
+{
+    BlurPlanes in = src;
+    for ( int pass = 0; pass < numPasses; pass++ )
+    {
+        const BlurPlanes& out = pass == numPasses - 1
+                                    ? dst
+                                    : pass % 2 ? tmp2 : tmp1;
+
+        // As the columns are independent, we can process the data in bands of
+        // columns instead of rows here.
+        ProcessImageBands(3*width, height,
+        [&](int colStart, int colEnd)
+        {
+            wxVector<int> sums;
+            BoxBlurColumns(in.data, out.data, 3*width, height,
+                           colStart, colEnd, radii[pass], round, sums);
+        });
+
+        if ( src.alpha )
+        {
+            ProcessImageBands(width, height,
+            [&](int colStart, int colEnd)
             {
-                dst_data[0] = (unsigned char)(sum_r + 0.5);
-                dst_data[1] = (unsigned char)(sum_g + 0.5);
-                dst_data[2] = (unsigned char)(sum_b + 0.5);
-            }
-            dst_data += 3;
+                wxVector<int> sums;
+                BoxBlurColumns(in.alpha, out.alpha, width, height,
+                               colStart, colEnd, radii[pass], round, sums);
+            });
         }
+
+        in = out;
     }
+}
 
-    return ret_image;
+// Return the planes for an image-like buffer of the given size stored in the
+// scratch buffer at the given index.
+BlurPlanes
+GetScratchPlanes(wxMemoryBuffer& scratch,
+                 int width,
+                 int height,
+                 bool hasAlpha,
+                 int index)
+{
+    const size_t numPixels = static_cast<size_t>(width)*height;
+    const size_t planesSize = hasAlpha ? 4*numPixels : 3*numPixels;
+
+    unsigned char* const
+        data = static_cast<unsigned char*>(scratch.GetData()) + index*planesSize;
+
+    return BlurPlanes(data, hasAlpha ? data + 3*numPixels : nullptr);
 }
 
-// Blur in the horizontal direction
-wxImage wxImage::BlurHorizontal(int blurRadius) const
+// Blur the image in both directions using the given radii for each pass and
+// store the result in the provided image of the same size.
+void
+DoBlur(const wxImage& image,
+       const wxImage& ret_image,
+       const int* radii,
+       int numPasses,
+       bool round,
+       wxMemoryBuffer& scratch)
 {
-    wxImage ret_image(MakeEmptyClone());
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+    const bool hasAlpha = image.HasAlpha();
 
-    wxCHECK( ret_image.IsOk(), ret_image );
+    // We need one buffer for the result of the horizontal pass and another
+    // one for the intermediate results of the vertical passes if there are
+    // more than one of them.
+    const size_t planesSize = static_cast<size_t>(width)*height*(hasAlpha ? 4 : 3);
+    const int numBuffers = numPasses > 1 ? 2 : 1;
+    scratch.SetBufSize(numBuffers*planesSize);
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
+    const BlurPlanes src(image.GetData(), image.GetAlpha());
+    const BlurPlanes dst(ret_image.GetData(), ret_image.GetAlpha());
+    const BlurPlanes tmp1 = GetScratchPlanes(scratch, width, height, hasAlpha, 0);
+    const BlurPlanes tmp2 = numBuffers > 1
+                                ? GetScratchPlanes(scratch, width, height, hasAlpha, 1)
+                                : BlurPlanes(nullptr, nullptr);
 
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
+    BoxBlurHorizontally(src, tmp1, width, height, radii, numPasses, round);
 
-    // Horizontal blurring algorithm - average all pixels in the specified blur
-    // radius in the X or horizontal direction
-    for ( int y = 0; y < M_IMGDATA->m_height; y++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
+    // Note that the first vertical pass reads from tmp1 and writes to tmp2,
+    // so the next one can use tmp1 for its output.
+    BoxBlurVertically(tmp1, dst, tmp2, tmp1, width, height,
+                      radii, numPasses, round);
+}
+
+// Compute the radii of 3 box blurs approximating the Gaussian blur with the
+// given standard deviation, see "Fast Almost-Gaussian Filtering" by Peter
+// Kovesi for the explanation of the formulas used here.
+void GetGaussianBoxRadii(double sigma, int radii[3])
+{
+    const int numPasses = 3;
 
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
+    // Ideal width of the box, we use the odd widths around it.
+    const double wIdeal = sqrt(12*sigma*sigma/numPasses + 1);
+    int wl = static_cast<int>(floor(wIdeal));
+    if ( wl % 2 == 0 )
+        wl--;
 
-        // Calculate the average of all pixels in the blur radius for the first
-        // pixel of the row
-        for ( int kernel_x = -blurRadius; kernel_x <= blurRadius; kernel_x++ )
-        {
-            // To deal with the pixels at the start of a row so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous row
-            if ( kernel_x < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = kernel_x + y * M_IMGDATA->m_width;
+    const int wu = wl + 2;
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+    // Number of passes using the smaller width.
+    const double mIdeal = (12*sigma*sigma - numPasses*wl*wl - 4*numPasses*wl
+                            - 3*numPasses) / (-4*wl - 4);
+    const int m = wxRound(mIdeal);
+
+    for ( int i = 0; i < numPasses; i++ )
+        radii[i] = ((i < m ? wl : wu) - 1) / 2;
+}
 
-        dst = dst_data + y * M_IMGDATA->m_width*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
+} // anonymous namespace
 
-        // Now average the values of the rest of the pixels by just moving the
-        // blur radius box along the row
-        for ( int x = 1; x < M_IMGDATA->m_width; x++ )
-        {
-            // Take care of edge pixels on the left edge by essentially
-            // duplicating the edge pixel
-            if ( x - blurRadius - 1 < 0 )
-                pixel_idx = y * M_IMGDATA->m_width;
-            else
-                pixel_idx = (x - blurRadius - 1) + y * M_IMGDATA->m_width;
-
-            // Subtract the value of the pixel at the left side of the blur
-            // radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+// Blur in the horizontal direction
+wxImage wxImage::BlurHorizontal(int blurRadius) const
+{
+    wxCHECK_MSG( blurRadius >= 0, wxImage(), "invalid blur radius" );
 
-            // Take care of edge pixels on the right edge
-            if ( x + blurRadius > M_IMGDATA->m_width - 1 )
-                pixel_idx = M_IMGDATA->m_width - 1 + y * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + blurRadius + y * M_IMGDATA->m_width;
+    wxImage ret_image(MakeEmptyClone());
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-            // Save off the averaged data
-            dst = dst_data + x*3 + y*M_IMGDATA->m_width*3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
-    }
+    BoxBlurHorizontally(BlurPlanes(M_IMGDATA->m_data, M_IMGDATA->m_alpha),
+                        BlurPlanes(ret_image.GetData(), ret_image.GetAlpha()),
+                        M_IMGDATA->m_width, M_IMGDATA->m_height,
+                        &blurRadius, 1, false);
 
     return ret_image;
 }
@@ -1221,115 +1700,63 @@ wxImage wxImage::BlurHorizontal(int blurRadius) const
 // Blur in the vertical direction
 wxImage wxImage::BlurVertical(int blurRadius) const
 {
+    wxCHECK_MSG( blurRadius >= 0, wxImage(), "invalid blur radius" );
+
     wxImage ret_image(MakeEmptyClone());
 
     wxCHECK( ret_image.IsOk(), ret_image );
 
-    const unsigned char* src_data = M_IMGDATA->m_data;
-    unsigned char* dst_data = ret_image.GetData();
-    const unsigned char* src_alpha = M_IMGDATA->m_alpha;
-    unsigned char* dst_alpha = ret_image.GetAlpha();
-
-    // number of pixels we average over
-    const int blurArea = blurRadius*2 + 1;
+    const BlurPlanes none(nullptr, nullptr);
+    BoxBlurVertically(BlurPlanes(M_IMGDATA->m_data, M_IMGDATA->m_alpha),
+                      BlurPlanes(ret_image.GetData(), ret_image.GetAlpha()),
+                      none, none,
+                      M_IMGDATA->m_width, M_IMGDATA->m_height,
+                      &blurRadius, 1, false);
 
-    // Vertical blurring algorithm - same as horizontal but switched the
-    // opposite direction
-    for ( int x = 0; x < M_IMGDATA->m_width; x++ )
-    {
-        // Variables used in the blurring algorithm
-        long sum_r = 0,
-             sum_g = 0,
-             sum_b = 0,
-             sum_a = 0;
+    return ret_image;
+}
 
-        long pixel_idx;
-        const unsigned char *src;
-        unsigned char *dst;
+// The new blur function
+wxImage wxImage::Blur(int blurRadius) const
+{
+    wxMemoryBuffer scratch;
+    return Blur(blurRadius, scratch);
+}
 
-        // Calculate the average of all pixels in our blur radius box for the
-        // first pixel of the column
-        for ( int kernel_y = -blurRadius; kernel_y <= blurRadius; kernel_y++ )
-        {
-            // To deal with the pixels at the start of a column so it's not
-            // grabbing GOK values from memory at negative indices of the
-            // image's data or grabbing from the previous column
-            if ( kernel_y < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + kernel_y * M_IMGDATA->m_width;
+wxImage wxImage::Blur(int blurRadius, wxMemoryBuffer& scratch) const
+{
+    wxCHECK_MSG( blurRadius >= 0, wxImage(), "invalid blur radius" );
 
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
-        }
+    wxImage ret_image(MakeEmptyClone());
 
-        dst = dst_data + x*3;
-        dst[0] = (unsigned char)(sum_r / blurArea);
-        dst[1] = (unsigned char)(sum_g / blurArea);
-        dst[2] = (unsigned char)(sum_b / blurArea);
-        if ( src_alpha )
-            dst_alpha[x] = (unsigned char)(sum_a / blurArea);
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-        // Now average the values of the rest of the pixels by just moving the
-        // box along the column from top to bottom
-        for ( int y = 1; y < M_IMGDATA->m_height; y++ )
-        {
-            // Take care of pixels that would be beyond the top edge by
-            // duplicating the top edge pixel for the column
-            if ( y - blurRadius - 1 < 0 )
-                pixel_idx = x;
-            else
-                pixel_idx = x + (y - blurRadius - 1) * M_IMGDATA->m_width;
+    // Blur the image in each direction
+    DoBlur(*this, ret_image, &blurRadius, 1, false, scratch);
 
-            // Subtract the value of the pixel at the top of our blur radius box
-            src = src_data + pixel_idx*3;
-            sum_r -= src[0];
-            sum_g -= src[1];
-            sum_b -= src[2];
-            if ( src_alpha )
-                sum_a -= src_alpha[pixel_idx];
+    return ret_image;
+}
 
-            // Take care of the pixels that would be beyond the bottom edge of
-            // the image similar to the top edge
-            if ( y + blurRadius > M_IMGDATA->m_height - 1 )
-                pixel_idx = x + (M_IMGDATA->m_height - 1) * M_IMGDATA->m_width;
-            else
-                pixel_idx = x + (blurRadius + y) * M_IMGDATA->m_width;
+wxImage wxImage::BlurGaussian(double sigma) const
+{
+    wxMemoryBuffer scratch;
+    return BlurGaussian(sigma, scratch);
+}
 
-            // Add the value of the pixel being added to the end of our box
-            src = src_data + pixel_idx*3;
-            sum_r += src[0];
-            sum_g += src[1];
-            sum_b += src[2];
-            if ( src_alpha )
-                sum_a += src_alpha[pixel_idx];
+wxImage wxImage::BlurGaussian(double sigma, wxMemoryBuffer& scratch) const
+{
+    wxCHECK_MSG( sigma >= 0, wxImage(), "invalid standard deviation" );
 
-            // Save off the averaged data
-            dst = dst_data + (x + y * M_IMGDATA->m_width) * 3;
-            dst[0] = (unsigned char)(sum_r / blurArea);
-            dst[1] = (unsigned char)(sum_g / blurArea);
-            dst[2] = (unsigned char)(sum_b / blurArea);
-            if ( src_alpha )
-                dst_alpha[x + y * M_IMGDATA->m_width] = (unsigned char)(sum_a / blurArea);
-        }
-    }
+    wxImage ret_image(MakeEmptyClone());
 
-    return ret_image;
-}
+    wxCHECK( ret_image.IsOk(), ret_image );
 
-// The new blur function
-wxImage wxImage::Blur(int blurRadius) const
-{
-    wxImage ret_image;
-    ret_image.Create(M_IMGDATA->m_width, M_IMGDATA->m_height, false);
+    int radii[3];
+    GetGaussianBoxRadii(sigma, radii);
 
-    // Blur the image in each direction
-    ret_image = BlurHorizontal(blurRadius);
-    ret_image = ret_image.BlurVertical(blurRadius);
+    // Round the intermediate results to avoid the systematic bias towards
+    // smaller values which would result from truncating them in every pass.
+    DoBlur(*this, ret_image, radii, WXSIZEOF(radii), true, scratch);
 
     return ret_image;
 }
@@ -3453,6 +3880,168 @@ void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
     });
 }
 
+//-----------------------------------------------------------------------------
+// wxImageView
+//-----------------------------------------------------------------------------
+
+wxImageView::wxImageView(const wxImage& image)
+    : m_image(image),
+      m_rect(image.IsOk() ? wxRect(image.GetSize()) : wxRect())
+{
+}
+
+wxImageView::wxImageView(const wxImage& image, const wxRect& rect)
+{
+    wxCHECK_RET( image.IsOk(), wxT("invalid image") );
+    wxCHECK_RET( !rect.IsEmpty() && wxRect(image.GetSize()).Contains(rect),
+                 wxT("invalid image view rectangle") );
+
+    m_image = image;
+    m_rect = rect;
+}
+
+wxImageView wxImageView::GetSubView(const wxRect& rect) const
+{
+    wxCHECK_MSG( IsOk(), wxImageView(), wxT("invalid image view") );
+    wxCHECK_MSG( wxRect(GetSize()).Contains(rect), wxImageView(),
+                 wxT("invalid image subview rectangle") );
+
+    return wxImageView(m_image, wxRect(m_rect.GetPosition() + rect.GetPosition(),
+                                       rect.GetSize()));
+}
+
+long wxImageView::GetPixelOffset(int x, int y) const
+{
+    if ( IsOk() && x >= 0 && y >= 0 && x < m_rect.width && y < m_rect.height )
+        return (long)(m_rect.y + y)*m_image.GetWidth() + m_rect.x + x;
+
+    return -1;
+}
+
+unsigned char wxImageView::GetRed(int x, int y) const
+{
+    const long pos = GetPixelOffset(x, y);
+    wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+
+    return m_image.GetData()[3*pos];
+}
+
+unsigned char wxImageView::GetGreen(int x, int y) const
+{
+    const long pos = GetPixelOffset(x, y);
+    wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+
+    return m_image.GetData()[3*pos + 1];
+}
+
+unsigned char wxImageView::GetBlue(int x, int y) const
+{
+    const long pos = GetPixelOffset(x, y);
+    wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+
+    return m_image.GetData()[3*pos + 2];
+}
+
+unsigned char wxImageView::GetAlpha(int x, int y) const
+{
+    wxCHECK_MSG( HasAlpha(), 0, wxT("no alpha channel") );
+
+    const long pos = GetPixelOffset(x, y);
+    wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+
+    return m_image.GetAlpha()[pos];
+}
+
+const unsigned char* wxImageView::GetRowData(int y) const
+{
+    const long pos = GetPixelOffset(0, y);
+    wxCHECK_MSG( pos != -1, nullptr, wxT("invalid image row") );
+
+    return m_image.GetData() + 3*pos;
+}
+
+const unsigned char* wxImageView::GetRowAlpha(int y) const
+{
+    const long pos = GetPixelOffset(0, y);
+    wxCHECK_MSG( pos != -1, nullptr, wxT("invalid image row") );
+
+    const unsigned char* const alpha = m_image.GetAlpha();
+    return alpha ? alpha + pos : nullptr;
+}
+
+void wxImageView::AllocExclusive()
+{
+    // If nobody else uses the image data, we can just modify them in place,
+    // but otherwise copy just the part of the image we need: this is the
+    // whole point of using the view instead of the image itself.
+    if ( m_image.GetRefData()->GetRefCount() > 1 )
+    {
+        m_image = m_image.GetSubImage(m_rect);
+        m_rect.SetPosition(wxPoint(0, 0));
+    }
+}
+
+void wxImageView::SetRGB(int x, int y,
+                         unsigned char r, unsigned char g, unsigned char b)
+{
+    const long pos = GetPixelOffset(x, y);
+    wxCHECK_RET( pos != -1, wxT("invalid image coordinates") );
+
+    AllocExclusive();
+
+    // Note that GetPixelOffset() result may have changed after making the
+    // copy of the data.
+    unsigned char* const data = m_image.GetData() + 3*GetPixelOffset(x, y);
+    data[0] = r;
+    data[1] = g;
+    data[2] = b;
+}
+
+void wxImageView::SetAlpha(int x, int y, unsigned char alpha)
+{
+    wxCHECK_RET( HasAlpha(), wxT("no alpha channel") );
+
+    const long pos = GetPixelOffset(x, y);
+    wxCHECK_RET( pos != -1, wxT("invalid image coordinates") );
+
+    AllocExclusive();
+
+    m_image.GetAlpha()[GetPixelOffset(x, y)] = alpha;
+}
+
+unsigned char* wxImageView::GetWritableRowData(int y)
+{
+    wxCHECK_MSG( GetPixelOffset(0, y) != -1, nullptr, wxT("invalid image row") );
+
+    AllocExclusive();
+
+    return m_image.GetData() + 3*GetPixelOffset(0, y);
+}
+
+unsigned char* wxImageView::GetWritableRowAlpha(int y)
+{
+    wxCHECK_MSG( GetPixelOffset(0, y) != -1, nullptr, wxT("invalid image row") );
+
+    if ( !HasAlpha() )
+        return nullptr;
+
+    AllocExclusive();
+
+    return m_image.GetAlpha() + GetPixelOffset(0, y);
+}
+
+wxImage wxImageView::ToImage() const
+{
+    wxCHECK_MSG( IsOk(), wxImage(), wxT("invalid image view") );
+
+    // Don't copy anything at all if we view the entire image, the image
+    // itself will make a copy of its data if it's modified later.
+    if ( m_rect == wxRect(m_image.GetSize()) )
+        return m_image;
+
+    return m_image.GetSubImage(m_rect);
+}
+
 //-----------------------------------------------------------------------------
 // wxImageHandler
 //-----------------------------------------------------------------------------
@@ -3485,6 +4074,50 @@ bool wxImageHandler::CallDoCanRead(wxInputStream& stream)
             .CallIfCanSeek(&wxImageHandler::DoCanRead, this);
 }
 
+//-----------------------------------------------------------------------------
+// wxImageDecoder
+//-----------------------------------------------------------------------------
+
+bool wxImageDecoder::Feed(const void* data, size_t size)
+{
+    if ( HasFailed() )
+        return false;
+
+    // Just ignore any data following the end of the image.
+    if ( IsDone() || !size )
+        return true;
+
+    if ( !DoFeed(static_cast<const unsigned char*>(data), size) )
+    {
+        m_state = State_Failed;
+        return false;
+    }
+
+    return true;
+}
+
+bool wxImageDecoder::Feed(wxInputStream& stream)
+{
+    unsigned char buf[4096];
+    while ( !IsDone() && !HasFailed() && stream.CanRead() )
+    {
+        const size_t size = stream.Read(buf, sizeof(buf)).LastRead();
+        if ( !size )
+            break;
+
+        if ( !Feed(buf, size) )
+            return false;
+    }
+
+    return !HasFailed();
+}
+
+void wxImageDecoder::NotifyRowsDecoded(int firstRow, int numRows)
+{
+    if ( m_callback )
+        m_callback(firstRow, numRows);
+}
+
 #endif // wxUSE_STREAMS
 
 /* static */
@@ -3695,11 +4328,11 @@ wxImage wxImage::Rotate(double angle,
         *offset_after_rotation = wxPoint (x1a, y1a);
     }
 
-    // the rotated (destination) image is always accessed sequentially via this
-    // pointer, there is no need for pointer-based arrays here
-    unsigned char *dst = rotated.GetData();
+    // the rotated (destination) image is always accessed sequentially via
+    // pointers to the rows, there is no need for pointer-based arrays here
+    unsigned char * const dst_data = rotated.GetData();
 
-    unsigned char *alpha_dst = has_alpha ? rotated.GetAlpha() : nullptr;
+    unsigned char * const alpha_dst_data = has_alpha ? rotated.GetAlpha() : nullptr;
 
     // if the original image has a mask, use its RGB values as the blank pixel,
     // else, fall back to default (black).
@@ -3726,183 +4359,199 @@ wxImage wxImage::Rotate(double angle,
     // only once, instead of repeating it for each pixel.
     if (interpolating)
     {
-        for (int y = 0; y < rH; y++)
+        ProcessImageBands(rH, rW,
+        [&](int yStart, int yEnd)
         {
-            for (int x = 0; x < rW; x++)
-            {
-                wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
+            unsigned char *dst = dst_data + 3*yStart*rW;
+            unsigned char *alpha_dst = has_alpha ? alpha_dst_data + yStart*rW
+                                                 : nullptr;
 
-                if (-0.25 < src.x && src.x < w - 0.75 &&
-                    -0.25 < src.y && src.y < h - 0.75)
+            for (int y = yStart; y < yEnd; y++)
+            {
+                for (int x = 0; x < rW; x++)
                 {
-                    // interpolate using the 4 enclosing grid-points.  Those
-                    // points can be obtained using floor and ceiling of the
-                    // exact coordinates of the point
-                    int x1, y1, x2, y2;
+                    wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
 
-                    if (0 < src.x && src.x < w - 1)
-                    {
-                        x1 = (int) floor(src.x);
-                        x2 = (int) ceil(src.x);
-                    }
-                    else    // else means that x is near one of the borders (0 or width-1)
+                    if (-0.25 < src.x && src.x < w - 0.75 &&
+                        -0.25 < src.y && src.y < h - 0.75)
                     {
-                        x1 = x2 = wxRound (src.x);
-                    }
+                        // interpolate using the 4 enclosing grid-points.  Those
+                        // points can be obtained using floor and ceiling of the
+                        // exact coordinates of the point
+                        int x1, y1, x2, y2;
 
-                    if (0 < src.y && src.y < h - 1)
-                    {
-                        y1 = (int) floor(src.y);
-                        y2 = (int) ceil(src.y);
-                    }
-                    else
-                    {
-                        y1 = y2 = wxRound (src.y);
-                    }
+                        if (0 < src.x && src.x < w - 1)
+                        {
+                            x1 = (int) floor(src.x);
+                            x2 = (int) ceil(src.x);
+                        }
+                        else    // else means that x is near one of the borders (0 or width-1)
+                        {
+                            x1 = x2 = wxRound (src.x);
+                        }
 
-                    // get four points and the distances (square of the distance,
-                    // for efficiency reasons) for the interpolation formula
+                        if (0 < src.y && src.y < h - 1)
+                        {
+                            y1 = (int) floor(src.y);
+                            y2 = (int) ceil(src.y);
+                        }
+                        else
+                        {
+                            y1 = y2 = wxRound (src.y);
+                        }
 
-                    // GRG: Do not calculate the points until they are
-                    //      really needed -- this way we can calculate
-                    //      just one, instead of four, if d1, d2, d3
-                    //      or d4 are < wxROTATE_EPSILON
+                        // get four points and the distances (square of the distance,
+                        // for efficiency reasons) for the interpolation formula
 
-                    const double d1 = (src.x - x1) * (src.x - x1) + (src.y - y1) * (src.y - y1);
-                    const double d2 = (src.x - x2) * (src.x - x2) + (src.y - y1) * (src.y - y1);
-                    const double d3 = (src.x - x2) * (src.x - x2) + (src.y - y2) * (src.y - y2);
-                    const double d4 = (src.x - x1) * (src.x - x1) + (src.y - y2) * (src.y - y2);
+                        // GRG: Do not calculate the points until they are
+                        //      really needed -- this way we can calculate
+                        //      just one, instead of four, if d1, d2, d3
+                        //      or d4 are < wxROTATE_EPSILON
 
-                    // Now interpolate as a weighted average of the four surrounding
-                    // points, where the weights are the distances to each of those points
+                        const double d1 = (src.x - x1) * (src.x - x1) + (src.y - y1) * (src.y - y1);
+                        const double d2 = (src.x - x2) * (src.x - x2) + (src.y - y1) * (src.y - y1);
+                        const double d3 = (src.x - x2) * (src.x - x2) + (src.y - y2) * (src.y - y2);
+                        const double d4 = (src.x - x1) * (src.x - x1) + (src.y - y2) * (src.y - y2);
 
-                    // If the point is exactly at one point of the grid of the source
-                    // image, then don't interpolate -- just assign the pixel
+                        // Now interpolate as a weighted average of the four surrounding
+                        // points, where the weights are the distances to each of those points
 
-                    // d1,d2,d3,d4 are positive -- no need for abs()
-                    if (d1 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y1] + (3 * x1);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                        // If the point is exactly at one point of the grid of the source
+                        // image, then don't interpolate -- just assign the pixel
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y1] + x1);
-                    }
-                    else if (d2 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y1] + (3 * x2);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                        // d1,d2,d3,d4 are positive -- no need for abs()
+                        if (d1 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y1] + (3 * x1);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y1] + x2);
-                    }
-                    else if (d3 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y2] + (3 * x2);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y1] + x1);
+                        }
+                        else if (d2 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y1] + (3 * x2);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y2] + x2);
-                    }
-                    else if (d4 < wxROTATE_EPSILON)
-                    {
-                        unsigned char *p = data[y2] + (3 * x1);
-                        *(dst++) = *(p++);
-                        *(dst++) = *(p++);
-                        *(dst++) = *p;
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y1] + x2);
+                        }
+                        else if (d3 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y2] + (3 * x2);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
-                            *(alpha_dst++) = *(alpha[y2] + x1);
-                    }
-                    else
-                    {
-                        // weights for the weighted average are proportional to the inverse of the distance
-                        unsigned char *v1 = data[y1] + (3 * x1);
-                        unsigned char *v2 = data[y1] + (3 * x2);
-                        unsigned char *v3 = data[y2] + (3 * x2);
-                        unsigned char *v4 = data[y2] + (3 * x1);
-
-                        const double w1 = 1/d1, w2 = 1/d2, w3 = 1/d3, w4 = 1/d4;
-
-                        // GRG: Unrolled.
-
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *(v1++) + w2 * *(v2++) +
-                               w3 * *(v3++) + w4 * *(v4++)) /
-                              (w1 + w2 + w3 + w4) );
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *(v1++) + w2 * *(v2++) +
-                               w3 * *(v3++) + w4 * *(v4++)) /
-                              (w1 + w2 + w3 + w4) );
-                        *(dst++) = (unsigned char)
-                            ( (w1 * *v1 + w2 * *v2 +
-                               w3 * *v3 + w4 * *v4) /
-                              (w1 + w2 + w3 + w4) );
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y2] + x2);
+                        }
+                        else if (d4 < wxROTATE_EPSILON)
+                        {
+                            unsigned char *p = data[y2] + (3 * x1);
+                            *(dst++) = *(p++);
+                            *(dst++) = *(p++);
+                            *(dst++) = *p;
 
-                        if (has_alpha)
+                            if (has_alpha)
+                                *(alpha_dst++) = *(alpha[y2] + x1);
+                        }
+                        else
                         {
-                            v1 = alpha[y1] + (x1);
-                            v2 = alpha[y1] + (x2);
-                            v3 = alpha[y2] + (x2);
-                            v4 = alpha[y2] + (x1);
+                            // weights for the weighted average are proportional to the inverse of the distance
+                            unsigned char *v1 = data[y1] + (3 * x1);
+                            unsigned char *v2 = data[y1] + (3 * x2);
+                            unsigned char *v3 = data[y2] + (3 * x2);
+                            unsigned char *v4 = data[y2] + (3 * x1);
+
+                            const double w1 = 1/d1, w2 = 1/d2, w3 = 1/d3, w4 = 1/d4;
+
+                            // GRG: Unrolled.
 
-                            *(alpha_dst++) = (unsigned char)
+                            *(dst++) = (unsigned char)
+                                ( (w1 * *(v1++) + w2 * *(v2++) +
+                                   w3 * *(v3++) + w4 * *(v4++)) /
+                                  (w1 + w2 + w3 + w4) );
+                            *(dst++) = (unsigned char)
+                                ( (w1 * *(v1++) + w2 * *(v2++) +
+                                   w3 * *(v3++) + w4 * *(v4++)) /
+                                  (w1 + w2 + w3 + w4) );
+                            *(dst++) = (unsigned char)
                                 ( (w1 * *v1 + w2 * *v2 +
                                    w3 * *v3 + w4 * *v4) /
                                   (w1 + w2 + w3 + w4) );
+
+                            if (has_alpha)
+                            {
+                                v1 = alpha[y1] + (x1);
+                                v2 = alpha[y1] + (x2);
+                                v3 = alpha[y2] + (x2);
+                                v4 = alpha[y2] + (x1);
+
+                                *(alpha_dst++) = (unsigned char)
+                                    ( (w1 * *v1 + w2 * *v2 +
+                                       w3 * *v3 + w4 * *v4) /
+                                      (w1 + w2 + w3 + w4) );
+                            }
                         }
                     }
-                }
-                else
-                {
-                    *(dst++) = blank_r;
-                    *(dst++) = blank_g;
-                    *(dst++) = blank_b;
+                    else
+                    {
+                        *(dst++) = blank_r;
+                        *(dst++) = blank_g;
+                        *(dst++) = blank_b;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = 0;
+                        if (has_alpha)
+                            *(alpha_dst++) = 0;
+                    }
                 }
             }
-        }
+        });
     }
     else // not interpolating
     {
-        for (int y = 0; y < rH; y++)
+        ProcessImageBands(rH, rW,
+        [&](int yStart, int yEnd)
         {
-            for (int x = 0; x < rW; x++)
+            unsigned char *dst = dst_data + 3*yStart*rW;
+            unsigned char *alpha_dst = has_alpha ? alpha_dst_data + yStart*rW
+                                                 : nullptr;
+
+            for (int y = yStart; y < yEnd; y++)
             {
-                wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
+                for (int x = 0; x < rW; x++)
+                {
+                    wxRealPoint src = wxRotatePoint (x + x1a, y + y1a, cos_angle, -sin_angle, p0);
 
-                const int xs = wxRound (src.x);      // wxRound rounds to the
-                const int ys = wxRound (src.y);      // closest integer
+                    const int xs = wxRound (src.x);      // wxRound rounds to the
+                    const int ys = wxRound (src.y);      // closest integer
 
-                if (0 <= xs && xs < w && 0 <= ys && ys < h)
-                {
-                    unsigned char *p = data[ys] + (3 * xs);
-                    *(dst++) = *(p++);
-                    *(dst++) = *(p++);
-                    *(dst++) = *p;
+                    if (0 <= xs && xs < w && 0 <= ys && ys < h)
+                    {
+                        unsigned char *p = data[ys] + (3 * xs);
+                        *(dst++) = *(p++);
+                        *(dst++) = *(p++);
+                        *(dst++) = *p;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = *(alpha[ys] + (xs));
-                }
-                else
-                {
-                    *(dst++) = blank_r;
-                    *(dst++) = blank_g;
-                    *(dst++) = blank_b;
+                        if (has_alpha)
+                            *(alpha_dst++) = *(alpha[ys] + (xs));
+                    }
+                    else
+                    {
+                        *(dst++) = blank_r;
+                        *(dst++) = blank_g;
+                        *(dst++) = blank_b;
 
-                    if (has_alpha)
-                        *(alpha_dst++) = 255;
+                        if (has_alpha)
+                            *(alpha_dst++) = 255;
+                    }
                 }
             }
-        }
+        });
     }
 
     delete [] data;
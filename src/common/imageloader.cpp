@@ -0,0 +1,291 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/imageloader.cpp
+// Purpose:     wxImageLoader implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_IMAGE
+
+#include "wx/imageloader.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+#endif // WX_PRECOMP
+
+#include "wx/filefn.h"
+
+#if wxUSE_THREADS
+    #include "wx/private/threadpool.h"
+#endif // wxUSE_THREADS
+
+wxDEFINE_EVENT(wxEVT_IMAGE_LOADED, wxThreadEvent);
+
+// ----------------------------------------------------------------------------
+// private helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Load the image from the given file and scale it down to fit into the given
+// size, if it's valid. This function is called from the worker threads and so
+// must not use any GUI functions.
+wxImage DoLoadImage(const wxString& path, const wxSize& size, wxBitmapType type)
+{
+    // Errors are reported by sending an event with an invalid image, don't
+    // show them to the user (and log messages from the worker threads would
+    // be only shown later anyhow).
+    wxLogNull noLog;
+
+    wxImage image;
+    if ( size.x > 0 && size.y > 0 )
+    {
+        // Allow the handlers supporting it to decode a smaller image directly.
+        image.SetOption(wxIMAGE_OPTION_DESIRED_WIDTH, size.x);
+        image.SetOption(wxIMAGE_OPTION_DESIRED_HEIGHT, size.y);
+    }
+
+    if ( !image.LoadFile(path, type) )
+        return wxImage();
+
+    if ( size.x > 0 && size.y > 0 )
+    {
+        const int w = image.GetWidth();
+        const int h = image.GetHeight();
+        if ( w > size.x || h > size.y )
+        {
+            // Preserve the aspect ratio when scaling.
+            int newW = size.x,
+                newH = size.y;
+            if ( static_cast<wxLongLong_t>(w)*size.y >
+                    static_cast<wxLongLong_t>(h)*size.x )
+                newH = wxMax(1, static_cast<int>((static_cast<wxLongLong_t>(h)*size.x)/w));
+            else
+                newW = wxMax(1, static_cast<int>((static_cast<wxLongLong_t>(w)*size.y)/h));
+
+            image.Rescale(newW, newH, wxIMAGE_QUALITY_HIGH);
+        }
+    }
+
+    return image;
+}
+
+// Return the approximate number of bytes used by the image data.
+size_t GetImageDataSize(const wxImage& image)
+{
+    const size_t numPixels = static_cast<size_t>(image.GetWidth())*image.GetHeight();
+
+    return numPixels*(image.HasAlpha() ? 4 : 3);
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxImageLoader::SharedState
+// ----------------------------------------------------------------------------
+
+// This struct is used by the worker threads to send the results back to the
+// loader object, if it still exists.
+struct wxImageLoader::SharedState
+{
+    explicit SharedState(wxImageLoader* loader_) : loader(loader_) { }
+
+#if wxUSE_THREADS
+    // Protects the pointer below.
+    wxMutex mutex;
+#endif // wxUSE_THREADS
+
+    // Reset to null when the loader is destroyed.
+    wxImageLoader* loader;
+};
+
+// ============================================================================
+// wxImageLoader implementation
+// ============================================================================
+
+wxImageLoader::wxImageLoader(wxEvtHandler* handler, size_t maxCacheSize)
+    : m_handler(handler),
+      m_maxCacheSize(maxCacheSize),
+      m_state(std::make_shared<SharedState>(this))
+{
+    wxASSERT_MSG( handler, "must have a valid handler" );
+
+    Bind(wxEVT_IMAGE_LOADED, &wxImageLoader::OnLoaded, this);
+}
+
+wxImageLoader::~wxImageLoader()
+{
+    // The worker threads may still be running, ensure they don't use this
+    // object any more.
+#if wxUSE_THREADS
+    wxMutexLocker lock(m_state->mutex);
+#endif // wxUSE_THREADS
+
+    m_state->loader = nullptr;
+}
+
+/* static */
+wxString wxImageLoader::MakeKey(const wxString& path, const wxSize& size)
+{
+    // Avoid the error message from wxFileModificationTime() if the file
+    // doesn't exist, loading it will fail anyhow in this case.
+    const time_t mtime = wxFileExists(path) ? wxFileModificationTime(path) : 0;
+
+    return wxString::Format("%lld:%d:%d:%s",
+                            static_cast<wxLongLong_t>(mtime),
+                            size.x, size.y, path);
+}
+
+void wxImageLoader::Load(const wxString& path,
+                         const wxSize& size,
+                         wxBitmapType type)
+{
+    const wxString key = MakeKey(path, size);
+
+    const wxImage image = GetCached(path, size);
+    if ( image.IsOk() )
+    {
+        // Still notify the handler asynchronously for consistency.
+        SendLoadedEvent(path, image);
+        return;
+    }
+
+    // Don't load the same image more than once simultaneously, the handler
+    // will get the event when the first load completes.
+    if ( !m_loading.emplace(key, path).second )
+        return;
+
+    const std::shared_ptr<SharedState> state = m_state;
+    auto task = [state, key, path, size, type]()
+    {
+        wxThreadEvent* const event = new wxThreadEvent(wxEVT_IMAGE_LOADED);
+        event->SetString(key);
+
+        // Note that the image must not be referenced from this thread after
+        // passing it to the event, as wxImage reference counting is not
+        // thread-safe, hence we don't use any local variable for it.
+        event->SetPayload(DoLoadImage(path, size, type));
+
+#if wxUSE_THREADS
+        wxMutexLocker lock(state->mutex);
+#endif // wxUSE_THREADS
+
+        if ( state->loader )
+            state->loader->QueueEvent(event);
+        else
+            delete event;
+    };
+
+#if wxUSE_THREADS
+    wxThreadPool::Get().QueueTask(task);
+#else // !wxUSE_THREADS
+    task();
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+wxImage wxImageLoader::GetCached(const wxString& path, const wxSize& size)
+{
+    const auto it = m_cacheMap.find(MakeKey(path, size));
+    if ( it == m_cacheMap.end() )
+        return wxImage();
+
+    // Move the entry to the front as it's now the most recently used one.
+    m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+
+    return it->second->image;
+}
+
+bool wxImageLoader::IsLoading(const wxString& path, const wxSize& size) const
+{
+    return m_loading.count(MakeKey(path, size)) != 0;
+}
+
+void wxImageLoader::SetMaxCacheSize(size_t maxCacheSize)
+{
+    m_maxCacheSize = maxCacheSize;
+
+    TrimCache(m_maxCacheSize);
+}
+
+void wxImageLoader::ClearCache()
+{
+    m_cacheList.clear();
+    m_cacheMap.clear();
+    m_cacheSize = 0;
+}
+
+void wxImageLoader::AddToCache(const wxString& key, const wxImage& image)
+{
+    const size_t size = GetImageDataSize(image);
+
+    // Don't bother caching images which wouldn't fit into it anyhow.
+    if ( size > m_maxCacheSize )
+        return;
+
+    const auto it = m_cacheMap.find(key);
+    if ( it != m_cacheMap.end() )
+    {
+        m_cacheSize -= it->second->size;
+        m_cacheList.erase(it->second);
+        m_cacheMap.erase(it);
+    }
+
+    TrimCache(m_maxCacheSize - size);
+
+    m_cacheList.push_front(CacheEntry{key, image, size});
+    m_cacheMap[key] = m_cacheList.begin();
+    m_cacheSize += size;
+}
+
+void wxImageLoader::TrimCache(size_t maxCacheSize)
+{
+    while ( m_cacheSize > maxCacheSize )
+    {
+        const CacheEntry& entry = m_cacheList.back();
+        m_cacheSize -= entry.size;
+        m_cacheMap.erase(entry.key);
+        m_cacheList.pop_back();
+    }
+}
+
+void wxImageLoader::SendLoadedEvent(const wxString& path, const wxImage& image)
+{
+    wxThreadEvent* const event = new wxThreadEvent(wxEVT_IMAGE_LOADED);
+    event->SetString(path);
+    event->SetPayload(image);
+
+    m_handler->QueueEvent(event);
+}
+
+void wxImageLoader::OnLoaded(wxThreadEvent& event)
+{
+    const wxString key = event.GetString();
+
+    const auto it = m_loading.find(key);
+    wxCHECK_RET( it != m_loading.end(), "unexpected image loaded event" );
+
+    const wxString path = it->second;
+    m_loading.erase(it);
+
+    const wxImage image = event.GetPayload<wxImage>();
+    if ( image.IsOk() )
+        AddToCache(key, image);
+
+    SendLoadedEvent(path, image);
+}
+
+#endif // wxUSE_IMAGE
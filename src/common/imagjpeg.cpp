@@ -38,6 +38,7 @@
 
 #include "wx/filefn.h"
 #include "wx/wfstream.h"
+#include "wx/vector.h"
 
 // For memcpy
 #include <string.h>
@@ -223,6 +224,101 @@ static inline void wx_cmyk_to_rgb(unsigned char* rgb, const unsigned char* cmyk)
     rgb[2] = (unsigned char)((c > 255) ? 0 : (255 - c));
 }
 
+// set up the output colour space and scale after reading the header, return
+// the number of bytes per pixel in the decoded scanlines
+static int wx_jpeg_setup_output(j_decompress_ptr cinfo,
+                                unsigned maxWidth,
+                                unsigned maxHeight,
+                                unsigned desiredWidth,
+                                unsigned desiredHeight)
+{
+    int bytesPerPixel;
+    if ((cinfo->out_color_space == JCS_CMYK) || (cinfo->out_color_space == JCS_YCCK))
+    {
+        cinfo->out_color_space = JCS_CMYK;
+        bytesPerPixel = 4;
+    }
+    else // all the rest is treated as RGB
+    {
+        cinfo->out_color_space = JCS_RGB;
+        bytesPerPixel = 3;
+    }
+
+    // use the smallest scale at which the picture is still at least of the
+    // desired size, as decoding at reduced scale is much faster
+    if ( desiredWidth > 0 || desiredHeight > 0 )
+    {
+        for ( unsigned denom = 8; denom > 1; denom /= 2 )
+        {
+            cinfo->scale_num = 1;
+            cinfo->scale_denom = denom;
+            jpeg_calc_output_dimensions(cinfo);
+
+            if ( cinfo->output_width >= desiredWidth &&
+                    cinfo->output_height >= desiredHeight )
+                break;
+
+            cinfo->scale_denom = 1;
+        }
+    }
+
+    // scale the picture to fit in the specified max size if necessary
+    if ( maxWidth > 0 || maxHeight > 0 )
+    {
+        unsigned& scale = cinfo->scale_denom;
+        while ( (maxWidth && (cinfo->image_width / scale > maxWidth)) ||
+                    (maxHeight && (cinfo->image_height / scale > maxHeight)) )
+        {
+            scale *= 2;
+        }
+    }
+
+    return bytesPerPixel;
+}
+
+// copy the decoded scanline to the image RGB data
+static void wx_jpeg_copy_row(j_decompress_ptr cinfo,
+                             unsigned char* ptr,
+                             const JSAMPLE* row)
+{
+    if (cinfo->out_color_space == JCS_RGB)
+    {
+        memcpy( ptr, row, cinfo->output_width * 3 );
+    }
+    else // CMYK
+    {
+        const unsigned char* inptr = (const unsigned char*) row;
+        for (size_t i = 0; i < cinfo->output_width; i++)
+        {
+            wx_cmyk_to_rgb(ptr, inptr);
+            ptr += 3;
+            inptr += 4;
+        }
+    }
+}
+
+// set the image options using the information from the JPEG header
+static void wx_jpeg_set_image_info(j_decompress_ptr cinfo, wxImage* image)
+{
+    // set up resolution if available: it's part of optional JFIF APP0 chunk
+    if ( cinfo->saw_JFIF_marker )
+    {
+        image->SetOption(wxIMAGE_OPTION_RESOLUTIONX, cinfo->X_density);
+        image->SetOption(wxIMAGE_OPTION_RESOLUTIONY, cinfo->Y_density);
+
+        // we use the same values for this option as libjpeg so we don't need
+        // any conversion here
+        image->SetOption(wxIMAGE_OPTION_RESOLUTIONUNIT, cinfo->density_unit);
+    }
+
+    if ( cinfo->image_width != cinfo->output_width || cinfo->image_height != cinfo->output_height )
+    {
+        // save the original image size
+        image->SetOption(wxIMAGE_OPTION_ORIGINAL_WIDTH, cinfo->image_width);
+        image->SetOption(wxIMAGE_OPTION_ORIGINAL_HEIGHT, cinfo->image_height);
+    }
+}
+
 // temporarily disable the warning C4611 (interaction between '_setjmp' and
 // C++ object destruction is non-portable) - I don't see any dtors here
 #ifdef __VISUALC__
@@ -239,7 +335,9 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
 
     // save this before calling Destroy()
     const unsigned maxWidth = image->GetOptionInt(wxIMAGE_OPTION_MAX_WIDTH),
-                   maxHeight = image->GetOptionInt(wxIMAGE_OPTION_MAX_HEIGHT);
+                   maxHeight = image->GetOptionInt(wxIMAGE_OPTION_MAX_HEIGHT),
+                   desiredWidth = image->GetOptionInt(wxIMAGE_OPTION_DESIRED_WIDTH),
+                   desiredHeight = image->GetOptionInt(wxIMAGE_OPTION_DESIRED_HEIGHT);
     image->Destroy();
 
     cinfo.err = jpeg_std_error( &jerr );
@@ -267,28 +365,8 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     wx_jpeg_io_src( &cinfo, stream );
     jpeg_read_header( &cinfo, TRUE );
 
-    int bytesPerPixel;
-    if ((cinfo.out_color_space == JCS_CMYK) || (cinfo.out_color_space == JCS_YCCK))
-    {
-        cinfo.out_color_space = JCS_CMYK;
-        bytesPerPixel = 4;
-    }
-    else // all the rest is treated as RGB
-    {
-        cinfo.out_color_space = JCS_RGB;
-        bytesPerPixel = 3;
-    }
-
-    // scale the picture to fit in the specified max size if necessary
-    if ( maxWidth > 0 || maxHeight > 0 )
-    {
-        unsigned& scale = cinfo.scale_denom;
-        while ( (maxWidth && (cinfo.image_width / scale > maxWidth)) ||
-                    (maxHeight && (cinfo.image_height / scale > maxHeight)) )
-        {
-            scale *= 2;
-        }
-    }
+    const int bytesPerPixel = wx_jpeg_setup_output(&cinfo, maxWidth, maxHeight,
+                                                   desiredWidth, desiredHeight);
 
     jpeg_start_decompress( &cinfo );
 
@@ -308,44 +386,244 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     while ( cinfo.output_scanline < cinfo.output_height )
     {
         jpeg_read_scanlines( &cinfo, tempbuf, 1 );
-        if (cinfo.out_color_space == JCS_RGB)
+        wx_jpeg_copy_row( &cinfo, ptr, tempbuf[0] );
+        ptr += cinfo.output_width * 3;
+    }
+
+    wx_jpeg_set_image_info( &cinfo, image );
+
+    jpeg_finish_decompress( &cinfo );
+    jpeg_destroy_decompress( &cinfo );
+    return true;
+}
+
+//------------- Incremental decoding
+
+// Source manager used by the incremental decoder: instead of reading the data
+// from a stream, it uses the data pushed into wxJPEGDecoder and suspends the
+// decoding if there are not enough of them yet.
+typedef struct {
+    struct jpeg_source_mgr pub;   /* public fields */
+
+    size_t skip;                  /* bytes to skip in the data to come */
+} wx_push_source_mgr;
+
+typedef wx_push_source_mgr * wx_push_src_ptr;
+
+extern "C"
+{
+
+CPP_METHODDEF(boolean) wx_push_fill_input_buffer ( j_decompress_ptr WXUNUSED(cinfo) )
+{
+    // Returning FALSE suspends the decoder until more data are available.
+    return FALSE;
+}
+
+CPP_METHODDEF(void) wx_push_skip_input_data ( j_decompress_ptr cinfo, long num_bytes )
+{
+    if (num_bytes > 0)
+    {
+        wx_push_src_ptr src = (wx_push_src_ptr) cinfo->src;
+
+        if ((size_t)num_bytes > src->pub.bytes_in_buffer)
         {
-            memcpy( ptr, tempbuf[0], stride );
-            ptr += stride;
+            // skip the rest when we get it
+            src->skip += (size_t)num_bytes - src->pub.bytes_in_buffer;
+            num_bytes = (long)src->pub.bytes_in_buffer;
         }
-        else // CMYK
+
+        src->pub.next_input_byte += (size_t) num_bytes;
+        src->pub.bytes_in_buffer -= (size_t) num_bytes;
+    }
+}
+
+CPP_METHODDEF(void) wx_push_term_source ( j_decompress_ptr WXUNUSED(cinfo) )
+{
+}
+
+} // extern "C"
+
+namespace
+{
+
+class wxJPEGDecoder : public wxImageDecoder
+{
+public:
+    explicit wxJPEGDecoder(bool verbose)
+        : wxImageDecoder(verbose)
+    {
+    }
+
+    virtual ~wxJPEGDecoder() override
+    {
+        if ( m_created )
+            jpeg_destroy_decompress(&m_cinfo);
+    }
+
+    bool Create();
+
+protected:
+    virtual bool DoFeed(const unsigned char* data, size_t size) override;
+
+private:
+    // Append the new data to the data not consumed by libjpeg yet.
+    void AppendData(const unsigned char* data, size_t size);
+
+    enum Stage
+    {
+        Stage_Header,
+        Stage_Start,
+        Stage_Rows,
+        Stage_Finish
+    };
+
+    struct jpeg_decompress_struct m_cinfo;
+    wx_error_mgr m_jerr;
+    bool m_created = false;
+
+    Stage m_stage = Stage_Header;
+
+    wxVector<JOCTET> m_buffer;
+    JSAMPARRAY m_row = nullptr;
+};
+
+bool wxJPEGDecoder::Create()
+{
+    m_cinfo.err = jpeg_std_error( &m_jerr );
+    m_jerr.error_exit = wx_error_exit;
+
+    if (!IsVerbose())
+        m_cinfo.err->output_message = wx_ignore_message;
+
+    if (setjmp(m_jerr.setjmp_buffer))
+        return false;
+
+    jpeg_create_decompress( &m_cinfo );
+    m_created = true;
+
+    wx_push_src_ptr src = (wx_push_src_ptr)
+        (*m_cinfo.mem->alloc_small) ((j_common_ptr) &m_cinfo, JPOOL_PERMANENT,
+        sizeof(wx_push_source_mgr));
+
+    src->pub.bytes_in_buffer = 0;
+    src->pub.next_input_byte = nullptr;
+    src->skip = 0;
+
+    src->pub.init_source = wx_init_source;
+    src->pub.fill_input_buffer = wx_push_fill_input_buffer;
+    src->pub.skip_input_data = wx_push_skip_input_data;
+    src->pub.resync_to_restart = jpeg_resync_to_restart; /* use default method */
+    src->pub.term_source = wx_push_term_source;
+
+    m_cinfo.src = &src->pub;
+
+    return true;
+}
+
+void wxJPEGDecoder::AppendData(const unsigned char* data, size_t size)
+{
+    wx_push_src_ptr src = (wx_push_src_ptr) m_cinfo.src;
+
+    // Throw away the data which were already consumed.
+    m_buffer.erase(m_buffer.begin(),
+                   m_buffer.end() - (ptrdiff_t)src->pub.bytes_in_buffer);
+
+    // Skip the data which libjpeg asked to skip before we had them.
+    const size_t skip = wxMin(src->skip, size);
+    src->skip -= skip;
+
+    m_buffer.insert(m_buffer.end(), data + skip, data + size);
+
+    src->pub.next_input_byte = m_buffer.empty() ? nullptr : &m_buffer[0];
+    src->pub.bytes_in_buffer = m_buffer.size();
+}
+
+bool wxJPEGDecoder::DoFeed(const unsigned char* data, size_t size)
+{
+    AppendData(data, size);
+
+    /* Establish the setjmp return context for wx_error_exit to use. */
+    if (setjmp(m_jerr.setjmp_buffer))
+    {
+        if (IsVerbose())
         {
-            const unsigned char* inptr = (const unsigned char*) tempbuf[0];
-            for (size_t i = 0; i < cinfo.output_width; i++)
-            {
-                wx_cmyk_to_rgb(ptr, inptr);
-                ptr += 3;
-                inptr += 4;
-            }
+            wxLogError(_("JPEG: Couldn't load - file is probably corrupted."));
         }
+
+        return false;
     }
 
-    // set up resolution if available: it's part of optional JFIF APP0 chunk
-    if ( cinfo.saw_JFIF_marker )
+    // Note that all libjpeg functions called below return without doing
+    // anything if there is not enough data yet, in which case we just return
+    // and continue from the same stage when we get more data.
+    switch ( m_stage )
     {
-        image->SetOption(wxIMAGE_OPTION_RESOLUTIONX, cinfo.X_density);
-        image->SetOption(wxIMAGE_OPTION_RESOLUTIONY, cinfo.Y_density);
+        case Stage_Header:
+            if ( jpeg_read_header( &m_cinfo, TRUE ) == JPEG_SUSPENDED )
+                return true;
 
-        // we use the same values for this option as libjpeg so we don't need
-        // any conversion here
-        image->SetOption(wxIMAGE_OPTION_RESOLUTIONUNIT, cinfo.density_unit);
+            wx_jpeg_setup_output( &m_cinfo, 0, 0, 0, 0 );
+
+            m_stage = Stage_Start;
+            wxFALLTHROUGH;
+
+        case Stage_Start:
+            if ( !jpeg_start_decompress( &m_cinfo ) )
+                return true;
+
+            m_image.Create( m_cinfo.output_width, m_cinfo.output_height );
+            if ( !m_image.IsOk() )
+                return false;
+
+            m_row = (*m_cinfo.mem->alloc_sarray)
+                        ((j_common_ptr) &m_cinfo, JPOOL_IMAGE,
+                         m_cinfo.output_width * m_cinfo.output_components, 1 );
+
+            wx_jpeg_set_image_info( &m_cinfo, &m_image );
+
+            m_stage = Stage_Rows;
+            wxFALLTHROUGH;
+
+        case Stage_Rows:
+            while ( m_cinfo.output_scanline < m_cinfo.output_height )
+            {
+                const unsigned y = m_cinfo.output_scanline;
+                if ( jpeg_read_scanlines( &m_cinfo, m_row, 1 ) != 1 )
+                    return true;
+
+                wx_jpeg_copy_row( &m_cinfo,
+                                  m_image.GetData() + 3 * (size_t)m_cinfo.output_width * y,
+                                  m_row[0] );
+
+                NotifyRowsDecoded( y, 1 );
+            }
+
+            m_stage = Stage_Finish;
+            wxFALLTHROUGH;
+
+        case Stage_Finish:
+            if ( !jpeg_finish_decompress( &m_cinfo ) )
+                return true;
+
+            SetDone();
+            break;
     }
 
-    if ( cinfo.image_width != cinfo.output_width || cinfo.image_height != cinfo.output_height )
+    return true;
+}
+
+} // anonymous namespace
+
+wxImageDecoder* wxJPEGHandler::CreateDecoder(bool verbose)
+{
+    wxJPEGDecoder* const decoder = new wxJPEGDecoder(verbose);
+    if ( !decoder->Create() )
     {
-        // save the original image size
-        image->SetOption(wxIMAGE_OPTION_ORIGINAL_WIDTH, cinfo.image_width);
-        image->SetOption(wxIMAGE_OPTION_ORIGINAL_HEIGHT, cinfo.image_height);
+        delete decoder;
+        return nullptr;
     }
 
-    jpeg_finish_decompress( &cinfo );
-    jpeg_destroy_decompress( &cinfo );
-    return true;
+    return decoder;
 }
 
 typedef struct {
@@ -96,54 +96,147 @@ struct wxPNGInfoStruct
 
 #define WX_PNG_INFO(png_ptr) ((wxPNGInfoStruct*)png_get_io_ptr(png_ptr))
 
-// This is another helper struct which is used to pass parameters to
-// DoLoadPNGFile(). It allows us to use the usual RAII for freeing memory,
-// which wouldn't be possible inside DoLoadPNGFile() because it uses
-// setjmp/longjmp() functions for error handling, which are incompatible with
-// C++ destructors.
-struct wxPNGImageData
+// Helper class storing the rows decoded by libpng in wxImage directly,
+// without using any intermediate buffer for the entire image.
+class wxPNGRowWriter
 {
-    wxPNGImageData()
+public:
+    wxPNGRowWriter() = default;
+
+    ~wxPNGRowWriter()
     {
-        lines = nullptr;
-        m_buf = nullptr;
-        info_ptr = (png_infop) nullptr;
-        png_ptr = (png_structp) nullptr;
-        ok = false;
+        free(m_row);
     }
 
-    bool Alloc(png_uint_32 width, png_uint_32 height, unsigned char* buf)
+    // Create the image of the given size: if the rows decoded by libpng have
+    // alpha channel, they need to be converted to wxImage format, otherwise
+    // they're decoded directly into the image.
+    bool Init(wxImage* image,
+              png_uint_32 width,
+              png_uint_32 height,
+              bool hasAlpha,
+              bool interlaced)
     {
-        lines = (unsigned char **)malloc(height * sizeof(unsigned char *));
-        if ( !lines )
+        image->Create((int)width, (int)height, false /* don't init pixels */);
+        if ( !image->IsOk() )
             return false;
 
-        size_t w = width;
-        // if RGB data will be written directly to wxImage buffer
-        if (buf)
-            w *= 3;
-        else
+        m_image = image;
+        m_width = width;
+        m_height = height;
+        m_interlaced = interlaced;
+
+        if ( hasAlpha )
         {
-            // allocate intermediate RGBA buffer
-            w *= 4;
-            buf =
-            m_buf = static_cast<unsigned char*>(malloc(w * height));
-            if (!m_buf)
+            m_row = static_cast<unsigned char*>(malloc(4 * (size_t)width));
+            if ( !m_row )
                 return false;
         }
 
-        lines[0] = buf;
-        for (png_uint_32 i = 1; i < height; i++)
-            lines[i] = lines[i - 1] + w;
-
         return true;
     }
 
-    ~wxPNGImageData()
+    // Return the buffer for libpng to decode the given row into. For the
+    // interlaced images, it contains the pixels of this row decoded during
+    // the previous passes.
+    unsigned char* GetRowBuffer(png_uint_32 y)
+    {
+        unsigned char* ptrData = m_image->GetData() + 3 * (size_t)m_width * y;
+        if ( !m_row )
+            return ptrData;
+
+        if ( m_interlaced )
+        {
+            const unsigned char*
+                ptrAlpha = m_alpha ? m_alpha + (size_t)m_width * y : nullptr;
+
+            unsigned char* ptrDst = m_row;
+            for ( png_uint_32 x = 0; x < m_width; x++ )
+            {
+                *ptrDst++ = *ptrData++;
+                *ptrDst++ = *ptrData++;
+                *ptrDst++ = *ptrData++;
+                *ptrDst++ = ptrAlpha ? *ptrAlpha++ : 0xff;
+            }
+        }
+
+        return m_row;
+    }
+
+    // Store the row decoded into the buffer returned by GetRowBuffer().
+    void StoreRow(png_uint_32 y)
+    {
+        if ( !m_row )
+            return;
+
+        unsigned char* ptrDst = m_image->GetData() + 3 * (size_t)m_width * y;
+        unsigned char* alpha = m_alpha ? m_alpha + (size_t)m_width * y : nullptr;
+
+        const unsigned char* ptrSrc = m_row;
+        for ( png_uint_32 x = 0; x < m_width; x++ )
+        {
+            unsigned char r = *ptrSrc++;
+            unsigned char g = *ptrSrc++;
+            unsigned char b = *ptrSrc++;
+            unsigned char a = *ptrSrc++;
+
+            // the first time we encounter a transparent pixel we must
+            // allocate alpha channel for the image
+            if ( !IsOpaque(a) && !alpha )
+                alpha = InitAlpha() + (size_t)m_width * y + x;
+
+            if ( alpha )
+                *alpha++ = a;
+
+            *ptrDst++ = r;
+            *ptrDst++ = g;
+            *ptrDst++ = b;
+        }
+    }
+
+private:
+    // Create the alpha channel for the image and make all its pixels opaque,
+    // as all the pixels decoded so far were.
+    unsigned char* InitAlpha()
     {
-        free(m_buf);
-        free( lines );
+        m_image->SetAlpha();
+
+        m_alpha = m_image->GetAlpha();
+        memset(m_alpha, 0xff, (size_t)m_width * m_height);
+
+        return m_alpha;
+    }
+
+    wxImage* m_image = nullptr;
+    png_uint_32 m_width = 0,
+                m_height = 0;
+    bool m_interlaced = false;
+
+    // Temporary RGBA buffer, only used if the image has alpha.
+    unsigned char* m_row = nullptr;
+
+    // Alpha channel of the image, only allocated if it's really needed.
+    unsigned char* m_alpha = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(wxPNGRowWriter);
+};
 
+// This is another helper struct which is used to pass parameters to
+// DoLoadPNGFile(). It allows us to use the usual RAII for freeing memory,
+// which wouldn't be possible inside DoLoadPNGFile() because it uses
+// setjmp/longjmp() functions for error handling, which are incompatible with
+// C++ destructors.
+struct wxPNGImageData
+{
+    wxPNGImageData()
+    {
+        info_ptr = (png_infop) nullptr;
+        png_ptr = (png_structp) nullptr;
+        ok = false;
+    }
+
+    ~wxPNGImageData()
+    {
         if ( png_ptr )
         {
             if ( info_ptr )
@@ -155,8 +248,7 @@ struct wxPNGImageData
 
     void DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo);
 
-    unsigned char** lines;
-    unsigned char* m_buf;
+    wxPNGRowWriter writer;
     png_infop info_ptr;
     png_structp png_ptr;
     bool ok;
@@ -212,140 +304,29 @@ PNGLINKAGEMODE wx_PNG_error(png_structp png_ptr, png_const_charp message)
 // LoadFile() helpers
 // ----------------------------------------------------------------------------
 
-// init the alpha channel for the image and fill it with 1s up to (x, y)
-static
-unsigned char *InitAlpha(wxImage *image, png_uint_32 x, png_uint_32 y)
+// set up libpng to produce either RGB or RGBA rows, return the number of
+// passes needed for reading the image (more than 1 if it's interlaced)
+static int SetupPNGTransforms(png_structp png_ptr, png_infop info_ptr)
 {
-    // create alpha channel
-    image->SetAlpha();
-
-    unsigned char *alpha = image->GetAlpha();
-
-    // set alpha for the pixels we had so far
-    png_uint_32 end = y * image->GetWidth() + x;
-    // all the previous pixels were opaque
-    memset(alpha, 0xff, end);
-
-    return alpha + end;
-}
-
-// ----------------------------------------------------------------------------
-// reading PNGs
-// ----------------------------------------------------------------------------
-
-bool wxPNGHandler::DoCanRead( wxInputStream& stream )
-{
-    unsigned char hdr[4];
-
-    if ( !stream.Read(hdr, WXSIZEOF(hdr)) )     // it's ok to modify the stream position here
-        return false;
-
-    return memcmp(hdr, "\211PNG", WXSIZEOF(hdr)) == 0;
-}
-
-// convert data from RGB to wxImage format
-static
-void CopyDataFromPNG(wxImage *image,
-                     unsigned char **lines,
-                     png_uint_32 width,
-                     png_uint_32 height)
-{
-    // allocated on demand if we have any non-opaque pixels
-    unsigned char *alpha = nullptr;
-
-    unsigned char *ptrDst = image->GetData();
-    {
-        for ( png_uint_32 y = 0; y < height; y++ )
-        {
-            const unsigned char *ptrSrc = lines[y];
-            for ( png_uint_32 x = 0; x < width; x++ )
-            {
-                unsigned char r = *ptrSrc++;
-                unsigned char g = *ptrSrc++;
-                unsigned char b = *ptrSrc++;
-                unsigned char a = *ptrSrc++;
-
-                // the first time we encounter a transparent pixel we must
-                // allocate alpha channel for the image
-                if ( !IsOpaque(a) && !alpha )
-                    alpha = InitAlpha(image, x, y);
-
-                if ( alpha )
-                    *alpha++ = a;
-
-                *ptrDst++ = r;
-                *ptrDst++ = g;
-                *ptrDst++ = b;
-            }
-        }
-    }
-}
-
-// temporarily disable the warning C4611 (interaction between '_setjmp' and
-// C++ object destruction is non-portable) - I don't see any dtors here
-#ifdef __VISUALC__
-    #pragma warning(disable:4611)
-#endif /* VC++ */
-
-// This function uses wxPNGImageData to store some of its "local" variables in
-// order to avoid clobbering these variables by longjmp(): having them inside
-// the stack frame of the caller prevents this from happening. It also
-// "returns" its result via wxPNGImageData: use its "ok" field to check
-// whether loading succeeded or failed.
-void
-wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
-{
-    png_uint_32 width, height = 0;
-    int bit_depth, color_type;
-
-    image->Destroy();
-
-    png_ptr = png_create_read_struct
-                          (
-                            PNG_LIBPNG_VER_STRING,
-                            nullptr,
-                            wx_PNG_error,
-                            wx_PNG_warning
-                          );
-    if (!png_ptr)
-        return;
-
-    // NB: please see the comment near wxPNGInfoStruct declaration for
-    //     explanation why this line is mandatory
-    png_set_read_fn( png_ptr, &wxinfo, wx_PNG_stream_reader);
-
-    info_ptr = png_create_info_struct( png_ptr );
-    if (!info_ptr)
-        return;
-
-    if (setjmp(wxinfo.jmpbuf))
-        return;
-
-    png_read_info( png_ptr, info_ptr );
-    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr );
-
     png_set_expand(png_ptr);
     png_set_gray_to_rgb(png_ptr);
     png_set_strip_16( png_ptr );
     png_set_packing( png_ptr );
 
-    image->Create((int)width, (int)height, (bool) false /* no need to init pixels */);
-
-    if (!image->IsOk())
-        return;
+    const int numPasses = png_set_interlace_handling(png_ptr);
 
-    const bool needCopy =
-        (color_type & PNG_COLOR_MASK_ALPHA) ||
-        png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
-
-    if (!Alloc(width, height, needCopy ? nullptr : image->GetData()))
-        return;
+    png_read_update_info(png_ptr, info_ptr);
 
-    png_read_image( png_ptr, lines );
-    png_read_end( png_ptr, info_ptr );
+    return numPasses;
+}
 
+// set the image palette and resolution from the PNG info
+static void SetImageInfoFromPNG(wxImage* image,
+                                png_structp png_ptr,
+                                png_infop info_ptr)
+{
 #if wxUSE_PALETTE
-    if (color_type == PNG_COLOR_TYPE_PALETTE)
+    if (png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE)
     {
         png_colorp palette = nullptr;
         int numPalette = 0;
@@ -409,11 +390,86 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
 
         image->SetOption(wxIMAGE_OPTION_RESOLUTIONUNIT, res);
     }
+}
 
+// ----------------------------------------------------------------------------
+// reading PNGs
+// ----------------------------------------------------------------------------
+
+bool wxPNGHandler::DoCanRead( wxInputStream& stream )
+{
+    unsigned char hdr[4];
 
-    // loaded successfully, now init wxImage with this data
-    if (needCopy)
-        CopyDataFromPNG(image, lines, width, height);
+    if ( !stream.Read(hdr, WXSIZEOF(hdr)) )     // it's ok to modify the stream position here
+        return false;
+
+    return memcmp(hdr, "\211PNG", WXSIZEOF(hdr)) == 0;
+}
+
+// temporarily disable the warning C4611 (interaction between '_setjmp' and
+// C++ object destruction is non-portable) - I don't see any dtors here
+#ifdef __VISUALC__
+    #pragma warning(disable:4611)
+#endif /* VC++ */
+
+// This function uses wxPNGImageData to store some of its "local" variables in
+// order to avoid clobbering these variables by longjmp(): having them inside
+// the stack frame of the caller prevents this from happening. It also
+// "returns" its result via wxPNGImageData: use its "ok" field to check
+// whether loading succeeded or failed.
+void
+wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
+{
+    png_uint_32 width, height = 0;
+    int bit_depth, color_type;
+
+    image->Destroy();
+
+    png_ptr = png_create_read_struct
+                          (
+                            PNG_LIBPNG_VER_STRING,
+                            nullptr,
+                            wx_PNG_error,
+                            wx_PNG_warning
+                          );
+    if (!png_ptr)
+        return;
+
+    // NB: please see the comment near wxPNGInfoStruct declaration for
+    //     explanation why this line is mandatory
+    png_set_read_fn( png_ptr, &wxinfo, wx_PNG_stream_reader);
+
+    info_ptr = png_create_info_struct( png_ptr );
+    if (!info_ptr)
+        return;
+
+    if (setjmp(wxinfo.jmpbuf))
+        return;
+
+    png_read_info( png_ptr, info_ptr );
+    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr );
+
+    const int numPasses = SetupPNGTransforms(png_ptr, info_ptr);
+
+    // Decode the image row by row directly into wxImage, this avoids having
+    // to allocate memory for the intermediate copy of the entire image.
+    if ( !writer.Init(image, width, height,
+                      png_get_channels(png_ptr, info_ptr) == 4,
+                      numPasses > 1) )
+        return;
+
+    for ( int pass = 0; pass < numPasses; pass++ )
+    {
+        for ( png_uint_32 y = 0; y < height; y++ )
+        {
+            png_read_row( png_ptr, writer.GetRowBuffer(y), nullptr );
+            writer.StoreRow(y);
+        }
+    }
+
+    png_read_end( png_ptr, info_ptr );
+
+    SetImageInfoFromPNG(image, png_ptr, info_ptr);
 
     // This will indicate to the caller that loading succeeded.
     ok = true;
@@ -450,6 +506,214 @@ wxPNGHandler::LoadFile(wxImage *image,
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// incremental decoding
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class wxPNGDecoder;
+
+// Progressive reader uses the same pointer for I/O and for the callbacks, so
+// extend wxPNGInfoStruct (whose jmpbuf is used by our error handler) with the
+// pointer to the decoder.
+struct wxPNGDecoderInfoStruct : wxPNGInfoStruct
+{
+    wxPNGDecoder* decoder;
+};
+
+class wxPNGDecoder : public wxImageDecoder
+{
+public:
+    explicit wxPNGDecoder(bool verbose);
+    virtual ~wxPNGDecoder() override;
+
+    bool Create();
+
+    // Called by libpng callbacks.
+    void OnInfo();
+    void OnRow(png_bytep row, png_uint_32 y, int pass);
+    void OnEnd();
+
+protected:
+    virtual bool DoFeed(const unsigned char* data, size_t size) override;
+
+private:
+    wxPNGDecoderInfoStruct m_wxinfo;
+    wxPNGRowWriter m_writer;
+    png_structp m_png_ptr = nullptr;
+    png_infop m_info_ptr = nullptr;
+
+    // True if the rows are passed to OnRow() once per interlacing pass.
+    bool m_interlaced = false;
+};
+
+} // anonymous namespace
+
+extern "C"
+{
+
+static void
+PNGLINKAGEMODE wx_PNG_info_callback(png_structp png_ptr, png_infop WXUNUSED(info_ptr))
+{
+    static_cast<wxPNGDecoderInfoStruct*>(WX_PNG_INFO(png_ptr))->decoder->OnInfo();
+}
+
+static void
+PNGLINKAGEMODE wx_PNG_row_callback(png_structp png_ptr, png_bytep new_row,
+                                   png_uint_32 row_num, int pass)
+{
+    static_cast<wxPNGDecoderInfoStruct*>(WX_PNG_INFO(png_ptr))->decoder->OnRow(new_row, row_num, pass);
+}
+
+static void
+PNGLINKAGEMODE wx_PNG_end_callback(png_structp png_ptr, png_infop WXUNUSED(info_ptr))
+{
+    static_cast<wxPNGDecoderInfoStruct*>(WX_PNG_INFO(png_ptr))->decoder->OnEnd();
+}
+
+} // extern "C"
+
+wxPNGDecoder::wxPNGDecoder(bool verbose)
+    : wxImageDecoder(verbose)
+{
+    m_wxinfo.verbose = verbose;
+    m_wxinfo.stream.in = nullptr;
+    m_wxinfo.decoder = this;
+}
+
+wxPNGDecoder::~wxPNGDecoder()
+{
+    if ( m_png_ptr )
+    {
+        if ( m_info_ptr )
+            png_destroy_read_struct( &m_png_ptr, &m_info_ptr, (png_infopp) nullptr );
+        else
+            png_destroy_read_struct( &m_png_ptr, (png_infopp) nullptr, (png_infopp) nullptr );
+    }
+}
+
+bool wxPNGDecoder::Create()
+{
+    m_png_ptr = png_create_read_struct
+                          (
+                            PNG_LIBPNG_VER_STRING,
+                            nullptr,
+                            wx_PNG_error,
+                            wx_PNG_warning
+                          );
+    if ( !m_png_ptr )
+        return false;
+
+    m_info_ptr = png_create_info_struct( m_png_ptr );
+    if ( !m_info_ptr )
+        return false;
+
+    // NB: this uses the same trick as png_set_read_fn() in DoLoadPNGFile(),
+    //     see the comment near wxPNGInfoStruct declaration
+    png_set_progressive_read_fn(m_png_ptr,
+                                static_cast<wxPNGInfoStruct*>(&m_wxinfo),
+                                wx_PNG_info_callback,
+                                wx_PNG_row_callback,
+                                wx_PNG_end_callback);
+
+    return true;
+}
+
+bool wxPNGDecoder::DoFeed(const unsigned char* data, size_t size)
+{
+    if ( setjmp(m_wxinfo.jmpbuf) )
+    {
+        if ( IsVerbose() )
+        {
+           wxLogError(_("Couldn't load a PNG image - file is corrupted or not enough memory."));
+        }
+
+        return false;
+    }
+
+    png_process_data(m_png_ptr, m_info_ptr, const_cast<png_bytep>(data), size);
+
+    return true;
+}
+
+void wxPNGDecoder::OnInfo()
+{
+    png_uint_32 width, height;
+    int bit_depth, color_type;
+    png_get_IHDR( m_png_ptr, m_info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr );
+
+    const int numPasses = SetupPNGTransforms(m_png_ptr, m_info_ptr);
+    m_interlaced = numPasses > 1;
+
+    if ( !m_writer.Init(&m_image, width, height,
+                        png_get_channels(m_png_ptr, m_info_ptr) == 4,
+                        numPasses > 1) )
+    {
+        // We can't continue without the image, so abort decoding.
+        longjmp(m_wxinfo.jmpbuf, 1);
+    }
+
+    // Don't show garbage in the part of the image not decoded yet.
+    m_image.Clear();
+
+    // Palette and resolution must come before the image data, so we can
+    // already set them, allowing to use them before decoding the image fully.
+    SetImageInfoFromPNG(&m_image, m_png_ptr, m_info_ptr);
+}
+
+void wxPNGDecoder::OnRow(png_bytep row, png_uint_32 y, int pass)
+{
+    // Row may be null for interlaced images if it didn't change in this pass.
+    if ( row )
+    {
+        png_progressive_combine_row(m_png_ptr, m_writer.GetRowBuffer(y), row);
+        m_writer.StoreRow(y);
+    }
+
+    // Interlaced images rows are passed to us once per pass, only notify
+    // about them after the last pass containing any of their pixels.
+    if ( m_interlaced )
+    {
+        const png_uint_32 width = png_get_image_width(m_png_ptr, m_info_ptr);
+
+        int lastPass = 6;
+        while ( lastPass > 0 &&
+                    (!PNG_ROW_IN_INTERLACE_PASS(y, lastPass) ||
+                        PNG_PASS_COLS(width, lastPass) == 0) )
+        {
+            lastPass--;
+        }
+
+        if ( pass != lastPass )
+            return;
+    }
+    else if ( !row )
+    {
+        return;
+    }
+
+    NotifyRowsDecoded((int)y, 1);
+}
+
+void wxPNGDecoder::OnEnd()
+{
+    SetDone();
+}
+
+wxImageDecoder* wxPNGHandler::CreateDecoder(bool verbose)
+{
+    wxPNGDecoder* const decoder = new wxPNGDecoder(verbose);
+    if ( !decoder->Create() )
+    {
+        delete decoder;
+        return nullptr;
+    }
+
+    return decoder;
+}
+
 // ----------------------------------------------------------------------------
 // SaveFile() palette helpers
 // ----------------------------------------------------------------------------
@@ -288,8 +288,51 @@ TIFFwxOpen(wxOutputStream &stream, const char* name, const char* mode)
     return tif;
 }
 
+// Find the smallest reduced-resolution version of the first image in the file
+// which is still at least of the desired size, return its directory index or 0
+// if there is none. Also return the size of the full resolution image.
+static tdir_t
+TIFFFindReducedImage(TIFF* tif,
+                     wxUint32 desiredWidth, wxUint32 desiredHeight,
+                     wxUint32* fullWidth, wxUint32* fullHeight)
+{
+    TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, fullWidth );
+    TIFFGetField( tif, TIFFTAG_IMAGELENGTH, fullHeight );
+
+    tdir_t best = 0;
+    wxUint32 bestWidth = *fullWidth;
+
+    // Reduced-resolution images follow the full resolution one, so stop as
+    // soon as we find any other image.
+    for ( tdir_t dir = 1; TIFFReadDirectory(tif); dir++ )
+    {
+        wxUint32 subfileType = 0;
+        if ( !TIFFGetField(tif, TIFFTAG_SUBFILETYPE, &subfileType) ||
+                !(subfileType & FILETYPE_REDUCEDIMAGE) )
+            break;
+
+        wxUint32 w, h;
+        TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &w );
+        TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &h );
+
+        if ( w >= desiredWidth && h >= desiredHeight && w < bestWidth )
+        {
+            best = dir;
+            bestWidth = w;
+        }
+    }
+
+    return best;
+}
+
 bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int index )
 {
+    // save this before calling Destroy(), notice that the desired size is
+    // only used if no specific image index is requested
+    const wxUint32 desiredWidth = image->GetOptionInt(wxIMAGE_OPTION_DESIRED_WIDTH),
+                   desiredHeight = image->GetOptionInt(wxIMAGE_OPTION_DESIRED_HEIGHT);
+    const bool useReduced = index == -1 && (desiredWidth || desiredHeight);
+
     if (index == -1)
         index = 0;
 
@@ -319,6 +362,25 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         return false;
     }
 
+    wxUint32 fullWidth = 0,
+             fullHeight = 0;
+    if ( useReduced )
+    {
+        const tdir_t dir = TIFFFindReducedImage(tif, desiredWidth, desiredHeight,
+                                                &fullWidth, &fullHeight);
+        if ( !TIFFSetDirectory( tif, dir ) )
+        {
+            if (verbose)
+            {
+                wxLogError( _("TIFF: Error loading image.") );
+            }
+
+            TIFFClose( tif );
+
+            return false;
+        }
+    }
+
     wxUint32 w, h;
     wxUint32 *raster;
 
@@ -573,6 +635,13 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
             wxString::FromCDouble((double) resY));
     }
 
+    if ( fullWidth && (fullWidth != w || fullHeight != h) )
+    {
+        // save the original image size
+        image->SetOption(wxIMAGE_OPTION_ORIGINAL_WIDTH, fullWidth);
+        image->SetOption(wxIMAGE_OPTION_ORIGINAL_HEIGHT, fullHeight);
+    }
+
     _TIFFfree( raster );
 
     TIFFClose( tif );
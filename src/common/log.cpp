@@ -371,7 +371,13 @@ wxLog::OnLog(wxLogLevel level,
         logger = wxPerThreadLogger;
         if ( !logger )
         {
-            if ( ms_pLogger )
+            if ( ms_pLogger && ms_pLogger->IsThreadSafe() )
+            {
+                // no need to buffer anything, but also don't count the
+                // repeated messages, as this can't be done without locking
+                ms_pLogger->CallDoLogRecord(level, msg, info);
+            }
+            else if ( ms_pLogger )
             {
                 // buffer the messages until they can be shown from the main
                 // thread
@@ -425,6 +431,14 @@ wxLog::CallDoLogNow(wxLogLevel level,
         gs_prevLog.info = info;
     }
 
+    CallDoLogRecord(level, msg, info);
+}
+
+void
+wxLog::CallDoLogRecord(wxLogLevel level,
+                       const wxString& msg,
+                       const wxLogRecordInfo& info)
+{
     // handle extra data which may be passed to us by wxLogXXX()
     wxString prefix, suffix;
     wxUIntPtr num = 0;
@@ -0,0 +1,472 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/logasync.cpp
+// Purpose:     wxLogAsync implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#include "wx/logasync.h"
+
+#if wxUSE_LOG && wxUSE_THREADS && wxUSE_STREAMS
+
+#include "wx/file.h"
+#include "wx/wfstream.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// The writer thread writes the messages at least this often, even if nothing
+// wakes it up.
+const unsigned long WRITE_INTERVAL_MS = 100;
+
+// Maximal size of the buffer accumulating the formatted messages before
+// writing them.
+const size_t MAX_BATCH_SIZE = 64*1024;
+
+std::atomic<unsigned> gs_lastLoggerId{0};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxLogAsync::Queue
+// ----------------------------------------------------------------------------
+
+// Fixed size circular buffer of log records used by a single producer thread
+// and the writer thread, without any locking.
+class wxLogAsync::Queue
+{
+public:
+    Queue(size_t size, wxThreadIdType threadId)
+        : m_records(size),
+          m_threadId(threadId)
+    {
+        wxASSERT_MSG( !(size & (size - 1)), "size must be a power of 2" );
+    }
+
+    wxThreadIdType GetThreadId() const { return m_threadId; }
+
+    // The queue is abandoned when its thread exits or switches to using
+    // another wxLogAsync object and can be deleted once it becomes empty.
+    void SetAbandoned(bool abandoned)
+    {
+        m_abandoned.store(abandoned, std::memory_order_release);
+    }
+
+    // Can only be called by the writer thread while holding m_csQueues.
+    bool CanBeDeleted() const
+    {
+        // Note that the order of checks matters here: if the queue had been
+        // abandoned, all the records pushed before it must be visible.
+        return m_abandoned.load(std::memory_order_acquire) &&
+                m_tail.value.load(std::memory_order_relaxed) ==
+                    m_head.value.load(std::memory_order_acquire);
+    }
+
+    // Add a record to the queue, must be called from the producer thread.
+    //
+    // Return the number of records in the queue after adding it or 0 if the
+    // queue is full.
+    size_t Push(wxLogLevel level,
+                const wxString& msg,
+                const wxLogRecordInfo& info)
+    {
+        const size_t head = m_head.value.load(std::memory_order_relaxed);
+        const size_t count = head - m_tail.value.load(std::memory_order_acquire);
+        if ( count == m_records.size() )
+            return 0;
+
+        // Note that assigning to the existing record reuses the memory
+        // allocated by the strings in it, if possible.
+        Record& rec = m_records[head & (m_records.size() - 1)];
+        rec.level = level;
+        rec.msg = msg;
+        rec.info = info;
+
+        m_head.value.store(head + 1, std::memory_order_release);
+
+        return count + 1;
+    }
+
+    // Call the given function for all records in the queue and remove them,
+    // must be called from the writer thread.
+    template <typename F>
+    void PopAll(F func)
+    {
+        size_t tail = m_tail.value.load(std::memory_order_relaxed);
+        const size_t head = m_head.value.load(std::memory_order_acquire);
+        while ( tail != head )
+        {
+            const Record& rec = m_records[tail & (m_records.size() - 1)];
+            func(rec.level, rec.msg, rec.info);
+
+            // Free the slot as soon as possible, in case the producer thread
+            // is waiting for it.
+            m_tail.value.store(++tail, std::memory_order_release);
+        }
+    }
+
+private:
+    struct Record
+    {
+        wxLogLevel level = wxLOG_Info;
+        wxString msg;
+        wxLogRecordInfo info;
+    };
+
+    // Index padded to occupy the entire cache line, to avoid false sharing
+    // between the producer and the writer threads.
+    struct PaddedIndex
+    {
+        std::atomic<size_t> value{0};
+        char padding[64 - sizeof(std::atomic<size_t>)];
+    };
+
+    // The index of the next record to push, only modified by the producer.
+    PaddedIndex m_head;
+
+    // The index of the next record to pop, only modified by the writer.
+    PaddedIndex m_tail;
+
+    std::vector<Record> m_records;
+
+    const wxThreadIdType m_threadId;
+
+    std::atomic<bool> m_abandoned{false};
+
+    wxDECLARE_NO_COPY_CLASS(Queue);
+};
+
+// ----------------------------------------------------------------------------
+// wxLogAsync::WriterThread
+// ----------------------------------------------------------------------------
+
+class wxLogAsync::WriterThread : public wxThread
+{
+public:
+    explicit WriterThread(wxLogAsync& log)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_log(log)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_log.WriterMain();
+
+        return nullptr;
+    }
+
+private:
+    wxLogAsync& m_log;
+
+    wxDECLARE_NO_COPY_CLASS(WriterThread);
+};
+
+// ============================================================================
+// wxLogAsync implementation
+// ============================================================================
+
+constexpr size_t wxLogAsync::DEFAULT_QUEUE_SIZE;
+
+wxLogAsync::wxLogAsync(const wxString& filename, size_t queueSize)
+    : m_id(++gs_lastLoggerId),
+      m_condWake(m_mutex),
+      m_condWritten(m_mutex)
+{
+    wxFile file;
+    if ( file.Open(filename, wxFile::write_append) )
+        m_stream.reset(new wxFileOutputStream(file.Detach()));
+
+    Init(queueSize);
+}
+
+wxLogAsync::wxLogAsync(wxOutputStream* stream, size_t queueSize)
+    : m_id(++gs_lastLoggerId),
+      m_stream(stream),
+      m_condWake(m_mutex),
+      m_condWritten(m_mutex)
+{
+    Init(queueSize);
+}
+
+void wxLogAsync::Init(size_t queueSize)
+{
+    // Round the size up to the next power of 2.
+    m_queueSize = 2;
+    while ( m_queueSize < queueSize )
+        m_queueSize *= 2;
+
+    if ( !m_stream || !m_stream->IsOk() )
+        return;
+
+    m_thread = new WriterThread(*this);
+    if ( m_thread->Run() != wxTHREAD_NO_ERROR )
+    {
+        delete m_thread;
+        m_thread = nullptr;
+    }
+}
+
+wxLogAsync::~wxLogAsync()
+{
+    if ( m_thread )
+    {
+        {
+            wxMutexLocker lock(m_mutex);
+            m_stopRequested = true;
+            m_condWake.Signal();
+        }
+
+        m_thread->Wait();
+        delete m_thread;
+    }
+}
+
+bool wxLogAsync::IsOk() const
+{
+    return m_thread != nullptr;
+}
+
+wxLogAsync::Queue& wxLogAsync::GetQueueForThisThread()
+{
+    // Normally only a single wxLogAsync object is used, so just remember the
+    // queue used for it by this thread. Note that the queue is shared with
+    // wxLogAsync, as either the thread or the logger can be destroyed first.
+    struct ThreadQueue
+    {
+        ~ThreadQueue()
+        {
+            // Let the writer thread delete the queue once it becomes empty.
+            if ( queue )
+                queue->SetAbandoned(true);
+        }
+
+        unsigned loggerId = 0;
+        std::shared_ptr<Queue> queue;
+    };
+
+    thread_local ThreadQueue s_threadQueue;
+
+    if ( s_threadQueue.loggerId != m_id )
+    {
+        if ( s_threadQueue.queue )
+            s_threadQueue.queue->SetAbandoned(true);
+
+        const wxThreadIdType threadId = wxThread::GetCurrentId();
+
+        wxCriticalSectionLocker lock(m_csQueues);
+
+        // Reuse the existing queue if this thread had already used this
+        // logger and its queue hasn't been deleted yet (or if another thread
+        // with the same ID did, which is fine too, as it must have already
+        // terminated).
+        s_threadQueue.queue.reset();
+        for ( const auto& queue : m_queues )
+        {
+            if ( queue->GetThreadId() == threadId )
+            {
+                queue->SetAbandoned(false);
+                s_threadQueue.queue = queue;
+                break;
+            }
+        }
+
+        if ( !s_threadQueue.queue )
+        {
+            m_queues.emplace_back(std::make_shared<Queue>(m_queueSize, threadId));
+            s_threadQueue.queue = m_queues.back();
+        }
+
+        s_threadQueue.loggerId = m_id;
+    }
+
+    return *s_threadQueue.queue;
+}
+
+void wxLogAsync::DoLogRecord(wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+{
+    if ( !m_thread )
+        return;
+
+    Queue& queue = GetQueueForThisThread();
+
+    size_t count = queue.Push(level, msg, info);
+    if ( !count )
+    {
+        if ( m_policy == Overflow_Drop )
+        {
+            // Don't wake up the writer: this was already done when the queue
+            // became half full.
+            m_numDropped++;
+            return;
+        }
+
+        wxMutexLocker lock(m_mutex);
+
+        m_numWaiting++;
+        while ( (count = queue.Push(level, msg, info)) == 0 )
+        {
+            m_wakeRequested = true;
+            m_condWake.Signal();
+
+            m_condWritten.Wait();
+        }
+        m_numWaiting--;
+    }
+
+    // Don't wait until the queue becomes full to start writing it out.
+    if ( count == m_queueSize / 2 )
+        WakeUpWriter();
+}
+
+void wxLogAsync::WakeUpWriter()
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_wakeRequested = true;
+    m_condWake.Signal();
+}
+
+void wxLogAsync::Flush()
+{
+    wxLog::Flush();
+
+    // Don't wait for the messages to be written, as this function is called
+    // periodically from the main thread which shouldn't be blocked.
+    if ( m_thread )
+        WakeUpWriter();
+}
+
+void wxLogAsync::WaitUntilWritten()
+{
+    if ( !m_thread )
+        return;
+
+    wxMutexLocker lock(m_mutex);
+
+    const unsigned long writeRequested = ++m_writeRequested;
+    m_wakeRequested = true;
+    m_condWake.Signal();
+
+    m_numWaiting++;
+    while ( m_writeDone < writeRequested )
+        m_condWritten.Wait();
+    m_numWaiting--;
+}
+
+void wxLogAsync::WriterMain()
+{
+    // Logging anything from this thread, e.g. an error when writing to the
+    // stream, would add more messages to write and could block it forever.
+    wxLog::EnableLogging(false);
+
+    for ( ;; )
+    {
+        unsigned long writeRequested;
+        bool stopRequested;
+        {
+            wxMutexLocker lock(m_mutex);
+
+            if ( !m_wakeRequested && !m_stopRequested )
+                m_condWake.WaitTimeout(WRITE_INTERVAL_MS);
+
+            m_wakeRequested = false;
+            writeRequested = m_writeRequested;
+            stopRequested = m_stopRequested;
+        }
+
+        WriteQueued();
+
+        if ( m_numWaiting )
+        {
+            wxMutexLocker lock(m_mutex);
+
+            m_writeDone = writeRequested;
+            m_condWritten.Broadcast();
+        }
+
+        // Note that we check for this only after writing out all the messages
+        // queued before the stop request.
+        if ( stopRequested )
+            break;
+    }
+}
+
+void wxLogAsync::WriteQueued()
+{
+    // Copy the queues pointers to avoid keeping the lock while writing, this
+    // is safe because the queues are only deleted by this thread.
+    {
+        wxCriticalSectionLocker lock(m_csQueues);
+
+        m_queuesToWrite.clear();
+        for ( const auto& queue : m_queues )
+            m_queuesToWrite.push_back(queue.get());
+    }
+
+    for ( auto queue : m_queuesToWrite )
+    {
+        queue->PopAll([this](wxLogLevel level,
+                             const wxString& msg,
+                             const wxLogRecordInfo& info)
+            {
+                // Use the base class version to format the message and pass
+                // it to our DoLogTextAtLevel().
+                wxLog::DoLogRecord(level, msg, info);
+
+                if ( m_batch.size() >= MAX_BATCH_SIZE )
+                    WriteBatch();
+            });
+    }
+
+    WriteBatch();
+
+    // Delete the queues of the threads which won't use them any more, if we
+    // have written all their messages: this ensures that the number of queues
+    // doesn't grow indefinitely when many short-lived threads log messages.
+    wxCriticalSectionLocker lock(m_csQueues);
+
+    m_queues.erase(std::remove_if(m_queues.begin(), m_queues.end(),
+                                  [](const std::shared_ptr<Queue>& queue)
+                                  {
+                                      return queue->CanBeDeleted();
+                                  }),
+                   m_queues.end());
+}
+
+void wxLogAsync::DoLogTextAtLevel(wxLogLevel WXUNUSED(level),
+                                  const wxString& msg)
+{
+    const wxScopedCharBuffer buf = msg.utf8_str();
+    m_batch.append(buf.data(), buf.length());
+    m_batch += '\n';
+}
+
+void wxLogAsync::WriteBatch()
+{
+    if ( m_batch.empty() )
+        return;
+
+    m_stream->Write(m_batch.data(), m_batch.size());
+    m_batch.clear();
+}
+
+#endif // wxUSE_LOG && wxUSE_THREADS && wxUSE_STREAMS
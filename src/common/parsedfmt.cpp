@@ -0,0 +1,813 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/parsedfmt.cpp
+// Purpose:     wxParsedFormat implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/parsedfmt.h"
+
+#include "wx/private/wxprintf.h"
+
+#include <stdio.h>
+
+#include <functional>
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// wxParsedFormat::Data
+// ----------------------------------------------------------------------------
+
+struct wxParsedFormat::Data
+{
+    // The different ways of handling the conversions: all the simple ones
+    // are handled directly, while the rest is formatted using snprintf().
+    enum Kind
+    {
+        Kind_String,        // "%s"
+        Kind_Char,          // "%c"
+        Kind_Int,           // "%d", "%i" or "%u" with any length modifier
+        Kind_Generic        // anything else
+    };
+
+    struct Conversion
+    {
+        // The literal text preceding this conversion.
+        wxString prefix;
+
+        wxPrintfConvSpec<wxStringCharType> spec;
+
+        Kind kind;
+
+        // Index of the argument to format and of the arguments used for '*'
+        // width and precision, if any.
+        unsigned arg;
+        unsigned starArgs[2];
+        unsigned numStars;
+
+        // For Kind_Int only: true for "%u".
+        bool isUnsigned;
+    };
+
+    explicit Data(const wxString& fmt) : format(fmt) { }
+
+    void Parse();
+
+
+    // Helpers for formatting individual arguments.
+    static wxLongLong_t GetInt(const Arg& arg);
+    static long double GetLongDouble(const Arg& arg);
+    static const void* GetPointer(const Arg& arg);
+    static wxUniChar GetChar(const Conversion& conv, const Arg& arg);
+
+    static void AppendInt(wxString& out, const Conversion& conv, const Arg& arg);
+    static void AppendGeneric(wxString& out,
+                              const Conversion& conv,
+                              std::initializer_list<Arg> args);
+
+
+    const wxString format;
+
+    // All conversions in order of their appearance in the format string.
+    std::vector<Conversion> conversions;
+
+    // The text following the last conversion.
+    wxString suffix;
+
+    // The expected types of the arguments, as wxFormatString::ArgumentType.
+    std::vector<int> argTypes;
+
+    bool ok = true;
+};
+
+namespace
+{
+
+// Append the string in the internal wxString representation to the output.
+inline void
+AppendNative(wxString& out, const wxStringCharType* s, size_t len)
+{
+#if wxUSE_UNICODE_UTF8
+    out += wxString::FromUTF8Unchecked(s, len);
+#else
+    out.append(s, len);
+#endif
+}
+
+// Append the output of snprintf() to the string: it is almost always ASCII,
+// but could also contain e.g. a non-ASCII decimal separator.
+void AppendSnprintfOutput(wxString& out, const char* s, size_t len)
+{
+    for ( size_t n = 0; n < len; n++ )
+    {
+        if ( static_cast<unsigned char>(s[n]) >= 0x80 )
+        {
+            out += wxString(s, wxConvLibc, len);
+            return;
+        }
+    }
+
+#if wxUSE_UNICODE_UTF8
+    AppendNative(out, s, len);
+#else
+    wchar_t chunk[64];
+    while ( len )
+    {
+        const size_t lenChunk = wxMin(len, WXSIZEOF(chunk));
+        for ( size_t n = 0; n < lenChunk; n++ )
+            chunk[n] = static_cast<unsigned char>(s[n]);
+
+        out.append(chunk, lenChunk);
+
+        s += lenChunk;
+        len -= lenChunk;
+    }
+#endif
+}
+
+template <typename T>
+int
+DoSnprintf(char* buf, size_t size,
+           const char* flags, const int* stars, unsigned numStars, T value)
+{
+    switch ( numStars )
+    {
+        case 0:
+            return snprintf(buf, size, flags, value);
+
+        case 1:
+            return snprintf(buf, size, flags, stars[0], value);
+
+        case 2:
+            return snprintf(buf, size, flags, stars[0], stars[1], value);
+    }
+
+    wxFAIL_MSG( "unreachable" );
+    return -1;
+}
+
+// Format a single number using snprintf() with the given conversion.
+template <typename T>
+void
+AppendUsingSnprintf(wxString& out,
+                    const char* flags, const int* stars, unsigned numStars,
+                    T value)
+{
+    char buf[wxMAX_SVNPRINTF_SCRATCHBUFFER_LEN];
+    const int len = DoSnprintf(buf, sizeof(buf), flags, stars, numStars, value);
+    if ( len < 0 )
+        return;
+
+    if ( static_cast<size_t>(len) < sizeof(buf) )
+    {
+        AppendSnprintfOutput(out, buf, len);
+        return;
+    }
+
+    // This can only happen for huge width or precision, just use a big
+    // enough buffer in this case.
+    wxCharBuffer bufLarge(len);
+    DoSnprintf(bufLarge.data(), len + 1, flags, stars, numStars, value);
+    AppendSnprintfOutput(out, bufLarge.data(), len);
+}
+
+// Append the string padded to the given width.
+void
+AppendPadded(wxString& out, const wxString& s, int minWidth, bool alignLeft)
+{
+    const size_t len = s.length();
+    const size_t pad = minWidth > 0 && static_cast<size_t>(minWidth) > len
+                        ? minWidth - len
+                        : 0;
+
+    if ( !alignLeft )
+        out.append(pad, ' ');
+
+    out += s;
+
+    if ( alignLeft )
+        out.append(pad, ' ');
+}
+
+wxFormatString::ArgumentType ArgTypeFromParamType(wxPrintfArgType type)
+{
+    switch ( type )
+    {
+        case wxPAT_CHAR:
+        case wxPAT_WCHAR:
+            return wxFormatString::Arg_Char;
+
+        case wxPAT_PCHAR:
+        case wxPAT_PWCHAR:
+            return wxFormatString::Arg_String;
+
+        case wxPAT_INT:
+            return wxFormatString::Arg_Int;
+        case wxPAT_LONGINT:
+            return wxFormatString::Arg_LongInt;
+        case wxPAT_LONGLONGINT:
+            return wxFormatString::Arg_LongLongInt;
+        case wxPAT_SIZET:
+            return wxFormatString::Arg_Size_t;
+
+        case wxPAT_DOUBLE:
+            return wxFormatString::Arg_Double;
+        case wxPAT_LONGDOUBLE:
+            return wxFormatString::Arg_LongDouble;
+
+        case wxPAT_POINTER:
+            return wxFormatString::Arg_Pointer;
+
+        case wxPAT_STAR:
+            return wxFormatString::Arg_Int;
+
+        case wxPAT_NINT:
+        case wxPAT_NSHORTINT:
+        case wxPAT_NLONGINT:
+        case wxPAT_INVALID:
+            // These are not supported and rejected by Parse().
+            break;
+    }
+
+    return wxFormatString::Arg_Unknown;
+}
+
+} // anonymous namespace
+
+void wxParsedFormat::Data::Parse()
+{
+    // The literal text accumulated so far and the start of the part of the
+    // format string which hasn't been added to it yet.
+    wxString text;
+    const wxStringCharType* literal = format.wx_str();
+
+    // Index of the next non-positional argument.
+    unsigned nextArg = 0;
+
+    const auto setArgType = [this](unsigned n, wxPrintfArgType type)
+    {
+        if ( n >= argTypes.size() )
+            argTypes.resize(n + 1, wxFormatString::Arg_Unused);
+
+        argTypes[n] = ArgTypeFromParamType(type);
+    };
+
+    for ( const wxStringCharType* p = literal; *p; ++p )
+    {
+        if ( *p != '%' )
+            continue;
+
+        if ( p[1] == '%' )
+        {
+            // Keep just the first of the two percent signs.
+            AppendNative(text, literal, p + 1 - literal);
+            literal = p + 2;
+
+            ++p;
+            continue;
+        }
+
+        Conversion conv;
+        conv.spec.Init();
+
+        // Invalid conversions are output as is, as wxVsnprintf() does.
+        if ( !conv.spec.Parse(p) )
+            continue;
+
+        switch ( conv.spec.m_type )
+        {
+            case wxPAT_NINT:
+            case wxPAT_NSHORTINT:
+            case wxPAT_NLONGINT:
+                wxFAIL_MSG
+                (
+                    wxString::Format
+                    (
+                        "%%n is not supported in format string \"%s\"",
+                        format
+                    )
+                );
+                ok = false;
+                return;
+
+            default:
+                break;
+        }
+
+        AppendNative(text, literal, p - literal);
+        conv.prefix.swap(text);
+
+        p = conv.spec.m_pArgEnd;
+        literal = p + 1;
+
+        // Note that width comes before the precision, so the arguments
+        // for them are taken in the order of asterisks appearance.
+        conv.numStars = 0;
+        for ( const char* f = strchr(conv.spec.m_szFlags, '*');
+              f;
+              f = strchr(f + 1, '*') )
+        {
+            if ( conv.spec.m_pos > 0 )
+            {
+                wxFAIL_MSG
+                (
+                    wxString::Format
+                    (
+                        "Format string \"%s\" uses both positional "
+                        "parameters and '*' which is not supported.",
+                        format
+                    )
+                );
+                ok = false;
+                return;
+            }
+
+            conv.starArgs[conv.numStars++] = nextArg;
+            setArgType(nextArg++, wxPAT_STAR);
+        }
+
+        if ( conv.spec.m_pos > 0 )
+        {
+            conv.arg = conv.spec.m_pos - 1;
+            if ( nextArg < conv.spec.m_pos )
+                nextArg = conv.spec.m_pos;
+        }
+        else
+        {
+            conv.arg = nextArg++;
+        }
+
+        setArgType(conv.arg, conv.spec.m_type);
+
+        conv.kind = Kind_Generic;
+        conv.isUnsigned = false;
+        switch ( conv.spec.m_type )
+        {
+            case wxPAT_PCHAR:
+            case wxPAT_PWCHAR:
+                if ( conv.spec.m_nMinWidth == 0 &&
+                        conv.spec.m_nMaxWidth == INT_MAX )
+                    conv.kind = Kind_String;
+                break;
+
+            case wxPAT_CHAR:
+            case wxPAT_WCHAR:
+                if ( conv.spec.m_nMinWidth == 0 )
+                    conv.kind = Kind_Char;
+                break;
+
+            case wxPAT_INT:
+            case wxPAT_LONGINT:
+            case wxPAT_LONGLONGINT:
+            case wxPAT_SIZET:
+                {
+                    // Check that there are only length modifiers, but no
+                    // flags, width or precision.
+                    const char* f = conv.spec.m_szFlags + 1;
+                    f += strspn(f, "lqLzZ");
+                    if ( (*f == 'd' || *f == 'i' || *f == 'u') && !f[1] )
+                    {
+                        conv.kind = Kind_Int;
+                        conv.isUnsigned = *f == 'u';
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        conversions.push_back(conv);
+    }
+
+    AppendNative(text, literal, wxStrlen(literal));
+    suffix.swap(text);
+}
+
+/* static */
+wxLongLong_t wxParsedFormat::Data::GetInt(const Arg& arg)
+{
+    switch ( arg.m_type )
+    {
+        case Arg::Type_Int:
+            return arg.m_int;
+
+        case Arg::Type_Double:
+            return static_cast<wxLongLong_t>(arg.m_double);
+
+        case Arg::Type_LongDouble:
+            return static_cast<wxLongLong_t>(arg.m_longDouble);
+
+        case Arg::Type_Pointer:
+        case Arg::Type_String:
+            return static_cast<wxLongLong_t>(wxPtrToUInt(arg.m_pointer));
+    }
+
+    wxFAIL_MSG( "unreachable" );
+    return 0;
+}
+
+/* static */
+long double wxParsedFormat::Data::GetLongDouble(const Arg& arg)
+{
+    switch ( arg.m_type )
+    {
+        case Arg::Type_Double:
+            return arg.m_double;
+
+        case Arg::Type_LongDouble:
+            return arg.m_longDouble;
+
+        case Arg::Type_Int:
+        case Arg::Type_Pointer:
+        case Arg::Type_String:
+            return static_cast<long double>(GetInt(arg));
+    }
+
+    wxFAIL_MSG( "unreachable" );
+    return 0;
+}
+
+/* static */
+const void* wxParsedFormat::Data::GetPointer(const Arg& arg)
+{
+    switch ( arg.m_type )
+    {
+        case Arg::Type_Pointer:
+        case Arg::Type_String:
+            return arg.m_pointer;
+
+        case Arg::Type_Int:
+        case Arg::Type_Double:
+        case Arg::Type_LongDouble:
+            return wxUIntToPtr(static_cast<wxUIntPtr>(GetInt(arg)));
+    }
+
+    wxFAIL_MSG( "unreachable" );
+    return nullptr;
+}
+
+/* static */
+wxUniChar
+wxParsedFormat::Data::GetChar(const Conversion& conv, const Arg& arg)
+{
+    const wxLongLong_t value = GetInt(arg);
+
+    // Narrow characters, which can be negative if char is signed, are in the
+    // current locale encoding, just as wxUniChar(char) expects.
+    if ( conv.spec.m_type == wxPAT_CHAR || (value < 0 && value >= CHAR_MIN) )
+        return wxUniChar(static_cast<char>(value));
+
+    return wxUniChar(static_cast<unsigned>(value));
+}
+
+/* static */
+void
+wxParsedFormat::Data::AppendInt(wxString& out,
+                                const Conversion& conv,
+                                const Arg& arg)
+{
+    // Cast the value to the type given by the conversion, exactly as passing
+    // it through the ellipsis to printf() would do.
+    const wxLongLong_t value = GetInt(arg);
+
+    wxULongLong_t magnitude;
+    bool negative = false;
+    if ( conv.isUnsigned )
+    {
+        switch ( conv.spec.m_type )
+        {
+            case wxPAT_INT:
+                magnitude = static_cast<unsigned>(value);
+                break;
+
+            case wxPAT_LONGINT:
+                magnitude = static_cast<unsigned long>(value);
+                break;
+
+            case wxPAT_SIZET:
+                magnitude = static_cast<size_t>(value);
+                break;
+
+            default:
+                magnitude = static_cast<wxULongLong_t>(value);
+        }
+    }
+    else
+    {
+        wxLongLong_t signedValue;
+        switch ( conv.spec.m_type )
+        {
+            case wxPAT_INT:
+                signedValue = static_cast<int>(value);
+                break;
+
+            case wxPAT_LONGINT:
+                signedValue = static_cast<long>(value);
+                break;
+
+            case wxPAT_SIZET:
+                signedValue = static_cast<std::make_signed<size_t>::type>(value);
+                break;
+
+            default:
+                signedValue = value;
+        }
+
+        negative = signedValue < 0;
+        magnitude = static_cast<wxULongLong_t>(signedValue);
+        if ( negative )
+            magnitude = 0 - magnitude;
+    }
+
+    wxStringCharType buf[24];
+    wxStringCharType* const end = buf + WXSIZEOF(buf);
+    wxStringCharType* p = end;
+    do
+    {
+        *--p = static_cast<wxStringCharType>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while ( magnitude );
+
+    if ( negative )
+        *--p = '-';
+
+    AppendNative(out, p, end - p);
+}
+
+/* static */
+void
+wxParsedFormat::Data::AppendGeneric(wxString& out,
+                                    const Conversion& conv,
+                                    std::initializer_list<Arg> args)
+{
+    const Arg& arg = args.begin()[conv.arg];
+
+    int stars[2] = { 0, 0 };
+    for ( unsigned n = 0; n < conv.numStars; n++ )
+    {
+        if ( conv.starArgs[n] < args.size() )
+            stars[n] = static_cast<int>(GetInt(args.begin()[conv.starArgs[n]]));
+    }
+
+    const wxPrintfConvSpec<wxStringCharType>& spec = conv.spec;
+    const char* const flags = spec.m_szFlags;
+
+    switch ( spec.m_type )
+    {
+        case wxPAT_INT:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                static_cast<int>(GetInt(arg)));
+            return;
+
+        case wxPAT_LONGINT:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                static_cast<long>(GetInt(arg)));
+            return;
+
+        case wxPAT_LONGLONGINT:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                GetInt(arg));
+            return;
+
+        case wxPAT_SIZET:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                static_cast<size_t>(GetInt(arg)));
+            return;
+
+        case wxPAT_DOUBLE:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                static_cast<double>(GetLongDouble(arg)));
+            return;
+
+        case wxPAT_LONGDOUBLE:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                GetLongDouble(arg));
+            return;
+
+        case wxPAT_POINTER:
+            AppendUsingSnprintf(out, flags, stars, conv.numStars,
+                                GetPointer(arg));
+            return;
+
+        case wxPAT_CHAR:
+        case wxPAT_WCHAR:
+        case wxPAT_PCHAR:
+        case wxPAT_PWCHAR:
+            // Handled below.
+            break;
+
+        case wxPAT_NINT:
+        case wxPAT_NSHORTINT:
+        case wxPAT_NLONGINT:
+        case wxPAT_STAR:
+        case wxPAT_INVALID:
+            wxFAIL_MSG( "unexpected conversion type" );
+            return;
+    }
+
+    // Characters and strings are padded and truncated by us, using the
+    // values given by '*' if necessary, as snprintf() would do.
+    int minWidth = spec.m_nMinWidth,
+        maxWidth = spec.m_nMaxWidth;
+    bool alignLeft = spec.m_bAlignLeft;
+
+    unsigned star = 0;
+    if ( minWidth == -1 )
+    {
+        minWidth = stars[star++];
+        if ( minWidth < 0 )
+        {
+            alignLeft = true;
+            minWidth = -minWidth;
+        }
+    }
+
+    if ( maxWidth == -1 )
+    {
+        maxWidth = stars[star++];
+        if ( maxWidth < 0 )
+            maxWidth = INT_MAX;
+    }
+
+    wxString s;
+    if ( spec.m_type == wxPAT_CHAR || spec.m_type == wxPAT_WCHAR )
+    {
+        s = GetChar(conv, arg);
+    }
+    else if ( arg.m_type == Arg::Type_String )
+    {
+        if ( arg.m_str )
+        {
+            AppendNative(s, arg.m_str, wxStrlen(arg.m_str));
+            if ( s.length() > static_cast<size_t>(maxWidth) )
+                s.Truncate(maxWidth);
+        }
+        else if ( maxWidth >= 6 )
+        {
+            s = wxS("(null)");
+        }
+    }
+
+    AppendPadded(out, s, minWidth, alignLeft);
+}
+
+// ----------------------------------------------------------------------------
+// wxParsedFormat
+// ----------------------------------------------------------------------------
+
+wxParsedFormat::wxParsedFormat(const wxString& format)
+{
+    std::shared_ptr<Data> data = std::make_shared<Data>(format);
+    data->Parse();
+
+    m_data = data;
+}
+
+bool wxParsedFormat::IsOk() const
+{
+    return m_data && m_data->ok;
+}
+
+wxString wxParsedFormat::GetFormat() const
+{
+    return m_data ? m_data->format : wxString();
+}
+
+size_t wxParsedFormat::GetArgumentCount() const
+{
+    return m_data ? m_data->argTypes.size() : 0;
+}
+
+#if wxDEBUG_LEVEL
+
+void wxParsedFormat::DoValidate(std::initializer_list<int> argTypes) const
+{
+    wxCHECK_RET( IsOk(), "can't use invalid format string" );
+
+    const std::vector<int>& expected = m_data->argTypes;
+
+    // As with wxFormatString::Validate(), extra arguments are allowed.
+    if ( argTypes.size() < expected.size() )
+    {
+        wxFAIL_MSG
+        (
+            wxString::Format
+            (
+                "Not enough arguments, %zu given but at least %zu needed",
+                argTypes.size(),
+                expected.size()
+            )
+        );
+        return;
+    }
+
+    const int* const given = argTypes.begin();
+    for ( size_t n = 0; n < expected.size(); ++n )
+    {
+        const int ptype = expected[n];
+        wxASSERT_MSG
+        (
+            (ptype & given[n]) == ptype,
+            wxString::Format
+            (
+                "Format specifier mismatch for argument %zu of \"%s\"",
+                n + 1, m_data->format
+            )
+        );
+    }
+}
+
+#endif // wxDEBUG_LEVEL
+
+void wxParsedFormat::DoFormat(wxString& out,
+                              OutputMode mode,
+                              std::initializer_list<Arg> args) const
+{
+    // The arguments may point into the output string itself, e.g. when
+    // calling AppendTo(s, s), and modifying it would invalidate them, so
+    // format into a temporary string in this case.
+    const wxStringCharType* const outBegin = out.wx_str();
+#if wxUSE_UNICODE_UTF8
+    const wxStringCharType* const outEnd = outBegin + out.utf8_length();
+#else
+    const wxStringCharType* const outEnd = outBegin + out.length();
+#endif
+
+    const std::less_equal<const wxStringCharType*> lessEq;
+    for ( const Arg& arg : args )
+    {
+        if ( arg.m_type == Arg::Type_String && arg.m_str &&
+                lessEq(outBegin, arg.m_str) && lessEq(arg.m_str, outEnd) )
+        {
+            wxString str;
+            DoFormat(str, Output_Append, args);
+
+            if ( mode == Output_Append )
+                out += str;
+            else
+                out.swap(str);
+
+            return;
+        }
+    }
+
+    if ( mode == Output_Replace )
+        out.clear();
+
+    if ( !IsOk() )
+        return;
+
+    for ( const Data::Conversion& conv : m_data->conversions )
+    {
+        out += conv.prefix;
+
+        // Conversions without the corresponding argument are just skipped,
+        // this error is detected by DoValidate() in debug builds.
+        if ( conv.arg >= args.size() )
+            continue;
+
+        const Arg& arg = args.begin()[conv.arg];
+        switch ( conv.kind )
+        {
+            case Data::Kind_String:
+                if ( arg.m_type != Arg::Type_String )
+                    break;
+
+                if ( arg.m_str )
+                    AppendNative(out, arg.m_str, wxStrlen(arg.m_str));
+                else
+                    out += wxS("(null)");
+                break;
+
+            case Data::Kind_Char:
+                out += Data::GetChar(conv, arg);
+                break;
+
+            case Data::Kind_Int:
+                Data::AppendInt(out, conv, arg);
+                break;
+
+            case Data::Kind_Generic:
+                Data::AppendGeneric(out, conv, args);
+                break;
+        }
+    }
+
+    out += m_data->suffix;
+}
@@ -943,6 +943,85 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+namespace
+{
+
+// Return the number of ASCII characters at the start of the given buffer.
+//
+// This is used to handle runs of ASCII characters, which are by far the most
+// common ones in practice, in bulk instead of one by one. The buffer is
+// examined a machine word at a time, which is much faster than checking each
+// byte individually.
+inline size_t GetASCIIRunLength(const char* src, size_t srcLen)
+{
+    static const wxUint64 NON_ASCII_MASK = wxULL(0x8080808080808080);
+
+    size_t n = 0;
+    for ( ; srcLen - n >= sizeof(wxUint64); n += sizeof(wxUint64) )
+    {
+        wxUint64 word;
+        memcpy(&word, src + n, sizeof(word));
+        if ( word & NON_ASCII_MASK )
+            break;
+    }
+
+    while ( n < srcLen && !(src[n] & 0x80) )
+        n++;
+
+    return n;
+}
+
+// Copy the given number of ASCII characters to the output buffer.
+inline void CopyASCII(wchar_t* dst, const char* src, size_t len)
+{
+    // This loop is simple enough for the compiler to vectorize it.
+    for ( size_t n = 0; n < len; n++ )
+        dst[n] = static_cast<unsigned char>(src[n]);
+}
+
+// Convert the initial run of ASCII characters, stopping at NUL if end is
+// null, and return the number of characters in it.
+//
+// The characters are only stored in the output buffer if it is non-null and
+// at most dstLen of them are processed in this case.
+inline size_t ConvertASCIIRun(char* dst, size_t dstLen,
+                              const wchar_t* src, const wchar_t* end)
+{
+    const size_t maxLen = dst ? dstLen : static_cast<size_t>(-1);
+
+    size_t n = 0;
+    if ( end )
+    {
+        const size_t srcLen = end - src;
+        const size_t len = srcLen < maxLen ? srcLen : maxLen;
+        for ( ; n < len; n++ )
+        {
+            const wxUint32 code = static_cast<wxUint32>(src[n]);
+            if ( code >= 0x80 )
+                break;
+
+            if ( dst )
+                dst[n] = static_cast<char>(code);
+        }
+    }
+    else
+    {
+        for ( ; n < maxLen; n++ )
+        {
+            const wxUint32 code = static_cast<wxUint32>(src[n]);
+            if ( !code || code >= 0x80 )
+                break;
+
+            if ( dst )
+                dst[n] = static_cast<char>(code);
+        }
+    }
+
+    return n;
+}
+
+} // anonymous namespace
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -955,6 +1034,28 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
 
     for ( const char *p = src; ; p++ )
     {
+        // Convert all ASCII characters at once, if there are several of them.
+        size_t run = GetASCIIRunLength(p, srcLen);
+        if ( run > 1 )
+        {
+            // Leave the last one to the code below, which handles running
+            // out of space in the output buffer.
+            run--;
+            if ( out )
+            {
+                if ( run > dstLen )
+                    run = dstLen;
+
+                CopyASCII(out, p, run);
+                out += run;
+                dstLen -= run;
+            }
+
+            p += run;
+            srcLen -= run;
+            written += run;
+        }
+
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -1068,6 +1169,20 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
     const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : src + srcLen;
     for ( const wchar_t *wp = src; ; )
     {
+        // Convert all ASCII characters at once first.
+        const size_t run = ConvertASCIIRun(out, dstLen, wp, end);
+        if ( run )
+        {
+            if ( out )
+            {
+                out += run;
+                dstLen -= run;
+            }
+
+            wp += run;
+            written += run;
+        }
+
         if ( end ? wp == end : !*wp )
         {
             // all done successfully, just add the trailing NUL if we are not
@@ -1212,6 +1327,24 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
                     *buf++ = cc;
                 len++;
             }
+            else if ( !isNulTerminated &&
+                        !(m_options & MAP_INVALID_UTF8_TO_OCTAL) )
+            {
+                // convert all the following ASCII characters at once
+                size_t run = GetASCIIRunLength(psz, srcLen);
+                if ( buf && run > n - len )
+                    run = n - len;
+
+                if ( buf )
+                {
+                    CopyASCII(buf, psz, run);
+                    buf += run;
+                }
+
+                psz += run;
+                srcLen -= run;
+                len += run;
+            }
         }
         else
         {
@@ -1425,6 +1558,19 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
                 if (buf)
                     *buf++ = (char) cc;
                 len++;
+
+                // convert all the following ASCII characters at once, unless
+                // we need to check them for octal escapes
+                if ( !(m_options & MAP_INVALID_UTF8_TO_OCTAL) )
+                {
+                    const size_t run = ConvertASCIIRun(buf, buf ? n - len : 0,
+                                                       psz, end);
+                    if ( buf )
+                        buf += run;
+
+                    psz += run;
+                    len += run;
+                }
             }
             else
             {
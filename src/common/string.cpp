@@ -33,6 +33,10 @@
 #include "wx/vector.h"
 #include "wx/xlocale.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #ifdef __WINDOWS__
     #include "wx/msw/wrapwin.h"
 #endif // __WINDOWS__
@@ -145,6 +149,199 @@ static wxStrCacheStatsDumper s_showCacheStats;
 
 #endif // wxPROFILE_STRING_CACHE
 
+#if wxUSE_STRING_POS_INDEX
+
+// The index contains the offsets in m_impl of every STEP-th character of the
+// string, allowing to find the offset of any character by iterating over at
+// most STEP - 1 characters.
+//
+// The index is extended only when necessary, as the string is typically
+// accessed near its beginning and, more importantly, because the functions
+// modifying the string can use it before actually changing the string, so
+// it must not contain the entries after the position being modified. As
+// several threads can read the same string simultaneously, the entries are
+// stored in a fixed size array and are never modified once added, which is
+// indicated by updating the atomic count, so reading them doesn't require
+// any locking.
+struct wxString::PosIndex
+{
+    enum { STEP = 64 };
+
+    explicit PosIndex(size_t capacity_)
+        : offsets(new size_t[capacity_]),
+          capacity(capacity_)
+    {
+        offsets[0] = 0;
+    }
+
+    size_t GetCount() const { return count.load(std::memory_order_acquire); }
+
+    // offsets[n] is the offset of the character n*STEP, the first element is
+    // always 0 and only the first count elements are valid
+    const std::unique_ptr<size_t[]> offsets;
+    const size_t capacity;
+    std::atomic<size_t> count{1};
+
+    // length of the string when the index was found to contain all the
+    // entries for it, npos if it doesn't contain them yet
+    std::atomic<size_t> completeLength{npos};
+
+    // the index replaced by this one because it was too small, which must be
+    // kept alive as long as this one because it could still be used by the
+    // other threads
+    std::unique_ptr<PosIndex> previous;
+
+    wxDECLARE_NO_COPY_CLASS(PosIndex);
+};
+
+void wxString::ResetPosIndex()
+{
+    delete m_posIndex.exchange(nullptr, std::memory_order_relaxed);
+}
+
+const wxString::PosIndex&
+wxString::GetPosIndex(size_t n, size_t implPos) const
+{
+    const auto isEnough = [=](const PosIndex& index)
+    {
+        const size_t count = index.GetCount();
+        return count > n || index.offsets[count - 1] >= implPos ||
+                index.completeLength.load(std::memory_order_acquire)
+                    == m_impl.length();
+    };
+
+    PosIndex* index = m_posIndex.load(std::memory_order_acquire);
+    if ( index && isEnough(*index) )
+        return *index;
+
+    // Creating or extending the index is rare, so just use a single lock for
+    // all strings for it.
+    wxCRIT_SECT_DECLARE(s_csPosIndex);
+    wxCRIT_SECT_LOCKER(lock, s_csPosIndex);
+
+    // Another thread could have updated the index while we were waiting.
+    index = m_posIndex.load(std::memory_order_acquire);
+    if ( index && isEnough(*index) )
+        return *index;
+
+    // The string can't have more entries than this as each character takes
+    // at least one byte.
+    const size_t maxCount = m_impl.length() / PosIndex::STEP + 1;
+    if ( !index || index->capacity < maxCount )
+    {
+        // Allocate a new index if we don't have any yet or if it's too small,
+        // which can happen if it was created by a function modifying the
+        // string before making it longer.
+        PosIndex* const newIndex = new PosIndex(maxCount);
+        if ( index )
+        {
+            const size_t count = index->GetCount();
+            std::copy(index->offsets.get(), index->offsets.get() + count,
+                      newIndex->offsets.get());
+            newIndex->count.store(count, std::memory_order_relaxed);
+            newIndex->previous.reset(index);
+        }
+
+        index = newIndex;
+        m_posIndex.store(index, std::memory_order_release);
+    }
+
+    size_t count = index->GetCount();
+    const wxStringImpl::const_iterator e(m_impl.end());
+    wxStringImpl::const_iterator i(m_impl.begin() + index->offsets[count - 1]);
+    bool complete = false;
+    while ( count <= n && index->offsets[count - 1] < implPos )
+    {
+        unsigned k;
+        for ( k = 0; k < PosIndex::STEP && i != e; k++ )
+            wxStringOperations::IncIter(i);
+
+        // not enough characters for another entry
+        if ( k < PosIndex::STEP )
+        {
+            complete = true;
+            break;
+        }
+
+        index->offsets[count++] = i - m_impl.begin();
+        if ( count == index->capacity )
+        {
+            complete = true;
+            break;
+        }
+    }
+
+    // Publish the new entries for the other threads.
+    index->count.store(count, std::memory_order_release);
+    if ( complete )
+        index->completeLength.store(m_impl.length(), std::memory_order_release);
+
+    return *index;
+}
+
+size_t wxString::DoPosToImplUsingIndex(size_t pos) const
+{
+    Cache::Element * const cache = GetCacheElement();
+    if ( pos == cache->pos )
+        return cache->impl;
+
+    // Start from the cached position if it's close enough, as is the case
+    // when iterating over the string, or from the closest indexed one.
+    size_t startPos,
+           startImpl;
+    if ( cache->pos < pos && pos - cache->pos < PosIndex::STEP )
+    {
+        startPos = cache->pos;
+        startImpl = cache->impl;
+    }
+    else
+    {
+        const size_t n = pos / PosIndex::STEP;
+        const PosIndex& index = GetPosIndex(n, npos);
+
+        // the index may be shorter if pos is beyond the end of the string
+        const size_t count = index.GetCount();
+        const size_t nStart = n < count ? n : count - 1;
+        startPos = nStart*PosIndex::STEP;
+        startImpl = index.offsets[nStart];
+    }
+
+    wxStringImpl::const_iterator i(m_impl.begin() + startImpl);
+    for ( size_t n = startPos; n < pos; n++ )
+        wxStringOperations::IncIter(i);
+
+    cache->pos = pos;
+    cache->impl = i - m_impl.begin();
+
+    wxSTRING_CACHE_ASSERT(
+        (int)cache->impl == (begin() + pos).impl() - m_impl.begin() );
+
+    return cache->impl;
+}
+
+size_t wxString::DoPosFromImplUsingIndex(size_t pos) const
+{
+    // Ensure that the index covers the given offset.
+    const PosIndex& index = GetPosIndex(npos, pos);
+    const size_t* const offsets = index.offsets.get();
+
+    // Find the last indexed character not after the given offset.
+    const size_t* const
+        it = std::upper_bound(offsets, offsets + index.GetCount(), pos) - 1;
+
+    // Count the remaining characters directly instead of using wxString
+    // iterators, as creating them modifies the list of this string
+    // iterators, which is not safe to do from multiple threads.
+    size_t n = (it - offsets)*PosIndex::STEP;
+    const wxStringImpl::const_iterator end(m_impl.begin() + pos);
+    for ( wxStringImpl::const_iterator i(m_impl.begin() + *it); i < end; n++ )
+        wxStringOperations::IncIter(i);
+
+    return n;
+}
+
+#endif // wxUSE_STRING_POS_INDEX
+
 #endif // wxUSE_STRING_POS_CACHE
 
 // ----------------------------------------------------------------------------
@@ -476,19 +673,20 @@ const wchar_t *wxString::AsWChar(const wxMBConv& conv) const
     //            allow to save on buffer reallocations but at the cost of
     //            consuming (even) more memory, we should benchmark this to
     //            determine if it's worth doing
-    if ( !m_convertedToWChar.m_str || lenWC != m_convertedToWChar.m_len )
+    if ( !m_convertedToWChar.GetStr() || lenWC != m_convertedToWChar.GetLen() )
     {
         if ( !const_cast<wxString *>(this)->m_convertedToWChar.Extend(lenWC) )
             return nullptr;
     }
 
     // finally do convert
-    m_convertedToWChar.m_str[lenWC] = L'\0';
-    if ( conv.ToWChar(m_convertedToWChar.m_str, lenWC,
+    wchar_t * const str = m_convertedToWChar.GetStr();
+    str[lenWC] = L'\0';
+    if ( conv.ToWChar(str, lenWC,
                       strMB, lenMB) == wxCONV_FAILED )
         return nullptr;
 
-    return m_convertedToWChar.m_str;
+    return str;
 }
 
 #endif // !wxUSE_UNICODE_WCHAR
@@ -505,7 +703,7 @@ const char *wxString::AsChar(const wxMBConv& conv) const
         return m_impl.c_str();
 
     const wchar_t * const strWC = AsWChar(wxMBConvStrictUTF8());
-    const size_t lenWC = m_convertedToWChar.m_len;
+    const size_t lenWC = m_convertedToWChar.GetLen();
 #else // wxUSE_UNICODE_WCHAR
     const wchar_t * const strWC = m_impl.c_str();
     const size_t lenWC = m_impl.length();
@@ -515,18 +713,19 @@ const char *wxString::AsChar(const wxMBConv& conv) const
     if ( lenMB == wxCONV_FAILED )
         return nullptr;
 
-    if ( !m_convertedToChar.m_str || lenMB != m_convertedToChar.m_len )
+    if ( !m_convertedToChar.GetStr() || lenMB != m_convertedToChar.GetLen() )
     {
         if ( !const_cast<wxString *>(this)->m_convertedToChar.Extend(lenMB) )
             return nullptr;
     }
 
-    m_convertedToChar.m_str[lenMB] = '\0';
-    if ( conv.FromWChar(m_convertedToChar.m_str, lenMB,
+    char * const str = m_convertedToChar.GetStr();
+    str[lenMB] = '\0';
+    if ( conv.FromWChar(str, lenMB,
                         strWC, lenWC) == wxCONV_FAILED )
         return nullptr;
 
-    return m_convertedToChar.m_str;
+    return str;
 }
 
 // ---------------------------------------------------------------------------
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#if wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/log.h"
+    #include "wx/module.h"
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include "wx/private/threadpool.h"
+
+#include <atomic>
+#include <memory>
+
+// ----------------------------------------------------------------------------
+// private classes
+// ----------------------------------------------------------------------------
+
+class wxThreadPool::WorkerThread : public wxThread
+{
+public:
+    explicit WorkerThread(wxThreadPool& pool)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_pool.WorkerMain();
+
+        return nullptr;
+    }
+
+private:
+    wxThreadPool& m_pool;
+
+    wxDECLARE_NO_COPY_CLASS(WorkerThread);
+};
+
+namespace
+{
+
+// The state shared by all the threads participating in ParallelFor().
+//
+// Note that it is reference-counted because the tasks queued by ParallelFor()
+// may only start running after it returns, if all ranges had been already
+// processed by the other threads by then, and must not access any of its
+// local variables in this case.
+struct ParallelForState
+{
+    ParallelForState(int count_,
+                     int numRanges_,
+                     const std::function<void(int, int)>& func_)
+        : func(func_),
+          count(count_),
+          numRanges(numRanges_),
+          condition(mutex)
+    {
+    }
+
+    // Process the ranges while there are any left, return only when there
+    // are none remaining (but they may be still being processed by the other
+    // threads).
+    void ProcessRanges()
+    {
+        for ( ;; )
+        {
+            const int n = nextRange++;
+            if ( n >= numRanges )
+                break;
+
+            // Note that we must only use func after having claimed a range
+            // as it can be already dangling otherwise.
+            func(GetRangeStart(n), GetRangeStart(n + 1));
+
+            wxMutexLocker lock(mutex);
+            if ( ++numDone == numRanges )
+                condition.Signal();
+        }
+    }
+
+    void WaitUntilDone()
+    {
+        wxMutexLocker lock(mutex);
+        while ( numDone < numRanges )
+            condition.Wait();
+    }
+
+    int GetRangeStart(int n) const
+    {
+        return static_cast<int>((static_cast<wxLongLong_t>(count) * n) / numRanges);
+    }
+
+    const std::function<void(int, int)>& func;
+
+    const int count;
+    const int numRanges;
+
+    std::atomic<int> nextRange{0};
+
+    wxMutex mutex;
+    wxCondition condition;
+    int numDone = 0;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// global pool management
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxThreadPool* gs_threadPool = nullptr;
+
+// This is only used to protect gs_threadPool creation.
+wxCriticalSection gs_csThreadPool;
+
+} // anonymous namespace
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule() = default;
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override
+    {
+        delete gs_threadPool;
+        gs_threadPool = nullptr;
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+// ============================================================================
+// wxThreadPool implementation
+// ============================================================================
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_numThreads(numThreads > 0 ? numThreads
+                                  : wxMax(wxThread::GetCPUCount(), 1)),
+      m_condition(m_mutex)
+{
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_stopping = true;
+        m_condition.Broadcast();
+    }
+
+    for ( auto thread : m_threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+}
+
+/* static */
+wxThreadPool& wxThreadPool::Get()
+{
+    wxCriticalSectionLocker lock(gs_csThreadPool);
+
+    if ( !gs_threadPool )
+        gs_threadPool = new wxThreadPool();
+
+    return *gs_threadPool;
+}
+
+void wxThreadPool::DoStartThreadsIfNeeded()
+{
+    if ( !m_threads.empty() )
+        return;
+
+    m_threads.reserve(m_numThreads);
+    for ( int n = 0; n < m_numThreads; n++ )
+    {
+        WorkerThread* const thread = new WorkerThread(*this);
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to launch thread pool worker thread.");
+            delete thread;
+            continue;
+        }
+
+        m_threads.push_back(thread);
+    }
+}
+
+void wxThreadPool::QueueTask(Task task)
+{
+    wxMutexLocker lock(m_mutex);
+
+    wxCHECK_RET( !m_stopping, "can't queue tasks to a stopping pool" );
+
+    DoStartThreadsIfNeeded();
+
+    m_tasks.push_back(std::move(task));
+    m_condition.Signal();
+}
+
+void wxThreadPool::WorkerMain()
+{
+    for ( ;; )
+    {
+        Task task;
+
+        {
+            wxMutexLocker lock(m_mutex);
+            while ( m_tasks.empty() && !m_stopping )
+                m_condition.Wait();
+
+            // Note that we still execute all the pending tasks when stopping.
+            if ( m_tasks.empty() )
+                break;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+void
+wxThreadPool::ParallelFor(int count,
+                          int maxThreads,
+                          const std::function<void(int, int)>& func)
+{
+    if ( count <= 0 )
+        return;
+
+    int numThreads = m_numThreads + 1; // Don't forget the calling thread.
+    if ( maxThreads > 0 && maxThreads < numThreads )
+        numThreads = maxThreads;
+    if ( numThreads > count )
+        numThreads = count;
+
+    if ( numThreads == 1 )
+    {
+        func(0, count);
+        return;
+    }
+
+    // Use more ranges than threads to balance the load better if some of the
+    // ranges take longer to process than the others.
+    const int numRanges = wxMin(count, 4*numThreads);
+
+    auto state = std::make_shared<ParallelForState>(count, numRanges, func);
+
+    for ( int n = 1; n < numThreads; n++ )
+    {
+        QueueTask([state]() { state->ProcessRanges(); });
+    }
+
+    state->ProcessRanges();
+    state->WaitUntilDone();
+}
+
+#endif // wxUSE_THREADS
@@ -54,6 +54,10 @@
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 //-----------------------------------------------------------------------------
 // classes
 //-----------------------------------------------------------------------------
@@ -530,6 +534,11 @@ public:
     void InsertChild(wxDataViewMainWindow* window,
                      wxDataViewTreeNode *node, unsigned index);
 
+    // Insert all the given nodes at once, either in sort order, if the
+    // children are sorted, or in the order of their items in the model.
+    void InsertChildren(wxDataViewMainWindow* window,
+                        const wxDataViewTreeNodes& nodes);
+
     void RemoveChild(unsigned index)
     {
         wxCHECK_RET( m_branchData != nullptr, "leaf node doesn't have children" );
@@ -645,7 +654,9 @@ public:
             m_parent->ChangeSubTreeCount(num);
     }
 
-    void Resort(wxDataViewMainWindow* window);
+    // Sort the children of this node, and of all its open descendants,
+    // returns true if the order of any of them changed.
+    bool Resort(wxDataViewMainWindow* window);
 
     // Should be called after changing the item value to update its position in
     // the control if necessary.
@@ -656,6 +667,11 @@ public:
     }
 
 private:
+    // Update the sort order of the children before inserting new ones, after
+    // calling it the children must be kept sorted if their sort order is the
+    // same as the given one.
+    void UpdateSortOrderBeforeInsert(const SortOrder& sortOrder);
+
     // Called by the child after it has been updated to put it in the right
     // place among its siblings, depending on the sort order.
     //
@@ -730,21 +746,21 @@ public:
 
     // notifications from wxDataViewModel
     bool ItemAdded( const wxDataViewItem &parent, const wxDataViewItem &item );
+    bool ItemsAdded( const wxDataViewItem &parent, const wxDataViewItemArray &items );
     bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item );
     bool ItemChanged( const wxDataViewItem &item )
     {
         return DoItemChanged(item, wxNOT_FOUND);
     }
+    bool ItemsChanged( const wxDataViewItemArray &items );
     bool ValueChanged( const wxDataViewItem &item, unsigned int model_column );
     bool Cleared();
     void Resort()
     {
-        ClearRowHeightCache();
+        // Only clear the row heights cache if the rows were really reordered.
+        if ( IsVirtualList() || m_root->Resort(this) )
+            ClearRowHeightCache();
 
-        if (!IsVirtualList())
-        {
-            m_root->Resort(this);
-        }
         UpdateDisplay();
     }
     void ClearRowHeightCache()
@@ -1086,10 +1102,14 @@ public:
 
     virtual bool ItemAdded( const wxDataViewItem & parent, const wxDataViewItem & item ) override
         { return m_mainWindow->ItemAdded( parent , item ); }
+    virtual bool ItemsAdded( const wxDataViewItem & parent, const wxDataViewItemArray & items ) override
+        { return m_mainWindow->ItemsAdded( parent, items ); }
     virtual bool ItemDeleted( const wxDataViewItem &parent, const wxDataViewItem &item ) override
         { return m_mainWindow->ItemDeleted( parent, item ); }
     virtual bool ItemChanged( const wxDataViewItem & item ) override
         { return m_mainWindow->ItemChanged(item);  }
+    virtual bool ItemsChanged( const wxDataViewItemArray & items ) override
+        { return m_mainWindow->ItemsChanged(items); }
     virtual bool ValueChanged( const wxDataViewItem & item , unsigned int col ) override
         { return m_mainWindow->ValueChanged( item, col ); }
     virtual bool Cleared() override
@@ -1845,18 +1865,8 @@ private:
 
 } // anonymous namespace
 
-void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
-                                     wxDataViewTreeNode *node, unsigned index)
+void wxDataViewTreeNode::UpdateSortOrderBeforeInsert(const SortOrder& sortOrder)
 {
-    if (!m_branchData)
-        m_branchData = new BranchNodeData;
-
-    const SortOrder sortOrder = window->GetSortOrder();
-
-    // Flag indicating whether we should retain existing sorted list when
-    // inserting the child node.
-    bool insertSorted = false;
-
     if ( sortOrder.IsNone() )
     {
         // We should insert assuming an unsorted list. This will cause the
@@ -1886,27 +1896,34 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
         // For open branches, children should be already sorted.
         wxASSERT_MSG( m_branchData->sortOrder == sortOrder,
                       wxS("Logic error in wxDVC sorting code") );
-
-        // We can use fast insertion.
-        insertSorted = true;
-    }
-    else if ( m_branchData->sortOrder == sortOrder )
-    {
-        // The children are already sorted by the correct criteria (because
-        // the node must have been opened in the same time in the past). Even
-        // though it is closed now, we still insert in sort order to avoid a
-        // later resort.
-        insertSorted = true;
     }
-    else
+    else if ( m_branchData->sortOrder != sortOrder )
     {
         // The children of this closed node aren't sorted by the correct
         // criteria, so we just insert unsorted.
         m_branchData->sortOrder = SortOrder();
     }
+    //else: The children are already sorted by the correct criteria (because
+    //      the node must have been opened in the same time in the past). Even
+    //      though it is closed now, we still insert in sort order to avoid a
+    //      later resort.
+}
 
+void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
+                                     wxDataViewTreeNode *node, unsigned index)
+{
+    if (!m_branchData)
+        m_branchData = new BranchNodeData;
 
-    if ( insertSorted )
+    const SortOrder sortOrder = window->GetSortOrder();
+
+    UpdateSortOrderBeforeInsert(sortOrder);
+
+    // We don't need to search for the position to insert the first child at,
+    // even if the children are sorted.
+    if ( !sortOrder.IsNone() &&
+            m_branchData->sortOrder == sortOrder &&
+                !m_branchData->children.empty() )
     {
         // Use binary search to find the correct position to insert at.
         wxGenericTreeModelNodeCmp cmp(window, sortOrder);
@@ -1930,15 +1947,128 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
     }
 }
 
+void wxDataViewTreeNode::InsertChildren(wxDataViewMainWindow* window,
+                                        const wxDataViewTreeNodes& nodes)
+{
+    if (!m_branchData)
+        m_branchData = new BranchNodeData;
+
+    const SortOrder sortOrder = window->GetSortOrder();
+
+    UpdateSortOrderBeforeInsert(sortOrder);
+
+    wxDataViewTreeNodes& children = m_branchData->children;
+
+    if ( sortOrder.IsNone() )
+    {
+        // Insert each new child before the first existing one following it
+        // in the model, just as InsertChild() called from ItemAdded() would
+        // do, but for all of them in a single pass over the model items.
+        wxDataViewItemArray modelChildren;
+        window->GetModel()->GetChildren(m_item, modelChildren);
+
+        std::unordered_map<void*, size_t> existing;
+        existing.reserve(children.size());
+        for ( size_t n = 0; n < children.size(); n++ )
+            existing[children[n]->GetItem().GetID()] = n;
+
+        std::unordered_map<void*, wxDataViewTreeNode*> added;
+        added.reserve(nodes.size());
+        for ( const auto node : nodes )
+            added[node->GetItem().GetID()] = node;
+
+        // Walk the model items backwards to find the position of the next
+        // existing child for each of the new ones.
+        std::vector<std::pair<size_t, wxDataViewTreeNode*>> positions;
+        positions.reserve(nodes.size());
+
+        size_t nextPos = children.size();
+        for ( size_t n = modelChildren.size(); n > 0; n-- )
+        {
+            void* const id = modelChildren[n - 1].GetID();
+
+            const auto itExisting = existing.find(id);
+            if ( itExisting != existing.end() )
+            {
+                nextPos = itExisting->second;
+                continue;
+            }
 
-void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
+            const auto itAdded = added.find(id);
+            if ( itAdded != added.end() )
+            {
+                positions.emplace_back(nextPos, itAdded->second);
+                added.erase(itAdded);
+            }
+        }
+
+        wxASSERT_MSG( added.empty(), "adding non-existent items?" );
+
+        // Append the items not found in the model, as ItemAdded() does.
+        for ( const auto node : nodes )
+        {
+            if ( added.count(node->GetItem().GetID()) )
+                positions.emplace_back(children.size(), node);
+        }
+
+        // The positions were found in reverse model order, so they're sorted
+        // in decreasing order now, except for the ones just appended above.
+        std::reverse(positions.begin(),
+                     positions.begin() + (nodes.size() - added.size()));
+        std::stable_sort(positions.begin(), positions.end(),
+                         [](const std::pair<size_t, wxDataViewTreeNode*>& p1,
+                            const std::pair<size_t, wxDataViewTreeNode*>& p2)
+                         {
+                             return p1.first < p2.first;
+                         });
+
+        wxDataViewTreeNodes newChildren;
+        newChildren.reserve(children.size() + nodes.size());
+
+        auto it = positions.begin();
+        for ( size_t n = 0; n <= children.size(); n++ )
+        {
+            for ( ; it != positions.end() && it->first == n; ++it )
+                newChildren.push_back(it->second);
+
+            if ( n < children.size() )
+                newChildren.push_back(children[n]);
+        }
+
+        children.swap(newChildren);
+    }
+    else if ( m_branchData->sortOrder == sortOrder )
+    {
+        // Sort just the new children and merge them with the existing ones,
+        // which are already sorted.
+        const size_t oldCount = children.size();
+        children.insert(children.end(), nodes.begin(), nodes.end());
+
+        const wxGenericTreeModelNodeCmp cmp(window, sortOrder);
+        std::sort(children.begin() + oldCount, children.end(), cmp);
+        std::inplace_merge(children.begin(),
+                           children.begin() + oldCount,
+                           children.end(),
+                           cmp);
+    }
+    else
+    {
+        // The children will be sorted when the node is opened.
+        children.insert(children.end(), nodes.begin(), nodes.end());
+    }
+}
+
+
+bool wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 {
     if (!m_branchData)
-        return;
+        return false;
 
     // No reason to sort a closed node.
     if ( !m_branchData->open )
-        return;
+        return false;
+
+    bool changed = false;
 
     const SortOrder sortOrder = window->GetSortOrder();
     if ( !sortOrder.IsNone() )
@@ -1947,12 +2077,17 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 
         // When sorting by column value, we can skip resorting entirely if the
         // same sort order was used previously. However we can't do this when
-        // using model-specific sort order, which can change at any time.
+        // using model-specific sort order, which can change at any time, but
+        // even then we don't need to sort the children if they're still in
+        // order, which is much faster to check.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            const wxGenericTreeModelNodeCmp cmp(window, sortOrder);
+            if ( !std::is_sorted(nodes.begin(), nodes.end(), cmp) )
+            {
+                std::sort(nodes.begin(), nodes.end(), cmp);
+                changed = true;
+            }
 
             m_branchData->sortOrder = sortOrder;
         }
@@ -1961,10 +2096,12 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         int len = nodes.size();
         for ( int i = 0; i < len; i++ )
         {
-            if ( nodes[i]->HasChildren() )
-                nodes[i]->Resort(window);
+            if ( nodes[i]->HasChildren() && nodes[i]->Resort(window) )
+                changed = true;
         }
     }
+
+    return changed;
 }
 
 
@@ -3113,9 +3250,6 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     }
     else
     {
-        // specific position (row) is unclear, so clear whole height cache
-        ClearRowHeightCache();
-
         const FindNodeResult findResult = FindNode(parent);
         wxDataViewTreeNode *parentNode = findResult.m_node;
 
@@ -3208,6 +3342,15 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
         }
 
         InvalidateCount();
+
+        // Shift the cached heights of the rows after the new one, if it's
+        // visible, otherwise the rows don't change at all.
+        if ( m_rowHeightCache )
+        {
+            const int row = GetRowByItem(item, Walk_ExpandedOnly);
+            if ( row != -1 )
+                m_rowHeightCache->InsertRows(row, 1);
+        }
     }
 
     m_selection.OnItemsInserted(GetRowByItem(item), 1);
@@ -3218,6 +3361,125 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsAdded(const wxDataViewItem& parent,
+                                      const wxDataViewItemArray& items)
+{
+    // There is nothing to gain from handling the items added to a virtual list
+    // model all at once.
+    if ( IsVirtualList() || items.size() < 2 )
+    {
+        for ( const auto& item : items )
+        {
+            if ( !ItemAdded(parent, item) )
+                return false;
+        }
+
+        return true;
+    }
+
+    const FindNodeResult findResult = FindNode(parent);
+    wxDataViewTreeNode *parentNode = findResult.m_node;
+
+    // The checks below are the same as in ItemAdded(), see the comments there.
+    if ( !findResult.m_subtreeRealized )
+        return true;
+
+    if ( !parentNode )
+        return false;
+
+    if ( !parentNode->HasChildren() )
+    {
+        parentNode->SetHasChildren(true);
+        return true;
+    }
+
+    if ( !parentNode->IsOpen() && parentNode->GetChildNodes().empty() )
+        return true;
+
+    wxDataViewTreeNodes nodes;
+    nodes.reserve(items.size());
+    for ( const auto& item : items )
+    {
+        wxDataViewTreeNode *itemNode = new wxDataViewTreeNode(parentNode, item);
+        itemNode->SetHasChildren(GetModel()->IsContainer(item));
+        nodes.push_back(itemNode);
+    }
+
+    // Insert all the new nodes at once: this merges them with the existing
+    // ones in a single pass instead of searching for the position of each of
+    // them individually.
+    parentNode->ChangeSubTreeCount(static_cast<int>(nodes.size()));
+    parentNode->InsertChildren(this, nodes);
+
+    InvalidateCount();
+
+    // If the new items are visible, find the rows they were inserted at, in
+    // a single pass over all the children, and update the selection and the
+    // cached row heights.
+    int row = 0;
+    if ( parent.IsOk() )
+    {
+        row = GetRowByItem(parent, Walk_ExpandedOnly);
+        if ( row == -1 || !parentNode->IsOpen() )
+            row = -2;
+        else
+            row++;
+    }
+
+    if ( row != -2 )
+    {
+        const std::unordered_set<wxDataViewTreeNode*>
+            newNodes(nodes.begin(), nodes.end());
+
+        int firstNewRow = -1;
+        int runStart = -1,
+            runLength = 0;
+        for ( const auto child : parentNode->GetChildNodes() )
+        {
+            if ( newNodes.count(child) )
+            {
+                if ( firstNewRow == -1 )
+                    firstNewRow = row;
+
+                if ( runLength && runStart + runLength == row )
+                {
+                    runLength++;
+                }
+                else
+                {
+                    if ( runLength )
+                        m_selection.OnItemsInserted(runStart, runLength);
+
+                    runStart = row;
+                    runLength = 1;
+                }
+            }
+
+            row += child->GetSubTreeCount() + 1;
+        }
+
+        if ( runLength )
+            m_selection.OnItemsInserted(runStart, runLength);
+
+        if ( m_rowHeightCache )
+        {
+            // If all the new rows are consecutive, as is the case when they're
+            // appended or inserted in sort order before or after all the
+            // existing ones, just shift the subsequent rows, otherwise forget
+            // all the heights after the first new row.
+            if ( runStart == firstNewRow )
+                m_rowHeightCache->InsertRows(firstNewRow, runLength);
+            else
+                m_rowHeightCache->Remove(firstNewRow);
+        }
+    }
+
+    GetOwner()->InvalidateColBestWidths();
+    UpdateDisplay();
+
+    return true;
+}
+
 bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
                                        const wxDataViewItem& item)
 {
@@ -3386,6 +3648,74 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
     return true;
 }
 
+bool wxDataViewMainWindow::ItemsChanged(const wxDataViewItemArray& items)
+{
+    if ( items.size() < 2 )
+    {
+        for ( const auto& item : items )
+        {
+            if ( !ItemChanged(item) )
+                return false;
+        }
+
+        return true;
+    }
+
+    if ( !IsVirtualList() )
+    {
+        // Find the first row which may be affected by the changes before
+        // changing anything: as the items may move among their siblings after
+        // being resorted, take the row of the first sibling if sorting.
+        const bool sorted = !GetSortOrder().IsNone();
+
+        int firstRow = -1;
+        for ( const auto& item : items )
+        {
+            int row;
+            if ( sorted )
+            {
+                const wxDataViewItem parent = GetModel()->GetParent(item);
+                row = parent.IsOk() ? GetRowByItem(parent) + 1 : 0;
+            }
+            else
+            {
+                row = GetRowByItem(item);
+            }
+
+            if ( row != -1 && (firstRow == -1 || row < firstRow) )
+                firstRow = row;
+        }
+
+        if ( m_rowHeightCache && firstRow != -1 )
+            m_rowHeightCache->Remove(firstRow);
+
+        // See the comment in DoItemChanged() for why we always do this.
+        for ( const auto& item : items )
+        {
+            const FindNodeResult findResult = FindNode(item);
+            wxDataViewTreeNode* const node = findResult.m_node;
+            if ( !findResult.m_subtreeRealized )
+                continue;
+            wxCHECK_MSG( node, false, "invalid item" );
+            node->PutInSortOrder(this);
+        }
+    }
+
+    GetOwner()->InvalidateColBestWidths();
+
+    // Update the displayed values: refreshing the entire window is cheaper
+    // than finding the rows of all the changed items.
+    Refresh();
+
+    for ( const auto& item : items )
+    {
+        wxDataViewEvent le(wxEVT_DATAVIEW_ITEM_VALUE_CHANGED, m_owner, nullptr, item);
+        m_owner->ProcessWindowEvent(le);
+    }
+
+    return true;
+}
+
 bool wxDataViewMainWindow::ValueChanged( const wxDataViewItem & item, unsigned int model_column )
 {
     int view_column = m_owner->GetModelColumnIndex(model_column);
@@ -4024,13 +4354,6 @@ wxDataViewMainWindow::DoExpand(wxDataViewTreeNode* node,
             return;
         }
 
-        if ( m_rowHeightCache )
-        {
-            // Expand makes new rows visible thus we invalidates all following
-            // rows in the height cache
-            m_rowHeightCache->Remove(row);
-        }
-
         node->ToggleOpen(this);
 
         // build the children of current node
@@ -4044,6 +4367,8 @@ wxDataViewMainWindow::DoExpand(wxDataViewTreeNode* node,
         // Shift all stored indices after this row by the number of newly added
         // rows.
         m_selection.OnItemsInserted(row + 1, countNewRows);
+        if ( m_rowHeightCache )
+            m_rowHeightCache->InsertRows(row + 1, countNewRows);
         if ( HasCurrentRow() && m_currentRow > row )
             ChangeCurrentRow(m_currentRow + countNewRows);
 
@@ -4094,13 +4419,6 @@ void wxDataViewMainWindow::Collapse(unsigned int row)
     if (!node->HasChildren())
         return;
 
-    if ( m_rowHeightCache )
-    {
-        // Collapse hides rows thus we invalidates all following
-        // rows in the height cache
-        m_rowHeightCache->Remove(row);
-    }
-
     if (node->IsOpen())
     {
         if ( !SendExpanderEvent(wxEVT_DATAVIEW_ITEM_COLLAPSING,node->GetItem()) )
@@ -4116,6 +4434,9 @@ void wxDataViewMainWindow::Collapse(unsigned int row)
             SendSelectionChangedEvent(GetItemByRow(row));
         }
 
+        if ( m_rowHeightCache )
+            m_rowHeightCache->DeleteRows(row + 1, countDeletedRows);
+
         node->ToggleOpen(this);
 
         // Adjust the current row if necessary.
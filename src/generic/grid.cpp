@@ -46,6 +46,7 @@
 #include "wx/renderer.h"
 #include "wx/headerctrl.h"
 #include "wx/scopeguard.h"
+#include "wx/time.h"
 
 #if wxUSE_CLIPBOARD
     #include "wx/clipbrd.h"
@@ -131,6 +132,7 @@ wxDEFINE_EVENT( wxEVT_GRID_ROW_SIZE, wxGridSizeEvent );
 wxDEFINE_EVENT( wxEVT_GRID_ROW_AUTO_SIZE, wxGridSizeEvent );
 wxDEFINE_EVENT( wxEVT_GRID_COL_SIZE, wxGridSizeEvent );
 wxDEFINE_EVENT( wxEVT_GRID_COL_AUTO_SIZE, wxGridSizeEvent );
+wxDEFINE_EVENT( wxEVT_GRID_COLS_AUTO_SIZED, wxGridEvent );
 wxDEFINE_EVENT( wxEVT_GRID_ROW_LABEL_SIZE, wxGridSizeEvent);
 wxDEFINE_EVENT( wxEVT_GRID_COL_LABEL_SIZE, wxGridSizeEvent);
 wxDEFINE_EVENT( wxEVT_GRID_ROW_MOVE, wxGridEvent );
@@ -1211,6 +1213,200 @@ wxGridCellAttrData::FindIndex(int row, int col) const
     return m_attrs.find(CoordsToKey(row, col));
 }
 
+// ----------------------------------------------------------------------------
+// wxGridCellAttrCache
+// ----------------------------------------------------------------------------
+
+bool wxGridCellAttrCache::Lookup(int row, int col, wxGridCellAttr** attr) const
+{
+    const auto it = m_attrs.find(CoordsToKey(row, col));
+    if ( it == m_attrs.end() )
+        return false;
+
+    *attr = it->second;
+    wxSafeIncRef(*attr);
+
+    return true;
+}
+
+void wxGridCellAttrCache::Add(int row, int col, wxGridCellAttr* attr)
+{
+    if ( m_attrs.size() >= MAX_CELLS )
+        Clear();
+
+    wxGridCellAttr*& cached = m_attrs[CoordsToKey(row, col)];
+
+    wxSafeIncRef(attr);
+    wxGridCellAttr* const oldAttr = cached;
+    cached = attr;
+    wxSafeDecRef(oldAttr);
+}
+
+void wxGridCellAttrCache::Remove(int row, int col)
+{
+    const auto it = m_attrs.find(CoordsToKey(row, col));
+    if ( it == m_attrs.end() )
+        return;
+
+    wxGridCellAttr* const oldAttr = it->second;
+    m_attrs.erase(it);
+    wxSafeDecRef(oldAttr);
+}
+
+void wxGridCellAttrCache::RemoveBlock(int topRow, int leftCol,
+                                      int bottomRow, int rightCol)
+{
+    // Iterate over whichever is smaller: the block or the cache itself.
+    const double blockSize = double(bottomRow - topRow + 1)*(rightCol - leftCol + 1);
+    if ( blockSize <= m_attrs.size() )
+    {
+        for ( int row = topRow; row <= bottomRow; row++ )
+        {
+            for ( int col = leftCol; col <= rightCol; col++ )
+                Remove(row, col);
+        }
+
+        return;
+    }
+
+    std::vector<wxGridCoordsToAttrMap::key_type> keys;
+    for ( const auto& kv : m_attrs )
+    {
+        int row, col;
+        KeyToCoords(kv.first, &row, &col);
+        if ( row >= topRow && row <= bottomRow &&
+                col >= leftCol && col <= rightCol )
+            keys.push_back(kv.first);
+    }
+
+    // As in Clear(), remove all the attributes from the cache before
+    // releasing any of them.
+    std::vector<wxGridCellAttr*> attrs;
+    attrs.reserve(keys.size());
+    for ( const auto key : keys )
+    {
+        const auto it = m_attrs.find(key);
+        attrs.push_back(it->second);
+        m_attrs.erase(it);
+    }
+
+    for ( auto attr : attrs )
+        wxSafeDecRef(attr);
+}
+
+void wxGridCellAttrCache::Clear()
+{
+    // wxSafeDecRef() might cause event processing that accesses the cached
+    // attributes (e.g. by deleting the editor stored within the attribute).
+    // Therefore it is important to invalidate the cache before calling it.
+    wxGridCoordsToAttrMap attrs;
+    attrs.swap(m_attrs);
+
+    for ( const auto& kv : attrs )
+        wxSafeDecRef(kv.second);
+}
+
+// ----------------------------------------------------------------------------
+// wxGridTextLayoutCache
+// ----------------------------------------------------------------------------
+
+const wxGridTextLayout*
+wxGridTextLayoutCache::Find(const wxReadOnlyDC& dc,
+                            const wxString& text,
+                            int width,
+                            wxEllipsizeMode mode)
+{
+    const Key key(text, width, mode);
+
+    const auto it = m_current.find(key);
+    if ( it != m_current.end() )
+    {
+        // Note that comparing the fonts is cheap when they share the same
+        // data, as is normally the case for the fonts of grid attributes.
+        return it->second.font == dc.GetFont() ? &it->second.layout : nullptr;
+    }
+
+    const auto itPrev = m_previous.find(key);
+    if ( itPrev == m_previous.end() || !(itPrev->second.font == dc.GetFont()) )
+        return nullptr;
+
+    // Move the layout which is still used to the current generation.
+    Entry& entry = m_current[key];
+    entry = std::move(itPrev->second);
+    m_previous.erase(itPrev);
+
+    return &entry.layout;
+}
+
+wxGridTextLayout&
+wxGridTextLayoutCache::Add(const wxReadOnlyDC& dc,
+                           const wxString& text,
+                           int width,
+                           wxEllipsizeMode mode)
+{
+    if ( m_current.size() >= MAX_ENTRIES )
+    {
+        m_previous = std::move(m_current);
+        m_current.clear();
+    }
+
+    Entry& entry = m_current[Key(text, width, mode)];
+    entry.font = dc.GetFont();
+    entry.layout = wxGridTextLayout();
+
+    return entry.layout;
+}
+
+void wxGridTextLayoutCache::Clear()
+{
+    m_current.clear();
+    m_previous.clear();
+}
+
+// ----------------------------------------------------------------------------
+// wxGridCellBestWidthCache
+// ----------------------------------------------------------------------------
+
+int wxGridCellBestWidthCache::Get(int row, int col) const
+{
+    const auto it = m_widths.find(col);
+    if ( it == m_widths.end() )
+        return -1;
+
+    const std::vector<int>& widths = it->second;
+    return static_cast<size_t>(row) < widths.size() ? widths[row] : -1;
+}
+
+void wxGridCellBestWidthCache::Set(int row, int col, int width)
+{
+    std::vector<int>& widths = m_widths[col];
+    if ( static_cast<size_t>(row) >= widths.size() )
+        widths.resize(row + 1, -1);
+
+    widths[row] = width;
+}
+
+void wxGridCellBestWidthCache::Invalidate(int row, int col)
+{
+    const auto it = m_widths.find(col);
+    if ( it == m_widths.end() )
+        return;
+
+    std::vector<int>& widths = it->second;
+    if ( static_cast<size_t>(row) < widths.size() )
+        widths[row] = -1;
+}
+
+void wxGridCellBestWidthCache::InvalidateRow(int row)
+{
+    for ( auto& kv : m_widths )
+    {
+        std::vector<int>& widths = kv.second;
+        if ( static_cast<size_t>(row) < widths.size() )
+            widths[row] = -1;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // wxGridRowOrColAttrData
 // ----------------------------------------------------------------------------
@@ -1224,14 +1420,23 @@ wxGridRowOrColAttrData::~wxGridRowOrColAttrData()
     }
 }
 
+int wxGridRowOrColAttrData::FindIndex(int rowOrCol) const
+{
+    // The rows or columns are kept sorted, so use binary search.
+    const auto it = std::lower_bound(m_rowsOrCols.begin(), m_rowsOrCols.end(),
+                                     rowOrCol);
+
+    return it - m_rowsOrCols.begin();
+}
+
 wxGridCellAttr *wxGridRowOrColAttrData::GetAttr(int rowOrCol) const
 {
     wxGridCellAttr *attr = nullptr;
 
-    int n = m_rowsOrCols.Index(rowOrCol);
-    if ( n != wxNOT_FOUND )
+    const size_t n = FindIndex(rowOrCol);
+    if ( n < m_rowsOrCols.size() && m_rowsOrCols[n] == rowOrCol )
     {
-        attr = m_attrs[(size_t)n];
+        attr = m_attrs[n];
         attr->IncRef();
     }
 
@@ -1240,21 +1445,19 @@ wxGridCellAttr *wxGridRowOrColAttrData::GetAttr(int rowOrCol) const
 
 void wxGridRowOrColAttrData::SetAttr(wxGridCellAttr *attr, int rowOrCol)
 {
-    int i = m_rowsOrCols.Index(rowOrCol);
-    if ( i == wxNOT_FOUND )
+    const size_t n = FindIndex(rowOrCol);
+    if ( n == m_rowsOrCols.size() || m_rowsOrCols[n] != rowOrCol )
     {
         if ( attr )
         {
             // store the new attribute, taking its ownership
-            m_rowsOrCols.Add(rowOrCol);
-            m_attrs.Add(attr);
+            m_rowsOrCols.Insert(rowOrCol, n);
+            m_attrs.Insert(attr, n);
         }
         // nothing to remove
     }
     else // we have an attribute for this row or column
     {
-        size_t n = (size_t)i;
-
         // notice that this code works correctly even when the old attribute is
         // the same as the new one: as we own of it, we must call DecRef() on
         // it in any case and this won't result in destruction of the new
@@ -1306,6 +1509,348 @@ void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols
     }
 }
 
+// ----------------------------------------------------------------------------
+// wxGridBlockAttrData
+// ----------------------------------------------------------------------------
+
+wxGridBlockAttrData::~wxGridBlockAttrData()
+{
+    for ( const auto& block : m_blocks )
+        wxSafeDecRef(block.attr);
+}
+
+void wxGridBlockAttrData::SetAttr(wxGridCellAttr *attr,
+                                  const wxGridBlockCoords& block)
+{
+    const wxGridBlockCoords coords = block.Canonicalize();
+    if ( coords.GetTopRow() < 0 || coords.GetLeftCol() < 0 )
+    {
+        wxSafeDecRef(attr);
+        wxFAIL_MSG( "invalid block" );
+        return;
+    }
+
+    // Nothing to remove.
+    if ( !attr && m_blocks.empty() )
+        return;
+
+    m_blocks.push_back({coords, attr});
+    m_indexValid = false;
+
+    // Rebuilding the index discards the blocks which are completely
+    // overridden by the later ones, do it from time to time even if GetAttr()
+    // is not called to avoid accumulating too many of them.
+    if ( m_blocks.size() > 2*m_compactedSize + 1024 )
+        UpdateIndex();
+}
+
+wxGridCellAttr *wxGridBlockAttrData::GetAttr(int row, int col) const
+{
+    UpdateIndex();
+
+    // Find the band after the one containing this row.
+    auto band = std::upper_bound(m_bands.begin(), m_bands.end(), row,
+                                 [](int r, const Band& b)
+                                 {
+                                    return r < b.topRow;
+                                 });
+
+    // Notice that the last band is always empty and only indicates where the
+    // previous one ends, so the row is not covered by any block if it's in it.
+    if ( band == m_bands.begin() || band == m_bands.end() )
+        return nullptr;
+
+    const auto end = m_segments.begin() + band->firstSegment;
+
+    --band;
+
+    const auto begin = m_segments.begin() + band->firstSegment;
+
+    // Find the segment after the one containing this column.
+    auto segment = std::upper_bound(begin, end, col,
+                                    [](int c, const Segment& s)
+                                    {
+                                        return c < s.leftCol;
+                                    });
+
+    if ( segment == begin )
+        return nullptr;
+
+    --segment;
+
+    if ( col > segment->rightCol )
+        return nullptr;
+
+    segment->attr->IncRef();
+    return segment->attr;
+}
+
+void wxGridBlockAttrData::UpdateIndex() const
+{
+    if ( m_indexValid )
+        return;
+
+    m_indexValid = true;
+    m_bands.clear();
+    m_segments.clear();
+
+    const size_t count = m_blocks.size();
+
+    // Find the boundaries of all bands.
+    std::vector<int> rows;
+    rows.reserve(2*count);
+    for ( const auto& block : m_blocks )
+    {
+        rows.push_back(block.coords.GetTopRow());
+        rows.push_back(block.coords.GetBottomRow() + 1);
+    }
+
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // Indices of the blocks sorted by their first and last rows, used to
+    // find the blocks which become active or inactive in each band.
+    std::vector<size_t> byTop(count), byBottom(count);
+    for ( size_t n = 0; n < count; n++ )
+        byTop[n] = byBottom[n] = n;
+
+    std::sort(byTop.begin(), byTop.end(),
+              [this](size_t n1, size_t n2)
+              {
+                return m_blocks[n1].coords.GetTopRow() <
+                        m_blocks[n2].coords.GetTopRow();
+              });
+    std::sort(byBottom.begin(), byBottom.end(),
+              [this](size_t n1, size_t n2)
+              {
+                return m_blocks[n1].coords.GetBottomRow() <
+                        m_blocks[n2].coords.GetBottomRow();
+              });
+
+    // Indices of the blocks covering the current band: as the later blocks
+    // override the earlier ones, the last one has the highest priority.
+    std::set<size_t> active;
+
+    // The blocks which affect at least some cells, the others are discarded.
+    std::vector<bool> used(count, false);
+
+    // Column boundaries of the active blocks: each element is the column and
+    // the index of the block starting at it, or the bitwise complement of it
+    // for the block ending just before it.
+    std::vector<std::pair<int, size_t>> events;
+
+    // The blocks covering the current segment and the number of those of
+    // them which are not null.
+    std::set<size_t> covering;
+    size_t numNonNull = 0;
+
+    size_t nextTop = 0,
+           nextBottom = 0;
+    for ( size_t nBand = 0; nBand < rows.size(); nBand++ )
+    {
+        const int topRow = rows[nBand];
+
+        while ( nextTop < count &&
+                    m_blocks[byTop[nextTop]].coords.GetTopRow() <= topRow )
+        {
+            active.insert(byTop[nextTop++]);
+        }
+
+        while ( nextBottom < count &&
+                    m_blocks[byBottom[nextBottom]].coords.GetBottomRow() < topRow )
+        {
+            active.erase(byBottom[nextBottom++]);
+        }
+
+        m_bands.push_back({topRow, m_segments.size()});
+
+        if ( active.empty() )
+            continue;
+
+        // Divide the columns of this band into segments.
+        events.clear();
+        for ( const auto n : active )
+        {
+            const wxGridBlockCoords& coords = m_blocks[n].coords;
+            events.push_back({coords.GetLeftCol(), n});
+            events.push_back({coords.GetRightCol() + 1, ~n});
+        }
+
+        std::sort(events.begin(), events.end(),
+                  [](const std::pair<int, size_t>& e1,
+                     const std::pair<int, size_t>& e2)
+                  {
+                    return e1.first < e2.first;
+                  });
+
+        const size_t firstSegment = m_segments.size();
+        for ( size_t nEvent = 0; nEvent < events.size(); )
+        {
+            const int col = events[nEvent].first;
+            for ( ; nEvent < events.size() && events[nEvent].first == col;
+                  nEvent++ )
+            {
+                size_t n = events[nEvent].second;
+                const bool isStart = n < count;
+                if ( !isStart )
+                    n = ~n;
+
+                const bool isNonNull = m_blocks[n].attr != nullptr;
+                if ( isStart )
+                {
+                    covering.insert(n);
+                    if ( isNonNull )
+                        numNonNull++;
+                }
+                else
+                {
+                    covering.erase(n);
+                    if ( isNonNull )
+                        numNonNull--;
+                }
+            }
+
+            if ( covering.empty() )
+                continue;
+
+            // As the last event always ends a block, there is always a next
+            // one if some blocks are still covering this column.
+            const int nextCol = events[nEvent].first;
+
+            const size_t top = *covering.rbegin();
+            wxGridCellAttr* const attr = m_blocks[top].attr;
+            if ( !attr )
+            {
+                // A block removing the attributes is only useful if it
+                // overrides some other block.
+                if ( numNonNull )
+                    used[top] = true;
+                continue;
+            }
+
+            used[top] = true;
+
+            // Merge the adjacent segments with the same attribute.
+            if ( m_segments.size() > firstSegment )
+            {
+                Segment& last = m_segments.back();
+                if ( last.attr == attr && last.rightCol == col - 1 )
+                {
+                    last.rightCol = nextCol - 1;
+                    continue;
+                }
+            }
+
+            m_segments.push_back({col, nextCol - 1, attr});
+        }
+    }
+
+    // Discard the blocks which don't affect anything any more.
+    size_t numUsed = 0;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( used[n] )
+            m_blocks[numUsed++] = m_blocks[n];
+        else
+            wxSafeDecRef(m_blocks[n].attr);
+    }
+
+    m_blocks.resize(numUsed);
+    m_compactedSize = numUsed;
+}
+
+void wxGridBlockAttrData::UpdateAttrRows( size_t pos, int numRows )
+{
+    DoUpdateAttrRowsOrCols(pos, numRows, true);
+}
+
+void wxGridBlockAttrData::UpdateAttrCols( size_t pos, int numCols )
+{
+    DoUpdateAttrRowsOrCols(pos, numCols, false);
+}
+
+void
+wxGridBlockAttrData::DoUpdateAttrRowsOrCols( size_t pos, int numRowsOrCols,
+                                             bool rows )
+{
+    const int first = static_cast<int>(pos);
+
+    std::vector<Block> blocks;
+    blocks.reserve(m_blocks.size());
+
+    for ( const auto& block : m_blocks )
+    {
+        int blockFirst = rows ? block.coords.GetTopRow()
+                              : block.coords.GetLeftCol();
+        int blockLast = rows ? block.coords.GetBottomRow()
+                             : block.coords.GetRightCol();
+
+        if ( numRowsOrCols > 0 )
+        {
+            if ( blockFirst < first && blockLast >= first )
+            {
+                // The new rows or columns don't have any attributes, just
+                // as the new cells don't have them when inserting inside a
+                // row with cell attributes, so split the block in two.
+                Block blockBefore = block;
+                if ( rows )
+                    blockBefore.coords.SetBottomRow(first - 1);
+                else
+                    blockBefore.coords.SetRightCol(first - 1);
+
+                wxSafeIncRef(blockBefore.attr);
+                blocks.push_back(blockBefore);
+
+                blockFirst = first;
+            }
+
+            if ( blockFirst >= first )
+                blockFirst += numRowsOrCols;
+            if ( blockLast >= first )
+                blockLast += numRowsOrCols;
+        }
+        else if ( numRowsOrCols < 0 )
+        {
+            // One past the last deleted row or column.
+            const int end = first - numRowsOrCols;
+
+            if ( blockFirst >= end )
+                blockFirst += numRowsOrCols;
+            else if ( blockFirst >= first )
+                blockFirst = first;
+
+            if ( blockLast >= end )
+                blockLast += numRowsOrCols;
+            else if ( blockLast >= first )
+                blockLast = first - 1;
+
+            if ( blockLast < blockFirst )
+            {
+                // The entire block was deleted.
+                wxSafeDecRef(block.attr);
+                continue;
+            }
+        }
+
+        Block blockNew = block;
+        if ( rows )
+        {
+            blockNew.coords.SetTopRow(blockFirst);
+            blockNew.coords.SetBottomRow(blockLast);
+        }
+        else
+        {
+            blockNew.coords.SetLeftCol(blockFirst);
+            blockNew.coords.SetRightCol(blockLast);
+        }
+
+        blocks.push_back(blockNew);
+    }
+
+    m_blocks.swap(blocks);
+    m_indexValid = false;
+}
+
 // ----------------------------------------------------------------------------
 // wxGridCellAttrProvider
 // ----------------------------------------------------------------------------
@@ -1334,62 +1879,59 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
         switch (kind)
         {
             case (wxGridCellAttr::Any):
-                // Get cached merge attributes.
-                // Currently not used as no cache implemented as not mutable
-                // attr = m_data->m_mergeAttr.GetAttr(row, col);
-                if (!attr)
                 {
-                    // Basically implement old version.
-                    // Also check merge cache, so we don't have to re-merge every time..
-                    wxGridCellAttr *attrcell = m_data->m_cellAttrs.GetAttr(row, col);
-                    wxGridCellAttr *attrrow = m_data->m_rowAttrs.GetAttr(row);
-                    wxGridCellAttr *attrcol = m_data->m_colAttrs.GetAttr(col);
-
-                    if ((attrcell != attrrow) && (attrrow != attrcol) && (attrcell != attrcol))
+                    // Order is important: the attributes of the cell itself
+                    // take precedence over those of the blocks containing it
+                    // which take precedence over the column and then the row
+                    // attributes.
+                    wxGridCellAttr* attrs[] =
                     {
-                        // Two or more are non null
-                        attr = new wxGridCellAttr;
-                        attr->SetKind(wxGridCellAttr::Merged);
+                        m_data->m_cellAttrs.GetAttr(row, col),
+                        m_data->m_blockAttrs.GetAttr(row, col),
+                        m_data->m_colAttrs.GetAttr(col),
+                        m_data->m_rowAttrs.GetAttr(row),
+                    };
+
+                    // Count the distinct non-null attributes, notice that the
+                    // same attribute may be used for several of them.
+                    int count = 0;
+                    for ( size_t n = 0; n < WXSIZEOF(attrs); n++ )
+                    {
+                        if ( !attrs[n] )
+                            continue;
 
-                        // Order is important..
-                        if (attrcell)
+                        for ( size_t m = 0; m < n; m++ )
                         {
-                            attr->MergeWith(attrcell);
-                            attrcell->DecRef();
-                        }
-                        if (attrcol)
-                        {
-                            attr->MergeWith(attrcol);
-                            attrcol->DecRef();
+                            if ( attrs[m] == attrs[n] )
+                            {
+                                attrs[n]->DecRef();
+                                attrs[n] = nullptr;
+                                break;
+                            }
                         }
-                        if (attrrow)
+
+                        if ( attrs[n] )
                         {
-                            attr->MergeWith(attrrow);
-                            attrrow->DecRef();
+                            attr = attrs[n];
+                            count++;
                         }
-
-                        // store merge attr if cache implemented
-                        //attr->IncRef();
-                        //m_data->m_mergeAttr.SetAttr(attr, row, col);
                     }
-                    else
+
+                    if ( count > 1 )
                     {
-                        // one or none is non null return it or null.
-                        if (attrrow)
-                            attr = attrrow;
-                        if (attrcol)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcol;
-                        }
-                        if (attrcell)
+                        attr = new wxGridCellAttr;
+                        attr->SetKind(wxGridCellAttr::Merged);
+
+                        for ( const auto attrOther : attrs )
                         {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcell;
+                            if ( attrOther )
+                            {
+                                attr->MergeWith(attrOther);
+                                attrOther->DecRef();
+                            }
                         }
                     }
+                    //else: one or none is non null, just return it or null.
                 }
                 break;
 
@@ -1425,6 +1967,15 @@ void wxGridCellAttrProvider::SetAttr(wxGridCellAttr *attr,
     m_data->m_cellAttrs.SetAttr(attr, row, col);
 }
 
+void wxGridCellAttrProvider::SetBlockAttr(wxGridCellAttr *attr,
+                                          const wxGridBlockCoords& block)
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_blockAttrs.SetAttr(attr, block);
+}
+
 void wxGridCellAttrProvider::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( !m_data )
@@ -1447,6 +1998,8 @@ void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
     {
         m_data->m_cellAttrs.UpdateAttrRows( pos, numRows );
 
+        m_data->m_blockAttrs.UpdateAttrRows( pos, numRows );
+
         m_data->m_rowAttrs.UpdateAttrRowsOrCols( pos, numRows );
     }
 }
@@ -1457,6 +2010,8 @@ void wxGridCellAttrProvider::UpdateAttrCols( size_t pos, int numCols )
     {
         m_data->m_cellAttrs.UpdateAttrCols( pos, numCols );
 
+        m_data->m_blockAttrs.UpdateAttrCols( pos, numCols );
+
         m_data->m_colAttrs.UpdateAttrRowsOrCols( pos, numCols );
     }
 }
@@ -1735,6 +2290,23 @@ void wxGridTableBase::SetAttr(wxGridCellAttr* attr, int row, int col)
     }
 }
 
+void wxGridTableBase::SetBlockAttr(wxGridCellAttr* attr,
+                                   const wxGridBlockCoords& block)
+{
+    if ( m_attrProvider )
+    {
+        if ( attr )
+            attr->SetKind(wxGridCellAttr::Cell);
+        m_attrProvider->SetBlockAttr(attr, block);
+    }
+    else
+    {
+        // as we take ownership of the pointer and don't store it, we must
+        // free it now
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGridTableBase::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( m_attrProvider )
@@ -2850,6 +3422,7 @@ void wxGridWindow::OnFocus(wxFocusEvent& event)
 wxBEGIN_EVENT_TABLE( wxGrid, wxScrolledCanvas )
     EVT_SIZE( wxGrid::OnSize )
     EVT_DPI_CHANGED( wxGrid::OnDPIChanged )
+    EVT_IDLE( wxGrid::OnIdle )
     EVT_KEY_DOWN( wxGrid::OnKeyDown )
     EVT_CHAR ( wxGrid::OnChar )
 wxEND_EVENT_TABLE()
@@ -2902,6 +3475,11 @@ wxGrid::~wxGrid()
     delete m_typeRegistry;
     delete m_selection;
 
+    delete m_attrCache;
+    delete m_textLayoutCache;
+    delete m_bestWidthCache;
+    delete m_autoSizeColsState;
+
     delete m_setFixedRows;
     delete m_setFixedCols;
 
@@ -3091,6 +3669,8 @@ wxGrid::SetTable(wxGridTableBase *table,
 
             // Don't hold on to attributes cached from the old table
             ClearAttrCache();
+            ClearAutoSizeCache();
+            CancelAutoSizeColumnsInIdle();
 
             m_table->SetView(nullptr);
             if( m_ownTable )
@@ -3172,10 +3752,12 @@ void wxGrid::Init()
     m_setFixedRows =
     m_setFixedCols = nullptr;
 
-    // init attr cache
-    m_attrCache.row = -1;
-    m_attrCache.col = -1;
-    m_attrCache.attr = nullptr;
+    m_attrCache = new wxGridCellAttrCache;
+    m_textLayoutCache = new wxGridTextLayoutCache;
+    m_bestWidthCache = nullptr;
+
+    m_autoSizeSampleSize = 0;
+    m_autoSizeColsState = nullptr;
 
     m_labelFont = GetFont();
     m_labelFont.SetWeight( wxFONTWEIGHT_BOLD );
@@ -3484,6 +4066,12 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
     // cell than stored in the cache after adding/removing rows/columns.
     ClearAttrCache();
 
+    // Same for the cells widths and, as we don't know which cells were
+    // already measured any more, auto-sizing in progress has to restart.
+    ClearAutoSizeCache();
+    if ( m_autoSizeColsState )
+        m_autoSizeColsState->Restart();
+
     // By the same reasoning, the editor should be dismissed if columns are
     // added or removed. And for consistency, it should IMHO always be
     // removed, not only if the cell "underneath" it actually changes.
@@ -5974,6 +6562,10 @@ wxGrid::SendEvent(wxEventType type, int row, int col, const wxString& s)
 
 void wxGrid::Refresh(bool eraseb, const wxRect* rect)
 {
+    // The attributes may depend on the data, or on anything else, really, so
+    // don't reuse the cached ones after a refresh, even if it's postponed.
+    ClearAttrCache();
+
     // Don't do anything if between Begin/EndBatch...
     // EndBatch() will do all this on the last nested one anyway.
     if ( ShouldRefresh() )
@@ -6029,6 +6621,11 @@ void wxGrid::RefreshBlock(int topRow, int leftCol,
         rightCol = leftCol;
     }
 
+    // As in Refresh(), the attributes of the cells being refreshed could
+    // have changed, e.g. because their values changed in the table, so don't
+    // reuse the cached ones for them.
+    m_attrCache->RemoveBlock(topRow, leftCol, bottomRow, rightCol);
+
 
     int row = topRow;
     int col = leftCol;
@@ -6197,6 +6794,10 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
 {
     InitPixelFields();
 
+    // The text extents are different now.
+    m_textLayoutCache->Clear();
+    ClearAutoSizeCache();
+
     // If we have any non-default row sizes, we need to scale them (default
     // ones will be scaled due to the reinitialization of m_defaultRowHeight
     // inside InitPixelFields() above).
@@ -7668,12 +8269,47 @@ void wxGrid::DrawTextRectangle( wxDC& dc,
     DrawTextRectangle(dc, lines, rect, horizAlign, vertAlign, textOrientation);
 }
 
-void wxGrid::DrawTextRectangle(wxDC& dc,
-                               const wxArrayString& lines,
-                               const wxRect& rect,
-                               int horizAlign,
-                               int vertAlign,
-                               int textOrientation) const
+namespace
+{
+
+// Compute the sizes of the lines of text drawn by DrawTextLines() below.
+void MeasureTextLines(const wxReadOnlyDC& dc,
+                      const wxArrayString& lines,
+                      std::vector<wxSize>& lineSizes,
+                      wxSize& size)
+{
+    lineSizes.clear();
+    lineSizes.reserve(lines.size());
+
+    size = wxSize();
+    for ( const auto& line : lines )
+    {
+        wxSize lineSize;
+        if ( line.empty() )
+        {
+            // GetTextExtent() would return 0 for empty lines, but we still
+            // need to account for their height.
+            lineSize.y = dc.GetCharHeight();
+        }
+        else
+        {
+            lineSize = dc.GetTextExtent(line);
+            size.x = wxMax(size.x, lineSize.x);
+        }
+
+        size.y += lineSize.y;
+        lineSizes.push_back(lineSize);
+    }
+}
+
+void DrawTextLines(wxDC& dc,
+                   const wxArrayString& lines,
+                   const std::vector<wxSize>& lineSizes,
+                   const wxSize& size,
+                   const wxRect& rect,
+                   int horizAlign,
+                   int vertAlign,
+                   int textOrientation)
 {
     if ( lines.empty() )
         return;
@@ -7684,9 +8320,15 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
          textHeight;
 
     if ( textOrientation == wxHORIZONTAL )
-        GetTextBoxSize( dc, lines, &textWidth, &textHeight );
+    {
+        textWidth = size.x;
+        textHeight = size.y;
+    }
     else
-        GetTextBoxSize( dc, lines, &textHeight, &textWidth );
+    {
+        textWidth = size.y;
+        textHeight = size.x;
+    }
 
     int x = 0,
         y = 0;
@@ -7723,13 +8365,12 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
 
         if ( line.empty() )
         {
-            *(textOrientation == wxHORIZONTAL ? &y : &x) += dc.GetCharHeight();
+            *(textOrientation == wxHORIZONTAL ? &y : &x) += lineSizes[l].y;
             continue;
         }
 
-        wxCoord lineWidth = 0,
-             lineHeight = 0;
-        dc.GetTextExtent(line, &lineWidth, &lineHeight);
+        const wxCoord lineWidth = lineSizes[l].x,
+                      lineHeight = lineSizes[l].y;
 
         switch ( horizAlign )
         {
@@ -7769,6 +8410,26 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
     }
 }
 
+} // anonymous namespace
+
+void wxGrid::DrawTextRectangle(wxDC& dc,
+                               const wxArrayString& lines,
+                               const wxRect& rect,
+                               int horizAlign,
+                               int vertAlign,
+                               int textOrientation) const
+{
+    if ( lines.empty() )
+        return;
+
+    std::vector<wxSize> lineSizes;
+    wxSize size;
+    MeasureTextLines(dc, lines, lineSizes, size);
+
+    DrawTextLines(dc, lines, lineSizes, size,
+                  rect, horizAlign, vertAlign, textOrientation);
+}
+
 void wxGrid::DrawTextRectangle(wxDC& dc,
                                const wxString& text,
                                const wxRect& rect,
@@ -7776,19 +8437,65 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
                                int hAlign,
                                int vAlign) const
 {
+    if ( text.empty() )
+        return;
+
     attr.GetNonDefaultAlignment(&hAlign, &vAlign);
 
-    // This does nothing if there is no need to ellipsize.
-    const wxString& ellipsizedText = wxControl::Ellipsize
-                                     (
-                                         text,
-                                         dc,
-                                         attr.GetFitMode().GetEllipsizeMode(),
-                                         rect.GetWidth() - 2 * GRID_TEXT_MARGIN,
-                                         wxELLIPSIZE_FLAGS_NONE
-                                     );
+    const wxEllipsizeMode ellipsizeMode = attr.GetFitMode().GetEllipsizeMode();
+    const int width = rect.GetWidth() - 2 * GRID_TEXT_MARGIN;
+
+    if ( !CanUseTextLayoutCache(dc) )
+    {
+        // This does nothing if there is no need to ellipsize.
+        const wxString& ellipsizedText = wxControl::Ellipsize
+                                         (
+                                             text,
+                                             dc,
+                                             ellipsizeMode,
+                                             width,
+                                             wxELLIPSIZE_FLAGS_NONE
+                                         );
+
+        DrawTextRectangle(dc, ellipsizedText, rect, hAlign, vAlign);
+        return;
+    }
+
+    // Ellipsizing and measuring the text is relatively slow, so reuse the
+    // results computed when this text was drawn the last time if possible.
+    const wxGridTextLayout*
+        layout = m_textLayoutCache->Find(dc, text, width, ellipsizeMode);
+    if ( !layout )
+    {
+        wxGridTextLayout&
+            newLayout = m_textLayoutCache->Add(dc, text, width, ellipsizeMode);
+
+        StringToLines(wxControl::Ellipsize(text, dc, ellipsizeMode, width,
+                                           wxELLIPSIZE_FLAGS_NONE),
+                      newLayout.lines);
+        MeasureTextLines(dc, newLayout.lines,
+                         newLayout.lineSizes, newLayout.size);
+
+        layout = &newLayout;
+    }
+
+    DrawTextLines(dc, layout->lines, layout->lineSizes, layout->size,
+                  rect, hAlign, vAlign, wxHORIZONTAL);
+}
+
+bool wxGrid::CanUseTextLayoutCache(const wxReadOnlyDC& dc) const
+{
+    // The cached text extents are only valid for the DCs associated with our
+    // windows on screen: they may be different e.g. when printing or when
+    // rendering the grid into a bitmap, see Render().
+    const wxWindow* const win = dc.GetWindow();
+    if ( !win || win->GetParent() != this )
+        return false;
+
+    double scaleX, scaleY;
+    dc.GetUserScale(&scaleX, &scaleY);
 
-    DrawTextRectangle(dc, ellipsizedText, rect, hAlign, vAlign);
+    return scaleX == 1.0 && scaleY == 1.0;
 }
 
 // Split multi-line text up into an array of strings.
@@ -8290,6 +8997,10 @@ void wxGrid::DoSaveEditControlValue()
         case Event_Handled:
             editor->ApplyEdit(row, col, this);
 
+            // ApplyEdit() changes the value in the table directly, so the
+            // cached attributes and best width of this cell may be stale now.
+            RefreshAttr(row, col);
+
             // for compatibility reasons dating back to wx 2.8 when this event
             // was called wxEVT_GRID_CELL_CHANGE and wxEVT_GRID_CELL_CHANGING
             // didn't exist we allow vetoing this one too
@@ -9745,6 +10456,8 @@ void wxGrid::SetDefaultCellFitMode(wxGridFitMode fitMode)
 void wxGrid::SetDefaultCellFont( const wxFont& font )
 {
     m_defaultCellAttr->SetFont(font);
+
+    ClearAutoSizeCache();
 }
 
 // For editors and renderers the type registry takes precedence over the
@@ -9909,47 +10622,27 @@ bool wxGrid::CanHaveAttributes() const
 
 void wxGrid::ClearAttrCache()
 {
-    if ( m_attrCache.row != -1 )
-    {
-        wxGridCellAttr *oldAttr = m_attrCache.attr;
-        m_attrCache.attr = nullptr;
-        m_attrCache.row = -1;
-        // wxSafeDecRec(...) might cause event processing that accesses
-        // the cached attribute, if one exists (e.g. by deleting the
-        // editor stored within the attribute). Therefore it is important
-        // to invalidate the cache  before calling wxSafeDecRef!
-        wxSafeDecRef(oldAttr);
-    }
+    m_attrCache->Clear();
 }
 
 void wxGrid::RefreshAttr(int row, int col)
 {
-    if ( m_attrCache.row == row && m_attrCache.col == col )
-        ClearAttrCache();
+    m_attrCache->Remove(row, col);
+
+    if ( m_bestWidthCache )
+        m_bestWidthCache->Invalidate(row, col);
 }
 
 
 void wxGrid::CacheAttr(int row, int col, wxGridCellAttr *attr) const
 {
-    if ( attr != nullptr )
-    {
-        wxGrid * const self = const_cast<wxGrid *>(this);
-
-        self->ClearAttrCache();
-        self->m_attrCache.row = row;
-        self->m_attrCache.col = col;
-        self->m_attrCache.attr = attr;
-        wxSafeIncRef(attr);
-    }
+    m_attrCache->Add(row, col, attr);
 }
 
 bool wxGrid::LookupAttr(int row, int col, wxGridCellAttr **attr) const
 {
-    if ( row == m_attrCache.row && col == m_attrCache.col )
+    if ( m_attrCache->Lookup(row, col, attr) )
     {
-        *attr = m_attrCache.attr;
-        wxSafeIncRef(m_attrCache.attr);
-
 #ifdef DEBUG_ATTR_CACHE
         gs_nAttrCacheHits++;
 #endif
@@ -10074,6 +10767,21 @@ void wxGrid::SetAttr(int row, int col, wxGridCellAttr *attr)
     {
         m_table->SetAttr(attr, row, col);
         ClearAttrCache();
+        ClearAutoSizeCache();
+    }
+    else
+    {
+        wxSafeDecRef(attr);
+    }
+}
+
+void wxGrid::SetBlockAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr)
+{
+    if ( CanHaveAttributes() )
+    {
+        m_table->SetBlockAttr(attr, block);
+        ClearAttrCache();
+        ClearAutoSizeCache();
     }
     else
     {
@@ -10087,6 +10795,7 @@ void wxGrid::SetRowAttr(int row, wxGridCellAttr *attr)
     {
         m_table->SetRowAttr(attr, row);
         ClearAttrCache();
+        ClearAutoSizeCache();
     }
     else
     {
@@ -10100,6 +10809,7 @@ void wxGrid::SetColAttr(int col, wxGridCellAttr *attr)
     {
         m_table->SetColAttr(attr, col);
         ClearAttrCache();
+        ClearAutoSizeCache();
     }
     else
     {
@@ -10128,6 +10838,9 @@ void wxGrid::SetCellFont( int row, int col, const wxFont& font )
     if ( CanHaveAttributes() )
     {
         GetOrCreateCellAttrPtr(row, col)->SetFont(font);
+
+        if ( m_bestWidthCache )
+            m_bestWidthCache->Invalidate(row, col);
     }
 }
 
@@ -10198,6 +10911,19 @@ void wxGrid::SetCellSize( int row, int col, int num_rows, int num_cols )
                 }
             }
         }
+
+        // The cells which were, or are now, covered by this one are measured
+        // differently, so forget their widths.
+        if ( m_bestWidthCache )
+        {
+            const int maxRow = row + wxMax(num_rows, cell_rows);
+            const int maxCol = col + wxMax(num_cols, cell_cols);
+            for ( int j = row; j < maxRow; j++ )
+            {
+                for ( int i = col; i < maxCol; i++ )
+                    m_bestWidthCache->Invalidate(j, i);
+            }
+        }
     }
 }
 
@@ -10206,6 +10932,9 @@ void wxGrid::SetCellRenderer(int row, int col, wxGridCellRenderer *renderer)
     if ( CanHaveAttributes() )
     {
         GetOrCreateCellAttrPtr(row, col)->SetRenderer(renderer);
+
+        if ( m_bestWidthCache )
+            m_bestWidthCache->Invalidate(row, col);
     }
 }
 
@@ -10234,6 +10963,9 @@ void wxGrid::RegisterDataType(const wxString& typeName,
                               wxGridCellEditor* editor)
 {
     m_typeRegistry->RegisterDataType(typeName, renderer, editor);
+
+    // The cells of this type may be measured differently now.
+    ClearAutoSizeCache();
 }
 
 
@@ -10449,6 +11181,9 @@ void wxGrid::DoSetRowSize( int row, int height )
     if ( !diff )
         return;
 
+    // The best width of the cells may depend on their height if they wrap.
+    if ( m_bestWidthCache )
+        m_bestWidthCache->InvalidateRow(row);
 
     for ( int rowPos = GetRowPos(row); rowPos < m_numRows; rowPos++ )
     {
@@ -10730,6 +11465,94 @@ void wxGrid::SetNativeHeaderColOrder()
 // auto sizing
 // ----------------------------------------------------------------------------
 
+wxCoord
+wxGrid::GetCellBestExtent(wxDC& dc,
+                          int row, int col,
+                          wxGridDirection direction,
+                          wxGridCellAttrPtr& attr,
+                          wxGridCellRendererPtr& renderer)
+{
+    const bool column = direction == wxGRID_COLUMN;
+
+    // we need to account for the cells spanning multiple columns/rows:
+    // while they may need a lot of space, they don't need all of it in
+    // this column/row
+    int numRows, numCols;
+    const CellSpan span = GetCellSize(row, col, &numRows, &numCols);
+
+    // Only the widths of the normal cells are cached, as the width of a cell
+    // inside a span depends on another cell.
+    const bool useCache = column && m_bestWidthCache && span == CellSpan_None;
+    if ( useCache )
+    {
+        const int width = m_bestWidthCache->Get(row, col);
+        if ( width != -1 )
+            return width;
+    }
+
+    if ( span == CellSpan_Inside )
+    {
+        // we need to get the size of the main cell, not of a cell hidden
+        // by it
+        row += numRows;
+        col += numCols;
+
+        // get the size of the main cell too
+        GetCellSize(row, col, &numRows, &numCols);
+    }
+
+    // get cell ( main cell if CellSpan_Inside ) renderer best size
+    if ( !attr )
+    {
+        attr = GetCellAttrPtr(row, col);
+        renderer = attr->GetRendererPtr(this, row, col);
+    }
+
+    if ( !renderer )
+        return 0;
+
+    wxCoord extent = column
+                        ? renderer->GetBestWidth(*this, *attr, dc, row, col,
+                                                 GetRowHeight(row))
+                        : renderer->GetBestHeight(*this, *attr, dc, row, col,
+                                                  GetColWidth(col));
+
+    if ( span != CellSpan_None )
+    {
+        // we spread the size of a spanning cell over all the cells it
+        // covers evenly -- this is probably not ideal but we can't
+        // really do much better here
+        //
+        // notice that numCols and numRows are never 0 as they
+        // correspond to the size of the main cell of the span and not
+        // of the cell inside it
+        extent /= column ? numCols : numRows;
+    }
+
+    if ( useCache )
+        m_bestWidthCache->Set(row, col, extent);
+
+    return extent;
+}
+
+int wxGrid::GetAutoSizeRowsCount() const
+{
+    if ( m_autoSizeSampleSize > 0 && m_autoSizeSampleSize < m_numRows )
+        return m_autoSizeSampleSize;
+
+    return m_numRows;
+}
+
+int wxGrid::GetAutoSizeRow(int n) const
+{
+    const int count = GetAutoSizeRowsCount();
+    if ( count == m_numRows )
+        return n;
+
+    // Spread the sampled rows evenly over the entire grid.
+    return static_cast<int>(static_cast<wxLongLong_t>(n) * m_numRows / count);
+}
+
 void
 wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
 {
@@ -10755,112 +11578,75 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
 
     AcceptCellEditControlIfShown();
 
-    // initialize both of them just to avoid compiler warnings even if only
-    // really needs to be initialized here
-    int row,
-        col;
-    if ( column )
-    {
-        row = -1;
-        col = colOrRow;
-    }
-    else
-    {
-        row = colOrRow;
-        col = -1;
-    }
-
     // If possible, reuse the same attribute and renderer for all cells: this
     // is an important optimization (resulting in up to 80% speed up of
     // AutoSizeColumns()) as finding the attribute and renderer for the cell
     // are very slow operations, due to the number of steps involved in them.
-    const bool canReuseAttr = column && m_table->CanMeasureColUsingSameAttr(col);
+    const bool canReuseAttr = column && m_table->CanMeasureColUsingSameAttr(colOrRow);
     wxGridCellAttrPtr attr;
     wxGridCellRendererPtr renderer;
 
     wxCoord extent, extentMax = 0;
-    int max = column ? m_numRows : m_numCols;
-    for ( int rowOrCol = 0; rowOrCol < max; rowOrCol++ )
+    const int count = column ? GetAutoSizeRowsCount() : m_numCols;
+    for ( int n = 0; n < count; n++ )
     {
+        int row,
+            col;
         if ( column )
         {
-            if ( !IsRowShown(rowOrCol) )
+            row = GetAutoSizeRow(n);
+            if ( !IsRowShown(row) )
                 continue;
 
-            row = rowOrCol;
             col = colOrRow;
         }
         else
         {
-            if ( !IsColShown(rowOrCol) )
+            col = n;
+            if ( !IsColShown(col) )
                 continue;
 
             row = colOrRow;
-            col = rowOrCol;
         }
 
-        // we need to account for the cells spanning multiple columns/rows:
-        // while they may need a lot of space, they don't need all of it in
-        // this column/row
-        int numRows, numCols;
-        const CellSpan span = GetCellSize(row, col, &numRows, &numCols);
-        if ( span == CellSpan_Inside )
+        if ( !canReuseAttr )
         {
-            // we need to get the size of the main cell, not of a cell hidden
-            // by it
-            row += numRows;
-            col += numCols;
-
-            // get the size of the main cell too
-            GetCellSize(row, col, &numRows, &numCols);
+            attr.reset(nullptr);
         }
-
-        // get cell ( main cell if CellSpan_Inside ) renderer best size
-        if ( !canReuseAttr || !attr )
+        else if ( !attr )
         {
             attr = GetCellAttrPtr(row, col);
             renderer = attr->GetRendererPtr(this, row, col);
 
-            if ( canReuseAttr )
-            {
-                // Try to get the best width for the entire column at once, if
-                // it's supported by the renderer.
-                extent = renderer->GetMaxBestSize(*this, *attr, dc).x;
+            // Try to get the best width for the entire column at once, if
+            // it's supported by the renderer.
+            extent = renderer->GetMaxBestSize(*this, *attr, dc).x;
 
-                if ( extent != wxDefaultCoord )
-                {
-                    extentMax = extent;
+            if ( extent != wxDefaultCoord )
+            {
+                extentMax = extent;
 
-                    // No need to check all the values.
-                    break;
-                }
+                // No need to check all the values.
+                break;
             }
         }
 
-        if ( renderer )
-        {
-            extent = column
-                        ? renderer->GetBestWidth(*this, *attr, dc, row, col,
-                                                 GetRowHeight(row))
-                        : renderer->GetBestHeight(*this, *attr, dc, row, col,
-                                                  GetColWidth(col));
+        extent = GetCellBestExtent(dc, row, col, direction, attr, renderer);
+        if ( extent > extentMax )
+            extentMax = extent;
+    }
 
-            if ( span != CellSpan_None )
-            {
-                // we spread the size of a spanning cell over all the cells it
-                // covers evenly -- this is probably not ideal but we can't
-                // really do much better here
-                //
-                // notice that numCols and numRows are never 0 as they
-                // correspond to the size of the main cell of the span and not
-                // of the cell inside it
-                extent /= column ? numCols : numRows;
-            }
+    SetAutoSizeExtent(dc, colOrRow, extentMax, setAsMin, direction);
+}
 
-            if ( extent > extentMax )
-                extentMax = extent;
-        }
-    }
+void
+wxGrid::SetAutoSizeExtent(wxDC& dc,
+                          int colOrRow,
+                          wxCoord extentMax,
+                          bool setAsMin,
+                          wxGridDirection direction)
+{
+    const bool column = direction == wxGRID_COLUMN;
 
     // now also compare with the column label extent
     wxCoord extentLabel;
@@ -11052,6 +11838,116 @@ void wxGrid::AutoSizeRows(bool setAsMin)
         AutoSizeRow(row, setAsMin);
 }
 
+void wxGrid::EnableAutoSizeCache(bool enable)
+{
+    if ( enable )
+    {
+        if ( !m_bestWidthCache )
+            m_bestWidthCache = new wxGridCellBestWidthCache;
+    }
+    else
+    {
+        wxDELETE(m_bestWidthCache);
+    }
+}
+
+void wxGrid::ClearAutoSizeCache()
+{
+    if ( m_bestWidthCache )
+        m_bestWidthCache->Clear();
+}
+
+void wxGrid::SetAutoSizeSampleSize(int numRows)
+{
+    wxCHECK_RET( numRows >= 0, "invalid number of rows" );
+
+    m_autoSizeSampleSize = numRows;
+
+    if ( m_autoSizeColsState )
+        m_autoSizeColsState->Restart();
+}
+
+void wxGrid::AutoSizeColumnsInIdle(bool setAsMin)
+{
+    AcceptCellEditControlIfShown();
+
+    delete m_autoSizeColsState;
+    m_autoSizeColsState = new wxGridAutoSizeColsState(setAsMin);
+}
+
+void wxGrid::CancelAutoSizeColumnsInIdle()
+{
+    wxDELETE(m_autoSizeColsState);
+}
+
+void wxGrid::OnIdle(wxIdleEvent& event)
+{
+    event.Skip();
+
+    if ( !m_autoSizeColsState )
+        return;
+
+    // Don't block the UI for longer than this (in ms) while measuring.
+    static const int AUTO_SIZE_IDLE_TIME = 20;
+
+    wxGridAutoSizeColsState& state = *m_autoSizeColsState;
+    state.extents.resize(m_numCols, 0);
+
+    wxClientDC dc(m_gridWin);
+
+    wxGridCellAttrPtr attr;
+    wxGridCellRendererPtr renderer;
+
+    const wxMilliClock_t start = wxGetLocalTimeMillis();
+    const int count = GetAutoSizeRowsCount();
+    while ( state.nextRow < count )
+    {
+        const int row = GetAutoSizeRow(state.nextRow++);
+        if ( !IsRowShown(row) )
+            continue;
+
+        for ( int col = 0; col < m_numCols; col++ )
+        {
+            if ( !IsColShown(col) )
+                continue;
+
+            attr.reset(nullptr);
+            const wxCoord extent = GetCellBestExtent(dc, row, col,
+                                                     wxGRID_COLUMN,
+                                                     attr, renderer);
+            if ( extent > state.extents[col] )
+                state.extents[col] = extent;
+        }
+
+        if ( wxGetLocalTimeMillis() - start >= AUTO_SIZE_IDLE_TIME )
+            break;
+    }
+
+    if ( state.nextRow < count )
+    {
+        event.RequestMore();
+        return;
+    }
+
+    // All cells have been measured, resize the columns now.
+    const bool setAsMin = state.setAsMin;
+    const std::vector<int> extents = std::move(state.extents);
+    wxDELETE(m_autoSizeColsState);
+
+    {
+        wxGridUpdateLocker locker(this);
+
+        for ( int col = 0; col < m_numCols; col++ )
+        {
+            if ( IsColShown(col) )
+                SetAutoSizeExtent(dc, col, extents[col], setAsMin, wxGRID_COLUMN);
+        }
+    }
+
+    wxGridEvent gridEvt(GetId(), wxEVT_GRID_COLS_AUTO_SIZED, this);
+    GetEventHandler()->ProcessEvent(gridEvt);
+}
+
 void wxGrid::AutoSize()
 {
     wxGridUpdateLocker locker(this);
@@ -11145,6 +12041,13 @@ void wxGrid::SetCellValue( int row, int col, const wxString& s )
     if ( m_table )
     {
         m_table->SetValue( row, col, s );
+
+        // The attributes provided by the table can depend on the values.
+        ClearAttrCache();
+
+        if ( m_bestWidthCache )
+            m_bestWidthCache->Invalidate(row, col);
+
         if ( ShouldRefresh() )
         {
             wxRect rect( CellToRect( row, col ) );
@@ -11283,118 +12186,39 @@ static
 wxGridBlockCoordsVector
 DoGetRowOrColBlocks(wxGridBlocks blocks, const wxGridOperations& oper)
 {
-    wxGridBlockCoordsVector res;
-
-    for ( wxGridBlocks::iterator it = blocks.begin(); it != blocks.end(); ++it )
-    {
-        const int firstNew = oper.SelectFirst(*it);
-        const int lastNew = oper.SelectLast(*it);
-
-        // Check if this block intersects any of the existing ones.
-        //
-        // We use simple linear search because we assume there are only a few
-        // blocks in all, and it's not worth complicating the code to use
-        // anything more advanced, but this definitely could be improved to use
-        // the fact that the vector is always sorted.
-        for ( size_t n = 0;; )
-        {
-            if ( n == res.size() )
-            {
-                // We didn't find any overlapping blocks, so add this one to
-                // the end.
-                res.push_back(*it);
-                break;
-            }
-
-            wxGridBlockCoords& block = res[n];
-            const int firstThis = oper.SelectFirst(block);
-            const int lastThis = oper.SelectLast(block);
-
-            if ( lastNew < firstThis )
-            {
-                // Not only it doesn't overlap this block, but it won't overlap
-                // any subsequent ones either, so insert it here and stop.
-                res.insert(res.begin() + n, *it);
-                break;
-            }
-
-            if ( lastThis < firstNew )
-            {
-                // It doesn't overlap this one, but continue checking.
-                n++;
-                continue;
-            }
-
-            // The blocks overlap, combine them by adjusting the bounds of the
-            // current block.
-
-            // The first bound is simple as we know that firstNew must be
-            // strictly greater than the last coordinate of all the previous
-            // elements, otherwise we would have combined it with them earlier.
-            if ( firstNew < firstThis )
-                oper.SetFirst(block, firstNew);
-
-            // But for the last one, we need to find the last element it
-            // overlaps (which may be this block itself). We call its index n2
-            // to avoid confusion with "last" used for the block component.
-            size_t n2 = n;
-            for ( ;; )
-            {
-                const wxGridBlockCoords& block2 = res[n2];
-                if ( lastNew < oper.SelectFirst(block2) )
-                {
-                    oper.SetLast(block, lastNew);
-                    break;
-                }
-
-                // Do it here as we'll need to remove the current block if it's
-                // the last overlapping one and we break just below.
-                n2++;
-
-                if ( lastNew < oper.SelectLast(block2) )
-                {
-                    oper.SetLast(block, oper.SelectLast(block2));
-                    break;
-                }
-
-                if ( n2 == res.size() )
-                {
-                    oper.SetLast(block, lastNew);
-                    break;
-                }
-            }
+    wxGridBlockCoordsVector res(blocks.begin(), blocks.end());
 
-            if ( n2 > n + 1 )
-                res.erase(res.begin() + n + 1, res.begin() + n2);
+    // Sort the blocks by their first row or column to be able to combine the
+    // overlapping and adjacent ones in a single pass: this is important when
+    // there are many selected blocks, e.g. if the user selected many rows one
+    // by one.
+    std::sort(res.begin(), res.end(),
+              [&oper](const wxGridBlockCoords& b1, const wxGridBlockCoords& b2)
+              {
+                return oper.SelectFirst(b1) < oper.SelectFirst(b2);
+              });
 
-            break;
-        }
-    }
-
-    // This is another inefficiency: it would be also possible to do everything
-    // in one pass, combining the adjacent ranges in the loop above. But this
-    // is more complicated and doesn't seem to be worth it, for the arrays of
-    // small sizes that we work with here, so do an extra path combining the
-    // adjacent ranges.
-    for ( size_t n = 0;; )
+    size_t last = 0;
+    for ( size_t n = 1; n < res.size(); n++ )
     {
-        if ( n + 1 >= res.size() )
-            break;
+        const wxGridBlockCoords& block = res[n];
+        wxGridBlockCoords& lastBlock = res[last];
 
-        if ( oper.SelectFirst(res[n + 1]) == oper.SelectLast(res[n]) + 1 )
+        if ( oper.SelectFirst(block) <= oper.SelectLast(lastBlock) + 1 )
         {
-            // The ranges touch, combine them.
-            oper.SetLast(res[n], oper.SelectLast(res[n + 1]));
-
-            // And erase the subsumed range.
-            res.erase(res.begin() + n + 1, res.begin() + n + 2);
+            // The blocks overlap or touch, combine them.
+            if ( oper.SelectLast(block) > oper.SelectLast(lastBlock) )
+                oper.SetLast(lastBlock, oper.SelectLast(block));
         }
-        else // Just go to the next one.
+        else
         {
-            n++;
+            res[++last] = block;
         }
     }
 
+    if ( !res.empty() )
+        res.resize(last + 1);
+
     return res;
 }
 
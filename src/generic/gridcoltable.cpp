@@ -0,0 +1,1393 @@
+///////////////////////////////////////////////////////////////////////////
+// Name:        src/generic/gridcoltable.cpp
+// Purpose:     wxGridColumnarTable implementation
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/wxprec.h"
+
+
+#if wxUSE_GRID
+
+#include "wx/grid.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
+#include "wx/math.h"
+#include "wx/stream.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include <limits>
+
+#if wxHAS_CXX17_INCLUDE(<charconv>)
+    #include <charconv>
+#endif
+
+namespace
+{
+
+// Values used for the empty cells in the numeric columns.
+const long MISSING_LONG = LONG_MIN;
+const double MISSING_DOUBLE = std::numeric_limits<double>::quiet_NaN();
+
+inline bool IsMissing(double value)
+{
+    return wxIsNaN(value);
+}
+
+// Parse the string as a long value, only accepting the strings in the
+// canonical form, i.e. which would be produced by formatting the value, to
+// ensure that no information is lost.
+bool ParseLong(const char* s, size_t len, long* value)
+{
+    if ( !len )
+        return false;
+
+    size_t n = 0;
+    const bool negative = s[0] == '-';
+    if ( negative )
+        n++;
+
+    // Reject "-", "-0" and leading zeroes.
+    if ( n == len || (s[n] == '0' && (negative || len > 1)) )
+        return false;
+
+    unsigned long absValue = 0;
+    for ( ; n < len; n++ )
+    {
+        const char ch = s[n];
+        if ( ch < '0' || ch > '9' )
+            return false;
+
+        const unsigned digit = ch - '0';
+        if ( absValue > (static_cast<unsigned long>(LONG_MAX) - digit) / 10 )
+            return false;
+
+        absValue = absValue*10 + digit;
+    }
+
+    // Note that LONG_MIN is not accepted as it's used for the missing values.
+    *value = negative ? -static_cast<long>(absValue)
+                      : static_cast<long>(absValue);
+
+    return true;
+}
+
+// Return the number of digits after the decimal point in the string or -1
+// if it doesn't have any.
+int GetNumberOfDecimals(const char* s, size_t len)
+{
+    const char* const dot = static_cast<const char*>(memchr(s, '.', len));
+    if ( !dot )
+        return -1;
+
+    return static_cast<int>(s + len - dot - 1);
+}
+
+// Format the double value as done by wxGridColumnarTable: precision is
+// either -1 for the default format or the number of decimals to use.
+wxString FormatDouble(double value, int precision)
+{
+    return wxString::FromCDouble(value, precision);
+}
+
+// Format the double value using the shortest string which can be parsed back
+// to exactly the same value: this is used when storing doubles as strings, as
+// the default "%g"-like format would lose precision.
+wxString FormatDoubleExact(double value)
+{
+#ifdef __cpp_lib_to_chars
+    char buf[64];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    if ( res.ec == std::errc{} )
+        return wxString::FromAscii(buf, res.ptr - buf);
+#endif // __cpp_lib_to_chars
+
+    // Without to_chars() find the shortest representation manually: 17
+    // significant digits are always enough for round-tripping a double.
+    wxString s;
+    for ( int digits = 15; digits <= 17; digits++ )
+    {
+        s = wxString::Format("%.*g", digits, value);
+
+        // Undo the effect of the current locale, see FromCDouble().
+        s.Replace(",", ".");
+
+        double parsed;
+        if ( s.ToCDouble(&parsed) && parsed == value )
+            break;
+    }
+
+    return s;
+}
+
+// Parse the string as a double if formatting it with the given precision
+// gives exactly the same string.
+bool ParseDouble(const char* s, size_t len, int precision, double* value)
+{
+    if ( !len )
+        return false;
+
+    const wxString str = wxString::FromUTF8(s, len);
+    if ( !str.ToCDouble(value) || !wxFinite(*value) )
+        return false;
+
+    return FormatDouble(*value, precision) == str;
+}
+
+// Check if the string is valid UTF-8.
+bool IsValidUTF8(const char* s, size_t len)
+{
+#if wxUSE_UNICODE_UTF8
+    return wxStringOperations::IsValidUtf8String(s, len);
+#else
+    return wxConvUTF8.ToWChar(nullptr, 0, s, len) != wxCONV_FAILED;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// wxGridColumnarStringPool: stores unique strings in a single buffer
+// ----------------------------------------------------------------------------
+
+// All strings are stored in UTF-8 in a contiguous buffer and are identified by
+// their indices in it, with the index 0 always corresponding to the empty
+// string. Each string is only stored once.
+class wxGridColumnarStringPool
+{
+public:
+    wxGridColumnarStringPool()
+    {
+        Clear();
+    }
+
+    void Clear()
+    {
+        m_buffer.clear();
+        m_offsets.assign(2, 0);
+        m_slots.clear();
+        m_slots.resize(16, 0);
+    }
+
+    // Return the index of the given string, adding it to the pool if needed.
+    wxUint32 Intern(const char* s, size_t len)
+    {
+        if ( !len )
+            return 0;
+
+        // Keep the load factor under 1/2.
+        if ( 2*GetCount() >= m_slots.size() )
+            Rehash(2*m_slots.size());
+
+        const size_t mask = m_slots.size() - 1;
+        for ( size_t n = Hash(s, len) & mask; ; n = (n + 1) & mask )
+        {
+            const wxUint32 slot = m_slots[n];
+            if ( !slot )
+            {
+                const wxUint32 id = static_cast<wxUint32>(GetCount());
+                m_buffer.insert(m_buffer.end(), s, s + len);
+                m_offsets.push_back(m_buffer.size());
+                m_slots[n] = id;
+                return id;
+            }
+
+            if ( GetLength(slot) == len && memcmp(GetData(slot), s, len) == 0 )
+                return slot;
+        }
+    }
+
+    wxUint32 Intern(const wxString& s)
+    {
+        const wxScopedCharBuffer buf = s.utf8_str();
+        return Intern(buf.data(), buf.length());
+    }
+
+    // Return the number of strings, including the empty one.
+    size_t GetCount() const { return m_offsets.size() - 1; }
+
+    const char* GetData(wxUint32 id) const { return m_buffer.data() + m_offsets[id]; }
+    size_t GetLength(wxUint32 id) const { return m_offsets[id + 1] - m_offsets[id]; }
+
+    // Note that the pool only contains valid UTF-8 strings as they're either
+    // obtained from wxString or validated by CSVParser, so no need to check
+    // them here.
+    wxString Get(wxUint32 id) const
+    {
+        return wxString::FromUTF8Unchecked(GetData(id), GetLength(id));
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return m_buffer.capacity() +
+                m_offsets.capacity()*sizeof(size_t) +
+                    m_slots.capacity()*sizeof(wxUint32);
+    }
+
+private:
+    // FNV-1a hash function.
+    static size_t Hash(const char* s, size_t len)
+    {
+        wxUint32 hash = 2166136261u;
+        for ( size_t n = 0; n < len; n++ )
+        {
+            hash ^= static_cast<unsigned char>(s[n]);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    void Rehash(size_t numSlots)
+    {
+        m_slots.assign(numSlots, 0);
+
+        const size_t mask = numSlots - 1;
+        for ( wxUint32 id = 1; id < GetCount(); id++ )
+        {
+            size_t n = Hash(GetData(id), GetLength(id)) & mask;
+            while ( m_slots[n] )
+                n = (n + 1) & mask;
+
+            m_slots[n] = id;
+        }
+    }
+
+    // All strings data.
+    std::vector<char> m_buffer;
+
+    // Offsets of all strings in the buffer, with an extra element at the end
+    // so that the length of each string is the difference between the next
+    // offset and its own one.
+    std::vector<size_t> m_offsets;
+
+    // Open addressing hash table containing the string indices, with 0
+    // meaning that the slot is free, as the empty string is never stored in
+    // it.
+    std::vector<wxUint32> m_slots;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxGridColumnarTable::Column
+// ----------------------------------------------------------------------------
+
+class wxGridColumnarTable::Column
+{
+public:
+    enum Type
+    {
+        Type_String,
+        Type_Long,
+        Type_Double
+    };
+
+    explicit Column(size_t numRows)
+        : m_type(Type_String),
+          m_ids(numRows, 0)
+    {
+    }
+
+    Type GetType() const { return m_type; }
+
+    wxString GetTypeName() const
+    {
+        switch ( m_type )
+        {
+            case Type_String:
+                break;
+
+            case Type_Long:
+                return wxGRID_VALUE_NUMBER;
+
+            case Type_Double:
+                if ( m_precision == -1 )
+                    return wxGRID_VALUE_FLOAT;
+
+                return wxString::Format("%s:,%d", wxGRID_VALUE_FLOAT, m_precision);
+        }
+
+        return wxGRID_VALUE_STRING;
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return sizeof(*this) +
+                m_pool.GetMemoryUsage() +
+                    m_ids.capacity()*sizeof(wxUint32) +
+                        m_longs.capacity()*sizeof(long) +
+                            m_doubles.capacity()*sizeof(double);
+    }
+
+    void InsertRows(size_t pos, size_t numRows)
+    {
+        switch ( m_type )
+        {
+            case Type_String:
+                m_ids.insert(m_ids.begin() + pos, numRows, 0);
+                break;
+
+            case Type_Long:
+                m_longs.insert(m_longs.begin() + pos, numRows, MISSING_LONG);
+                break;
+
+            case Type_Double:
+                m_doubles.insert(m_doubles.begin() + pos, numRows, MISSING_DOUBLE);
+                break;
+        }
+    }
+
+    void DeleteRows(size_t pos, size_t numRows)
+    {
+        switch ( m_type )
+        {
+            case Type_String:
+                m_ids.erase(m_ids.begin() + pos, m_ids.begin() + pos + numRows);
+                break;
+
+            case Type_Long:
+                m_longs.erase(m_longs.begin() + pos, m_longs.begin() + pos + numRows);
+                break;
+
+            case Type_Double:
+                m_doubles.erase(m_doubles.begin() + pos, m_doubles.begin() + pos + numRows);
+                break;
+        }
+    }
+
+    bool IsEmpty(size_t row) const
+    {
+        switch ( m_type )
+        {
+            case Type_String:
+                break;
+
+            case Type_Long:
+                return m_longs[row] == MISSING_LONG;
+
+            case Type_Double:
+                return IsMissing(m_doubles[row]);
+        }
+
+        return m_ids[row] == 0;
+    }
+
+    wxString GetValue(size_t row) const
+    {
+        if ( IsEmpty(row) )
+            return wxString();
+
+        switch ( m_type )
+        {
+            case Type_String:
+                break;
+
+            case Type_Long:
+                return wxString::Format("%ld", m_longs[row]);
+
+            case Type_Double:
+                return FormatDouble(m_doubles[row], m_precision);
+        }
+
+        return m_pool.Get(m_ids[row]);
+    }
+
+    void SetValue(size_t row, const wxString& value)
+    {
+        const wxScopedCharBuffer buf = value.utf8_str();
+        const char* const s = buf.data();
+        const size_t len = buf.length();
+
+        switch ( m_type )
+        {
+            case Type_String:
+                break;
+
+            case Type_Long:
+                if ( !len )
+                {
+                    m_longs[row] = MISSING_LONG;
+                    return;
+                }
+
+                if ( ParseLong(s, len, &m_longs[row]) )
+                    return;
+                break;
+
+            case Type_Double:
+                if ( !len )
+                {
+                    m_doubles[row] = MISSING_DOUBLE;
+                    return;
+                }
+
+                if ( ParseDouble(s, len, m_precision, &m_doubles[row]) )
+                    return;
+
+                // If the value has more decimals than the existing ones,
+                // use them for all values as this doesn't lose anything.
+                if ( m_precision != -1 )
+                {
+                    const int precision = GetNumberOfDecimals(s, len);
+                    if ( precision > m_precision &&
+                            ParseDouble(s, len, precision, &m_doubles[row]) )
+                    {
+                        m_precision = precision;
+                        return;
+                    }
+                }
+                break;
+        }
+
+        // The value can't be stored in a numeric column, so switch to the
+        // type which can store anything.
+        ConvertTo(Type_String);
+
+        m_ids[row] = m_pool.Intern(s, len);
+    }
+
+    bool GetLong(size_t row, long* value) const
+    {
+        if ( m_type != Type_Long || IsEmpty(row) )
+            return false;
+
+        *value = m_longs[row];
+        return true;
+    }
+
+    bool GetDouble(size_t row, double* value) const
+    {
+        if ( m_type != Type_Double || IsEmpty(row) )
+            return false;
+
+        *value = m_doubles[row];
+        return true;
+    }
+
+    void SetLong(size_t row, long value)
+    {
+        if ( m_type == Type_Long && value != MISSING_LONG )
+            m_longs[row] = value;
+        else
+            SetValue(row, wxString::Format("%ld", value));
+    }
+
+    void SetDouble(size_t row, double value)
+    {
+        if ( m_type == Type_Double )
+            m_doubles[row] = value;
+        else
+            SetValue(row, FormatDoubleExact(value));
+    }
+
+    // Convert all values to the given type, return false and don't change
+    // anything if this can't be done without losing information.
+    bool ConvertTo(Type type)
+    {
+        if ( type == m_type )
+            return true;
+
+        if ( m_type != Type_String )
+        {
+            // Convert to strings first: this is not the most efficient way to
+            // convert between the numeric types, but this is rarely needed.
+            Column tmp(0);
+            tmp.m_ids.reserve(GetRowCount());
+            for ( size_t row = 0; row < GetRowCount(); row++ )
+                tmp.m_ids.push_back(tmp.m_pool.Intern(GetValue(row)));
+
+            if ( !tmp.ConvertTo(type) )
+                return false;
+
+            Swap(tmp);
+            return true;
+        }
+
+        switch ( type )
+        {
+            case Type_String:
+                break;
+
+            case Type_Long:
+                return ConvertStringsToLong();
+
+            case Type_Double:
+                return ConvertStringsToDouble();
+        }
+
+        return true;
+    }
+
+    // Return true if the string column doesn't have any non-empty values.
+    bool IsAllEmpty() const
+    {
+        return m_type == Type_String && m_pool.GetCount() == 1;
+    }
+
+    // Append a new value to the string column, used when loading data.
+    void AppendUTF8(const char* s, size_t len)
+    {
+        m_ids.push_back(m_pool.Intern(s, len));
+    }
+
+    wxString m_label;
+    bool m_hasLabel = false;
+
+private:
+    size_t GetRowCount() const
+    {
+        switch ( m_type )
+        {
+            case Type_String:
+                break;
+
+            case Type_Long:
+                return m_longs.size();
+
+            case Type_Double:
+                return m_doubles.size();
+        }
+
+        return m_ids.size();
+    }
+
+    // Both functions below only need to parse each unique string once.
+    // Return the flags indicating which strings in the pool are still used
+    // by this column: the pool never forgets the strings interned in it, so
+    // it can contain the strings overwritten since then.
+    std::vector<bool> GetUsedIds() const
+    {
+        std::vector<bool> used(m_pool.GetCount(), false);
+        for ( const auto id : m_ids )
+            used[id] = true;
+
+        return used;
+    }
+
+    bool ConvertStringsToLong()
+    {
+        const std::vector<bool> used = GetUsedIds();
+
+        std::vector<long> values(m_pool.GetCount(), MISSING_LONG);
+        for ( wxUint32 id = 1; id < m_pool.GetCount(); id++ )
+        {
+            if ( !used[id] )
+                continue;
+
+            if ( !ParseLong(m_pool.GetData(id), m_pool.GetLength(id), &values[id]) )
+                return false;
+        }
+
+        m_longs.reserve(m_ids.size());
+        for ( const auto id : m_ids )
+            m_longs.push_back(values[id]);
+
+        DoFreeStrings(Type_Long);
+
+        return true;
+    }
+
+    bool ConvertStringsToDouble()
+    {
+        const std::vector<bool> used = GetUsedIds();
+
+        // First try using the default format, which works for many numbers,
+        // then the fixed one with the number of decimals of the first
+        // number not parsed by it, as the numbers in the same column often
+        // have the same number of decimals.
+        std::vector<double> values(m_pool.GetCount(), MISSING_DOUBLE);
+
+        int precision = -1;
+        for ( wxUint32 id = 1; id < m_pool.GetCount(); id++ )
+        {
+            if ( !used[id] )
+                continue;
+
+            const char* const s = m_pool.GetData(id);
+            const size_t len = m_pool.GetLength(id);
+            if ( !ParseDouble(s, len, precision, &values[id]) )
+            {
+                if ( precision != -1 )
+                    return false;
+
+                precision = GetNumberOfDecimals(s, len);
+                if ( precision == -1 )
+                    return false;
+
+                // Restart using this precision.
+                id = 0;
+            }
+        }
+
+        m_doubles.reserve(m_ids.size());
+        for ( const auto id : m_ids )
+            m_doubles.push_back(values[id]);
+
+        m_precision = precision;
+        DoFreeStrings(Type_Double);
+
+        return true;
+    }
+
+    void DoFreeStrings(Type type)
+    {
+        m_type = type;
+        m_pool.Clear();
+        std::vector<wxUint32>().swap(m_ids);
+    }
+
+    void Swap(Column& other)
+    {
+        std::swap(m_type, other.m_type);
+        std::swap(m_precision, other.m_precision);
+        std::swap(m_pool, other.m_pool);
+        m_ids.swap(other.m_ids);
+        m_longs.swap(other.m_longs);
+        m_doubles.swap(other.m_doubles);
+    }
+
+
+    Type m_type;
+
+    // Precision used for formatting the double values, -1 for default.
+    int m_precision = -1;
+
+    // Data of the string columns.
+    wxGridColumnarStringPool m_pool;
+    std::vector<wxUint32> m_ids;
+
+    // Data of the numeric columns.
+    std::vector<long> m_longs;
+    std::vector<double> m_doubles;
+};
+
+// ----------------------------------------------------------------------------
+// wxGridColumnarTable::CSVParser
+// ----------------------------------------------------------------------------
+
+// This class parses CSV data as described in RFC 4180, but is more lenient
+// and accepts any line endings and quotes in the middle of unquoted fields.
+class wxGridColumnarTable::CSVParser
+{
+public:
+    using Columns = std::vector<std::unique_ptr<Column>>;
+
+    CSVParser(char sep, bool hasHeader, const wxMBConv& conv)
+        : m_sep(sep),
+          m_conv(conv),
+          m_inHeader(hasHeader)
+    {
+    }
+
+    // Parse the next chunk of data.
+    void Parse(const char* p, const char* end)
+    {
+        if ( m_skipBOM )
+        {
+            m_skipBOM = false;
+
+            if ( end - p >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0 )
+                p += 3;
+        }
+
+        while ( p < end )
+        {
+            if ( m_skipLF )
+            {
+                m_skipLF = false;
+                if ( *p == '\n' )
+                {
+                    ++p;
+                    continue;
+                }
+            }
+
+            switch ( m_state )
+            {
+                case State_FieldStart:
+                    if ( *p == '"' )
+                    {
+                        m_state = State_Quoted;
+                        ++p;
+                        break;
+                    }
+
+                    m_state = State_Unquoted;
+                    wxFALLTHROUGH;
+
+                case State_Unquoted:
+                    {
+                        const char* const start = p;
+                        while ( p < end && *p != m_sep && *p != '\n' && *p != '\r' )
+                            ++p;
+
+                        m_field.append(start, p);
+                    }
+
+                    if ( p < end )
+                        EndFieldAt(*p++);
+                    break;
+
+                case State_Quoted:
+                    {
+                        const char* const start = p;
+                        while ( p < end && *p != '"' )
+                            ++p;
+
+                        m_field.append(start, p);
+                    }
+
+                    if ( p < end )
+                    {
+                        m_state = State_QuoteInQuoted;
+                        ++p;
+                    }
+                    break;
+
+                case State_QuoteInQuoted:
+                    if ( *p == '"' )
+                    {
+                        // Doubled quote stands for a single quote.
+                        m_field += '"';
+                        m_state = State_Quoted;
+                        ++p;
+                    }
+                    else if ( *p == m_sep || *p == '\n' || *p == '\r' )
+                    {
+                        m_quoted = true;
+                        EndFieldAt(*p++);
+                    }
+                    else
+                    {
+                        // Invalid data, just take the rest of the field as is.
+                        m_state = State_Unquoted;
+                    }
+                    break;
+            }
+        }
+    }
+
+    // Must be called after parsing all the data.
+    void Finish()
+    {
+        if ( m_state != State_FieldStart || m_fieldIndex )
+        {
+            if ( m_state == State_Quoted || m_state == State_QuoteInQuoted )
+                m_quoted = true;
+
+            EndFieldAt('\n');
+        }
+    }
+
+    // Get the number of data rows, must be called after Finish().
+    size_t GetRowCount() const { return m_numRows; }
+
+    Columns& GetColumns() { return m_cols; }
+
+private:
+    // End the current field terminated by the given character, which is either
+    // the separator or the new line.
+    void EndFieldAt(char ch)
+    {
+        const bool endOfLine = ch != m_sep;
+        if ( ch == '\r' )
+            m_skipLF = true;
+
+        m_state = State_FieldStart;
+
+        // Ignore empty lines.
+        if ( endOfLine && !m_fieldIndex && m_field.empty() && !m_quoted )
+            return;
+
+        ConvertFieldToUTF8();
+
+        if ( m_fieldIndex == m_cols.size() )
+            m_cols.push_back(std::unique_ptr<Column>(new Column(m_numRows)));
+
+        Column& col = *m_cols[m_fieldIndex++];
+        if ( m_inHeader )
+        {
+            col.m_label = wxString::FromUTF8Unchecked(m_field.data(),
+                                                      m_field.length());
+            col.m_hasLabel = true;
+        }
+        else
+        {
+            col.AppendUTF8(m_field.data(), m_field.length());
+        }
+
+        m_field.clear();
+        m_quoted = false;
+
+        if ( endOfLine )
+        {
+            if ( m_inHeader )
+            {
+                m_inHeader = false;
+            }
+            else
+            {
+                // Fill the missing fields in this line.
+                for ( ; m_fieldIndex < m_cols.size(); m_fieldIndex++ )
+                    m_cols[m_fieldIndex]->AppendUTF8(nullptr, 0);
+
+                m_numRows++;
+            }
+
+            m_fieldIndex = 0;
+        }
+    }
+
+    // Convert the current field from the encoding of the data to UTF-8, if
+    // necessary. The fields which can't be converted are interpreted as
+    // being in ISO-8859-1, so that they're never lost.
+    void ConvertFieldToUTF8()
+    {
+        if ( m_field.empty() ||
+                (m_conv.IsUTF8() && IsValidUTF8(m_field.data(), m_field.length())) )
+            return;
+
+        wxString str(m_field.data(), m_conv, m_field.length());
+        if ( str.empty() )
+            str = wxString(m_field.data(), wxConvISO8859_1, m_field.length());
+
+        const wxScopedCharBuffer buf = str.utf8_str();
+        m_field.assign(buf.data(), buf.length());
+    }
+
+    enum State
+    {
+        State_FieldStart,
+        State_Unquoted,
+        State_Quoted,
+        State_QuoteInQuoted
+    };
+
+    const char m_sep;
+    const wxMBConv& m_conv;
+
+    State m_state = State_FieldStart;
+
+    // True if we're parsing the header line.
+    bool m_inHeader;
+
+    // True before parsing the first chunk.
+    bool m_skipBOM = true;
+
+    // True if the last character was CR and so LF must be ignored.
+    bool m_skipLF = false;
+
+    // True if the current field was quoted.
+    bool m_quoted = false;
+
+    // The contents of the current field and its index in the line.
+    std::string m_field;
+    size_t m_fieldIndex = 0;
+
+    size_t m_numRows = 0;
+    Columns m_cols;
+};
+
+// ----------------------------------------------------------------------------
+// wxGridColumnarTable
+// ----------------------------------------------------------------------------
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxGridColumnarTable, wxGridTableBase);
+
+wxGridColumnarTable::wxGridColumnarTable()
+        : wxGridTableBase()
+{
+    m_numRows = 0;
+}
+
+wxGridColumnarTable::wxGridColumnarTable( int numRows, int numCols )
+        : wxGridTableBase()
+{
+    m_numRows = numRows;
+
+    m_cols.reserve(numCols);
+    for ( int col = 0; col < numCols; col++ )
+        m_cols.push_back(std::unique_ptr<Column>(new Column(numRows)));
+}
+
+wxGridColumnarTable::~wxGridColumnarTable()
+{
+}
+
+wxGridColumnarTable::Column*
+wxGridColumnarTable::GetColumn( int row, int col ) const
+{
+    if ( row < 0 || row >= m_numRows || col < 0 || col >= static_cast<int>(m_cols.size()) )
+        return nullptr;
+
+    return m_cols[col].get();
+}
+
+wxString wxGridColumnarTable::GetValue( int row, int col )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, wxString(),
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    return column->GetValue(row);
+}
+
+void wxGridColumnarTable::SetValue( int row, int col, const wxString& value )
+{
+    Column* const column = GetColumn(row, col);
+    wxCHECK_RET( column,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    column->SetValue(row, value);
+}
+
+bool wxGridColumnarTable::IsEmptyCell( int row, int col )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, true,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    return column->IsEmpty(row);
+}
+
+wxString wxGridColumnarTable::GetTypeName( int row, int col )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, wxGRID_VALUE_STRING,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    return column->GetTypeName();
+}
+
+bool wxGridColumnarTable::CanGetValueAs( int row, int col, const wxString& typeName )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, false,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    switch ( column->GetType() )
+    {
+        case Column::Type_String:
+            break;
+
+        case Column::Type_Long:
+            // Return false for the empty cells to let the renderer show them
+            // as empty rather than as 0.
+            return typeName == wxGRID_VALUE_NUMBER && !column->IsEmpty(row);
+
+        case Column::Type_Double:
+            return typeName == wxGRID_VALUE_FLOAT && !column->IsEmpty(row);
+    }
+
+    return typeName == wxGRID_VALUE_STRING;
+}
+
+bool wxGridColumnarTable::CanSetValueAs( int row, int col, const wxString& typeName )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, false,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    // Any value can be stored, but may change the column type.
+    return typeName == wxGRID_VALUE_STRING ||
+            typeName == wxGRID_VALUE_NUMBER ||
+                typeName == wxGRID_VALUE_FLOAT;
+}
+
+long wxGridColumnarTable::GetValueAsLong( int row, int col )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, 0,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    long value;
+    if ( !column->GetLong(row, &value) )
+        return 0;
+
+    return value;
+}
+
+double wxGridColumnarTable::GetValueAsDouble( int row, int col )
+{
+    const Column* const column = GetColumn(row, col);
+    wxCHECK_MSG( column, 0.0,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    double value;
+    if ( !column->GetDouble(row, &value) )
+        return 0.0;
+
+    return value;
+}
+
+void wxGridColumnarTable::SetValueAsLong( int row, int col, long value )
+{
+    Column* const column = GetColumn(row, col);
+    wxCHECK_RET( column,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    column->SetLong(row, value);
+}
+
+void wxGridColumnarTable::SetValueAsDouble( int row, int col, double value )
+{
+    Column* const column = GetColumn(row, col);
+    wxCHECK_RET( column,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    column->SetDouble(row, value);
+}
+
+void wxGridColumnarTable::Clear()
+{
+    // Preserve the column labels, just as wxGridStringTable does.
+    for ( auto& col : m_cols )
+    {
+        std::unique_ptr<Column> empty(new Column(m_numRows));
+        empty->m_label = col->m_label;
+        empty->m_hasLabel = col->m_hasLabel;
+
+        col = std::move(empty);
+    }
+}
+
+bool wxGridColumnarTable::InsertRows( size_t pos, size_t numRows )
+{
+    if ( pos >= static_cast<size_t>(m_numRows) )
+    {
+        return AppendRows( numRows );
+    }
+
+    for ( auto& col : m_cols )
+        col->InsertRows(pos, numRows);
+
+    m_numRows += numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_INSERTED,
+                                pos,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::AppendRows( size_t numRows )
+{
+    for ( auto& col : m_cols )
+        col->InsertRows(m_numRows, numRows);
+
+    m_numRows += numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::DeleteRows( size_t pos, size_t numRows )
+{
+    const size_t curNumRows = m_numRows;
+
+    wxCHECK_MSG( pos < curNumRows, false,
+                 "invalid position in wxGridColumnarTable::DeleteRows()" );
+
+    if ( numRows > curNumRows - pos )
+    {
+        numRows = curNumRows - pos;
+    }
+
+    for ( auto& col : m_cols )
+        col->DeleteRows(pos, numRows);
+
+    m_numRows -= numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                                pos,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::InsertCols( size_t pos, size_t numCols )
+{
+    if ( pos >= m_cols.size() )
+    {
+        return AppendCols( numCols );
+    }
+
+    // Only the columns themselves need to be moved, not their data.
+    std::vector<std::unique_ptr<Column>> newCols;
+    newCols.reserve(numCols);
+    for ( size_t n = 0; n < numCols; n++ )
+        newCols.push_back(std::unique_ptr<Column>(new Column(m_numRows)));
+
+    m_cols.insert(m_cols.begin() + pos,
+                  std::make_move_iterator(newCols.begin()),
+                  std::make_move_iterator(newCols.end()));
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_INSERTED,
+                                pos,
+                                numCols );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::AppendCols( size_t numCols )
+{
+    for ( size_t n = 0; n < numCols; n++ )
+        m_cols.push_back(std::unique_ptr<Column>(new Column(m_numRows)));
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                numCols );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::DeleteCols( size_t pos, size_t numCols )
+{
+    const size_t curNumCols = m_cols.size();
+
+    wxCHECK_MSG( pos < curNumCols, false,
+                 "invalid position in wxGridColumnarTable::DeleteCols()" );
+
+    // Just as wxGridStringTable, delete the columns starting from the one
+    // shown at the given position.
+    size_t colID;
+    if ( GetView() )
+        colID = GetView()->GetColAt( pos );
+    else
+        colID = pos;
+
+    if ( numCols > curNumCols - colID )
+    {
+        numCols = curNumCols - colID;
+    }
+
+    m_cols.erase(m_cols.begin() + colID, m_cols.begin() + colID + numCols);
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_DELETED,
+                                pos,
+                                numCols );
+    }
+
+    return true;
+}
+
+wxString wxGridColumnarTable::GetRowLabelValue( int row )
+{
+    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetRowLabelValue( row );
+    }
+    else
+    {
+        return m_rowLabels[row];
+    }
+}
+
+wxString wxGridColumnarTable::GetColLabelValue( int col )
+{
+    if ( col < 0 || col >= GetNumberCols() || !m_cols[col]->m_hasLabel )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetColLabelValue( col );
+    }
+    else
+    {
+        return m_cols[col]->m_label;
+    }
+}
+
+void wxGridColumnarTable::SetRowLabelValue( int row, const wxString& value )
+{
+    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
+    {
+        int n = m_rowLabels.GetCount();
+        int i;
+
+        for ( i = n; i <= row; i++ )
+        {
+            m_rowLabels.Add( wxGridTableBase::GetRowLabelValue(i) );
+        }
+    }
+
+    m_rowLabels[row] = value;
+}
+
+void wxGridColumnarTable::SetColLabelValue( int col, const wxString& value )
+{
+    wxCHECK_RET( col >= 0 && col < GetNumberCols(),
+                 "invalid column index in wxGridColumnarTable" );
+
+    m_cols[col]->m_label = value;
+    m_cols[col]->m_hasLabel = true;
+}
+
+void wxGridColumnarTable::SetCornerLabelValue( const wxString& value )
+{
+    m_cornerLabel = value;
+}
+
+wxString wxGridColumnarTable::GetCornerLabelValue() const
+{
+    return m_cornerLabel;
+}
+
+bool wxGridColumnarTable::SetColType( int col, const wxString& typeName )
+{
+    wxCHECK_MSG( col >= 0 && col < GetNumberCols(), false,
+                 "invalid column index in wxGridColumnarTable" );
+
+    Column::Type type;
+    if ( typeName == wxGRID_VALUE_STRING )
+        type = Column::Type_String;
+    else if ( typeName == wxGRID_VALUE_NUMBER )
+        type = Column::Type_Long;
+    else if ( typeName == wxGRID_VALUE_FLOAT )
+        type = Column::Type_Double;
+    else
+    {
+        wxFAIL_MSG( "unsupported column type" );
+        return false;
+    }
+
+    return m_cols[col]->ConvertTo(type);
+}
+
+wxString wxGridColumnarTable::GetColType( int col ) const
+{
+    wxCHECK_MSG( col >= 0 && col < static_cast<int>(m_cols.size()),
+                 wxGRID_VALUE_STRING,
+                 "invalid column index in wxGridColumnarTable" );
+
+    return m_cols[col]->GetTypeName().BeforeFirst(':');
+}
+
+bool wxGridColumnarTable::LoadCSV( wxInputStream& stream,
+                                   char sep,
+                                   int flags,
+                                   const wxMBConv& conv )
+{
+    CSVParser parser(sep, (flags & wxGRID_CSV_HEADER) != 0, conv);
+
+    char buf[65536];
+    for ( ;; )
+    {
+        const size_t len = stream.Read(buf, sizeof(buf)).LastRead();
+        if ( !len )
+            break;
+
+        parser.Parse(buf, buf + len);
+    }
+
+    const wxStreamError err = stream.GetLastError();
+    if ( err != wxSTREAM_NO_ERROR && err != wxSTREAM_EOF )
+        return false;
+
+    parser.Finish();
+
+    wxCHECK_MSG( parser.GetRowCount() <= INT_MAX, false,
+                 "too many rows for wxGrid" );
+
+    auto& cols = parser.GetColumns();
+    if ( flags & wxGRID_CSV_DETECT_TYPES )
+    {
+        for ( auto& col : cols )
+        {
+            // Note that the conversion does nothing if it fails.
+            // Leave the columns without any values as strings.
+            if ( col->IsAllEmpty() )
+                continue;
+
+            if ( !col->ConvertTo(Column::Type_Long) )
+                col->ConvertTo(Column::Type_Double);
+        }
+    }
+
+    DoReplaceData(cols, static_cast<int>(parser.GetRowCount()));
+
+    return true;
+}
+
+void
+wxGridColumnarTable::DoReplaceData(std::vector<std::unique_ptr<Column>>& cols,
+                                   int numRows)
+{
+    const int oldNumRows = m_numRows;
+    const int oldNumCols = GetNumberCols();
+
+    m_cols.swap(cols);
+    m_numRows = numRows;
+
+    wxGrid* const grid = GetView();
+    if ( !grid )
+        return;
+
+    // Notify the grid about the removal of all the old data first.
+    if ( oldNumRows )
+    {
+        grid->ProcessTableMessage(this, wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                                  0, oldNumRows);
+    }
+
+    if ( oldNumCols )
+    {
+        grid->ProcessTableMessage(this, wxGRIDTABLE_NOTIFY_COLS_DELETED,
+                                  0, oldNumCols);
+    }
+
+    if ( numRows )
+    {
+        grid->ProcessTableMessage(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                                  numRows);
+    }
+
+    if ( GetNumberCols() )
+    {
+        grid->ProcessTableMessage(this, wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                  GetNumberCols());
+    }
+}
+
+size_t wxGridColumnarTable::GetMemoryUsage() const
+{
+    size_t size = sizeof(*this) + m_cols.capacity()*sizeof(m_cols[0]);
+    for ( const auto& col : m_cols )
+        size += col->GetMemoryUsage();
+
+    return size;
+}
+
+#endif // wxUSE_GRID
@@ -616,6 +616,26 @@ wxSize wxGridCellStringRenderer::GetBestSize(wxGrid& grid,
     return DoGetBestSize(attr, dc, grid.GetCellValue(row, col));
 }
 
+// Check if the text of the cell starting at the given row and spanning the
+// given number of rows can overflow into the given column, i.e. if all the
+// cells of this column next to it are empty.
+static bool
+IsOverflowCellEmpty(const wxGrid& grid, int row, int cell_rows, int col)
+{
+    for (int j=row; j < row + cell_rows; j++)
+    {
+        // check w/ anchor cell for multicell block
+        int c_rows, c_cols;
+        grid.GetCellSize(j, col, &c_rows, &c_cols);
+        if (c_rows > 0)
+            c_rows = 0;
+        if (!grid.GetTable()->IsEmptyCell(j + c_rows, col))
+            return false;
+    }
+
+    return true;
+}
+
 void wxGridCellStringRenderer::Draw(wxGrid& grid,
                                     wxGridCellAttr& attr,
                                     wxDC& dc,
@@ -636,29 +656,26 @@ void wxGridCellStringRenderer::Draw(wxGrid& grid,
 
         int overflowCols = 0;
         int cols = grid.GetNumberCols();
-        int best_width = GetBestSize(grid,attr,dc,row,col).GetWidth();
         int cell_rows, cell_cols;
         attr.GetSize( &cell_rows, &cell_cols ); // shouldn't get here if <= 0
+
+        // Measuring the text is relatively expensive, so don't do it if it
+        // can't overflow anyhow because the next cell is not empty, which is
+        // the most common case.
+        int best_width = 0;
+        if ( grid.GetTable() &&
+                (col + cell_cols >= cols ||
+                    IsOverflowCellEmpty(grid, row, cell_rows, col + cell_cols)) )
+        {
+            best_width = GetBestSize(grid,attr,dc,row,col).GetWidth();
+        }
+
         if ((best_width > rectCell.width) && (col < cols) && grid.GetTable())
         {
-            int i, c_cols, c_rows;
+            int i;
             for (i = col+cell_cols; i < cols; i++)
             {
-                bool is_empty = true;
-                for (int j=row; j < row + cell_rows; j++)
-                {
-                    // check w/ anchor cell for multicell block
-                    grid.GetCellSize(j, i, &c_rows, &c_cols);
-                    if (c_rows > 0)
-                        c_rows = 0;
-                    if (!grid.GetTable()->IsEmptyCell(j + c_rows, i))
-                    {
-                        is_empty = false;
-                        break;
-                    }
-                }
-
-                if (is_empty)
+                if (IsOverflowCellEmpty(grid, row, cell_rows, i))
                 {
                     rect.width += grid.GetColSize(i);
                 }
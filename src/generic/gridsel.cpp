@@ -22,22 +22,54 @@
 #if wxUSE_GRID
 
 #include "wx/generic/gridsel.h"
-#include "wx/dynarray.h"
 
 #include "wx/generic/private/grid.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace
 {
 
-// The helper function to compare wxIntSortedArray elements.
-int CompareInts(int n1, int n2)
+// Beyond this number of selected blocks, IsInSelection() uses the index
+// instead of just checking all of them.
+const size_t MIN_BLOCKS_FOR_INDEX = 16;
+
+// Return true if the two blocks are adjacent and can be combined into one.
+bool CanMergeBlocks(const wxGridBlockCoords& b1, const wxGridBlockCoords& b2)
 {
-    return n1 - n2;
+    if ( b1.GetLeftCol() == b2.GetLeftCol() &&
+         b1.GetRightCol() == b2.GetRightCol() )
+    {
+        if ( std::abs(b1.GetTopRow() - b2.GetBottomRow()) == 1 ||
+             std::abs(b2.GetTopRow() - b1.GetBottomRow()) == 1 )
+            return true;
+    }
+    else if ( b1.GetTopRow() == b2.GetTopRow() &&
+              b1.GetBottomRow() == b2.GetBottomRow() )
+    {
+        if ( std::abs(b1.GetLeftCol() - b2.GetRightCol()) == 1 ||
+             std::abs(b2.GetLeftCol() - b1.GetRightCol()) == 1 )
+            return true;
+    }
+
+    return false;
 }
 
+// Extend the first block to also cover the second one.
+void MergeBlocks(wxGridBlockCoords& b1, const wxGridBlockCoords& b2)
+{
+    if ( b2.GetTopRow() < b1.GetTopRow() )
+        b1.SetTopRow(b2.GetTopRow());
+    if ( b2.GetLeftCol() < b1.GetLeftCol() )
+        b1.SetLeftCol(b2.GetLeftCol());
+    if ( b2.GetBottomRow() > b1.GetBottomRow() )
+        b1.SetBottomRow(b2.GetBottomRow());
+    if ( b2.GetRightCol() > b1.GetRightCol() )
+        b1.SetRightCol(b2.GetRightCol());
 }
 
-WX_DEFINE_SORTED_ARRAY_CMP_INT(int, CompareInts, wxIntSortedArray);
+} // anonymous namespace
 
 
 wxGridSelection::wxGridSelection( wxGrid * grid,
@@ -47,6 +79,8 @@ wxGridSelection::wxGridSelection( wxGrid * grid,
     m_selectionMode = sel;
 }
 
+wxGridSelection::~wxGridSelection() = default;
+
 bool wxGridSelection::IsSelection()
 {
     return !m_selection.empty();
@@ -83,19 +117,36 @@ void wxGridSelection::CancelSelecting()
     const wxGridBlockCoords& block = m_selection.back();
     m_grid->RefreshBlock(block.GetTopLeft(), block.GetBottomRight());
     m_selection.pop_back();
+    InvalidateIndex();
 }
 
 
 bool wxGridSelection::IsInSelection( int row, int col ) const
 {
-    // Check whether the given cell is contained in one of the selected blocks.
-    //
-    // Note that this algorithm is O(N) in number of selected blocks, not in
-    // number of cells in the grid, so it should be reasonably efficient even
-    // for very large grids, as the user shouldn't be able to select too many
-    // blocks. If we still run into problems with this, we should find a more
-    // efficient way of storing the selection, e.g. using k-d trees.
     const size_t count = m_selection.size();
+
+    // Checking all blocks is O(N) in their number, which is fine as long as
+    // there are not too many of them, but as this function is called for all
+    // the visible cells when drawing the grid, use the index, which allows to
+    // do it in O(log N), when there are many blocks.
+    if ( count > MIN_BLOCKS_FOR_INDEX )
+    {
+        if ( !m_indexValid )
+        {
+            if ( !m_index )
+                m_index.reset(new wxGridPrivate::SelectionIndex);
+
+            if ( !m_index->Build(m_selection) )
+                m_index.reset();
+
+            m_indexValid = true;
+        }
+
+        if ( m_index )
+            return m_index->Contains(row, col);
+    }
+
+    // Check whether the given cell is contained in one of the selected blocks.
     for ( size_t n = 0; n < count; n++ )
     {
         if ( m_selection[n].Contains(wxGridCellCoords(row, col)) )
@@ -169,6 +220,7 @@ void wxGridSelection::SetSelectionMode( wxGrid::wxGridSelectionModes selmode )
             if ( !valid )
             {
                 m_selection.erase(m_selection.begin() + n);
+                InvalidateIndex();
 
                 if ( m_grid->UsesOverlaySelection() )
                 {
@@ -263,6 +315,7 @@ wxGridSelection::SelectAll()
     // There is no need to refresh anything, as Select() will do it anyhow, and
     // no need to generate any events, so do not call ClearSelection() here.
     m_selection.clear();
+    InvalidateIndex();
 
     const int numRows = m_grid->GetNumberRows();
     const int numCols = m_grid->GetNumberCols();
@@ -363,6 +416,7 @@ wxGridSelection::DeselectBlock(const wxGridBlockCoords& block,
         // remove the block (note that selBlock, being a reference, is
         // invalidated here and can't be used any more below)
         m_selection.erase(m_selection.begin() + n);
+        InvalidateIndex();
         n--;
         count--;
 
@@ -388,6 +442,7 @@ wxGridSelection::DeselectBlock(const wxGridBlockCoords& block,
     }
 
     wxGridPrivate::MergeAdjacentBlocks(m_selection);
+    m_blocksMerged = true;
 
     // Refresh the screen and send events.
 
@@ -428,6 +483,7 @@ void wxGridSelection::ClearSelection()
     if ( m_grid->UsesOverlaySelection() )
     {
         m_selection.clear();
+        InvalidateIndex();
 
         ComputeSelectionShape();
     }
@@ -441,6 +497,7 @@ void wxGridSelection::ClearSelection()
             coords1 = block.GetTopLeft();
             coords2 = block.GetBottomRight();
             m_selection.erase(m_selection.begin() + n);
+            InvalidateIndex();
             if ( !m_grid->GetBatchCount() )
             {
                 m_grid->RefreshBlock(coords1, coords2);
@@ -470,6 +527,12 @@ void wxGridSelection::ClearSelection()
 
 void wxGridSelection::UpdateRows( size_t pos, int numRows )
 {
+    InvalidateIndex();
+
+    // Deleting rows or columns can make blocks which were not adjacent before
+    // adjacent now.
+    m_blocksMerged = false;
+
     size_t count = m_selection.size();
     size_t n;
 
@@ -519,6 +582,12 @@ void wxGridSelection::UpdateRows( size_t pos, int numRows )
 
 void wxGridSelection::UpdateCols( size_t pos, int numCols )
 {
+    InvalidateIndex();
+
+    // Deleting rows or columns can make blocks which were not adjacent before
+    // adjacent now.
+    m_blocksMerged = false;
+
     size_t count = m_selection.size();
     size_t n;
 
@@ -720,6 +789,10 @@ bool wxGridSelection::ExtendCurrentBlock(const wxGridCellCoords& blockStart,
 
     // Update the current block in place.
     *m_selection.rbegin() = newBlock;
+    InvalidateIndex();
+
+    // It may become adjacent to some other block now.
+    m_blocksMerged = false;
 
     if ( m_grid->UsesOverlaySelection() )
     {
@@ -820,7 +893,7 @@ wxArrayInt wxGridSelection::GetRowSelection() const
             m_selectionMode == wxGrid::wxGridSelectNone )
         return wxArrayInt();
 
-    wxIntSortedArray uniqueRows;
+    wxArrayInt result;
     const size_t count = m_selection.size();
     for ( size_t n = 0; n < count; ++n )
     {
@@ -829,19 +902,14 @@ wxArrayInt wxGridSelection::GetRowSelection() const
              block.GetRightCol() == m_grid->GetNumberCols() - 1 )
         {
             for ( int r = block.GetTopRow(); r <= block.GetBottomRow(); ++r )
-            {
-                if ( uniqueRows.Index(r) == wxNOT_FOUND )
-                    uniqueRows.Add(r);
-            }
+                result.push_back(r);
         }
     }
 
-    wxArrayInt result;
-    result.reserve(uniqueRows.size());
-    for( size_t i = 0; i < uniqueRows.size(); ++i )
-    {
-        result.push_back(uniqueRows[i]);
-    }
+    // The blocks may overlap, so remove the duplicates.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
     return result;
 }
 
@@ -852,7 +920,7 @@ wxArrayInt wxGridSelection::GetColSelection() const
             m_selectionMode == wxGrid::wxGridSelectNone )
         return wxArrayInt();
 
-    wxIntSortedArray uniqueCols;
+    wxArrayInt result;
     const size_t count = m_selection.size();
     for ( size_t n = 0; n < count; ++n )
     {
@@ -861,19 +929,14 @@ wxArrayInt wxGridSelection::GetColSelection() const
              block.GetBottomRow() == m_grid->GetNumberRows() - 1 )
         {
             for ( int c = block.GetLeftCol(); c <= block.GetRightCol(); ++c )
-            {
-                if ( uniqueCols.Index(c) == wxNOT_FOUND )
-                    uniqueCols.Add(c);
-            }
+                result.push_back(c);
         }
     }
 
-    wxArrayInt result;
-    result.reserve(uniqueCols.size());
-    for( size_t i = 0; i < uniqueCols.size(); ++i )
-    {
-        result.push_back(uniqueCols[i]);
-    }
+    // See above.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
     return result;
 }
 
@@ -886,8 +949,20 @@ wxGridSelection::Select(const wxGridBlockCoords& block,
         return;
 
     m_selection.push_back(block);
+    InvalidateIndex();
 
-    wxGridPrivate::MergeAdjacentBlocks(m_selection);
+    // Merging just the new block is enough if the existing ones had been
+    // already merged, which is normally the case and is much faster when
+    // many blocks are selected one by one.
+    if ( m_blocksMerged )
+    {
+        wxGridPrivate::MergeLastBlock(m_selection);
+    }
+    else
+    {
+        wxGridPrivate::MergeAdjacentBlocks(m_selection);
+        m_blocksMerged = true;
+    }
 
     // Update View:
     if ( m_grid->UsesOverlaySelection() )
@@ -941,27 +1016,6 @@ void wxGridSelection::MergeOrAddBlock(wxGridBlockCoordsVector& blocks,
 
 void wxGridPrivate::MergeAdjacentBlocks(wxGridBlockCoordsVector& selection)
 {
-    auto CanMergeBlocks = [](const wxGridBlockCoords& b1,
-                             const wxGridBlockCoords& b2) -> bool
-    {
-        if ( b1.GetLeftCol() == b2.GetLeftCol() &&
-             b1.GetRightCol() == b2.GetRightCol() )
-        {
-            if ( std::abs(b1.GetTopRow() - b2.GetBottomRow()) == 1 ||
-                 std::abs(b2.GetTopRow() - b1.GetBottomRow()) == 1 )
-                return true;
-        }
-        else if ( b1.GetTopRow() == b2.GetTopRow() &&
-                  b1.GetBottomRow() == b2.GetBottomRow() )
-        {
-            if ( std::abs(b1.GetLeftCol() - b2.GetRightCol()) == 1 ||
-                 std::abs(b2.GetLeftCol() - b1.GetRightCol()) == 1 )
-                return true;
-        }
-
-        return false;
-    };
-
     auto outerItr = selection.begin();
 
     while ( outerItr != selection.end() )
@@ -976,14 +1030,7 @@ void wxGridPrivate::MergeAdjacentBlocks(wxGridBlockCoordsVector& selection)
 
             if ( CanMergeBlocks(b1, b2) )
             {
-                if ( b2.GetTopRow() < b1.GetTopRow() )
-                    b1.SetTopRow(b2.GetTopRow());
-                if ( b2.GetLeftCol() < b1.GetLeftCol() )
-                    b1.SetLeftCol(b2.GetLeftCol());
-                if ( b2.GetBottomRow() > b1.GetBottomRow() )
-                    b1.SetBottomRow(b2.GetBottomRow());
-                if ( b2.GetRightCol() > b1.GetRightCol() )
-                    b1.SetRightCol(b2.GetRightCol());
+                MergeBlocks(b1, b2);
 
                 innerItr = selection.erase(innerItr); // get rid of b2
                 outerItr = selection.begin();
@@ -996,6 +1043,55 @@ void wxGridPrivate::MergeAdjacentBlocks(wxGridBlockCoordsVector& selection)
     }
 }
 
+void wxGridPrivate::MergeLastBlock(wxGridBlockCoordsVector& selection)
+{
+    if ( selection.empty() )
+        return;
+
+    // As only the current block can be merged with the others, this merges
+    // the same pairs of blocks, and in the same order, as MergeAdjacentBlocks()
+    // does, but without checking all the other pairs of blocks.
+    size_t current = selection.size() - 1;
+    for ( ;; )
+    {
+        // MergeAdjacentBlocks() would merge the current block into the first
+        // preceding block which can be merged with it, if any...
+        size_t next = current + 1;
+        bool merged = false;
+        for ( size_t n = 0; n < current; n++ )
+        {
+            if ( CanMergeBlocks(selection[n], selection[current]) )
+            {
+                MergeBlocks(selection[n], selection[current]);
+                selection.erase(selection.begin() + current);
+
+                next = current;
+                current = n;
+                merged = true;
+                break;
+            }
+        }
+
+        // ... and then merge all the following blocks into it.
+        while ( next < selection.size() )
+        {
+            if ( CanMergeBlocks(selection[current], selection[next]) )
+            {
+                MergeBlocks(selection[current], selection[next]);
+                selection.erase(selection.begin() + next);
+                merged = true;
+            }
+            else
+            {
+                ++next;
+            }
+        }
+
+        if ( !merged )
+            break;
+    }
+}
+
 void wxGridPrivate::MergeAdjacentRects(std::vector<wxRect>& rectangles)
 {
     auto CanMergeRects = [](const wxRect& r1, const wxRect& r2) -> bool
@@ -1138,6 +1234,134 @@ void wxGridSelection::InvalidateSelectionShape()
     m_selectionShape.reset();
 }
 
+// ----------------------------------------------------------------------------
+// wxGridPrivate::SelectionIndex
+// ----------------------------------------------------------------------------
+
+bool wxGridPrivate::SelectionIndex::Build(const wxGridBlockCoordsVector& blocks)
+{
+    m_bands.clear();
+    m_ranges.clear();
+
+    const size_t count = blocks.size();
+
+    // Normally there are at most a few ranges per band and about twice as
+    // many bands as blocks, but if the blocks overlap in some pathological
+    // way, the index could become huge, so don't let it grow too much.
+    const size_t maxRanges = 16*count + 1024;
+
+    // Find the boundaries of all bands.
+    std::vector<int> rows;
+    rows.reserve(2*count);
+    for ( const auto& block : blocks )
+    {
+        rows.push_back(block.GetTopRow());
+        rows.push_back(block.GetBottomRow() + 1);
+    }
+
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // Indices of the blocks sorted by their first row.
+    std::vector<size_t> byTop(count);
+    std::iota(byTop.begin(), byTop.end(), 0);
+    std::sort(byTop.begin(), byTop.end(),
+              [&blocks](size_t n1, size_t n2)
+              {
+                return blocks[n1].GetTopRow() < blocks[n2].GetTopRow();
+              });
+
+    // Indices of the blocks covering the current band.
+    std::vector<size_t> active;
+
+    // Column ranges of these blocks.
+    std::vector<Range> ranges;
+
+    size_t nextTop = 0;
+    for ( const int topRow : rows )
+    {
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&blocks, topRow](size_t n)
+                                    {
+                                        return blocks[n].GetBottomRow() < topRow;
+                                    }),
+                     active.end());
+
+        for ( ; nextTop < count && blocks[byTop[nextTop]].GetTopRow() <= topRow;
+              nextTop++ )
+        {
+            active.push_back(byTop[nextTop]);
+        }
+
+        const size_t firstRange = m_ranges.size();
+        m_bands.push_back({topRow, firstRange});
+
+        ranges.clear();
+        for ( const auto n : active )
+            ranges.push_back({blocks[n].GetLeftCol(), blocks[n].GetRightCol()});
+
+        std::sort(ranges.begin(), ranges.end(),
+                  [](const Range& r1, const Range& r2)
+                  {
+                    return r1.first < r2.first;
+                  });
+
+        // Combine the overlapping or adjacent ranges.
+        for ( const auto& range : ranges )
+        {
+            if ( m_ranges.size() > firstRange &&
+                    range.first <= m_ranges.back().last + 1 )
+            {
+                if ( range.last > m_ranges.back().last )
+                    m_ranges.back().last = range.last;
+            }
+            else
+            {
+                m_ranges.push_back(range);
+            }
+        }
+
+        if ( m_ranges.size() > maxRanges )
+            return false;
+    }
+
+    return true;
+}
+
+bool wxGridPrivate::SelectionIndex::Contains(int row, int col) const
+{
+    // Find the band after the one containing this row.
+    auto band = std::upper_bound(m_bands.begin(), m_bands.end(), row,
+                                 [](int r, const Band& b)
+                                 {
+                                    return r < b.topRow;
+                                 });
+
+    // As the last band is always empty, the row is not selected if it's in it.
+    if ( band == m_bands.begin() || band == m_bands.end() )
+        return false;
+
+    const auto end = m_ranges.begin() + band->firstRange;
+
+    --band;
+
+    const auto begin = m_ranges.begin() + band->firstRange;
+
+    // Find the range after the one containing this column.
+    auto range = std::upper_bound(begin, end, col,
+                                  [](int c, const Range& r)
+                                  {
+                                    return c < r.first;
+                                  });
+
+    if ( range == begin )
+        return false;
+
+    --range;
+
+    return col <= range->last;
+}
+
 void wxGridPrivate::SelectionShape::Append(const std::vector<wxPoint>& points)
 {
     CalcBoundingBox(points);
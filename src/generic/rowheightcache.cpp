@@ -19,6 +19,7 @@
 #include "wx/wxprec.h"
 
 #ifndef WX_PRECOMP
+    #include "wx/utils.h"
 #endif // WX_PRECOMP
 
 #include "wx/generic/private/rowheightcache.h"
@@ -189,27 +190,75 @@ unsigned int RowRanges::CountTo(unsigned int row) const
 // HeightCache
 // ----------------------------------------------------------------------------
 
-bool HeightCache::GetLineInfo(unsigned int row, int &start, int &height)
+namespace
 {
-    int y = 0;
-    bool found = false;
 
-    for ( const auto& kv : m_heightToRowRange )
-    {
-        int rowHeight = kv.first;
-        const RowRanges& rowRanges = kv.second;
-        if (rowRanges.Has(row))
-        {
-            height = rowHeight;
-            found = true;
-        }
-        y += rowHeight * (rowRanges.CountTo(row));
-    }
-    if (found)
+// Return the value of the lowest bit set in the given index of the tree.
+inline unsigned int LowBit(unsigned int n)
+{
+    return n & (~n + 1);
+}
+
+} // anonymous namespace
+
+int HeightCache::GetSumBefore(unsigned int row) const
+{
+    int sum = 0;
+    for ( unsigned int n = row; n > 0; n -= LowBit(n) )
+        sum += m_tree[n];
+
+    return sum;
+}
+
+void HeightCache::AddToTree(unsigned int row, int delta)
+{
+    const size_t count = m_heights.size();
+    for ( size_t n = row + 1; n <= count; n += LowBit(n) )
+        m_tree[n] += delta;
+}
+
+void HeightCache::RebuildTreeFrom(unsigned int row)
+{
+    const unsigned int count = m_heights.size();
+    m_tree.resize(count + 1);
+
+    for ( unsigned int n = row + 1; n <= count; n++ )
     {
-        start = y;
+        // The element n of the tree contains the sum of the heights of the
+        // rows in (n - LowBit(n), n], which is the height of the row n - 1
+        // plus the sum of the tree elements covering the rest of this range.
+        //
+        // Notice that the inner loop runs only once on average, so the total
+        // time is linear in the number of updated rows.
+        const unsigned int first = n - LowBit(n);
+
+        int sum = m_heights[n - 1];
+        for ( unsigned int m = n - 1; m > first; m -= LowBit(m) )
+            sum += m_tree[m];
+
+        m_tree[n] = sum;
     }
-    return found;
+}
+
+void HeightCache::FindFirstUnknownFrom(unsigned int row)
+{
+    const unsigned int count = m_heights.size();
+    while ( row < count && m_heights[row] )
+        row++;
+
+    m_firstUnknown = row;
+}
+
+bool HeightCache::GetLineInfo(unsigned int row, int &start, int &height)
+{
+    // The start of the row is unknown if the height of any previous row is.
+    if ( row >= m_firstUnknown )
+        return false;
+
+    height = m_heights[row];
+
+    start = GetSumBefore(row);
+    return true;
 }
 
 bool HeightCache::GetLineStart(unsigned int row, int &start)
@@ -220,92 +269,123 @@ bool HeightCache::GetLineStart(unsigned int row, int &start)
 
 bool HeightCache::GetLineHeight(unsigned int row, int &height)
 {
-    for ( const auto& kv : m_heightToRowRange )
-    {
-        int rowHeight = kv.first;
-        const RowRanges& rowRanges = kv.second;
-        if (rowRanges.Has(row))
-        {
-            height = rowHeight;
-            return true;
-        }
-    }
-    return false;
+    if ( row >= m_heights.size() || !m_heights[row] )
+        return false;
+
+    height = m_heights[row];
+    return true;
 }
 
 bool HeightCache::GetLineAt(int y, unsigned int &row)
 {
-    unsigned int total = 0;
-
-    for ( const auto& kv : m_heightToRowRange )
-    {
-        const RowRanges& rowRanges = kv.second;
-        total += rowRanges.CountAll();
-    }
+    if ( y < 0 )
+        return false;
 
-    if (total == 0)
-    {
+    // Only the rows before the first unknown one can be found.
+    const unsigned int count = m_firstUnknown;
+    if ( !count )
         return false;
-    }
 
-    int lo = 0;
-    int hi = total;
-    int start, height;
-    while (lo < hi)
-    {
-        int mid = (lo + hi) / 2;
-        if (GetLineInfo(mid, start, height))
-        {
-            if (start + height <= y)
-            {
-                lo = mid + 1;
-            }
-            else
-            {
-                hi = mid;
-            }
-        }
-        else
-        {
-            // should never happen, except the HeightCache has gaps which is an
-            // invalid state
-            return false;
-        }
-    }
-    if (GetLineInfo(lo, start, height))
+    unsigned int step = 1;
+    while ( step <= count / 2 )
+        step *= 2;
+
+    // Find the number of the rows ending at or before y.
+    unsigned int n = 0;
+    int remaining = y;
+    for ( ; step; step /= 2 )
     {
-        if (y < start)
+        if ( n + step <= count && m_tree[n + step] <= remaining )
         {
-            // given y point is before the first row
-            return false;
+            n += step;
+            remaining -= m_tree[n];
         }
-        row = lo;
-        return true;
     }
-    else
-    {
-        // given y point is after the last row
+
+    // This can only happen if y is after the last known row.
+    if ( n == count )
         return false;
-    }
+
+    row = n;
+    return true;
 }
 
 void HeightCache::Put(unsigned int row, int height)
 {
-    m_heightToRowRange[height].Add(row);
+    wxCHECK_RET( height > 0, "row height must be positive" );
+
+    if ( row >= m_heights.size() )
+    {
+        const unsigned int oldCount = m_heights.size();
+        m_heights.resize(row + 1);
+        m_heights[row] = height;
+
+        RebuildTreeFrom(oldCount);
+
+        // If all the previous rows are known, the first unknown row is now
+        // the next one, otherwise it doesn't change.
+        if ( m_firstUnknown == row )
+            m_firstUnknown++;
+        return;
+    }
+
+    const int delta = height - m_heights[row];
+    if ( delta )
+    {
+        m_heights[row] = height;
+        AddToTree(row, delta);
+    }
+
+    if ( row == m_firstUnknown )
+        FindFirstUnknownFrom(row + 1);
 }
 
 void HeightCache::Remove(unsigned int row)
 {
-    for ( auto& kv : m_heightToRowRange )
+    // The tree elements for the rows before this one don't depend on the
+    // heights of the subsequent rows and so remain valid.
+    if ( row < m_heights.size() )
     {
-        RowRanges& rowRanges = kv.second;
-        rowRanges.Remove(row);
+        m_heights.resize(row);
+        m_tree.resize(row + 1);
+
+        if ( m_firstUnknown > row )
+            m_firstUnknown = row;
     }
 }
 
+void HeightCache::InsertRows(unsigned int row, unsigned int count)
+{
+    if ( row >= m_heights.size() || !count )
+        return;
+
+    m_heights.insert(m_heights.begin() + row, count, 0);
+    RebuildTreeFrom(row);
+
+    if ( m_firstUnknown > row )
+        m_firstUnknown = row;
+}
+
+void HeightCache::DeleteRows(unsigned int row, unsigned int count)
+{
+    if ( row >= m_heights.size() || !count )
+        return;
+
+    const unsigned int end = wxMin(row + count, unsigned(m_heights.size()));
+    m_heights.erase(m_heights.begin() + row, m_heights.begin() + end);
+    RebuildTreeFrom(row);
+
+    if ( m_firstUnknown >= end )
+        m_firstUnknown -= end - row;
+    else if ( m_firstUnknown >= row )
+        FindFirstUnknownFrom(row);
+}
+
 void HeightCache::Clear()
 {
-    m_heightToRowRange.clear();
+    m_heights.clear();
+    m_tree.clear();
+    m_firstUnknown = 0;
 }
 
 HeightCache::~HeightCache()
@@ -20,6 +20,8 @@
 
 #include "wx/selstore.h"
 
+#include <algorithm>
+
 // ============================================================================
 // wxSelectionStore
 // ============================================================================
@@ -27,49 +29,144 @@
 const unsigned wxSelectionStore::NO_SELECTION = static_cast<unsigned>(-1);
 
 // ----------------------------------------------------------------------------
-// tests
+// helpers
 // ----------------------------------------------------------------------------
 
-bool wxSelectionStore::IsSelected(unsigned item) const
+wxSelectionStore::Ranges::iterator wxSelectionStore::FindRange(unsigned item)
 {
-    bool isSel = m_itemsSel.Index(item) != wxNOT_FOUND;
-
-    // if the default state is to be selected, being in m_itemsSel means that
-    // the item is not selected, so we have to inverse the logic
-    return m_defaultState ? !isSel : isSel;
+    return std::lower_bound(m_ranges.begin(), m_ranges.end(), item,
+                            [](const Range& r, unsigned n)
+                            {
+                                return r.last < n;
+                            });
 }
 
-// ----------------------------------------------------------------------------
-// Select*()
-// ----------------------------------------------------------------------------
+wxSelectionStore::Ranges::const_iterator
+wxSelectionStore::FindRange(unsigned item) const
+{
+    return std::lower_bound(m_ranges.begin(), m_ranges.end(), item,
+                            [](const Range& r, unsigned n)
+                            {
+                                return r.last < n;
+                            });
+}
 
-bool wxSelectionStore::SelectItem(unsigned item, bool select)
+unsigned wxSelectionStore::ChangeRange(unsigned first, unsigned last, bool add,
+                                       wxArrayInt *itemsChanged,
+                                       size_t maxChanged)
 {
-    // search for the item ourselves as like this we get the index where to
-    // insert it later if needed, so we do only one search in the array instead
-    // of two (adding item to a sorted array requires a search)
-    size_t index = m_itemsSel.IndexForInsert(item);
-    bool isSel = index < m_itemsSel.GetCount() && m_itemsSel[index] == item;
+    unsigned numChanged = 0;
 
-    if ( select != m_defaultState )
+    // Account for the items in the given range changing their state.
+    const auto changed = [&](unsigned from, unsigned to)
     {
-        if ( !isSel )
+        numChanged += to - from + 1;
+
+        if ( itemsChanged )
         {
-            m_itemsSel.AddAt(item, index);
+            for ( unsigned item = from;
+                  item <= to && itemsChanged->size() < maxChanged;
+                  item++ )
+            {
+                itemsChanged->push_back(item);
+            }
+        }
+    };
+
+    if ( add )
+    {
+        // Find all the ranges overlapping or adjacent to the new one: they
+        // are all going to be combined with it.
+        const Ranges::iterator begin = FindRange(first ? first - 1 : 0);
+        Ranges::iterator end = begin;
+
+        Range merged = { first, last };
+
+        // The first item of the new range not covered by the existing ones.
+        unsigned next = first;
+        for ( ; end != m_ranges.end() && end->first <= last + 1; ++end )
+        {
+            if ( end->first > next )
+                changed(next, end->first - 1);
 
-            return true;
+            if ( end->last >= next )
+                next = end->last + 1;
+
+            if ( end->first < merged.first )
+                merged.first = end->first;
+            if ( end->last > merged.last )
+                merged.last = end->last;
         }
+
+        if ( next <= last )
+            changed(next, last);
+
+        if ( begin == end )
+        {
+            m_ranges.insert(begin, merged);
+        }
+        else
+        {
+            *begin = merged;
+            m_ranges.erase(begin + 1, end);
+        }
+
+        m_numItemsSel += numChanged;
     }
-    else // reset to default state
+    else // remove
     {
-        if ( isSel )
+        const Ranges::iterator begin = FindRange(first);
+        Ranges::iterator end = begin;
+        for ( ; end != m_ranges.end() && end->first <= last; ++end )
         {
-            m_itemsSel.RemoveAt(index);
-            return true;
+            changed(std::max(end->first, first), std::min(end->last, last));
         }
+
+        if ( begin == end )
+            return 0;
+
+        // The parts of the first and last ranges outside of the removed one
+        // remain.
+        const Range head = { begin->first, first - 1 };
+        const Range tail = { last + 1, (end - 1)->last };
+        const bool hasHead = begin->first < first;
+        const bool hasTail = (end - 1)->last > last;
+
+        const size_t pos = begin - m_ranges.begin();
+        m_ranges.erase(begin, end);
+
+        if ( hasTail )
+            m_ranges.insert(m_ranges.begin() + pos, tail);
+        if ( hasHead )
+            m_ranges.insert(m_ranges.begin() + pos, head);
+
+        m_numItemsSel -= numChanged;
     }
 
-    return false;
+    return numChanged;
+}
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+bool wxSelectionStore::IsSelected(unsigned item) const
+{
+    const Ranges::const_iterator it = FindRange(item);
+    const bool isSel = it != m_ranges.end() && it->first <= item;
+
+    // if the default state is to be selected, being in m_ranges means that
+    // the item is not selected, so we have to inverse the logic
+    return m_defaultState ? !isSel : isSel;
+}
+
+// ----------------------------------------------------------------------------
+// Select*()
+// ----------------------------------------------------------------------------
+
+bool wxSelectionStore::SelectItem(unsigned item, bool select)
+{
+    return ChangeRange(item, item, select != m_defaultState) != 0;
 }
 
 bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
@@ -83,105 +180,64 @@ bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
 
     wxASSERT_MSG( itemFrom <= itemTo, wxT("should be in order") );
 
-    // are we going to have more [un]selected items than the other ones?
-    if ( itemTo - itemFrom > m_count/2 )
+    if ( itemsChanged )
     {
-        if ( select != m_defaultState )
-        {
-            // the default state now becomes the same as 'select'
-            m_defaultState = select;
+        itemsChanged->Empty();
+    }
 
-            // so all the old selections (which had state select) shouldn't be
-            // selected any more, but all the other ones should
-            wxSelectedIndices selOld = m_itemsSel;
-            m_itemsSel.Empty();
+    // are we going to have more [un]selected items than the other ones?
+    if ( itemTo - itemFrom > m_count/2 && select != m_defaultState )
+    {
+        // the default state now becomes the same as 'select'
+        m_defaultState = select;
 
-            // TODO: it should be possible to optimize the searches a bit
-            //       knowing the possible range
+        // so all the old ranges (which had state select) shouldn't be
+        // selected any more, but all the other items outside of the range
+        // should
+        Ranges rangesOld;
+        rangesOld.swap(m_ranges);
+        m_numItemsSel = 0;
 
-            unsigned item;
-            for ( item = 0; item < itemFrom; item++ )
+        const auto add = [this, itemFrom, itemTo](unsigned first, unsigned last)
+        {
+            if ( first < itemFrom )
             {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
+                const Range r = { first, std::min(last, itemFrom - 1) };
+                m_ranges.push_back(r);
+                m_numItemsSel += r.last - r.first + 1;
             }
 
-            for ( item = itemTo + 1; item < m_count; item++ )
+            if ( last > itemTo )
             {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
+                const Range r = { std::max(first, itemTo + 1), last };
+                m_ranges.push_back(r);
+                m_numItemsSel += r.last - r.first + 1;
             }
+        };
 
-            // many items (> half) changed state
-            itemsChanged = nullptr;
-        }
-        else // select == m_defaultState
+        unsigned next = 0;
+        for ( const auto& r : rangesOld )
         {
-            // get the inclusive range of items between itemFrom and itemTo
-            size_t count = m_itemsSel.GetCount(),
-                   start = m_itemsSel.IndexForInsert(itemFrom),
-                   end = m_itemsSel.IndexForInsert(itemTo);
+            if ( r.first > next )
+                add(next, r.first - 1);
 
-            if ( start == count || m_itemsSel[start] < itemFrom )
-            {
-                start++;
-            }
+            next = r.last + 1;
+        }
 
-            if ( end == count || m_itemsSel[end] > itemTo )
-            {
-                end--;
-            }
+        if ( next < m_count )
+            add(next, m_count - 1);
 
-            if ( start <= end )
-            {
-                // delete all of them (from end to avoid changing indices)
-                for ( int i = end; i >= (int)start; i-- )
-                {
-                    if ( itemsChanged )
-                    {
-                        if ( itemsChanged->GetCount() > MANY_ITEMS )
-                        {
-                            // stop counting (see comment below)
-                            itemsChanged = nullptr;
-                        }
-                        else
-                        {
-                            itemsChanged->Add(m_itemsSel[i]);
-                        }
-                    }
-
-                    m_itemsSel.RemoveAt(i);
-                }
-            }
-        }
+        // many items (> half) changed state
+        return false;
     }
-    else // "few" items change state
-    {
-        if ( itemsChanged )
-        {
-            itemsChanged->Empty();
-        }
 
-        // just add the items to the selection
-        for ( unsigned item = itemFrom; item <= itemTo; item++ )
-        {
-            if ( SelectItem(item, select) && itemsChanged )
-            {
-                itemsChanged->Add(item);
-
-                if ( itemsChanged->GetCount() > MANY_ITEMS )
-                {
-                    // stop counting them, we'll just eat gobs of memory
-                    // for nothing at all - faster to refresh everything in
-                    // this case
-                    itemsChanged = nullptr;
-                }
-            }
-        }
-    }
+    const unsigned numChanged = ChangeRange(itemFrom, itemTo,
+                                            select != m_defaultState,
+                                            itemsChanged, MANY_ITEMS + 1);
 
-    // we set it to nullptr if there are many items changing state
-    return itemsChanged != nullptr;
+    // don't bother returning the changed items if there are too many of them,
+    // it's faster to refresh everything in this case
+    return itemsChanged && numChanged <= MANY_ITEMS;
 }
 
 // ----------------------------------------------------------------------------
@@ -190,85 +246,68 @@ bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
 
 void wxSelectionStore::OnItemsInserted(unsigned item, unsigned numItems)
 {
-    const size_t count = m_itemsSel.GetCount();
+    if ( !numItems )
+        return;
 
-    size_t idx = m_itemsSel.IndexForInsert(item);
+    Ranges::iterator it = FindRange(item);
+    if ( it != m_ranges.end() && it->first < item )
+    {
+        // split the range containing the insertion point, the second part of
+        // it will be shifted below
+        const Range tail = { item, it->last };
+        it->last = item - 1;
+        it = m_ranges.insert(it + 1, tail);
+    }
 
-    for ( size_t i = idx; i < count; i++ )
+    for ( ; it != m_ranges.end(); ++it )
     {
-        m_itemsSel[i] += numItems;
+        it->first += numItems;
+        it->last += numItems;
     }
 
+    m_count += numItems;
+
     if ( m_defaultState )
     {
         // All newly inserted items are not selected, so if the default state
         // is to be selected, we need to manually add them to the deselected
-        // items indices.
-        for ( unsigned n = item; n < item + numItems; n++ )
-        {
-            m_itemsSel.AddAt(n, idx++);
-        }
+        // items ranges.
+        ChangeRange(item, item + numItems - 1, true);
     }
-
-    m_count += numItems;
 }
 
 void wxSelectionStore::OnItemDelete(unsigned item)
 {
-    size_t count = m_itemsSel.GetCount(),
-           i = m_itemsSel.IndexForInsert(item);
-
-    if ( i < count && m_itemsSel[i] == item )
-    {
-        // this item itself was in m_itemsSel, remove it from there
-        m_itemsSel.RemoveAt(i);
-
-        count--;
-    }
-
-    // and adjust the index of all which follow it
-    while ( i < count )
-    {
-        // all following elements must be greater than the one we deleted
-        wxASSERT_MSG( m_itemsSel[i] > item, wxT("logic error") );
-
-        m_itemsSel[i++]--;
-    }
-
-    m_count--;
+    OnItemsDeleted(item, 1);
 }
 
 bool wxSelectionStore::OnItemsDeleted(unsigned item, unsigned numItems)
 {
-    bool anyDeletedInSelItems = false,
-         allDeletedInSelItems = true;
+    if ( !numItems )
+        return false;
 
-    size_t i = m_itemsSel.IndexForInsert(item);
+    // forget about the deleted items first
+    const unsigned numInRanges = ChangeRange(item, item + numItems - 1, false);
 
-    const unsigned firstAfterDeleted = item + numItems;
-    while ( i < m_itemsSel.size() )
+    // and adjust the indices of all the following ones
+    Ranges::iterator it = FindRange(item);
+    for ( Ranges::iterator i = it; i != m_ranges.end(); ++i )
     {
-        if ( m_itemsSel[i] < firstAfterDeleted )
-        {
-            // This item is going to be deleted, so remove it from the
-            // selected indices entirely. Notice that we do not update i here
-            // as it now refers to the next element.
-            m_itemsSel.RemoveAt(i);
-
-            anyDeletedInSelItems = true;
-        }
-        else
-        {
-            // This item remains, just update its index.
-            m_itemsSel[i++] -= numItems;
+        i->first -= numItems;
+        i->last -= numItems;
+    }
 
-            allDeletedInSelItems = false;
-        }
+    // the ranges before and after the deleted items may be adjacent now
+    if ( it != m_ranges.begin() && it != m_ranges.end() &&
+            (it - 1)->last + 1 == it->first )
+    {
+        (it - 1)->last = it->last;
+        m_ranges.erase(it);
     }
 
     m_count -= numItems;
 
-    return m_defaultState ? allDeletedInSelItems : anyDeletedInSelItems;
+    return m_defaultState ? numInRanges < numItems : numInRanges != 0;
 }
 
 
@@ -278,11 +317,18 @@ void wxSelectionStore::SetItemCount(unsigned count)
     // decreased
     if ( count < m_count )
     {
-        for ( size_t i = m_itemsSel.GetCount(); i > 0; i-- )
+        Ranges::iterator it = FindRange(count);
+        if ( it != m_ranges.end() && it->first < count )
         {
-            if ( m_itemsSel[i - 1] >= count )
-                m_itemsSel.RemoveAt(i - 1);
+            m_numItemsSel -= it->last - count + 1;
+            it->last = count - 1;
+            ++it;
         }
+
+        for ( Ranges::iterator i = it; i != m_ranges.end(); ++i )
+            m_numItemsSel -= i->last - i->first + 1;
+
+        m_ranges.erase(it, m_ranges.end());
     }
 
     // remember the new number of items
@@ -302,28 +348,32 @@ unsigned wxSelectionStore::GetFirstSelectedItem(IterationState& cookie) const
 
 unsigned wxSelectionStore::GetNextSelectedItem(IterationState& cookie) const
 {
+    // The cookie is the first item which hasn't been returned yet.
+    if ( cookie >= m_count )
+        return NO_SELECTION;
+
+    unsigned item = static_cast<unsigned>(cookie);
+
+    const Ranges::const_iterator it = FindRange(item);
     if ( m_defaultState )
     {
-        // We have no choice but to iterate over all items in this case. It
-        // shouldn't be that bad in practice because (almost) all items are
-        // supposed to be selected if m_defaultState == true anyhow.
-        for ( unsigned item = cookie; ; item++ )
-        {
-            if ( item >= m_count )
-                return NO_SELECTION;
+        // Skip the range of unselected items, if we're inside one, the next
+        // item after it must be selected as the ranges are never adjacent.
+        if ( it != m_ranges.end() && it->first <= item )
+            item = it->last + 1;
 
-            if ( IsSelected(item) )
-            {
-                cookie = item + 1;
-                return item;
-            }
-        }
+        if ( item >= m_count )
+            return NO_SELECTION;
     }
     else // Simple case when we directly have the selected items.
     {
-        if ( cookie >= m_itemsSel.size() )
+        if ( it == m_ranges.end() )
             return NO_SELECTION;
 
-        return m_itemsSel[cookie++];
+        if ( it->first > item )
+            item = it->first;
     }
+
+    cookie = item + 1;
+    return item;
 }
@@ -184,7 +184,11 @@ int wxConsoleEventLoop::DispatchTimeout(unsigned long timeout)
     wxUsecClock_t nextTimer;
     if ( wxTimerScheduler::Get().GetNext(&nextTimer) )
     {
-        unsigned long timeUntilNextTimer = wxMilliClockToLong(nextTimer / 1000);
+        // round the timeout up as otherwise we'd wake up before the timer
+        // expiration and would have to wait again, possibly with 0 timeout,
+        // i.e. spinning, if less than a millisecond remained
+        unsigned long timeUntilNextTimer =
+            wxMilliClockToLong((nextTimer + 999) / 1000);
         if ( timeUntilNextTimer < timeout )
             timeout = timeUntilNextTimer;
     }
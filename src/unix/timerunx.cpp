@@ -48,45 +48,101 @@ wxTimerScheduler *wxTimerScheduler::ms_instance = nullptr;
 
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    DoAddTimer(wxTimerSchedule(timer, expiration));
+    DoAddTimer(timer, expiration);
 }
 
-void wxTimerScheduler::DoAddTimer(const wxTimerSchedule& s)
+void wxTimerScheduler::DoAddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
-    {
-        wxASSERT_MSG( node->m_timer != s.m_timer,
-                      wxT("adding the same timer twice?") );
+    wxASSERT_MSG( timer->m_heapIndex >= m_timers.size() ||
+                    m_timers[timer->m_heapIndex].m_timer != timer,
+                  wxT("adding the same timer twice?") );
 
-        if ( node->m_expiration > s.m_expiration )
-            break;
-    }
+    m_timers.push_back(wxTimerSchedule(timer, expiration, m_nextSeq++));
+    timer->m_heapIndex = m_timers.size() - 1;
 
-    m_timers.insert(node, s);
+    DoSiftUp(m_timers.size() - 1);
 
     wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
-               s.m_timer->GetId(),
-               s.m_expiration.ToString());
+               timer->GetId(),
+               expiration.ToString());
 }
 
 void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    const size_t n = timer->m_heapIndex;
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("removing inexistent timer?") );
+
+    DoRemoveAt(n);
+}
+
+void wxTimerScheduler::DoRemoveAt(size_t n)
+{
+    const size_t last = m_timers.size() - 1;
+    if ( n != last )
     {
-        if ( node->m_timer == timer )
-        {
-            m_timers.erase(node);
-            return;
-        }
+        // move the last element into the freed slot and restore the heap
+        // order, which can require moving it either up or down
+        DoPlace(n, m_timers[last]);
+        m_timers.pop_back();
+
+        DoSiftDown(n);
+        DoSiftUp(n);
+    }
+    else
+    {
+        m_timers.pop_back();
+    }
+}
+
+void wxTimerScheduler::DoPlace(size_t n, const wxTimerSchedule& s)
+{
+    m_timers[n] = s;
+    s.m_timer->m_heapIndex = n;
+}
+
+void wxTimerScheduler::DoSiftUp(size_t n)
+{
+    const wxTimerSchedule s = m_timers[n];
+    while ( n > 0 )
+    {
+        const size_t parent = (n - 1) / 2;
+        if ( !s.IsBefore(m_timers[parent]) )
+            break;
+
+        DoPlace(n, m_timers[parent]);
+        n = parent;
     }
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    DoPlace(n, s);
+}
+
+void wxTimerScheduler::DoSiftDown(size_t n)
+{
+    const size_t count = m_timers.size();
+    if ( n >= count )
+        return;
+
+    const wxTimerSchedule s = m_timers[n];
+    for ( ;; )
+    {
+        size_t child = 2*n + 1;
+        if ( child >= count )
+            break;
+
+        if ( child + 1 < count && m_timers[child + 1].IsBefore(m_timers[child]) )
+            child++;
+
+        if ( !m_timers[child].IsBefore(s) )
+            break;
+
+        DoPlace(n, m_timers[child]);
+        n = child;
+    }
+
+    DoPlace(n, s);
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -96,7 +152,7 @@ bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
 
     wxCHECK_MSG( remaining, false, wxT("null pointer") );
 
-    *remaining = m_timers.begin()->m_expiration - wxGetUTCTimeUSec();
+    *remaining = m_timers.front().m_expiration - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -115,28 +171,35 @@ bool wxTimerScheduler::NotifyExpired()
 
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() )
     {
-        wxTimerSchedule s = *cur;
-        if ( s.m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
+        // as the heap is ordered by expiration time, we can stop as soon as
+        // we find a timer which hasn't expired yet
+        if ( m_timers.front().m_expiration > now )
             break;
-        }
 
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
+        wxUnixTimerImpl * const timer = m_timers.front().m_timer;
+        DoRemoveAt(0);
 
-        m_timers.erase(cur);
+        toNotify.push_back(timer);
+    }
 
-        // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s.m_timer;
+    if ( toNotify.empty() )
+        return false;
+
+    // check whether we need to keep the expired timers: notice that we do it
+    // only after removing all of them to avoid finding the periodic timers
+    // rescheduled to expire immediately again in the loop above
+    for ( TimerImpls::const_iterator i = toNotify.begin(),
+                                     end = toNotify.end();
+          i != end;
+          ++i )
+    {
+        wxUnixTimerImpl * const timer = *i;
         if ( timer->IsOneShot() )
         {
             // the timer needs to be stopped but don't call its Stop() from
-            // here as it would attempt to remove the timer from our list and
+            // here as it would attempt to remove the timer from our heap and
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
         }
@@ -146,20 +209,13 @@ bool wxTimerScheduler::NotifyExpired()
             // the current time instead of just offsetting it from the current
             // expiration time because it could happen that we're late and the
             // current expiration time is (far) in the past
-            s.m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
+            DoAddTimer(timer, now + timer->GetInterval()*1000);
         }
-
-        // we can't notify the timer from this loop as the timer event handler
-        // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
-        toNotify.push_back(timer);
     }
 
-    if ( toNotify.empty() )
-        return false;
-
+    // we can't notify the timers from the loops above as the timer event
+    // handler could modify m_timers (for example, but not only, by stopping
+    // this timer), so do it only now
     for ( TimerImpls::const_iterator i = toNotify.begin(),
                                      end = toNotify.end();
           i != end;
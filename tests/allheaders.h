@@ -193,6 +193,7 @@
 #include <wx/iconloc.h>
 #include <wx/imagbmp.h>
 #include <wx/image.h>
+#include <wx/imageloader.h>
 #include <wx/imaggif.h>
 #include <wx/imagiff.h>
 #include <wx/imagjpeg.h>
@@ -225,6 +226,7 @@
 #include <wx/list.h>
 #include <wx/localedefs.h>
 #include <wx/log.h>
+#include <wx/logasync.h>
 #include <wx/longlong.h>
 #include <wx/lzmastream.h>
 #include <wx/math.h>
@@ -259,6 +261,7 @@
 #include <wx/palette.h>
 #include <wx/panel.h>
 #include <wx/paper.h>
+#include <wx/parsedfmt.h>
 #include <wx/pen.h>
 #include <wx/peninfobase.h>
 #include <wx/persist.h>
@@ -0,0 +1,250 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/events.cpp
+// Purpose:     Events-related benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/app.h"
+#include "wx/event.h"
+#include "wx/thread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Number of events queued by each thread during a single benchmark run.
+const int NUM_EVENTS_PER_THREAD = 10000;
+
+class LatencyEvent;
+wxDECLARE_EVENT(wxEVT_BENCH_LATENCY, LatencyEvent);
+
+// Event remembering the time when it was queued.
+class LatencyEvent : public wxEvent
+{
+public:
+    LatencyEvent()
+        : wxEvent(0, wxEVT_BENCH_LATENCY),
+          m_queued(Clock::now())
+    {
+    }
+
+    Clock::time_point GetQueuedTime() const { return m_queued; }
+
+    virtual wxEvent* Clone() const override { return new LatencyEvent(*this); }
+
+private:
+    const Clock::time_point m_queued;
+};
+
+wxDEFINE_EVENT(wxEVT_BENCH_LATENCY, LatencyEvent);
+
+// Handler counting the received events and collecting their latencies.
+class LatencyHandler : public wxEvtHandler
+{
+public:
+    LatencyHandler()
+    {
+        Bind(wxEVT_BENCH_LATENCY, &LatencyHandler::OnEvent, this);
+    }
+
+    int GetCount() const { return m_count; }
+    void ResetCount() { m_count = 0; }
+
+    // Show the latency percentiles of all the events received so far.
+    void ShowLatencies()
+    {
+        if ( m_latencies.empty() )
+            return;
+
+        std::sort(m_latencies.begin(), m_latencies.end());
+
+        const auto percentile = [this](double p)
+        {
+            return m_latencies[static_cast<size_t>(p*(m_latencies.size() - 1))];
+        };
+
+        wxPrintf("\tlatency: %.1fus p50, %.1fus p90, %.1fus p99, "
+                 "%.1fus p99.9, %.1fus max\n",
+                 percentile(0.5), percentile(0.9), percentile(0.99),
+                 percentile(0.999), m_latencies.back());
+
+        m_latencies.clear();
+    }
+
+private:
+    void OnEvent(LatencyEvent& event)
+    {
+        const std::chrono::duration<double, std::micro>
+            latency = Clock::now() - event.GetQueuedTime();
+        m_latencies.push_back(latency.count());
+
+        m_count++;
+    }
+
+    int m_count = 0;
+    std::vector<double> m_latencies;
+};
+
+LatencyHandler* gs_handler = nullptr;
+
+class ProducerThread : public wxThread
+{
+public:
+    ProducerThread() : wxThread(wxTHREAD_JOINABLE) { }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < NUM_EVENTS_PER_THREAD; n++ )
+            gs_handler->QueueEvent(new LatencyEvent());
+
+        return nullptr;
+    }
+};
+
+bool InitHandler()
+{
+    gs_handler = new LatencyHandler();
+
+    return true;
+}
+
+void DoneHandler()
+{
+    gs_handler->ShowLatencies();
+
+    delete gs_handler;
+    gs_handler = nullptr;
+}
+
+} // anonymous namespace
+
+// Measure the throughput of queuing the events from the given number (4 by
+// default) of threads and processing them in the main one.
+BENCHMARK_FUNC_WITH_INIT(QueueEventThreads, InitHandler, DoneHandler)
+{
+    const int numThreads = Bench::GetNumericParameter(4);
+
+    gs_handler->ResetCount();
+
+    std::vector<ProducerThread*> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        ProducerThread* const thread = new ProducerThread();
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            delete thread;
+            return false;
+        }
+
+        threads.push_back(thread);
+    }
+
+    const int numEvents = numThreads*NUM_EVENTS_PER_THREAD;
+    while ( gs_handler->GetCount() < numEvents )
+        wxTheApp->ProcessPendingEvents();
+
+    for ( auto thread : threads )
+    {
+        thread->Wait();
+        delete thread;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// Dynamic event handlers dispatch
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class DispatchEvent;
+wxDECLARE_EVENT(wxEVT_BENCH_DISPATCH, DispatchEvent);
+
+class DispatchEvent : public wxEvent
+{
+public:
+    DispatchEvent() : wxEvent(0, wxEVT_BENCH_DISPATCH) { }
+
+    virtual wxEvent* Clone() const override { return new DispatchEvent(*this); }
+};
+
+wxDEFINE_EVENT(wxEVT_BENCH_DISPATCH, DispatchEvent);
+
+// Number of events processed during a single benchmark run.
+const int NUM_DISPATCHED_EVENTS = 1000;
+
+class BoundHandlersBench
+{
+public:
+    // Create the handler with the given number of handlers bound to it, each
+    // one for its own id.
+    explicit BoundHandlersBench(int numHandlers)
+        : m_numHandlers(numHandlers)
+    {
+        for ( int id = 1; id <= numHandlers; id++ )
+        {
+            m_handler.Bind(wxEVT_BENCH_DISPATCH,
+                           [this](DispatchEvent&) { m_count++; },
+                           id);
+        }
+    }
+
+    // Process events for all the ids in turn.
+    bool Run()
+    {
+        m_count = 0;
+
+        DispatchEvent event;
+        for ( int n = 0; n < NUM_DISPATCHED_EVENTS; n++ )
+        {
+            event.SetId(n % m_numHandlers + 1);
+            m_handler.ProcessEvent(event);
+        }
+
+        return m_count == NUM_DISPATCHED_EVENTS;
+    }
+
+private:
+    wxEvtHandler m_handler;
+    const int m_numHandlers;
+    int m_count = 0;
+};
+
+} // anonymous namespace
+
+// Measure dispatching of events to the handlers bound to an object with the
+// given number of bound handlers.
+BENCHMARK_FUNC(DispatchBound10)
+{
+    static BoundHandlersBench s_bench(10);
+    return s_bench.Run();
+}
+
+BENCHMARK_FUNC(DispatchBound100)
+{
+    static BoundHandlersBench s_bench(100);
+    return s_bench.Run();
+}
+
+BENCHMARK_FUNC(DispatchBound1000)
+{
+    static BoundHandlersBench s_bench(1000);
+    return s_bench.Run();
+}
@@ -0,0 +1,241 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid-related benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/grid.h"
+#include "wx/mstream.h"
+
+#include "bench.h"
+
+#include <vector>
+
+#if wxUSE_GRID
+
+namespace
+{
+
+// CSV data used by the benchmarks below and the same data as separate cells.
+wxCharBuffer gs_csv;
+std::vector<wxString> gs_cells;
+
+const int NUM_COLS = 6;
+int gs_numRows = 0;
+
+// Table loaded from gs_csv for the benchmarks accessing it.
+wxGridColumnarTable* gs_table = nullptr;
+
+bool InitCSV()
+{
+    gs_numRows = Bench::GetNumericParameter(100000);
+
+    static const char* const categories[] =
+        { "fruit", "vegetable", "dairy", "bakery", "meat", "fish" };
+
+    wxString csv = "id,name,category,price,quantity,comment\n";
+    gs_cells.reserve(static_cast<size_t>(gs_numRows) * NUM_COLS);
+    for ( int n = 0; n < gs_numRows; n++ )
+    {
+        const bool onSale = n % 10 == 0;
+
+        gs_cells.push_back(wxString::Format("%d", n));
+        gs_cells.push_back(wxString::Format("item %d", n % 1000));
+        gs_cells.push_back(categories[n % WXSIZEOF(categories)]);
+        gs_cells.push_back(wxString::Format("%d.%02d", n % 100, n % 97));
+        gs_cells.push_back(wxString::Format("%d", n % 50));
+        gs_cells.push_back(onSale ? "on sale, limited" : "");
+
+        csv += wxString::Format("%d,item %d,%s,%d.%02d,%d,%s\n",
+                                n,
+                                n % 1000,
+                                categories[n % WXSIZEOF(categories)],
+                                n % 100, n % 97,
+                                n % 50,
+                                onSale ? "\"on sale, limited\"" : "");
+    }
+
+    gs_csv = csv.utf8_str();
+
+    return true;
+}
+
+void DoneCSV()
+{
+    gs_csv.reset();
+    std::vector<wxString>().swap(gs_cells);
+}
+
+bool InitTable()
+{
+    if ( !InitCSV() )
+        return false;
+
+    wxMemoryInputStream input(gs_csv.data(), gs_csv.length());
+    gs_table = new wxGridColumnarTable();
+    return gs_table->LoadCSV(input);
+}
+
+void DoneTable()
+{
+    delete gs_table;
+    gs_table = nullptr;
+
+    DoneCSV();
+}
+
+// Return the approximate amount of memory used by wxGridStringTable data.
+size_t GetStringTableMemoryUsage(wxGridStringTable& table)
+{
+    size_t size = 0;
+    for ( int row = 0; row < table.GetNumberRows(); row++ )
+    {
+        size += sizeof(wxArrayString) + table.GetNumberCols()*sizeof(wxString);
+        for ( int col = 0; col < table.GetNumberCols(); col++ )
+        {
+            // Assume that short strings don't need any heap allocations.
+            const size_t len = table.GetValue(row, col).length();
+            if ( len > 15 / sizeof(wxChar) )
+                size += (len + 1)*sizeof(wxChar);
+        }
+    }
+
+    return size;
+}
+
+} // anonymous namespace
+
+// Load the CSV with the given number of rows (100000 by default) into
+// wxGridColumnarTable.
+BENCHMARK_FUNC_WITH_INIT(GridColumnarTableLoadCSV, InitCSV, DoneCSV)
+{
+    wxMemoryInputStream input(gs_csv.data(), gs_csv.length());
+
+    wxGridColumnarTable table;
+    if ( !table.LoadCSV(input) )
+        return false;
+
+    static bool s_reported = false;
+    if ( !s_reported )
+    {
+        s_reported = true;
+        wxPrintf("\twxGridColumnarTable uses %zuKiB for %d rows\n",
+                 table.GetMemoryUsage() / 1024, gs_numRows);
+    }
+
+    return table.GetNumberRows() == gs_numRows &&
+            table.GetNumberCols() == NUM_COLS;
+}
+
+// Fill wxGridStringTable with the same data, for comparison.
+BENCHMARK_FUNC_WITH_INIT(GridStringTableFill, InitCSV, DoneCSV)
+{
+    wxGridStringTable table(gs_numRows, NUM_COLS);
+
+    size_t n = 0;
+    for ( int row = 0; row < gs_numRows; row++ )
+    {
+        for ( int col = 0; col < NUM_COLS; col++ )
+            table.SetValue(row, col, gs_cells[n++]);
+    }
+
+    static bool s_reported = false;
+    if ( !s_reported )
+    {
+        s_reported = true;
+        wxPrintf("\twxGridStringTable uses %zuKiB for %d rows\n",
+                 GetStringTableMemoryUsage(table) / 1024, gs_numRows);
+    }
+
+    return true;
+}
+
+// Sum all the values of a numeric column, as e.g. a custom renderer
+// showing totals would do.
+BENCHMARK_FUNC_WITH_INIT(GridColumnarTableSumColumn, InitTable, DoneTable)
+{
+    double total = 0;
+    for ( int row = 0; row < gs_numRows; row++ )
+        total += gs_table->GetValueAsDouble(row, 3);
+
+    return total > 0;
+}
+
+// Get all the values as strings, as drawing the grid does.
+BENCHMARK_FUNC_WITH_INIT(GridColumnarTableGetValue, InitTable, DoneTable)
+{
+    size_t len = 0;
+    for ( int row = 0; row < gs_numRows; row++ )
+    {
+        for ( int col = 0; col < NUM_COLS; col++ )
+            len += gs_table->GetValue(row, col).length();
+    }
+
+    return len > 0;
+}
+
+namespace
+{
+
+wxGridCellAttrProvider* gs_attrProvider = nullptr;
+
+const int ATTR_NUM_COLS = 20;
+
+// Use the given number (10000 by default) of rows with attributes and, in
+// each of them, a few blocks of cells with different attributes, as would be
+// done by conditional formatting.
+bool InitAttrProvider()
+{
+    const int numRows = Bench::GetNumericParameter(10000);
+
+    gs_attrProvider = new wxGridCellAttrProvider();
+    for ( int row = 0; row < numRows; row++ )
+    {
+        wxGridCellAttr* const attrRow = new wxGridCellAttr();
+        attrRow->SetBackgroundColour(row % 2 ? *wxWHITE : *wxLIGHT_GREY);
+        gs_attrProvider->SetRowAttr(attrRow, row);
+
+        for ( int col = row % 3; col < ATTR_NUM_COLS; col += 5 )
+        {
+            wxGridCellAttr* const attrBlock = new wxGridCellAttr();
+            attrBlock->SetTextColour(*wxRED);
+            gs_attrProvider->SetBlockAttr(attrBlock,
+                                          wxGridBlockCoords(row, col,
+                                                            row, col + 1));
+        }
+    }
+
+    return true;
+}
+
+void DoneAttrProvider()
+{
+    delete gs_attrProvider;
+    gs_attrProvider = nullptr;
+}
+
+} // anonymous namespace
+
+// Get the attributes of all cells, as drawing the grid does.
+BENCHMARK_FUNC_WITH_INIT(GridAttrProviderGetAttr,
+                         InitAttrProvider, DoneAttrProvider)
+{
+    const int numRows = Bench::GetNumericParameter(10000);
+
+    int numAttrs = 0;
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < ATTR_NUM_COLS; col++ )
+        {
+            if ( gs_attrProvider->GetAttrPtr(row, col, wxGridCellAttr::Any) )
+                numAttrs++;
+        }
+    }
+
+    return numAttrs == numRows*ATTR_NUM_COLS;
+}
+
+#endif // wxUSE_GRID
@@ -30,6 +30,25 @@ BENCHMARK_FUNC(LoadJPEG)
     return image.LoadFile("horse.jpg");
 }
 
+BENCHMARK_FUNC(LoadJPEGThumbnail)
+{
+    static bool s_handlerAdded = false;
+    if ( !s_handlerAdded )
+    {
+        s_handlerAdded = true;
+        wxImage::AddHandler(new wxJPEGHandler);
+    }
+
+    // Use the numeric parameter to specify the thumbnail size.
+    const int size = Bench::GetNumericParameter(32);
+
+    wxImage image;
+    image.SetOption(wxIMAGE_OPTION_DESIRED_WIDTH, size);
+    image.SetOption(wxIMAGE_OPTION_DESIRED_HEIGHT, size);
+    return image.LoadFile("horse.jpg") &&
+            image.Rescale(size, size, wxIMAGE_QUALITY_HIGH).IsOk();
+}
+
 BENCHMARK_FUNC(LoadPNG)
 {
     static bool s_handlerAdded = false;
@@ -118,3 +137,137 @@ BENCHMARK_FUNC(ShrinkHighQuality)
     return image.Scale(factor*image.GetWidth(), factor*image.GetHeight(),
                        wxIMAGE_QUALITY_HIGH).IsOk();
 }
+
+// Create a big image, e.g. 4K, with some non-trivial contents and, optionally,
+// alpha channel for testing resampling in both directions.
+static wxImage CreateResampleImage(int width, int height, bool withAlpha)
+{
+    wxImage image(width, height, false);
+    if ( withAlpha )
+        image.SetAlpha();
+
+    unsigned char* data = image.GetData();
+    unsigned char* alpha = image.GetAlpha();
+    for ( int y = 0; y < height; y++ )
+    {
+        for ( int x = 0; x < width; x++ )
+        {
+            *data++ = static_cast<unsigned char>(x ^ y);
+            *data++ = static_cast<unsigned char>(x + y);
+            *data++ = static_cast<unsigned char>(x * y);
+            if ( alpha )
+                *alpha++ = static_cast<unsigned char>(x - y);
+        }
+    }
+
+    return image;
+}
+
+static const wxImage& GetResampleImage(int size)
+{
+    static wxImage s_big, s_small;
+    wxImage& image = size > 256 ? s_big : s_small;
+    if ( !image.IsOk() )
+    {
+        // Use string parameter to enable testing the alpha channel code path.
+        image = CreateResampleImage(size, size,
+                                    Bench::GetStringParameter() == "alpha");
+    }
+
+    return image;
+}
+
+#define RESAMPLE_BENCHMARK(name, from, to, quality)                           \
+    BENCHMARK_FUNC(name)                                                      \
+    {                                                                         \
+        return GetResampleImage(from).Scale(to, to, quality).IsOk();          \
+    }
+
+RESAMPLE_BENCHMARK(Shrink4KTo256Nearest, 4096, 256, wxIMAGE_QUALITY_NEAREST)
+RESAMPLE_BENCHMARK(Shrink4KTo256Bilinear, 4096, 256, wxIMAGE_QUALITY_BILINEAR)
+RESAMPLE_BENCHMARK(Shrink4KTo256Bicubic, 4096, 256, wxIMAGE_QUALITY_BICUBIC)
+RESAMPLE_BENCHMARK(Shrink4KTo256BoxAverage, 4096, 256, wxIMAGE_QUALITY_BOX_AVERAGE)
+RESAMPLE_BENCHMARK(Shrink4KTo256Normal, 4096, 256, wxIMAGE_QUALITY_NORMAL)
+
+RESAMPLE_BENCHMARK(Enlarge256To4KNearest, 256, 4096, wxIMAGE_QUALITY_NEAREST)
+RESAMPLE_BENCHMARK(Enlarge256To4KBilinear, 256, 4096, wxIMAGE_QUALITY_BILINEAR)
+RESAMPLE_BENCHMARK(Enlarge256To4KBicubic, 256, 4096, wxIMAGE_QUALITY_BICUBIC)
+RESAMPLE_BENCHMARK(Enlarge256To4KBoxAverage, 256, 4096, wxIMAGE_QUALITY_BOX_AVERAGE)
+RESAMPLE_BENCHMARK(Enlarge256To4KNormal, 256, 4096, wxIMAGE_QUALITY_NORMAL)
+
+#undef RESAMPLE_BENCHMARK
+
+// Parallel processing benchmarks: the numeric parameter specifies the number
+// of threads to use, with 0 (default) meaning to use all CPUs, so run them
+// with "-p 1" to get the serial results for comparison.
+class ProcessingThreadsSetter
+{
+public:
+    ProcessingThreadsSetter()
+    {
+        wxImage::SetMaxProcessingThreads(Bench::GetNumericParameter(0));
+    }
+
+    ~ProcessingThreadsSetter()
+    {
+        wxImage::SetMaxProcessingThreads(1);
+    }
+};
+
+BENCHMARK_FUNC(ParallelScaleBicubic)
+{
+    ProcessingThreadsSetter setThreads;
+    return GetResampleImage(4096).Scale(2048, 2048, wxIMAGE_QUALITY_BICUBIC).IsOk();
+}
+
+BENCHMARK_FUNC(ParallelScaleNormal)
+{
+    ProcessingThreadsSetter setThreads;
+    return GetResampleImage(4096).Scale(1000, 1000, wxIMAGE_QUALITY_NORMAL).IsOk();
+}
+
+BENCHMARK_FUNC(ParallelBlur)
+{
+    ProcessingThreadsSetter setThreads;
+    return GetResampleImage(4096).Blur(10).IsOk();
+}
+
+BENCHMARK_FUNC(ParallelRotate)
+{
+    ProcessingThreadsSetter setThreads;
+    return GetResampleImage(4096).Rotate(0.5, wxPoint(2048, 2048)).IsOk();
+}
+
+// Tiling benchmarks: iterate over all 256*256 tiles of a big image and sum
+// the values of one of their pixels, either copying the tiles or not.
+BENCHMARK_FUNC(TileSubImage)
+{
+    const wxImage& image = GetResampleImage(4096);
+
+    unsigned sum = 0;
+    for ( int y = 0; y < image.GetHeight(); y += 256 )
+    {
+        for ( int x = 0; x < image.GetWidth(); x += 256 )
+        {
+            sum += image.GetSubImage(wxRect(x, y, 256, 256)).GetRed(1, 0);
+        }
+    }
+
+    return sum != 0;
+}
+
+BENCHMARK_FUNC(TileView)
+{
+    const wxImage& image = GetResampleImage(4096);
+
+    unsigned sum = 0;
+    for ( int y = 0; y < image.GetHeight(); y += 256 )
+    {
+        for ( int x = 0; x < image.GetWidth(); x += 256 )
+        {
+            sum += wxImageView(image, wxRect(x, y, 256, 256)).GetRed(1, 0);
+        }
+    }
+
+    return sum != 0;
+}
@@ -10,6 +10,12 @@
 #include "bench.h"
 
 #include "wx/log.h"
+#include "wx/logasync.h"
+#include "wx/stream.h"
+#include "wx/thread.h"
+
+#include <memory>
+#include <vector>
 
 // This class is used to check that the arguments of log functions are not
 // evaluated.
@@ -106,3 +112,123 @@ BENCHMARK_FUNC(LogTraceInactive)
 
     return true;
 }
+
+#if wxUSE_THREADS && wxUSE_STREAMS
+
+namespace
+{
+
+const int NUM_LOG_THREADS = 16;
+
+class LogBenchThread : public wxThread
+{
+public:
+    explicit LogBenchThread(int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < m_count; n++ )
+            wxLogMessage("Message %d from a worker thread", n);
+
+        return nullptr;
+    }
+
+private:
+    const int m_count;
+};
+
+// Log the given number of messages (1000 by default) from each of the worker
+// threads and wait until they terminate.
+bool LogFromThreads()
+{
+    const int numMessages = Bench::GetNumericParameter(1000);
+
+    std::vector<std::unique_ptr<LogBenchThread>> threads;
+    for ( int n = 0; n < NUM_LOG_THREADS; n++ )
+    {
+        threads.emplace_back(new LogBenchThread(numMessages));
+        if ( threads.back()->Run() != wxTHREAD_NO_ERROR )
+            return false;
+    }
+
+    for ( const auto& thread : threads )
+        thread->Wait();
+
+    return true;
+}
+
+// Log target formatting the messages and writing them to a stream, just as
+// wxLogAsync does, but synchronously.
+class StreamLog : public wxLog
+{
+public:
+    explicit StreamLog(wxOutputStream& stream)
+        : m_stream(stream)
+    {
+    }
+
+protected:
+    virtual void DoLogTextAtLevel(wxLogLevel, const wxString& msg) override
+    {
+        const wxScopedCharBuffer buf = msg.utf8_str();
+        m_stream.Write(buf.data(), buf.length());
+        m_stream.PutC('\n');
+    }
+
+private:
+    wxOutputStream& m_stream;
+};
+
+// Log from the worker threads to wxLogAsync using the given policy.
+bool LogFromThreadsAsync(wxLogAsync::OverflowPolicy policy)
+{
+    wxCountingOutputStream* const stream = new wxCountingOutputStream();
+
+    wxLogAsync log(stream);
+    log.SetOverflowPolicy(policy);
+
+    wxLog* const logOld = wxLog::SetActiveTarget(&log);
+
+    const bool ok = LogFromThreads();
+    log.WaitUntilWritten();
+
+    wxLog::SetActiveTarget(logOld);
+
+    return ok && stream->GetLength() > 0;
+}
+
+} // anonymous namespace
+
+// Messages logged from the worker threads are buffered by default and only
+// written when the log is flushed from the main thread.
+BENCHMARK_FUNC(LogThreadsBuffered)
+{
+    wxCountingOutputStream stream;
+    StreamLog log(stream);
+
+    wxLog* const logOld = wxLog::SetActiveTarget(&log);
+
+    const bool ok = LogFromThreads();
+    wxLog::FlushActive();
+
+    wxLog::SetActiveTarget(logOld);
+
+    return ok && stream.GetLength() > 0;
+}
+
+BENCHMARK_FUNC(LogThreadsAsyncBlock)
+{
+    return LogFromThreadsAsync(wxLogAsync::Overflow_Block);
+}
+
+BENCHMARK_FUNC(LogThreadsAsyncDrop)
+{
+    return LogFromThreadsAsync(wxLogAsync::Overflow_Drop);
+}
+
+#endif // wxUSE_THREADS && wxUSE_STREAMS
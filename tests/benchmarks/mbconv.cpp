@@ -12,6 +12,8 @@
 
 #include "bench.h"
 
+#include <vector>
+
 namespace
 {
 
@@ -42,6 +44,62 @@ bool ConvertToMB(const wxMBConv& conv)
     return conv.FromWChar(buf.data(), outlen, TEST_STRING) == outlen;
 }
 
+// UTF-8 text used by the benchmarks below, either pure ASCII or mostly
+// ASCII with some accented characters, as typical log files are.
+wxCharBuffer gs_utf8ASCII;
+wxCharBuffer gs_utf8Mixed;
+
+// Output buffer big enough for converting any of the strings above.
+std::vector<wchar_t> gs_wcBuf;
+
+bool InitUTF8()
+{
+    // Use a text of about 1MiB by default.
+    const long numRepeats = Bench::GetNumericParameter(2000);
+
+    wxString ascii,
+             mixed;
+    for ( long n = 0; n < numRepeats; n++ )
+    {
+        ascii += TEST_STRING;
+        mixed += TEST_STRING;
+        mixed += wxString::FromUTF8("\xc3\xa9t\xc3\xa9 \xe2\x82\xac");
+    }
+
+    gs_utf8ASCII = ascii.utf8_str();
+    gs_utf8Mixed = mixed.utf8_str();
+
+    gs_wcBuf.resize(gs_utf8Mixed.length() + 1);
+
+    return true;
+}
+
+void DoneUTF8()
+{
+    gs_utf8ASCII.reset();
+    gs_utf8Mixed.reset();
+
+    std::vector<wchar_t>().swap(gs_wcBuf);
+}
+
+// Convert the UTF-8 string to wide chars and back and check that the result
+// is the same as the original.
+bool ConvertUTF8(const wxMBConv& conv, const wxCharBuffer& utf8)
+{
+    const size_t lenWC = conv.ToWChar(&gs_wcBuf[0], gs_wcBuf.size(),
+                                      utf8.data(), utf8.length());
+    if ( lenWC == wxCONV_FAILED )
+        return false;
+
+    const size_t lenMB = conv.FromWChar(nullptr, 0, &gs_wcBuf[0], lenWC);
+    if ( lenMB != utf8.length() )
+        return false;
+
+    wxCharBuffer buf(lenMB);
+    return conv.FromWChar(buf.data(), lenMB, &gs_wcBuf[0], lenWC) == lenMB &&
+            memcmp(buf.data(), utf8.data(), lenMB) == 0;
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC(UTF16InitWX)
@@ -76,3 +134,26 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+BENCHMARK_FUNC_WITH_INIT(UTF8ASCII, InitUTF8, DoneUTF8)
+{
+    return ConvertUTF8(wxConvUTF8, gs_utf8ASCII);
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8Mixed, InitUTF8, DoneUTF8)
+{
+    return ConvertUTF8(wxConvUTF8, gs_utf8Mixed);
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8MixedPUA, InitUTF8, DoneUTF8)
+{
+    return ConvertUTF8(wxMBConvUTF8(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA),
+                       gs_utf8Mixed);
+}
+
+BENCHMARK_FUNC_WITH_INIT(UTF8FromString, InitUTF8, DoneUTF8)
+{
+    return wxString::FromUTF8(gs_utf8Mixed.data(),
+                              gs_utf8Mixed.length()).utf8_str().length()
+            == gs_utf8Mixed.length();
+}
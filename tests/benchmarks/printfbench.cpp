@@ -40,6 +40,7 @@
 //
 
 #include "wx/string.h"
+#include "wx/parsedfmt.h"
 #include "bench.h"
 
 // ----------------------------------------------------------------------------
@@ -132,3 +133,54 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxString::Format() vs wxParsedFormat
+// ----------------------------------------------------------------------------
+
+// Format string and arguments of a typical log message.
+#define LOG_MESSAGE_FORMAT \
+    "Processed %d items from \"%s\" in %.3fs (%zu bytes, %s)"
+
+#define LOG_MESSAGE_ARGS(n) \
+    n, g_fileName, 0.125*n, static_cast<size_t>(n)*1024, g_status
+
+static const wxString g_fileName("/var/log/application/input.dat");
+static const char* const g_status = "ok";
+
+BENCHMARK_FUNC(StringFormatMessage)
+{
+    size_t len = 0;
+    for ( int n = 0; n < 100; n++ )
+        len += wxString::Format(LOG_MESSAGE_FORMAT, LOG_MESSAGE_ARGS(n)).length();
+
+    return len > 0;
+}
+
+BENCHMARK_FUNC(ParsedFormatMessage)
+{
+    static const wxParsedFormat fmt(LOG_MESSAGE_FORMAT);
+
+    size_t len = 0;
+    for ( int n = 0; n < 100; n++ )
+        len += fmt.Format(LOG_MESSAGE_ARGS(n)).length();
+
+    return len > 0;
+}
+
+BENCHMARK_FUNC(ParsedFormatMessageReuse)
+{
+    static const wxParsedFormat fmt(LOG_MESSAGE_FORMAT);
+
+    // Reuse the same buffer for all messages.
+    wxString s;
+
+    size_t len = 0;
+    for ( int n = 0; n < 100; n++ )
+    {
+        fmt.FormatTo(s, LOG_MESSAGE_ARGS(n));
+        len += s.length();
+    }
+
+    return len > 0;
+}
@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/selstore.cpp
+// Purpose:     wxSelectionStore benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/selstore.h"
+
+#include "bench.h"
+
+namespace
+{
+
+// Return the number of items to use, 5M by default, as could be the case in
+// a virtual list control.
+unsigned GetNumItems()
+{
+    return static_cast<unsigned>(Bench::GetNumericParameter(5000000));
+}
+
+} // anonymous namespace
+
+// Select a range of items not covering more than half of them, which is
+// stored as is, and then select a few more items and ranges around it.
+BENCHMARK_FUNC(SelStoreSelectRange)
+{
+    const unsigned numItems = GetNumItems();
+
+    wxSelectionStore store;
+    store.SetItemCount(numItems);
+
+    store.SelectRange(numItems/10, numItems/2);
+    for ( unsigned n = 0; n < 100; n++ )
+        store.SelectItem(numItems/2 + 2*n + 2);
+    store.SelectRange(numItems/2, numItems/2 + 1000);
+
+    return store.GetSelectedCount() == numItems/2 - numItems/10 + 1001;
+}
+
+// Check whether each item is selected, as drawing the control does.
+BENCHMARK_FUNC(SelStoreIsSelected)
+{
+    const unsigned numItems = GetNumItems();
+
+    wxSelectionStore store;
+    store.SetItemCount(numItems);
+
+    // Use many separate ranges of selected items.
+    for ( unsigned n = 0; n < numItems; n += 100 )
+        store.SelectRange(n, n + 9);
+
+    unsigned numSelected = 0;
+    for ( unsigned n = 0; n < numItems; n++ )
+    {
+        if ( store.IsSelected(n) )
+            numSelected++;
+    }
+
+    return numSelected == store.GetSelectedCount();
+}
+
+// Insert and delete items in the middle of a big selected range.
+BENCHMARK_FUNC(SelStoreInsertDelete)
+{
+    const unsigned numItems = GetNumItems();
+
+    wxSelectionStore store;
+    store.SetItemCount(numItems);
+    store.SelectRange(numItems/10, numItems/2);
+
+    for ( unsigned n = 0; n < 1000; n++ )
+    {
+        store.OnItemsInserted(numItems/4 + n, 1);
+        store.OnItemsDeleted(numItems/3 + n, 1);
+    }
+
+    // Each deleted item was selected while the inserted ones are not.
+    return store.GetSelectedCount() == numItems/2 - numItems/10 + 1 - 1000;
+}
@@ -245,6 +245,27 @@ BENCHMARK_FUNC(ForStringRIter)
     return true;
 }
 
+// Access the characters of a long non-ASCII string in random order, this is
+// much slower than sequential access in UTF-8 build unless an index is used.
+BENCHMARK_FUNC(ForStringIndexRandom)
+{
+    static wxString s;
+    if ( s.empty() )
+    {
+        for ( int n = 0; n < 1000; n++ )
+            s += wxString::FromUTF8(utf8str);
+    }
+
+    const size_t len = s.length();
+    for ( size_t n = 0; n < 10000; n++ )
+    {
+        if ( s[(n*7919) % len] == '~' )
+            return false;
+    }
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // wxString::Replace()
 // ----------------------------------------------------------------------------
@@ -716,3 +737,53 @@ BENCHMARK_FUNC(StdToChars)
 #endif // __cpp_lib_to_chars
 
 #endif // wxHAS_CXX17_INCLUDE(<charconv>)
+
+// ----------------------------------------------------------------------------
+// memory usage of many short strings
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Create the given number of short strings, as e.g. property names.
+std::vector<wxString> CreateShortStrings(size_t num)
+{
+    std::vector<wxString> v;
+    v.reserve(num);
+    for ( size_t n = 0; n < num; n++ )
+        v.push_back(wxString::Format("prop%zu", n % 1000));
+
+    return v;
+}
+
+const size_t NUM_SHORT_STRINGS = 1000000;
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(ManyShortStrings)
+{
+    static bool s_reported = false;
+    if ( !s_reported )
+    {
+        s_reported = true;
+        wxPrintf("\tsizeof(wxString) = %zu, of which %zu are used by "
+                 "the string itself and %zu by the auxiliary data\n",
+                 sizeof(wxString), sizeof(wxStringImpl),
+                 sizeof(wxString) - sizeof(wxStringImpl));
+    }
+
+    return CreateShortStrings(NUM_SHORT_STRINGS).size() == NUM_SHORT_STRINGS;
+}
+
+// Also convert all strings to multibyte, as when passing them to C APIs,
+// which allocates the conversion buffer in wxUSE_UNICODE_WCHAR build.
+BENCHMARK_FUNC(ManyShortStringsMB)
+{
+    std::vector<wxString> v = CreateShortStrings(NUM_SHORT_STRINGS);
+
+    size_t len = 0;
+    for ( const auto& s : v )
+        len += strlen(s.mb_str());
+
+    return len > NUM_SHORT_STRINGS;
+}
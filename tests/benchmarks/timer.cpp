@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/timer.cpp
+// Purpose:     wxTimer-related benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-18
+// Copyright:   (c) wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#include "wx/timer.h"
+
+#include <vector>
+
+#if wxUSE_TIMER
+
+namespace
+{
+
+// All timers used by the benchmarks below.
+std::vector<wxTimer*> gs_timers;
+
+// Return the interval to use for the timer with the given index: it is long
+// enough for the timers to never expire during the benchmark and the timers
+// are deliberately not started in the order of their expiration.
+int GetTimerInterval(size_t n)
+{
+    return 1000000 + static_cast<int>((n*7919) % 100000);
+}
+
+bool InitTimers()
+{
+    const long numTimers = Bench::GetNumericParameter(100000);
+
+    gs_timers.reserve(numTimers);
+    for ( long n = 0; n < numTimers; n++ )
+        gs_timers.push_back(new wxTimer());
+
+    return true;
+}
+
+void DoneTimers()
+{
+    for ( auto timer : gs_timers )
+        delete timer;
+
+    gs_timers.clear();
+}
+
+// Stop all the timers in a different order from the one they were started in.
+bool StopAllTimers()
+{
+    const size_t count = gs_timers.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxTimer* const timer = gs_timers[(n*31) % count];
+        if ( !timer->IsRunning() )
+            return false;
+
+        timer->Stop();
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+// Start the given number (100000 by default) of timers and stop them all.
+BENCHMARK_FUNC_WITH_INIT(TimersStartStop, InitTimers, DoneTimers)
+{
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        gs_timers[n]->Start(GetTimerInterval(n), wxTIMER_ONE_SHOT);
+
+    return StopAllTimers();
+}
+
+// Restart all the running timers, as is typically done for the timeouts which
+// are reset whenever there is some activity.
+BENCHMARK_FUNC_WITH_INIT(TimersRestart, InitTimers, DoneTimers)
+{
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        gs_timers[n]->Start(GetTimerInterval(n), wxTIMER_ONE_SHOT);
+
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        gs_timers[n]->Start(GetTimerInterval(n + 1), wxTIMER_ONE_SHOT);
+
+    return StopAllTimers();
+}
+
+#endif // wxUSE_TIMER
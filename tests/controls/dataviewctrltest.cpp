@@ -19,9 +19,7 @@
 #include "wx/dataview.h"
 #include "wx/uiaction.h"
 
-#ifdef __WXGTK__
-    #include "waitfor.h"
-#endif // __WXGTK__
+#include "waitfor.h"
 
 #include "testableframe.h"
 #include "asserthelper.h"
@@ -837,6 +835,52 @@ TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
     CHECK( m_dvc->GetChildCount(wxDataViewItem()) == 0 );
 }
 
+TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
+                 "wxDVC::ItemsAdded",
+                 "[wxDataViewCtrl][add]")
+{
+#ifdef __WXGTK__
+    // We need to let the native control have some events to lay itself out.
+    wxYield();
+#endif // __WXGTK__
+
+    m_dvc->Select(m_child2);
+
+    // Add several items at different positions to the model and notify the
+    // control about all of them at once.
+    wxDataViewTreeStore* const store = m_dvc->GetStore();
+
+    wxDataViewItemArray items;
+    const wxDataViewItem first = store->PrependItem(m_root, "first");
+    items.push_back(first);
+    // Note that InsertItem() inserts the new item before the given one.
+    const wxDataViewItem middle = store->InsertItem(m_root, m_child2, "middle");
+    items.push_back(middle);
+    const wxDataViewItem last = store->AppendItem(m_root, "last");
+    items.push_back(last);
+
+    store->ItemsAdded(m_root, items);
+
+    CHECK( m_dvc->GetChildCount(m_root) == 5 );
+    CHECK( m_dvc->GetSelection() == m_child2 );
+
+#ifdef __WXGTK__
+    wxYield();
+#endif // __WXGTK__
+
+    // Check that the items appear in the same order as in the model.
+    const wxDataViewItem order[] = { first, m_child1, middle, m_child2, last };
+
+    int prevY = m_dvc->GetItemRect(m_root).y;
+    for ( const auto& item : order )
+    {
+        const wxRect rect = m_dvc->GetItemRect(item);
+        INFO("Item \"" << store->GetItemText(item) << "\" at " << rect);
+        CHECK( rect.y > prevY );
+        prevY = rect.y;
+    }
+}
+
 TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
                  "wxDVC::AppendTextColumn",
                  "[wxDataViewCtrl][column]")
@@ -861,6 +905,64 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+TEST_CASE("wxDVC::AsyncVirtualListModel", "[wxDataViewCtrl][model]")
+{
+    class PlaceholderModel : public wxDataViewAsyncVirtualListModel
+    {
+    public:
+        explicit PlaceholderModel(const RowFetcher& fetcher)
+            : wxDataViewAsyncVirtualListModel(fetcher, 1000)
+        {
+        }
+
+        void GetPlaceholderByRow(wxVariant& variant,
+                                 unsigned int WXUNUSED(row),
+                                 unsigned int WXUNUSED(col)) const override
+        {
+            variant = "...";
+        }
+    };
+
+    wxObjectDataPtr<PlaceholderModel> model(new PlaceholderModel(
+        [](unsigned int row, wxVector<wxVariant>& values)
+        {
+            values.push_back(wxString::Format("row %u", row));
+            values.push_back(static_cast<long>(row));
+        }));
+    model->SetPrefetchMargin(2);
+
+    // The placeholder is returned initially.
+    wxVariant value;
+    model->GetValueByRow(value, 100, 0);
+    CHECK( value.GetString() == "..." );
+
+    // But the real values become available later.
+    REQUIRE( WaitFor("row to be fetched", [&]() {
+        return model->IsRowCached(100) && model->IsRowCached(102);
+    }, 5000) );
+
+    model->GetValueByRow(value, 100, 0);
+    CHECK( value.GetString() == "row 100" );
+    model->GetValueByRow(value, 102, 1);
+    CHECK( value.GetLong() == 102 );
+
+    // The rows beyond the margin are not fetched.
+    CHECK( !model->IsRowCached(103) );
+
+    model->PrefetchRows(500, 509);
+    REQUIRE( WaitFor("rows to be prefetched", [&]() {
+        return model->IsRowCached(509);
+    }, 5000) );
+
+    // Only the rows closest to the last requested one are kept in the cache.
+    model->SetMaxCachedRows(4);
+    CHECK( model->IsRowCached(100) );
+    CHECK( !model->IsRowCached(509) );
+
+    model->ClearCache();
+    CHECK( !model->IsRowCached(100) );
+}
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
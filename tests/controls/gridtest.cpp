@@ -14,10 +14,13 @@
 #ifndef WX_PRECOMP
     #include "wx/app.h"
     #include "wx/dcclient.h"
+    #include "wx/textctrl.h"
 #endif // WX_PRECOMP
 
 #include "wx/grid.h"
 #include "wx/headerctrl.h"
+#include "wx/mstream.h"
+#include "wx/generic/private/grid.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -28,6 +31,8 @@
 
 #include "waitfor.h"
 
+#include <random>
+
 // To disable tests which work locally, but not when run on GitHub CI.
 #if defined(__WXGTK__) && !defined(__WXGTK3__)
     #define wxSKIP_AUTOMATIC_TEST_IF_GTK2() \
@@ -996,6 +1001,52 @@ TEST_CASE_METHOD(GridTestCase, "Grid::SelectionRange", "[grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::SelectManyBlocks", "[grid][selection]")
+{
+    m_grid->AppendRows(190);
+    m_grid->SetSelectionMode(wxGrid::wxGridSelectRows);
+
+    // Select every third row, which results in too many blocks to check them
+    // all when testing whether a cell is selected.
+    for ( int row = 0; row < 200; row += 3 )
+        m_grid->SelectRow(row, true);
+
+    CHECK( m_grid->GetSelectedRows().size() == 67 );
+    CHECK( m_grid->GetSelectedRowBlocks().size() == 67 );
+
+    for ( int row = 0; row < 200; row++ )
+    {
+        INFO("Row " << row);
+        CHECK( m_grid->IsInSelection(row, 1) == (row % 3 == 0) );
+    }
+
+    // Selecting the rows in between merges all blocks together.
+    for ( int row = 1; row < 200; row += 3 )
+        m_grid->SelectRow(row, true);
+    for ( int row = 2; row < 200; row += 3 )
+        m_grid->SelectRow(row, true);
+
+    const wxGridBlockCoordsVector blocks = m_grid->GetSelectedRowBlocks();
+    REQUIRE( blocks.size() == 1 );
+    CHECK( blocks[0] == wxGridBlockCoords(0, 0, 199, 1) );
+
+    // And deselecting some of them splits it again.
+    m_grid->DeselectRow(10);
+    m_grid->DeselectRow(100);
+
+    CHECK( m_grid->GetSelectedRows().size() == 198 );
+    CHECK( !m_grid->IsInSelection(10, 0) );
+    CHECK( !m_grid->IsInSelection(100, 1) );
+    CHECK( m_grid->IsInSelection(11, 0) );
+    CHECK( m_grid->IsInSelection(199, 1) );
+
+    // Check that the selection is updated when rows are deleted too.
+    m_grid->DeleteRows(0, 11);
+    CHECK( m_grid->IsInSelection(0, 0) );
+    CHECK( !m_grid->IsInSelection(89, 0) );
+    CHECK( m_grid->GetSelectedRows().size() == 188 );
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::SelectEmptyGrid", "[grid]")
 {
     for ( int i = 0; i < 2; ++i )
@@ -1836,6 +1887,131 @@ TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumn", "[grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumnsOptions", "[grid]")
+{
+    const wxString longStr = "WWWWWWWWWWWWWWWW";
+    const wxString shortStr = "WW";
+
+    const int defWidth = m_grid->GetDefaultColSize();
+
+    // Return the width of the first column after auto-sizing it.
+    auto autoSizedWidth = [this]()
+    {
+        m_grid->AutoSizeColumn(0, false);
+        return m_grid->GetColSize(0);
+    };
+
+    SECTION("Sample")
+    {
+        m_grid->SetCellValue(3, 0, longStr);
+        const int widthLong = autoSizedWidth();
+        CHECK( widthLong > defWidth );
+
+        // Only rows 0 and 5 are measured now.
+        m_grid->SetAutoSizeSampleSize(2);
+        CHECK( m_grid->GetAutoSizeSampleSize() == 2 );
+        CHECK( autoSizedWidth() < widthLong );
+
+        m_grid->SetCellValue(5, 0, longStr);
+        CHECK( autoSizedWidth() == widthLong );
+
+        m_grid->SetAutoSizeSampleSize(0);
+        m_grid->SetCellValue(5, 0, wxString());
+        CHECK( autoSizedWidth() == widthLong );
+    }
+
+    SECTION("Cache")
+    {
+        m_grid->EnableAutoSizeCache();
+        CHECK( m_grid->IsAutoSizeCacheEnabled() );
+
+        m_grid->SetCellValue(0, 0, shortStr);
+        const int widthShort = autoSizedWidth();
+
+        m_grid->SetCellValue(0, 0, longStr);
+        const int widthLong = autoSizedWidth();
+        CHECK( widthLong > widthShort );
+
+        // Changing the table directly doesn't invalidate the cache.
+        m_grid->GetTable()->SetValue(0, 0, shortStr);
+        CHECK( autoSizedWidth() == widthLong );
+
+        m_grid->ClearAutoSizeCache();
+        CHECK( autoSizedWidth() == widthShort );
+
+        // But changing the attributes does.
+        wxFont font = m_grid->GetDefaultCellFont();
+        font.SetPointSize(3*font.GetPointSize());
+        m_grid->SetCellFont(0, 0, font);
+        CHECK( autoSizedWidth() > widthShort );
+
+        m_grid->EnableAutoSizeCache(false);
+        CHECK( !m_grid->IsAutoSizeCacheEnabled() );
+    }
+
+    SECTION("CacheEdit")
+    {
+        m_grid->EnableAutoSizeCache();
+
+        m_grid->SetCellValue(0, 0, shortStr);
+        const int widthShort = autoSizedWidth();
+
+        // Changing the value using the editor must invalidate the cache too.
+        m_grid->SetGridCursor(0, 0);
+        m_grid->EnableCellEditControl();
+        REQUIRE( m_grid->IsCellEditControlEnabled() );
+
+        wxGridCellEditorPtr editor(m_grid->GetCellEditor(0, 0));
+        wxTextCtrl* const text = wxDynamicCast(editor->GetControl(), wxTextCtrl);
+        REQUIRE( text );
+        text->ChangeValue(longStr);
+
+        m_grid->DisableCellEditControl();
+        CHECK( autoSizedWidth() > widthShort );
+    }
+
+    SECTION("Idle")
+    {
+        m_grid->SetCellValue(0, 0, longStr);
+        m_grid->SetCellValue(5, 1, shortStr);
+
+        m_grid->AutoSizeColumns(false);
+        const int width0 = m_grid->GetColSize(0);
+        const int width1 = m_grid->GetColSize(1);
+
+        m_grid->SetColSize(0, defWidth);
+        m_grid->SetColSize(1, defWidth);
+
+        EventCounter autoSized(m_grid, wxEVT_GRID_COLS_AUTO_SIZED);
+
+        m_grid->AutoSizeColumnsInIdle(false);
+        CHECK( m_grid->IsAutoSizingColumnsInIdle() );
+        CHECK( m_grid->GetColSize(0) == defWidth );
+
+        SECTION("Complete")
+        {
+            WaitFor("columns to be auto-sized", [this]() {
+                return !m_grid->IsAutoSizingColumnsInIdle();
+            });
+
+            CHECK( autoSized.GetCount() == 1 );
+            CHECK( m_grid->GetColSize(0) == width0 );
+            CHECK( m_grid->GetColSize(1) == width1 );
+        }
+
+        SECTION("Cancel")
+        {
+            m_grid->CancelAutoSizeColumnsInIdle();
+            CHECK( !m_grid->IsAutoSizingColumnsInIdle() );
+
+            YieldForAWhile();
+
+            CHECK( autoSized.GetCount() == 0 );
+            CHECK( m_grid->GetColSize(0) == defWidth );
+        }
+    }
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::DrawInvalidCell", "[grid][multicell]")
 {
     // Set up a multicell with inside an overflowing cell.
@@ -2126,6 +2302,98 @@ TEST_CASE_METHOD(GridTestCase, "Grid::SetTable_ClearAttrCache", "[grid]")
 #endif // !__WXOSX__
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AttrCache", "[grid]")
+{
+    // Attribute provider returning attributes depending on external state.
+    class ColourAttrProvider : public wxGridCellAttrProvider
+    {
+    public:
+        virtual wxGridCellAttr *GetAttr(int WXUNUSED(row), int WXUNUSED(col),
+                                        wxGridCellAttr::wxAttrKind WXUNUSED(kind)) const override
+        {
+            wxGridCellAttr* const attr = new wxGridCellAttr();
+            attr->SetTextColour(m_colour);
+            return attr;
+        }
+
+        wxColour m_colour = *wxRED;
+    };
+
+    ColourAttrProvider* const provider = new ColourAttrProvider();
+    m_grid->GetTable()->SetAttrProvider(provider);
+    m_grid->Refresh();
+
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxRED );
+
+    // The attributes are cached until the grid is refreshed...
+    provider->m_colour = *wxGREEN;
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxRED );
+
+    // ... unless the cache is explicitly invalidated for the cell.
+    m_grid->RefreshAttr(0, 0);
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxGREEN );
+
+    provider->m_colour = *wxBLUE;
+    m_grid->Refresh();
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxBLUE );
+    CHECK( m_grid->GetCellTextColour(1, 1) == *wxBLUE );
+
+    // Changing a value also invalidates the cache as the attributes may
+    // depend on it.
+    provider->m_colour = *wxRED;
+    m_grid->SetCellValue(1, 1, "changed");
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxRED );
+}
+
+TEST_CASE_METHOD(GridTestCase, "Grid::AttrCacheValue", "[grid]")
+{
+    // Attribute provider returning attributes depending on the cell values.
+    class ValueAttrProvider : public wxGridCellAttrProvider
+    {
+    public:
+        explicit ValueAttrProvider(wxGridTableBase* table) : m_table(table) { }
+
+        virtual wxGridCellAttr *GetAttr(int row, int col,
+                                        wxGridCellAttr::wxAttrKind WXUNUSED(kind)) const override
+        {
+            wxGridCellAttr* const attr = new wxGridCellAttr();
+            attr->SetTextColour(m_table->GetValue(row, col) == "ok" ? *wxGREEN
+                                                                     : *wxRED);
+            return attr;
+        }
+
+    private:
+        wxGridTableBase* const m_table;
+    };
+
+    wxGridTableBase* const table = m_grid->GetTable();
+    table->SetAttrProvider(new ValueAttrProvider(table));
+    m_grid->Refresh();
+
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxRED );
+    CHECK( m_grid->GetCellTextColour(1, 1) == *wxRED );
+
+    // Changing the value using the editor must invalidate the cached
+    // attributes of the cell.
+    m_grid->SetGridCursor(0, 0);
+    m_grid->EnableCellEditControl();
+    REQUIRE( m_grid->IsCellEditControlEnabled() );
+
+    wxGridCellEditorPtr editor(m_grid->GetCellEditor(0, 0));
+    wxTextCtrl* const text = wxDynamicCast(editor->GetControl(), wxTextCtrl);
+    REQUIRE( text );
+    text->ChangeValue("ok");
+
+    m_grid->DisableCellEditControl();
+    CHECK( m_grid->GetCellValue(0, 0) == "ok" );
+    CHECK( m_grid->GetCellTextColour(0, 0) == *wxGREEN );
+
+    // And so must refreshing the cells after changing the table directly.
+    table->SetValue(1, 1, "ok");
+    m_grid->RefreshBlock(1, 1, 1, 1);
+    CHECK( m_grid->GetCellTextColour(1, 1) == *wxGREEN );
+}
+
 #define CHECK_MULTICELL() CHECK_THAT( *m_grid, HasMulticellOnly(multi) )
 
 #define CHECK_NO_MULTICELL() CHECK_THAT( *m_grid, HasEmptyGrid() )
@@ -2433,6 +2701,253 @@ TEST_CASE_METHOD(GridTestCase,
 
 }
 
+// Test wxGridCellAttrProvider here too as it doesn't need any grid window.
+
+TEST_CASE("GridCellAttrProvider::BlockAttr", "[grid]")
+{
+    const wxGridCellAttr::wxAttrKind Any = wxGridCellAttr::Any;
+
+    wxGridCellAttrProvider provider;
+
+    wxGridCellAttr* const attrBlock = new wxGridCellAttr();
+    attrBlock->SetTextColour(*wxRED);
+    provider.SetBlockAttr(attrBlock, wxGridBlockCoords(1, 1, 10, 5));
+
+    wxGridCellAttr* const attrInner = new wxGridCellAttr();
+    attrInner->SetBackgroundColour(*wxGREEN);
+    provider.SetBlockAttr(attrInner, wxGridBlockCoords(3, 2, 4, 3));
+
+    CHECK( !provider.GetAttrPtr(0, 0, Any) );
+    CHECK( provider.GetAttrPtr(1, 1, Any).get() == attrBlock );
+    CHECK( provider.GetAttrPtr(10, 5, Any).get() == attrBlock );
+    CHECK( !provider.GetAttrPtr(11, 5, Any) );
+    CHECK( !provider.GetAttrPtr(10, 6, Any) );
+    CHECK( provider.GetAttrPtr(3, 2, Any).get() == attrInner );
+    CHECK( provider.GetAttrPtr(4, 4, Any).get() == attrBlock );
+
+    // Block attributes are not individual cell attributes.
+    CHECK( !provider.GetAttrPtr(1, 1, wxGridCellAttr::Cell) );
+
+    SECTION("Merge")
+    {
+        wxGridCellAttr* const attrCell = new wxGridCellAttr();
+        attrCell->SetTextColour(*wxBLUE);
+        provider.SetAttr(attrCell, 1, 1);
+
+        wxGridCellAttr* const attrRow = new wxGridCellAttr();
+        attrRow->SetBackgroundColour(*wxYELLOW);
+        provider.SetRowAttr(attrRow, 1);
+
+        wxGridCellAttrPtr attr = provider.GetAttrPtr(1, 1, Any);
+        CHECK( attr->GetTextColour() == *wxBLUE );
+        CHECK( attr->GetBackgroundColour() == *wxYELLOW );
+
+        attr = provider.GetAttrPtr(1, 2, Any);
+        CHECK( attr->GetTextColour() == *wxRED );
+        CHECK( attr->GetBackgroundColour() == *wxYELLOW );
+    }
+
+    SECTION("Remove")
+    {
+        provider.SetBlockAttr(nullptr, wxGridBlockCoords(1, 1, 10, 2));
+        CHECK( !provider.GetAttrPtr(3, 2, Any) );
+        CHECK( !provider.GetAttrPtr(10, 1, Any) );
+        CHECK( provider.GetAttrPtr(3, 3, Any).get() == attrInner );
+        CHECK( provider.GetAttrPtr(1, 3, Any).get() == attrBlock );
+    }
+
+    SECTION("Insert and delete")
+    {
+        // The new rows are not part of any block.
+        provider.UpdateAttrRows(3, 2);
+        CHECK( provider.GetAttrPtr(2, 1, Any).get() == attrBlock );
+        CHECK( !provider.GetAttrPtr(3, 1, Any) );
+        CHECK( !provider.GetAttrPtr(4, 2, Any) );
+        CHECK( provider.GetAttrPtr(5, 2, Any).get() == attrInner );
+        CHECK( provider.GetAttrPtr(12, 5, Any).get() == attrBlock );
+
+        provider.UpdateAttrCols(0, -2);
+        CHECK( provider.GetAttrPtr(5, 0, Any).get() == attrInner );
+        CHECK( provider.GetAttrPtr(12, 3, Any).get() == attrBlock );
+        CHECK( !provider.GetAttrPtr(12, 4, Any) );
+
+        provider.UpdateAttrRows(0, -20);
+        CHECK( !provider.GetAttrPtr(0, 0, Any) );
+    }
+}
+
+// Test wxGridColumnarTable here too as it doesn't need any grid window.
+
+TEST_CASE("GridColumnarTable::LoadCSV", "[grid]")
+{
+    const char csv[] =
+        "\xEF\xBB\xBF" "name,count,price,code,empty\r\n"
+        "apple,1,1.50,007,\r\n"
+        "\"pear, green\",-12,2.25,x,\n"
+        "\n"
+        "\"say \"\"hi\"\"\",,3.00,5,\n"
+        "\"multi\nline\",3,,1,,extra\n"
+        "apple,4,0.10,2";
+    wxMemoryInputStream input(csv, sizeof(csv) - 1);
+
+    wxGridColumnarTable table;
+    REQUIRE( table.LoadCSV(input) );
+
+    REQUIRE( table.GetNumberRows() == 5 );
+    REQUIRE( table.GetNumberCols() == 6 );
+
+    CHECK( table.GetColLabelValue(0) == "name" );
+    CHECK( table.GetColLabelValue(5) == "F" );
+
+    CHECK( table.GetColType(0) == wxGRID_VALUE_STRING );
+    CHECK( table.GetColType(1) == wxGRID_VALUE_NUMBER );
+    CHECK( table.GetColType(2) == wxGRID_VALUE_FLOAT );
+    CHECK( table.GetTypeName(0, 2) == "double:,2" );
+
+    // "007" can't be stored as a number without losing information.
+    CHECK( table.GetColType(3) == wxGRID_VALUE_STRING );
+    CHECK( table.GetColType(4) == wxGRID_VALUE_STRING );
+
+    CHECK( table.GetValue(1, 0) == "pear, green" );
+    CHECK( table.GetValue(2, 0) == "say \"hi\"" );
+    CHECK( table.GetValue(3, 0) == "multi\nline" );
+    CHECK( table.GetValue(3, 5) == "extra" );
+    CHECK( table.GetValue(0, 5) == "" );
+
+    CHECK( table.GetValueAsLong(1, 1) == -12 );
+    CHECK( table.GetValue(1, 1) == "-12" );
+    CHECK( table.IsEmptyCell(2, 1) );
+    CHECK( !table.CanGetValueAs(2, 1, wxGRID_VALUE_NUMBER) );
+
+    CHECK( table.GetValue(0, 2) == "1.50" );
+    CHECK( table.GetValueAsDouble(4, 2) == 0.1 );
+    CHECK( table.GetValue(0, 3) == "007" );
+
+    SECTION("Without type detection")
+    {
+        wxMemoryInputStream input2("a;1\nb;2\n", 8);
+        REQUIRE( table.LoadCSV(input2, ';', wxGRID_CSV_HEADER) );
+
+        CHECK( table.GetNumberRows() == 1 );
+        CHECK( table.GetNumberCols() == 2 );
+        CHECK( table.GetColLabelValue(1) == "1" );
+        CHECK( table.GetColType(1) == wxGRID_VALUE_STRING );
+        CHECK( table.GetValue(0, 1) == "2" );
+    }
+
+    SECTION("Encoding")
+    {
+        // Fields which are not valid UTF-8 are decoded as ISO-8859-1.
+        const char csvInvalid[] =
+            "n\xE9me,ok\n"
+            "caf\xE9,\xC3\xA9t\xC3\xA9\n";
+        wxMemoryInputStream input2(csvInvalid, sizeof(csvInvalid) - 1);
+        REQUIRE( table.LoadCSV(input2) );
+
+        CHECK( table.GetColLabelValue(0) == wxString::FromUTF8("n\xC3\xA9me") );
+        CHECK( table.GetValue(0, 0) == wxString::FromUTF8("caf\xC3\xA9") );
+        CHECK( table.GetValue(0, 1) == wxString::FromUTF8("\xC3\xA9t\xC3\xA9") );
+
+        // But the encoding can also be specified explicitly.
+        const char csvLatin1[] = "a\n" "\xC3\xA9\n";
+        wxMemoryInputStream input3(csvLatin1, sizeof(csvLatin1) - 1);
+        REQUIRE( table.LoadCSV(input3, ',', wxGRID_CSV_DEFAULT, wxConvISO8859_1) );
+
+        CHECK( table.GetValue(0, 0) == wxString::FromUTF8("\xC3\x83\xC2\xA9") );
+    }
+}
+
+TEST_CASE("GridColumnarTable::Types", "[grid]")
+{
+    wxGridColumnarTable table(3, 2);
+
+    CHECK( table.GetColType(0) == wxGRID_VALUE_STRING );
+
+    table.SetValue(0, 0, "10");
+    table.SetValue(1, 0, "-3");
+    REQUIRE( table.SetColType(0, wxGRID_VALUE_NUMBER) );
+    CHECK( table.GetValueAsLong(1, 0) == -3 );
+    CHECK( table.IsEmptyCell(2, 0) );
+
+    // Setting a non-numeric value changes the type of the column.
+    table.SetValue(0, 0, "many");
+    CHECK( table.GetColType(0) == wxGRID_VALUE_STRING );
+    CHECK( table.GetValue(0, 0) == "many" );
+    CHECK( table.GetValue(1, 0) == "-3" );
+    CHECK( !table.SetColType(0, wxGRID_VALUE_NUMBER) );
+
+    // But the old value doesn't prevent changing it back once it's replaced.
+    table.SetValue(0, 0, "10");
+    CHECK( table.SetColType(0, wxGRID_VALUE_NUMBER) );
+    CHECK( table.SetColType(0, wxGRID_VALUE_FLOAT) );
+    CHECK( table.GetValueAsDouble(0, 0) == 10. );
+
+    table.SetValueAsDouble(2, 0, 0.25);
+    CHECK( table.SetColType(0, wxGRID_VALUE_STRING) );
+    CHECK( table.GetValue(2, 0) == "0.25" );
+
+    // Storing a double in a string column must not lose precision.
+    table.SetValueAsDouble(1, 0, 0.1 + 0.2);
+    CHECK( table.GetValue(1, 0) == "0.30000000000000004" );
+    table.SetValueAsDouble(1, 0, 1234567.875);
+    CHECK( table.GetValue(1, 0) == "1234567.875" );
+    table.SetValueAsDouble(1, 0, 1e-300);
+    CHECK( table.GetValue(1, 0) == "1e-300" );
+
+    const wxString s = wxString::FromUTF8("\xC3\xA9t\xC3\xA9");
+    table.SetValue(0, 1, s);
+    CHECK( table.GetValue(0, 1) == s );
+
+    // Setting a value with more decimals increases the column precision.
+    table.SetValue(0, 0, "0.50");
+    table.SetValue(1, 0, "1.25");
+    table.SetValue(2, 0, "");
+    REQUIRE( table.SetColType(0, wxGRID_VALUE_FLOAT) );
+    CHECK( table.GetTypeName(0, 0) == "double:,2" );
+
+    table.SetValue(1, 0, "1.125");
+    CHECK( table.GetTypeName(0, 0) == "double:,3" );
+    CHECK( table.GetValue(0, 0) == "0.500" );
+    CHECK( table.GetValue(1, 0) == "1.125" );
+
+    // But a value using a different format still changes the column type.
+    table.SetValue(1, 0, "1e10");
+    CHECK( table.GetColType(0) == wxGRID_VALUE_STRING );
+    CHECK( table.GetValue(0, 0) == "0.500" );
+}
+
+TEST_CASE("GridColumnarTable::RowsCols", "[grid]")
+{
+    wxGridColumnarTable table(3, 2);
+    for ( int row = 0; row < 3; row++ )
+        table.SetValue(row, 0, wxString::Format("r%d", row));
+    table.SetColLabelValue(0, "first");
+    table.SetColLabelValue(1, "second");
+
+    table.InsertRows(1, 2);
+    REQUIRE( table.GetNumberRows() == 5 );
+    CHECK( table.GetValue(0, 0) == "r0" );
+    CHECK( table.IsEmptyCell(1, 0) );
+    CHECK( table.GetValue(3, 0) == "r1" );
+
+    table.DeleteRows(0, 3);
+    REQUIRE( table.GetNumberRows() == 2 );
+    CHECK( table.GetValue(0, 0) == "r1" );
+
+    table.InsertCols(0);
+    REQUIRE( table.GetNumberCols() == 3 );
+    CHECK( table.GetValue(0, 1) == "r1" );
+    CHECK( table.GetColLabelValue(1) == "first" );
+
+    table.DeleteCols(0, 2);
+    REQUIRE( table.GetNumberCols() == 1 );
+    CHECK( table.GetColLabelValue(0) == "second" );
+
+    table.Clear();
+    CHECK( table.GetNumberRows() == 2 );
+    CHECK( table.IsEmptyCell(0, 0) );
+}
+
 // Test wxGridBlockCoords here because it'a a part of grid sources.
 
 std::ostream& operator<<(std::ostream& os, const wxGridBlockCoords& block) {
@@ -2619,6 +3134,67 @@ TEST_CASE("GridBlockCoords::SymDifference", "[grid]")
     }
 }
 
+TEST_CASE("GridPrivate::MergeLastBlock", "[grid][selection]")
+{
+    SECTION("Cascade")
+    {
+        // Adding the last block merges it with the block before it, which
+        // can then be merged with the first block, and then with the second.
+        wxGridBlockCoordsVector blocks;
+        blocks.push_back(wxGridBlockCoords(0, 0, 1, 1));
+        blocks.push_back(wxGridBlockCoords(4, 0, 5, 1));
+        blocks.push_back(wxGridBlockCoords(2, 0, 3, 0));
+        blocks.push_back(wxGridBlockCoords(2, 1, 3, 1));
+
+        wxGridPrivate::MergeLastBlock(blocks);
+        REQUIRE( blocks.size() == 1 );
+        CHECK( blocks[0] == wxGridBlockCoords(0, 0, 5, 1) );
+    }
+
+    SECTION("Random")
+    {
+        // Check that adding blocks one by one to a merged selection gives the
+        // same result as merging all of them, including when the merges
+        // cascade to the earlier blocks.
+        std::mt19937 rng(17);
+        const auto random = [&rng](int n) { return static_cast<int>(rng() % n); };
+
+        for ( int iter = 0; iter < 1000; iter++ )
+        {
+            const int size = 2 + random(6);
+
+            wxGridBlockCoordsVector blocks;
+            for ( int n = 0; n < 10; n++ )
+            {
+                const int row1 = random(size),
+                          row2 = random(size);
+
+                // Use full rows half of the time, as they're merged more often.
+                int col1 = 0,
+                    col2 = size - 1;
+                if ( random(2) )
+                {
+                    col1 = random(size);
+                    col2 = random(size);
+                }
+
+                blocks.push_back(wxGridBlockCoords(wxMin(row1, row2),
+                                                   wxMin(col1, col2),
+                                                   wxMax(row1, row2),
+                                                   wxMax(col1, col2)));
+
+                wxGridBlockCoordsVector expected = blocks;
+                wxGridPrivate::MergeAdjacentBlocks(expected);
+
+                wxGridPrivate::MergeLastBlock(blocks);
+
+                INFO("Iteration " << iter << ", block " << n);
+                REQUIRE( blocks == expected );
+            }
+        }
+    }
+}
+
 //
 // TestableGrid
 //
@@ -13,8 +13,11 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/event.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // test events and their handlers
 // ----------------------------------------------------------------------------
@@ -510,6 +513,200 @@ TEST_CASE("Event::UnbindFromHandler", "[event][bind][unbind]")
     handler.ProcessEvent(e);
 }
 
+namespace
+{
+
+// Functor remembering that it was called by appending its tag to the vector.
+struct TagRecorder
+{
+    TagRecorder(std::vector<int>& called, int tag)
+        : m_called(&called), m_tag(tag)
+    {
+    }
+
+    void operator()(MyEvent& e)
+    {
+        m_called->push_back(m_tag);
+        e.Skip();
+    }
+
+    std::vector<int>* m_called;
+    int m_tag;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Event::BindMany", "[event][bind]")
+{
+    // Use enough handlers for the index by id to be used.
+    const int NUM_HANDLERS = 100;
+
+    wxEvtHandler handler;
+    std::vector<int> called;
+
+    // Handlers for the individual ids.
+    std::vector<TagRecorder> recorders;
+    for ( int id = 1; id <= NUM_HANDLERS; id++ )
+        recorders.push_back(TagRecorder(called, id));
+
+    for ( int id = 1; id <= NUM_HANDLERS; id++ )
+        handler.Bind(MyEventType, recorders[id - 1], id);
+
+    // Handlers for a range of ids, for all of them and for an id which already
+    // has a handler.
+    const TagRecorder range(called, -1),
+                      any(called, -2),
+                      another(called, -3);
+    handler.Bind(MyEventType, range, 10, 20);
+    handler.Bind(MyEventType, any);
+    handler.Bind(MyEventType, another, 15);
+
+    // The handlers must be called in the reverse order of binding.
+    MyEvent e;
+    e.SetId(15);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{-3, -2, -1, 15} );
+
+    called.clear();
+    e.SetId(50);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{-2, 50} );
+
+    called.clear();
+    e.SetId(NUM_HANDLERS + 1);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{-2} );
+
+    // Events of other types must not be affected by all these handlers.
+    called.clear();
+    wxThreadEvent other(wxEVT_THREAD, 15);
+    handler.ProcessEvent(other);
+    CHECK( called.empty() );
+
+    // Check that unbinding works too.
+    CHECK( handler.Unbind(MyEventType, recorders[49], 50) );
+    CHECK( handler.Unbind(MyEventType, any) );
+
+    called.clear();
+    e.SetId(50);
+    handler.ProcessEvent(e);
+    CHECK( called.empty() );
+
+    // And binding new handlers after unbinding the old ones.
+    handler.Bind(MyEventType, another, 50);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{-3} );
+
+    called.clear();
+    e.SetId(15);
+    handler.ProcessEvent(e);
+    CHECK( called == std::vector<int>{-3, -1, 15} );
+}
+
+TEST_CASE("Event::QueueEventCoalesced", "[event][queue]")
+{
+    wxEvtHandler handler;
+
+    std::vector<int> received;
+    handler.Bind(wxEVT_THREAD, [&received](wxThreadEvent& event)
+        {
+            received.push_back(event.GetInt());
+        });
+
+    const auto queue = [&handler](int n, const char* key = nullptr)
+        {
+            wxThreadEvent* const event = new wxThreadEvent();
+            event->SetInt(n);
+            if ( key )
+                handler.QueueEventCoalesced(event, key);
+            else
+                handler.QueueEvent(event);
+        };
+
+    queue(1);
+    queue(2, "progress");
+    queue(3, "other");
+    queue(4, "progress");
+    queue(5);
+    queue(6, "progress");
+
+    wxTheApp->ProcessPendingEvents();
+
+    // The last "progress" event replaces the first one in place.
+    const std::vector<int> expected{1, 6, 3, 5};
+    CHECK( received == expected );
+
+    // Once the event was processed, the next one is queued normally.
+    received.clear();
+    queue(7, "progress");
+    queue(8);
+    queue(9, "progress");
+
+    wxTheApp->ProcessPendingEvents();
+
+    const std::vector<int> expected2{9, 8};
+    CHECK( received == expected2 );
+
+    // Deleting the pending events also deletes the coalesced ones.
+    received.clear();
+    queue(10, "progress");
+    handler.DeletePendingEvents();
+    queue(11, "progress");
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( received == std::vector<int>{11} );
+}
+
+TEST_CASE("Event::QueueEventCoalescedOverride", "[event][queue]")
+{
+    // Handler forwarding all the queued events to another one.
+    class ForwardingHandler : public wxEvtHandler
+    {
+    public:
+        explicit ForwardingHandler(wxEvtHandler& target) : m_target(target) { }
+
+        virtual void QueueEvent(wxEvent* event) override
+        {
+            m_numQueued++;
+            m_target.QueueEvent(event);
+        }
+
+        int m_numQueued = 0;
+
+    private:
+        wxEvtHandler& m_target;
+    };
+
+    wxEvtHandler target;
+
+    std::vector<int> received;
+    target.Bind(wxEVT_THREAD, [&received](wxThreadEvent& event)
+        {
+            received.push_back(event.GetInt());
+        });
+
+    ForwardingHandler handler(target);
+
+    const auto queue = [&handler](int n)
+        {
+            wxThreadEvent* const event = new wxThreadEvent();
+            event->SetInt(n);
+            handler.QueueEventCoalesced(event, "progress");
+        };
+
+    queue(1);
+    queue(2);
+    queue(3);
+
+    // Only the first event is queued, the other ones replace it.
+    CHECK( handler.m_numQueued == 1 );
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( received == std::vector<int>{3} );
+}
+
 // This is a compilation-time-only test: just check that a class inheriting
 // from wxEvtHandler non-publicly can use Bind() with its method, this used to
 // result in compilation errors.
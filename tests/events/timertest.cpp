@@ -18,6 +18,8 @@
 
 #include <time.h>
 
+#include <vector>
+
 #include "wx/evtloop.h"
 #include "wx/timer.h"
 
@@ -137,3 +139,73 @@ void TimerEventTestCase::Multiple()
     // more than one
     CPPUNIT_ASSERT( numTicks > 1 );
 }
+
+TEST_CASE("Timer::Order", "[timer]")
+{
+    // Timer remembering the order in which the timers expired.
+    class OrderTimer : public wxTimer
+    {
+    public:
+        OrderTimer(int n,
+                   std::vector<int>& order,
+                   size_t numExpected,
+                   wxEventLoopBase& loop)
+            : m_n(n),
+              m_order(order),
+              m_numExpected(numExpected),
+              m_loop(loop)
+        {
+        }
+
+        virtual void Notify() override
+        {
+            m_order.push_back(m_n);
+
+            if ( m_order.size() == m_numExpected )
+                m_loop.Exit();
+        }
+
+    private:
+        const int m_n;
+        std::vector<int>& m_order;
+        const size_t m_numExpected;
+        wxEventLoopBase& m_loop;
+    };
+
+    const int NUM_TIMERS = 50;
+
+    // Some of the timers will be stopped before expiring.
+    std::vector<int> expected;
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        if ( n % 3 != 1 )
+            expected.push_back(n);
+    }
+
+    wxEventLoop loop;
+
+    std::vector<int> order;
+    std::vector<wxTimer*> timers;
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+        timers.push_back(new OrderTimer(n, order, expected.size(), loop));
+
+    // Start the timers in an order different from their expiration one.
+    for ( int n = 0; n < NUM_TIMERS; n++ )
+    {
+        const int i = (n*7) % NUM_TIMERS;
+        timers[i]->StartOnce(10 + 5*i);
+    }
+
+    for ( int n = 1; n < NUM_TIMERS; n += 3 )
+        timers[n]->Stop();
+
+    loop.Run();
+
+    CHECK( order == expected );
+
+    for ( auto timer : timers )
+    {
+        CHECK( !timer->IsRunning() );
+        delete timer;
+    }
+}
@@ -32,6 +32,8 @@
 #include "wx/clipbrd.h"
 #include "wx/dataobj.h"
 #include "wx/utils.h"
+#include "wx/imageloader.h"
+#include "wx/stopwatch.h"
 
 // Check if we can use wxDIB::ConvertToBitmap(), which only exists for MSW and
 // which assumes the target is little-endian (matching the file format)
@@ -2447,6 +2449,241 @@ TEST_CASE("wxImage::Clear", "[image]")
     CHECK( image.GetRed(1, 1) == 0xff );
 }
 
+TEST_CASE("wxImage::Blur", "[image][blur]")
+{
+    wxImage image(20, 10);
+    image.SetRGB(wxRect(0, 0, 20, 10), 0x10, 0x80, 0xf0);
+    image.SetAlpha();
+    memset(image.GetAlpha(), 0x7f, 20*10);
+
+    // Blurring a uniform image must not change it, whatever the radius is,
+    // including radii greater than the image size.
+    for ( int radius : { 0, 1, 5, 15, 100 } )
+    {
+        INFO("Radius " << radius);
+        const wxImage blurred = image.Blur(radius);
+        CHECK( memcmp(blurred.GetData(), image.GetData(), 20*10*3) == 0 );
+        CHECK( memcmp(blurred.GetAlpha(), image.GetAlpha(), 20*10) == 0 );
+    }
+
+    const wxImage gauss = image.BlurGaussian(7.5);
+    CHECK( memcmp(gauss.GetData(), image.GetData(), 20*10*3) == 0 );
+    CHECK( memcmp(gauss.GetAlpha(), image.GetAlpha(), 20*10) == 0 );
+
+    // Using the scratch buffer must give the same results.
+    image.SetRGB(3, 4, 0xff, 0, 0);
+    wxMemoryBuffer scratch;
+    CHECK_THAT( image.Blur(2, scratch), RGBASameAs(image.Blur(2)) );
+    CHECK_THAT( image.BlurGaussian(1.5, scratch),
+                RGBASameAs(image.BlurGaussian(1.5)) );
+}
+
+TEST_CASE("wxImageView", "[image][view]")
+{
+    wxImage image(10, 8);
+    image.SetAlpha();
+    for ( int y = 0; y < 8; y++ )
+    {
+        for ( int x = 0; x < 10; x++ )
+        {
+            image.SetRGB(x, y, x, y, x + y);
+            image.SetAlpha(x, y, 100 + x);
+        }
+    }
+
+    wxImageView view(image, wxRect(2, 3, 5, 4));
+    REQUIRE( view.IsOk() );
+    CHECK( view.GetSize() == wxSize(5, 4) );
+
+    // The view must share the data with the image.
+    CHECK( view.GetImage().GetData() == image.GetData() );
+    CHECK( view.GetRowStride() == 30 );
+
+    CHECK( view.GetRed(0, 0) == 2 );
+    CHECK( view.GetGreen(0, 0) == 3 );
+    CHECK( view.GetBlue(4, 3) == 12 );
+    CHECK( view.GetAlpha(1, 0) == 103 );
+    CHECK( view.GetRowData(1)[1] == 4 );
+    CHECK( view.GetRowAlpha(2)[4] == 106 );
+
+    const wxImageView subview = view.GetSubView(wxRect(1, 1, 2, 2));
+    CHECK( subview.GetRed(0, 0) == 3 );
+    CHECK( subview.GetGreen(0, 0) == 4 );
+
+    const wxImage sub = view.ToImage();
+    CHECK_THAT( sub, RGBASameAs(image.GetSubImage(wxRect(2, 3, 5, 4))) );
+
+    // Modifying the view must copy just its part of the image.
+    view.SetRGB(0, 0, 99, 99, 99);
+    CHECK( view.GetRed(0, 0) == 99 );
+    CHECK( view.GetImage().GetSize() == wxSize(5, 4) );
+    CHECK( image.GetRed(2, 3) == 2 );
+    CHECK( subview.GetRed(0, 0) == 3 );
+
+    // And modifying the image must not affect the existing views.
+    image.SetRGB(3, 4, 77, 77, 77);
+    CHECK( subview.GetRed(0, 0) == 3 );
+
+    // Converting the view of the entire image doesn't copy anything.
+    CHECK( wxImageView(image).ToImage().GetData() == image.GetData() );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::DesiredSize", "[image][jpeg]")
+{
+    wxImage image;
+    image.SetOption(wxIMAGE_OPTION_DESIRED_WIDTH, 40);
+    image.SetOption(wxIMAGE_OPTION_DESIRED_HEIGHT, 30);
+    REQUIRE( image.LoadFile("horse.jpg") );
+
+    // The image is 200*200 and can be decoded at 1/2, 1/4 or 1/8 scale, so
+    // 1/4 is the smallest one still big enough.
+    CHECK( image.GetSize() == wxSize(50, 50) );
+    CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == 200 );
+    CHECK( image.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) == 200 );
+
+    // Desired size is just a hint, the image is not upscaled to match it.
+    image = wxImage();
+    image.SetOption(wxIMAGE_OPTION_DESIRED_WIDTH, 1000);
+    REQUIRE( image.LoadFile("horse.jpg") );
+    CHECK( image.GetSize() == wxSize(200, 200) );
+
+    // And it is ignored by the handlers not supporting it.
+    image = wxImage();
+    image.SetOption(wxIMAGE_OPTION_DESIRED_WIDTH, 40);
+    REQUIRE( image.LoadFile("horse.png") );
+    CHECK( image.GetSize() == wxSize(200, 200) );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::Decoder", "[image][decoder]")
+{
+    const char* const files[] =
+    {
+        "horse.png",
+        "horse.jpg",
+        "image/toucan.png",
+        // Non-interlaced PNG with alpha channel.
+        "image/paste_input_overlay_transparent_border_semitransparent_circle.png",
+    };
+    for ( const char* file : files )
+    {
+        INFO("Decoding " << file);
+
+        wxFileInputStream fis(file);
+        REQUIRE( fis.IsOk() );
+
+        wxMemoryOutputStream mos;
+        fis.Read(mos);
+        const wxStreamBuffer* const sb = mos.GetOutputStreamBuffer();
+        const unsigned char* const data =
+            static_cast<unsigned char*>(sb->GetBufferStart());
+        const size_t size = sb->GetBufferSize();
+
+        wxImage image;
+        REQUIRE( image.LoadFile(file) );
+
+        wxImageHandler* const
+            handler = wxImage::FindHandler(image.GetType());
+        REQUIRE( handler );
+
+        // Feed the data in chunks of different sizes, including very small
+        // ones, to check that decoding can be suspended at any point.
+        for ( size_t chunk : { size_t(1), size_t(100), size } )
+        {
+            INFO("Chunk size " << chunk);
+
+            std::unique_ptr<wxImageDecoder> decoder(handler->CreateDecoder());
+            REQUIRE( decoder );
+
+            int numRows = 0;
+            decoder->SetRowsCallback([&numRows](int, int n) { numRows += n; });
+
+            for ( size_t pos = 0; pos < size; pos += chunk )
+            {
+                REQUIRE( decoder->Feed(data + pos, wxMin(chunk, size - pos)) );
+            }
+
+            REQUIRE( decoder->IsDone() );
+            CHECK( numRows == image.GetHeight() );
+            CHECK_THAT( decoder->GetImage(), RGBASameAs(image) );
+        }
+
+        // Decoding an incomplete image is not an error.
+        std::unique_ptr<wxImageDecoder> decoder(handler->CreateDecoder());
+        CHECK( decoder->Feed(data, size / 2) );
+        CHECK( !decoder->IsDone() );
+        CHECK( decoder->GetImage().IsOk() );
+        CHECK( !decoder->HasFailed() );
+    }
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImageLoader", "[image][loader]")
+{
+    wxEvtHandler handler;
+
+    wxString loadedPath;
+    wxImage loadedImage;
+    int numEvents = 0;
+    handler.Bind(wxEVT_IMAGE_LOADED, [&](wxThreadEvent& event)
+        {
+            loadedPath = event.GetString();
+            loadedImage = event.GetPayload<wxImage>();
+            numEvents++;
+        });
+
+    const auto waitForEvents = [&numEvents](int expected)
+        {
+            wxStopWatch sw;
+            while ( numEvents < expected && sw.Time() < 10000 )
+                wxYield();
+        };
+
+    wxImageLoader loader(&handler);
+
+    // Loading the same image twice only results in a single event.
+    loader.Load("horse.png");
+    loader.Load("horse.png");
+    CHECK( loader.IsLoading("horse.png") );
+    waitForEvents(1);
+    REQUIRE( numEvents == 1 );
+    CHECK( loadedPath == "horse.png" );
+    REQUIRE( loadedImage.IsOk() );
+    CHECK( loadedImage.GetSize() == wxSize(200, 200) );
+    CHECK( !loader.IsLoading("horse.png") );
+    CHECK( loader.GetCached("horse.png").IsOk() );
+    CHECK( loader.GetCacheSize() == 200*200*3 );
+
+    // Loaded image is scaled to fit into the requested size.
+    loader.Load("horse.jpg", wxSize(40, 30));
+    waitForEvents(2);
+    REQUIRE( numEvents == 2 );
+    REQUIRE( loadedImage.IsOk() );
+    CHECK( loadedImage.GetSize() == wxSize(30, 30) );
+    CHECK( !loader.GetCached("horse.jpg").IsOk() );
+    CHECK( loader.GetCached("horse.jpg", wxSize(40, 30)).IsOk() );
+
+    // Cached images still result in an event.
+    loader.Load("horse.png");
+    waitForEvents(3);
+    CHECK( numEvents == 3 );
+    CHECK( loadedImage.GetSize() == wxSize(200, 200) );
+
+    // Failure to load the image is reported using an invalid image.
+    loader.Load("no-such-file.png");
+    waitForEvents(4);
+    REQUIRE( numEvents == 4 );
+    CHECK( loadedPath == "no-such-file.png" );
+    CHECK( !loadedImage.IsOk() );
+
+    // Reducing the cache size removes the least recently used images.
+    loader.SetMaxCacheSize(200*200*3);
+    CHECK( loader.GetCached("horse.png").IsOk() );
+    CHECK( !loader.GetCached("horse.jpg", wxSize(40, 30)).IsOk() );
+
+    loader.ClearCache();
+    CHECK( loader.GetCacheSize() == 0 );
+    CHECK( !loader.GetCached("horse.png").IsOk() );
+}
+
 TEST_CASE("wxImage::SizeLimits", "[image]")
 {
 #if SIZEOF_VOID_P == 8
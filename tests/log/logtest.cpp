@@ -16,9 +16,17 @@
 #ifndef WX_PRECOMP
     #include "wx/log.h"
     #include "wx/filefn.h"
+    #include "wx/crt.h"
 #endif // WX_PRECOMP
 
 #include "wx/scopeguard.h"
+#include "wx/file.h"
+#include "wx/filename.h"
+#include "wx/logasync.h"
+#include "wx/mstream.h"
+#include "wx/thread.h"
+
+#include "testfile.h"
 
 #if wxUSE_LOG
 
@@ -372,4 +380,176 @@ TEST_CASE("wxLog::Trace", "[log][.]")
     wxLogTrace("logtest", "Ending test 1/4s later");
 }
 
+#if wxUSE_THREADS && wxUSE_STREAMS
+
+namespace
+{
+
+// Thread logging the given number of numbered messages.
+class LogAsyncThread : public wxThread
+{
+public:
+    LogAsyncThread(int id, int count)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_id(id),
+          m_count(count)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        for ( int n = 0; n < m_count; n++ )
+            wxLogMessage("thread %d message %d", m_id, n);
+
+        return nullptr;
+    }
+
+private:
+    const int m_id;
+    const int m_count;
+};
+
+// Log the given number of messages from each of the given number of threads
+// using wxLogAsync writing them to the memory stream and return the lines
+// written to it.
+//
+// If numWaves is greater than 1, this is repeated the given number of times
+// with the new threads, using the IDs following the ones of the previous
+// wave, after waiting until the messages of the previous threads are written.
+wxArrayString
+LogFromThreads(int numThreads,
+               int numMessages,
+               wxLogAsync::OverflowPolicy policy,
+               size_t* numDropped,
+               int numWaves = 1)
+{
+    wxMemoryOutputStream* const stream = new wxMemoryOutputStream();
+
+    wxLogAsync log(stream, 16);
+    REQUIRE( log.IsOk() );
+
+    log.SetOverflowPolicy(policy);
+    delete log.SetFormatter(new wxLogFormatterNone());
+
+    wxLog* const logOld = wxLog::SetActiveTarget(&log);
+    wxON_BLOCK_EXIT1( wxLog::SetActiveTarget, logOld );
+
+    for ( int wave = 0; wave < numWaves; wave++ )
+    {
+        std::vector<std::unique_ptr<LogAsyncThread>> threads;
+        for ( int n = 0; n < numThreads; n++ )
+        {
+            threads.emplace_back(new LogAsyncThread(wave*numThreads + n,
+                                                    numMessages));
+            REQUIRE( threads.back()->Run() == wxTHREAD_NO_ERROR );
+        }
+
+        for ( const auto& thread : threads )
+            thread->Wait();
+
+        log.WaitUntilWritten();
+    }
+
+    *numDropped = log.GetDroppedCount();
+
+    wxCharBuffer buf(stream->GetLength());
+    stream->CopyTo(buf.data(), buf.length());
+
+    wxArrayString lines = wxSplit(wxString::FromUTF8(buf), '\n', '\0');
+    REQUIRE( !lines.empty() );
+    CHECK( lines.back() == "" );
+    lines.pop_back();
+
+    return lines;
+}
+
+// Check that the messages of each thread are in the right order.
+void CheckLogAsyncOrder(const wxArrayString& lines, int numThreads)
+{
+    std::vector<int> last(numThreads, -1);
+    for ( const auto& line : lines )
+    {
+        int id, n;
+        REQUIRE( wxSscanf(line, "thread %d message %d", &id, &n) == 2 );
+        REQUIRE( id >= 0 );
+        REQUIRE( id < numThreads );
+        CHECK( n > last[id] );
+        last[id] = n;
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxLogAsync::Block", "[log][async]")
+{
+    const int NUM_THREADS = 4;
+    const int NUM_MESSAGES = 1000;
+
+    size_t numDropped = 0;
+    const wxArrayString lines = LogFromThreads(NUM_THREADS, NUM_MESSAGES,
+                                               wxLogAsync::Overflow_Block,
+                                               &numDropped);
+    CHECK( numDropped == 0 );
+    CHECK( lines.size() == NUM_THREADS*NUM_MESSAGES );
+    CheckLogAsyncOrder(lines, NUM_THREADS);
+}
+
+TEST_CASE("wxLogAsync::Drop", "[log][async]")
+{
+    const int NUM_THREADS = 4;
+    const int NUM_MESSAGES = 1000;
+
+    size_t numDropped = 0;
+    const wxArrayString lines = LogFromThreads(NUM_THREADS, NUM_MESSAGES,
+                                               wxLogAsync::Overflow_Drop,
+                                               &numDropped);
+    CHECK( lines.size() + numDropped == NUM_THREADS*NUM_MESSAGES );
+    CheckLogAsyncOrder(lines, NUM_THREADS);
+}
+
+TEST_CASE("wxLogAsync::ShortLivedThreads", "[log][async]")
+{
+    // The queues of the threads are deleted after they exit, check that this
+    // doesn't lose any messages.
+    const int NUM_THREADS = 4;
+    const int NUM_MESSAGES = 100;
+    const int NUM_WAVES = 50;
+
+    size_t numDropped = 0;
+    const wxArrayString lines = LogFromThreads(NUM_THREADS, NUM_MESSAGES,
+                                               wxLogAsync::Overflow_Block,
+                                               &numDropped,
+                                               NUM_WAVES);
+    CHECK( numDropped == 0 );
+    CHECK( lines.size() == NUM_WAVES*NUM_THREADS*NUM_MESSAGES );
+    CheckLogAsyncOrder(lines, NUM_WAVES*NUM_THREADS);
+}
+
+TEST_CASE("wxLogAsync::File", "[log][async]")
+{
+    TempFile file(wxFileName::CreateTempFileName("logasync"));
+
+    {
+        wxLogAsync log(file.GetName());
+        REQUIRE( log.IsOk() );
+
+        delete log.SetFormatter(new wxLogFormatterNone());
+
+        wxLog* const logOld = wxLog::SetActiveTarget(&log);
+        wxON_BLOCK_EXIT1( wxLog::SetActiveTarget, logOld );
+
+        wxLogMessage("first");
+        wxLogWarning("second");
+    }
+
+    // Destroying the log target must have written all messages.
+    wxFile f(file.GetName());
+    wxString contents;
+    REQUIRE( f.ReadAll(&contents) );
+    CHECK( contents == "first\nsecond\n" );
+}
+
+#endif // wxUSE_THREADS && wxUSE_STREAMS
+
 #endif // wxUSE_LOG
@@ -1508,3 +1508,162 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+// ----------------------------------------------------------------------------
+// Tests of the UTF-8 conversions of ASCII runs
+// ----------------------------------------------------------------------------
+
+// The UTF-8 conversions handle runs of ASCII characters specially, check that
+// they work correctly around the boundaries of these runs.
+TEST_CASE("wxMBConv::UTF8ASCIIRuns", "[mbconv][utf8]")
+{
+    wxMBConvUTF8 convNot(wxMBConvUTF8::MAP_INVALID_UTF8_NOT);
+    wxMBConvUTF8 convPUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    wxMBConvUTF8 convOctal(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL);
+
+    struct Conv
+    {
+        const char* name;
+        const wxMBConv& conv;
+        bool strict;
+    };
+
+    const Conv convs[] =
+    {
+        { "wxConvUTF8", wxConvUTF8, true },
+        { "MAP_INVALID_UTF8_NOT", convNot, true },
+        { "MAP_INVALID_UTF8_TO_PUA", convPUA, false },
+        { "MAP_INVALID_UTF8_TO_OCTAL", convOctal, false },
+    };
+
+    SECTION("WordBoundary")
+    {
+        // Put a non-ASCII character at all positions around the first two
+        // 8 byte words checked at once, using different alignments of the
+        // start of the string too.
+        for ( size_t pos = 0; pos < 20; pos++ )
+        {
+            const std::string
+                utf8 = std::string(pos, 'a') + "\xC3\xA9" + std::string(10, 'b');
+            const std::wstring
+                wide = std::wstring(pos, L'a') + L"\xE9" + std::wstring(10, L'b');
+
+            for ( size_t offset = 0; offset < 8; offset++ )
+            {
+                char src[64] = { 0 };
+                memcpy(src + offset, utf8.c_str(), utf8.length() + 1);
+
+                for ( const auto& c : convs )
+                {
+                    INFO(c.name << ": non-ASCII char at " << pos
+                                << ", offset " << offset);
+
+                    wchar_t wbuf[64];
+                    REQUIRE( c.conv.ToWChar(wbuf, WXSIZEOF(wbuf),
+                                            src + offset, utf8.length())
+                                == wide.length() );
+                    CHECK( std::wstring(wbuf, wide.length()) == wide );
+
+                    REQUIRE( c.conv.ToWChar(wbuf, WXSIZEOF(wbuf), src + offset)
+                                == wide.length() + 1 );
+                    CHECK( wbuf == wide );
+
+                    char buf[64];
+                    REQUIRE( c.conv.FromWChar(buf, WXSIZEOF(buf),
+                                              wide.c_str(), wide.length())
+                                == utf8.length() );
+                    CHECK( std::string(buf, utf8.length()) == utf8 );
+
+                    REQUIRE( c.conv.FromWChar(buf, WXSIZEOF(buf), wide.c_str())
+                                == utf8.length() + 1 );
+                    CHECK( buf == utf8 );
+                }
+            }
+        }
+    }
+
+    SECTION("Truncation")
+    {
+        // Output buffer ending in the middle of the run must not be overflown.
+        const std::string utf8(40, 'a');
+        const std::wstring wide(40, L'a');
+
+        for ( size_t len = 1; len < utf8.length(); len++ )
+        {
+            for ( const auto& c : convs )
+            {
+                INFO(c.name << ": buffer of size " << len);
+
+                // If the conversion doesn't fail, it converts as many
+                // characters as fit into the buffer.
+                const size_t expected = c.strict ? wxCONV_FAILED : len;
+
+                wchar_t wbuf[64];
+                std::fill_n(wbuf, WXSIZEOF(wbuf), L'#');
+                CHECK( c.conv.ToWChar(wbuf, len, utf8.c_str(), utf8.length())
+                        == expected );
+                CHECK( std::wstring(wbuf, len) == wide.substr(0, len) );
+                CHECK( wbuf[len] == L'#' );
+
+                char buf[64];
+                std::fill_n(buf, WXSIZEOF(buf), '#');
+                CHECK( c.conv.FromWChar(buf, len, wide.c_str(), wide.length())
+                        == expected );
+                CHECK( std::string(buf, len) == utf8.substr(0, len) );
+                CHECK( buf[len] == '#' );
+            }
+        }
+    }
+
+    SECTION("InvalidAfterRun")
+    {
+        // Invalid byte, lead byte not followed by a continuation one and
+        // incomplete sequence at the end of the string.
+        const char* const invalids[] = { "\xFF" "zz", "\xC3" "zz", "\xE2\x98" };
+
+        for ( size_t run : { 7, 8, 9, 16, 17, 33 } )
+        {
+            for ( const char* invalid : invalids )
+            {
+                const std::string ascii(run, 'a');
+                const std::string utf8 = ascii + invalid;
+
+                INFO("Run of " << run << " followed by \""
+                               << utf8.substr(run) << "\"");
+
+                CHECK( wxConvUTF8.ToWChar(nullptr, 0, utf8.c_str(), utf8.length())
+                        == wxCONV_FAILED );
+                CHECK( convNot.ToWChar(nullptr, 0, utf8.c_str(), utf8.length())
+                        == wxCONV_FAILED );
+
+                // PUA mode maps each invalid byte to a PUA character and
+                // these characters are converted back to the original bytes.
+                wxWCharBuffer
+                    wbuf = convPUA.cMB2WC(utf8.c_str(), utf8.length(), nullptr);
+                REQUIRE( wbuf );
+                const std::wstring wide(wbuf.data());
+                CHECK( wide.substr(0, run) == std::wstring(run, L'a') );
+                CHECK( wide.length() == run + strlen(invalid) );
+
+                wxCharBuffer buf = convPUA.cWC2MB(wide.c_str(), wide.length(), nullptr);
+                REQUIRE( buf );
+                CHECK( std::string(buf.data()) == utf8 );
+
+                // And octal mode replaces them with escape sequences.
+                std::wstring expected(run, L'a');
+                for ( const char* p = invalid; *p; p++ )
+                {
+                    const unsigned char ch = *p;
+                    if ( ch < 0x80 )
+                        expected += static_cast<wchar_t>(ch);
+                    else
+                        expected += wxString::Format("\\%03o", ch).wc_str();
+                }
+
+                wbuf = convOctal.cMB2WC(utf8.c_str(), utf8.length(), nullptr);
+                REQUIRE( wbuf );
+                CHECK( std::wstring(wbuf.data()) == expected );
+            }
+        }
+    }
+}
@@ -166,3 +166,45 @@ TEST_CASE_METHOD(SelStoreTest, "wxSelectionStore::InsertInSelected", "[selstore]
     CHECK( !m_store.IsSelected(3) );
     CHECK( m_store.GetSelectedCount() == NUM_ITEMS );
 }
+
+TEST_CASE("wxSelectionStore::ManyItems", "[selstore]")
+{
+    static const unsigned NUM_MANY = 10000000;
+
+    wxSelectionStore store;
+    store.SetItemCount(NUM_MANY);
+
+    // Select several non-adjacent ranges: this must be fast even for a huge
+    // number of items.
+    CHECK( !store.SelectRange(10, NUM_MANY/4) );
+    store.SelectRange(NUM_MANY/4 + 2, NUM_MANY/3);
+    CHECK( store.GetSelectedCount() == NUM_MANY/3 - 10 );
+    CHECK( !store.IsSelected(9) );
+    CHECK( store.IsSelected(NUM_MANY/4) );
+    CHECK( !store.IsSelected(NUM_MANY/4 + 1) );
+    CHECK( store.IsSelected(NUM_MANY/3) );
+    CHECK( !store.IsSelected(NUM_MANY/3 + 1) );
+
+    // Filling the gap between the ranges should only change a single item.
+    wxArrayInt changed;
+    CHECK( store.SelectRange(NUM_MANY/4 - 1, NUM_MANY/4 + 3, true, &changed) );
+    REQUIRE( changed.size() == 1 );
+    CHECK( changed[0] == static_cast<int>(NUM_MANY/4 + 1) );
+
+    // Inserting items in the middle of a range splits it.
+    store.OnItemsInserted(100, 5);
+    CHECK( store.IsSelected(99) );
+    CHECK( !store.IsSelected(100) );
+    CHECK( !store.IsSelected(104) );
+    CHECK( store.IsSelected(105) );
+    CHECK( store.GetSelectedCount() == NUM_MANY/3 - 9 );
+
+    // And deleting them joins it back.
+    CHECK( !store.OnItemsDeleted(100, 5) );
+    CHECK( store.IsSelected(100) );
+    CHECK( store.GetSelectedCount() == NUM_MANY/3 - 9 );
+
+    wxSelectionStore::IterationState cookie;
+    CHECK( store.GetFirstSelectedItem(cookie) == 10 );
+    CHECK( store.GetNextSelectedItem(cookie) == 11 );
+}
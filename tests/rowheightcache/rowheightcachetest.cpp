@@ -19,6 +19,8 @@
 
 #include "wx/generic/private/rowheightcache.h"
 
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // TestRowRangesAdd
 // ----------------------------------------------------------------------------
@@ -270,3 +272,165 @@ TEST_CASE("RowHeightCacheTestCase::TestHeightCache", "[dataview][heightcache]")
     CHECK(hc.GetLineAt(22180, row) == false);
     CHECK(row == 666);
 }
+
+// ----------------------------------------------------------------------------
+// TestHeightCacheInsertDelete
+// ----------------------------------------------------------------------------
+TEST_CASE("RowHeightCacheTestCase::TestHeightCacheInsertDelete", "[dataview][heightcache]")
+{
+    HeightCache hc;
+
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        hc.Put(i, 10 + i % 3);
+    }
+
+    int start = 0;
+    int height = 0;
+    unsigned int row = 0;
+
+    CHECK(hc.GetLineInfo(50, start, height) == true);
+    CHECK(start == 50*10 + 49);
+    CHECK(height == 12);
+
+    // insert 10 rows with unknown height before row 20
+    hc.InsertRows(20, 10);
+
+    CHECK(hc.GetLineHeight(19, height) == true);
+    CHECK(height == 11);
+    for (unsigned int i = 20; i < 30; i++)
+    {
+        CHECK(hc.GetLineHeight(i, height) == false);
+    }
+
+    // the positions of the rows after the unknown ones are unknown too
+    CHECK(hc.GetLineInfo(60, start, height) == false);
+    CHECK(hc.GetLineStart(30, start) == false);
+    CHECK(hc.GetLineAt(20*10 + 19, row) == false);
+
+    // but the rows before them are still fine
+    CHECK(hc.GetLineAt(20*10 + 18, row) == true);
+    CHECK(row == 19);
+
+    for (unsigned int i = 20; i < 29; i++)
+    {
+        hc.Put(i, 100);
+    }
+
+    // a single unknown row is enough to make all the following ones unknown
+    CHECK(hc.GetLineInfo(60, start, height) == false);
+
+    hc.Put(29, 100);
+
+    CHECK(hc.GetLineInfo(60, start, height) == true);
+    CHECK(height == 12);
+
+    CHECK(hc.GetLineStart(60, start) == true);
+    CHECK(start == 50*10 + 49 + 1000);
+
+    CHECK(hc.GetLineAt(20*10 + 19, row) == true);
+    CHECK(row == 20);
+    CHECK(hc.GetLineAt(20*10 + 19 + 999, row) == true);
+    CHECK(row == 29);
+    CHECK(hc.GetLineAt(20*10 + 19 + 1000, row) == true);
+    CHECK(row == 30);
+
+    // and delete them back
+    hc.DeleteRows(20, 10);
+
+    CHECK(hc.GetLineInfo(50, start, height) == true);
+    CHECK(start == 50*10 + 49);
+    CHECK(height == 12);
+
+    // deleting the rows after the last one only removes the existing ones
+    hc.DeleteRows(90, 20);
+    CHECK(hc.GetLineHeight(89, height) == true);
+    CHECK(hc.GetLineHeight(90, height) == false);
+    CHECK(hc.GetLineAt(90*10 + 90, row) == false);
+
+    // inserting rows after the last one does nothing
+    hc.InsertRows(90, 10);
+    CHECK(hc.GetLineHeight(90, height) == false);
+}
+
+// ----------------------------------------------------------------------------
+// TestHeightCacheRandom
+// ----------------------------------------------------------------------------
+TEST_CASE("RowHeightCacheTestCase::TestHeightCacheRandom", "[dataview][heightcache]")
+{
+    HeightCache hc;
+    std::vector<int> heights;
+
+    srand(0);
+
+    for (int iter = 0; iter < 2000; iter++)
+    {
+        const unsigned int row = rand() % 300;
+        switch ( rand() % 8 )
+        {
+            case 0:
+                hc.Remove(row);
+                if (row < heights.size())
+                    heights.resize(row);
+                break;
+
+            case 1:
+                hc.InsertRows(row, 5);
+                if (row < heights.size())
+                    heights.insert(heights.begin() + row, 5, 0);
+                break;
+
+            case 2:
+                hc.DeleteRows(row, 5);
+                if (row < heights.size())
+                {
+                    const size_t end = row + 5 < heights.size() ? row + 5
+                                                                : heights.size();
+                    heights.erase(heights.begin() + row, heights.begin() + end);
+                }
+                break;
+
+            default:
+                {
+                    const int height = 1 + rand() % 50;
+                    hc.Put(row, height);
+                    if (row >= heights.size())
+                        heights.resize(row + 1);
+                    heights[row] = height;
+                }
+        }
+
+        // check all rows against the heights stored in the vector: only the
+        // rows before the first one with unknown height have known positions
+        int y = 0;
+        bool allKnown = true;
+        for (unsigned int n = 0; n < heights.size(); n++)
+        {
+            int start = -1;
+            int height = -1;
+            if (!heights[n])
+                allKnown = false;
+
+            if (allKnown)
+            {
+                REQUIRE(hc.GetLineInfo(n, start, height) == true);
+                CHECK(start == y);
+                CHECK(height == heights[n]);
+
+                unsigned int row2 = 0;
+                REQUIRE(hc.GetLineAt(y + height - 1, row2) == true);
+                CHECK(row2 == n);
+            }
+            else
+            {
+                CHECK(hc.GetLineInfo(n, start, height) == false);
+            }
+
+            if (allKnown)
+                y += heights[n];
+        }
+
+        unsigned int rowAfter = 0;
+        CHECK(hc.GetLineAt(y, rowAfter) == false);
+    }
+}
@@ -17,10 +17,14 @@
     #include "wx/wx.h"
 #endif // WX_PRECOMP
 
+#include "wx/thread.h"
 #include "wx/private/localeset.h"
 
 #include <errno.h>
 
+#include <memory>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // tests
 // ----------------------------------------------------------------------------
@@ -1109,6 +1113,114 @@ TEST_CASE("StringIndexedAccess", "[wxString]")
     CHECK( (char)s[2] == 'r' );
 }
 
+TEST_CASE("StringIndexedAccessLong", "[wxString]")
+{
+    // Use a string long enough for UTF-8 build to use an index for it and
+    // access its characters in non-sequential order.
+    const size_t len = 20000;
+    wxString s;
+    for ( size_t n = 0; n < len; n++ )
+        s += wxUniChar(n % 3 ? 'a' + n % 26 : 0x400 + n % 256);
+
+    const auto expected = [](size_t n)
+    {
+        return wxUniChar(n % 3 ? 'a' + n % 26 : 0x400 + n % 256);
+    };
+
+    REQUIRE( s.length() == len );
+    for ( size_t n = 0; n < len; n += 7 )
+    {
+        const size_t pos = (n*7919) % len;
+        INFO( "pos=" << pos );
+        CHECK( s[pos] == expected(pos) );
+    }
+
+    CHECK( s.find(expected(len - 3), len - 26) == len - 3 );
+
+    // Check that modifying the string doesn't result in using wrong offsets.
+    s.insert(10, 5, wxUniChar(0x263A));
+    CHECK( s[len - 1 + 5] == expected(len - 1) );
+    CHECK( s[12] == wxUniChar(0x263A) );
+
+    s.erase(100, 1000);
+    CHECK( s[len - 1 + 5 - 1000] == expected(len - 1) );
+    CHECK( s[len/2] == expected(len/2 - 5 + 1000) );
+
+    s.Replace(wxUniChar(0x263A), "xy");
+    CHECK( s[len - 1 + 10 - 1000] == expected(len - 1) );
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+// Thread reading the characters of the given string in non-sequential order
+// and counting the ones different from the expected values.
+class IndexedReadThread : public wxThread
+{
+public:
+    IndexedReadThread(const wxString& s, unsigned seed)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_str(s),
+          m_seed(seed)
+    {
+    }
+
+    size_t GetErrorCount() const { return m_errors; }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        const size_t len = m_str.length();
+        for ( size_t n = 0; n < len; n++ )
+        {
+            const size_t pos = (n*7919 + m_seed) % len;
+            if ( m_str[pos] != ExpectedChar(pos) )
+                m_errors++;
+        }
+
+        return nullptr;
+    }
+
+private:
+    static wxUniChar ExpectedChar(size_t n)
+    {
+        return wxUniChar(n % 3 ? 'a' + n % 26 : 0x400 + n % 256);
+    }
+
+    const wxString& m_str;
+    const unsigned m_seed;
+    size_t m_errors = 0;
+};
+
+} // anonymous namespace
+
+TEST_CASE("StringIndexedAccessThreads", "[wxString]")
+{
+    // Several threads accessing the same const string must be able to do it
+    // concurrently, even if this requires creating the index for it.
+    const size_t len = 100000;
+    wxString s;
+    for ( size_t n = 0; n < len; n++ )
+        s += wxUniChar(n % 3 ? 'a' + n % 26 : 0x400 + n % 256);
+
+    std::vector<std::unique_ptr<IndexedReadThread>> threads;
+    for ( unsigned n = 0; n < 8; n++ )
+        threads.emplace_back(new IndexedReadThread(s, n*1000));
+
+    for ( const auto& thread : threads )
+        REQUIRE( thread->Run() == wxTHREAD_NO_ERROR );
+
+    for ( const auto& thread : threads )
+    {
+        thread->Wait();
+        CHECK( thread->GetErrorCount() == 0 );
+    }
+}
+
+#endif // wxUSE_THREADS
+
 TEST_CASE("StringBeforeAndAfter", "[wxString]")
 {
     // Construct a string with 2 equal signs in it by concatenating its three
@@ -19,6 +19,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/string.h"
+#include "wx/parsedfmt.h"
 
 // ----------------------------------------------------------------------------
 // tests themselves
@@ -292,3 +293,80 @@ TEST_CASE("PrintfError", "[wxString][Format][vararg][error]")
     const int invalidChar = 0x1780;
     REQUIRE_NOTHROW( CallPrintfV("%c", invalidChar) );
 }
+
+TEST_CASE("ParsedFormat", "[wxParsedFormat][vararg]")
+{
+    // Check that the results are the same as with wxString::Format().
+    #define CHECK_PARSED_FORMAT(fmt, ...) \
+        CHECK( wxParsedFormat(fmt).Format(__VA_ARGS__) == \
+                    wxString::Format(fmt, __VA_ARGS__) )
+
+    CHECK_PARSED_FORMAT("%s %i", "foo", 42);
+    CHECK_PARSED_FORMAT("[%s](%s)", wxString("bar"), L"wide");
+    CHECK_PARSED_FORMAT("%s", std::string("std"));
+    CHECK_PARSED_FORMAT("%d %d %d", INT_MIN, -1, INT_MAX);
+    CHECK_PARSED_FORMAT("%u %x %X %o", -1, 255, 255U, 8);
+    CHECK_PARSED_FORMAT("%ld %lu", LONG_MIN, ULONG_MAX);
+    CHECK_PARSED_FORMAT("%lld %llu", wxINT64_MIN, wxUINT64_MAX);
+    CHECK_PARSED_FORMAT("%zu", sizeof(int));
+    CHECK_PARSED_FORMAT("%05d|%-5d|%+d|%5.3d", 42, 42, 42, 42);
+    CHECK_PARSED_FORMAT("%f %.2f %10.3e %g", 1.5, 2.345, 12345.678, 0.1);
+    CHECK_PARSED_FORMAT("%c%c", 'a', 66);
+    CHECK_PARSED_FORMAT("%5s|%-5s|%.2s|%5c", "ab", "cd", "efgh", 'x');
+    CHECK_PARSED_FORMAT("%*d|%-*s|%.*f", 4, 1, 3, "x", 2, 3.14159);
+    CHECK_PARSED_FORMAT("%2$s %1$s", "world", "hello");
+    CHECK_PARSED_FORMAT("100%% %s%%", "done");
+    CHECK_PARSED_FORMAT("%s", wxString::FromUTF8("\xd0\xb4\xd0\xb0"));
+    CHECK_PARSED_FORMAT("%s", wxString('.', 10000));
+
+    #undef CHECK_PARSED_FORMAT
+
+    // wxString::Format() doesn't handle non-ASCII characters in UTF-8 build.
+    CHECK( wxParsedFormat("%c").Format(wxUniChar(0x263A)) ==
+                wxString(wxUniChar(0x263A)) );
+
+    const wxParsedFormat fmt("%s has %d items");
+    CHECK( fmt.IsOk() );
+    CHECK( fmt.GetFormat() == "%s has %d items" );
+    CHECK( fmt.GetArgumentCount() == 2 );
+
+    // FormatTo() replaces the contents of the string, AppendTo() doesn't.
+    wxString s = "old contents";
+    fmt.FormatTo(s, "list", 3);
+    CHECK( s == "list has 3 items" );
+
+    fmt.AppendTo(s, "another", 17);
+    CHECK( s == "list has 3 itemsanother has 17 items" );
+
+    // The output string can also be used as an argument.
+    s = "list";
+    fmt.FormatTo(s, s, 3);
+    CHECK( s == "list has 3 items" );
+
+    s = wxString(100, 'x');
+    fmt.AppendTo(s, s, 1);
+    CHECK( s == wxString(100, 'x') + wxString(100, 'x') + " has 1 items" );
+
+    const wxString ete = wxString::FromUTF8("\xC3\xA9t\xC3\xA9");
+    s = ete;
+    wxParsedFormat("[%10s]").FormatTo(s, s.c_str());
+    CHECK( s == "[" + wxString(7, ' ') + ete + "]" );
+
+    CHECK( wxParsedFormat("no arguments").Format() == "no arguments" );
+    CHECK( wxParsedFormat("").Format() == "" );
+}
+
+TEST_CASE("ParsedFormatValidation", "[wxParsedFormat][vararg][error]")
+{
+    const wxParsedFormat fmt("%d + %d = %d");
+    WX_ASSERT_FAILS_WITH_ASSERT( fmt.Format(2, 2) );
+    WX_ASSERT_FAILS_WITH_ASSERT( wxParsedFormat("%i").Format("foo") );
+    WX_ASSERT_FAILS_WITH_ASSERT( wxParsedFormat("%s").Format(42) );
+
+    // Passing more arguments than needed is allowed.
+    CHECK( fmt.Format(2, 2, 4, 8) == "2 + 2 = 4" );
+
+    // "%n" is not supported at all.
+    WX_ASSERT_FAILS_WITH_ASSERT( wxParsedFormat("foo%n") );
+    CHECK( !wxParsedFormat().IsOk() );
+}